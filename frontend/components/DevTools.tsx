@@ -12,6 +12,7 @@ import {
 } from "lucide-react";
 import type { ServiceStatus, LogEntry, AgentMetrics, RLMetrics, PerformanceMetrics } from "../types/index.js";
 import { PerformanceProfiler } from "./PerformanceProfiler.js";
+import { WasmProfilePanel } from "./WasmProfilePanel.js";
 import { LogViewer } from "./LogViewer.js";
 import { ConfigPanel } from "./ConfigPanel.js";
 import { exportLogsToJSON, exportStateToJSON } from "../utils/exportUtils.js";
@@ -258,6 +259,9 @@ export const DevTools = ({
               <div className="bg-slate-800 rounded p-4 border border-slate-700">
                 <PerformanceProfiler metrics={performanceMetrics} isVisible={true} />
               </div>
+              <div className="bg-slate-800 rounded p-4 border border-slate-700">
+                <WasmProfilePanel isVisible={true} />
+              </div>
               <div className="bg-slate-800 rounded p-4 border border-slate-700">
                 <h4 className="text-xs font-bold text-slate-400 mb-2">Detailed Metrics</h4>
                 <div className="space-y-2 font-mono text-xs">
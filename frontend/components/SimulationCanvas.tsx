@@ -50,7 +50,10 @@ export const SimulationCanvas = ({
         await loadWasmPhysics();
         if (!mounted) return;
 
-        physicsEngineRef.current = new WasmSpaceshipPhysicsEngine(defaultSpaceshipConfig);
+        const wasmEngine = new WasmSpaceshipPhysicsEngine(defaultSpaceshipConfig);
+        // Roll and speed are read every frame; take them from the state buffer
+        wasmEngine.setDerivedStateExport(true);
+        physicsEngineRef.current = wasmEngine;
         setPhysicsBackend('wasm');
         console.log('[SimulationCanvas] Using WASM physics engine');
       } catch (error) {
@@ -0,0 +1,111 @@
+import { useEffect, useRef, useState } from "react";
+import { Cpu, RotateCcw } from "lucide-react";
+import {
+  diffProfileSamples,
+  readWasmProfiles,
+  resetWasmProfiles,
+  type ProfileSample,
+} from "../utils/wasmProfiler.js";
+
+interface WasmProfilePanelProps {
+  isVisible: boolean;
+  intervalMs?: number;
+}
+
+// Live per-stage self time inside the WASM modules, read zero-copy from each
+// module's profile buffer. "boundary" self time is the embind glue around the
+// calls; a large share of it means crossings, not the math, cost the frame.
+export const WasmProfilePanel = ({ isVisible, intervalMs = 500 }: WasmProfilePanelProps) => {
+  const [intervals, setIntervals] = useState<ProfileSample[]>([]);
+  const previousRef = useRef<ProfileSample[]>([]);
+
+  useEffect(() => {
+    if (!isVisible) return;
+    previousRef.current = readWasmProfiles();
+    const timer = setInterval(() => {
+      const current = readWasmProfiles();
+      const previous = previousRef.current;
+      setIntervals(
+        current.map((sample) => {
+          const earlier = previous.find((p) => p.module === sample.module);
+          return earlier ? diffProfileSamples(sample, earlier) : sample;
+        })
+      );
+      previousRef.current = current;
+    }, intervalMs);
+    return () => clearInterval(timer);
+  }, [isVisible, intervalMs]);
+
+  if (!isVisible) return null;
+
+  const handleReset = () => {
+    resetWasmProfiles();
+    previousRef.current = readWasmProfiles();
+  };
+
+  const enabled = intervals.filter((sample) => sample.enabled);
+  const perSecond = 1000 / intervalMs;
+
+  return (
+    <div className="space-y-3 font-mono text-xs">
+      <div className="flex items-center justify-between">
+        <div className="flex items-center gap-2 text-slate-400">
+          <Cpu className="w-3 h-3" />
+          <span className="font-bold">WASM Stages (self time per second)</span>
+        </div>
+        <button
+          onClick={handleReset}
+          className="px-2 py-1 bg-slate-900 border border-slate-700 text-slate-400 rounded hover:text-slate-200 flex items-center gap-1"
+        >
+          <RotateCcw size={10} /> Reset
+        </button>
+      </div>
+
+      {enabled.length === 0 && (
+        <div className="text-slate-500">
+          No profiled WASM module loaded. Build the native modules with -DAERONAV_PROFILING=ON.
+        </div>
+      )}
+
+      {enabled.map((sample) => {
+        const stages = sample.stages.filter((stage) => stage.calls > 0);
+        const moduleMs = stages.reduce((sum, stage) => sum + stage.selfMs, 0);
+        const boundary = stages.find((stage) => stage.name === "boundary");
+        const boundaryShare = moduleMs > 0 && boundary ? boundary.selfMs / moduleMs : 0;
+        return (
+          <div key={sample.module} className="bg-slate-900 rounded p-3 border border-slate-700">
+            <div className="flex justify-between mb-2">
+              <span className="text-sky-400 font-bold">{sample.module}</span>
+              <span className="text-slate-400">
+                {(moduleMs * perSecond).toFixed(2)} ms/s · {Math.round(sample.counters.boundaryCalls * perSecond)} calls/s ·
+                glue {(boundaryShare * 100).toFixed(0)}%
+              </span>
+            </div>
+            <div className="space-y-1">
+              {stages.map((stage) => (
+                <div key={stage.name} className="flex items-center gap-2">
+                  <span className="w-32 text-slate-500 truncate">{stage.name}</span>
+                  <div className="flex-1 h-2 bg-slate-800 rounded overflow-hidden">
+                    <div
+                      className={stage.name === "boundary" ? "h-full bg-amber-500" : "h-full bg-emerald-500"}
+                      style={{ width: `${moduleMs > 0 ? (stage.selfMs / moduleMs) * 100 : 0}%` }}
+                    />
+                  </div>
+                  <span className="w-36 text-right text-slate-300">
+                    {(stage.selfMs * perSecond).toFixed(3)}ms · {Math.round(stage.calls * perSecond)}/s
+                  </span>
+                </div>
+              ))}
+            </div>
+            <div className="flex gap-4 mt-2 text-slate-500">
+              <span>steps/s {Math.round(sample.counters.steps * perSecond)}</span>
+              <span>items/s {Math.round(sample.counters.items * perSecond)}</span>
+              <span>events/s {Math.round(sample.counters.events * perSecond)}</span>
+              <span>new heap blocks {sample.counters.heapAllocations}</span>
+            </div>
+          </div>
+        );
+      })}
+    </div>
+  );
+};
@@ -2,16 +2,91 @@
 // SIMD-accelerated frequency analysis
 
 import type { AudioAnalysisResult } from '../workers/audioProcessor.worker';
+import { registerProfiledModule, type WasmProfileExports } from './wasmProfiler';
 
 // Re-export for convenience
 export type { AudioAnalysisResult };
 
 // WASM module interface (matches embind exports)
-interface WasmAudioModule {
+interface WasmAudioModule extends WasmProfileExports {
   AudioAnalyzer: {
     new (): WasmAudioAnalyzerInstance;
+    new (maxBins: number): WasmAudioAnalyzerInstance;
+  };
+  StreamingAnalyzer: {
+    new (): WasmStreamingAnalyzerInstance;
+    new (
+      fftSize: number,
+      hopSize: number,
+      inputCapacity: number,
+      resultRecords: number,
+      mode: number
+    ): WasmStreamingAnalyzerInstance;
+  };
+  BandBank: {
+    new (): WasmBandBankInstance;
+    new (
+      bandCount: number,
+      binCount: number,
+      sampleRate: number,
+      minHz: number,
+      maxHz: number,
+      scale: number
+    ): WasmBandBankInstance;
   };
   analyzeFrequencies(data: Uint8Array): WasmAudioResult;
+  // Only exported by the shared-memory build (AERONAV_AUDIO_SHARED_MEMORY)
+  HEAPF32?: Float32Array;
+  HEAPU32?: Uint32Array;
+  STREAM_INPUT_PCM: number;
+  STREAM_INPUT_SPECTRUM: number;
+  STREAM_RESULT_STRIDE: number;
+  BAND_SCALE_LOG: number;
+  BAND_SCALE_MEL: number;
+  BAND_DETECTOR_STRIDE: number;
+}
+
+export interface RingLayout {
+  dataPtr: number;
+  capacity: number;
+  writeIndexPtr: number;
+  readIndexPtr: number;
+}
+
+interface WasmStreamingAnalyzerInstance {
+  process(maxBlocks: number): number;
+  getInputLayout(): RingLayout;
+  getResultLayout(): RingLayout;
+  getBlockSize(): number;
+  getHopSize(): number;
+  getSequence(): number;
+  getDroppedResults(): number;
+  setWindow(window: number): void;
+  setSmoothing(timeConstant: number): void;
+  setBassRange(endPercent: number): void;
+  setMidRange(endPercent: number): void;
+  delete(): void;
+}
+
+interface WasmBandBankInstance {
+  configure(bandCount: number, binCount: number, sampleRate: number, minHz: number, maxHz: number, scale: number): boolean;
+  getBandCount(): number;
+  setSmoothing(timeConstant: number): void;
+  setPeakDecay(decay: number): void;
+  setOnsetThreshold(ratio: number, minFlux: number): void;
+  setNoiseBands(begin: number, end: number): void;
+  setNoiseThresholds(high: number, low: number): void;
+  reset(): void;
+  getInputBuffer(length: number): Uint8Array;
+  getFloatInputBuffer(length: number): Float32Array;
+  process(length: number): number;
+  processFloat(length: number, normalized: boolean): number;
+  getBandView(): Float32Array;
+  getPeakView(): Float32Array;
+  getBandEdgeView(): Uint32Array;
+  getBandCenterView(): Float32Array;
+  getDetectorView(): Float32Array;
+  delete(): void;
 }
 
 interface WasmAudioResult {
@@ -22,6 +97,11 @@ interface WasmAudioResult {
 }
 
 interface WasmAudioAnalyzerInstance {
+  getInputBuffer(length: number): Uint8Array;
+  getFloatInputBuffer(length: number): Float32Array;
+  analyzeInput(length: number): WasmAudioResult;
+  analyzeFloatInput(length: number, normalized: boolean): WasmAudioResult;
+  analyzePointer(ptr: number, length: number): WasmAudioResult;
   analyzeUint8(data: Uint8Array): WasmAudioResult;
   analyzeFloat32(data: Float32Array, normalized: boolean): WasmAudioResult;
   setBassRange(endPercent: number): void;
@@ -52,6 +132,7 @@ export async function loadWasmAudio(): Promise<WasmAudioModule> {
       // The module is expected to be at /wasm/audio_fft.js
       const createModule = await import('/wasm/audio_fft.js');
       wasmModule = await createModule.default();
+      registerProfiledModule('audio', wasmModule!);
       console.log('[WasmAudio] Module loaded successfully');
       return wasmModule!;
     } catch (error) {
@@ -100,19 +181,41 @@ export function analyzeFrequenciesWasm(data: Uint8Array): AudioAnalysisResult |
  */
 export class WasmAudioAnalyzer {
   private analyzer: WasmAudioAnalyzerInstance;
+  private byteInput: Uint8Array | null = null;
+  private floatInput: Float32Array | null = null;
 
-  constructor() {
+  constructor(maxBins: number = 2048) {
     if (!wasmModule) {
       throw new Error('WASM module not loaded. Call loadWasmAudio() first.');
     }
-    this.analyzer = new wasmModule.AudioAnalyzer();
+    this.analyzer = new wasmModule.AudioAnalyzer(maxBins);
+  }
+
+  /**
+   * Persistent WASM-owned input view of the given length
+   * Re-acquired when the length changes or WASM memory growth detached it
+   */
+  private getByteInput(length: number): Uint8Array {
+    if (!this.byteInput || this.byteInput.length !== length) {
+      this.byteInput = this.analyzer.getInputBuffer(length);
+    }
+    return this.byteInput;
+  }
+
+  private getFloatInput(length: number): Float32Array {
+    if (!this.floatInput || this.floatInput.length !== length) {
+      this.floatInput = this.analyzer.getFloatInputBuffer(length);
+    }
+    return this.floatInput;
   }
 
   /**
    * Analyze Uint8Array frequency data (from getByteFrequencyData)
+   * Copies with a single set() into WASM memory and analyzes in place
    */
   analyzeUint8(data: Uint8Array): AudioAnalysisResult {
-    const result = this.analyzer.analyzeUint8(data);
+    this.getByteInput(data.length).set(data);
+    const result = this.analyzer.analyzeInput(data.length);
     return {
       bass: result.bass,
       mid: result.mid,
@@ -126,7 +229,8 @@ export class WasmAudioAnalyzer {
    * @param normalized If true, expects 0-1 range; if false, expects -1 to 1
    */
   analyzeFloat32(data: Float32Array, normalized: boolean = true): AudioAnalysisResult {
-    const result = this.analyzer.analyzeFloat32(data, normalized);
+    this.getFloatInput(data.length).set(data);
+    const result = this.analyzer.analyzeFloatInput(data.length, normalized);
     return {
       bass: result.bass,
       mid: result.mid,
@@ -159,6 +263,308 @@ export class WasmAudioAnalyzer {
   }
 }
 
+// Result record layout (matches StreamResultLayout in audio_stream.hpp)
+const STREAM_RESULT = {
+  SEQUENCE: 0,
+  BASS: 1,
+  MID: 2,
+  TREBLE: 3,
+  VOLUME: 4,
+} as const;
+
+export interface StreamedAudioResult extends AudioAnalysisResult {
+  sequence: number;                // hop counter (uint32 word in the record)
+}
+
+export interface StreamingAnalyzerOptions {
+  fftSize?: number;
+  hopSize?: number;
+  inputCapacity?: number;          // input ring floats
+  resultRecords?: number;          // result ring records
+}
+
+/**
+ * Streaming analyzer over two lock-free rings in shared WASM memory
+ * The module and the analysis live in a worker (workers/audioStream.worker.ts):
+ * an AudioWorklet (workers/audioStream.worklet.ts) writes PCM into the input
+ * ring and wakes the worker, which analyzes every complete hop; readLatest()
+ * drains results on this thread straight from the shared heap, without blocking.
+ * Requires the AERONAV_AUDIO_SHARED_MEMORY build and cross-origin isolation.
+ */
+export class WasmStreamingAnalyzer {
+  private worker: Worker;
+  private heapF32: Float32Array;
+  private heapU32: Uint32Array;
+  private inputLayout: RingLayout;
+  private resultLayout: RingLayout;
+  private stride: number;
+  private latest: StreamedAudioResult | null = null;
+  private droppedResults = 0;
+
+  private constructor(worker: Worker, heap: SharedArrayBuffer, inputLayout: RingLayout,
+                      resultLayout: RingLayout, stride: number) {
+    this.worker = worker;
+    this.heapF32 = new Float32Array(heap);
+    this.heapU32 = new Uint32Array(heap);
+    this.inputLayout = inputLayout;
+    this.resultLayout = resultLayout;
+    this.stride = stride;
+    this.worker.onmessage = (event: MessageEvent) => {
+      if (event.data.type === 'STATS') this.droppedResults = event.data.droppedResults;
+    };
+  }
+
+  /**
+   * Start the analysis worker; resolves once its rings are allocated
+   */
+  static create(options: StreamingAnalyzerOptions = {}): Promise<WasmStreamingAnalyzer> {
+    const { fftSize = 2048, hopSize = 512, inputCapacity = 16384, resultRecords = 256 } = options;
+    const worker = new Worker(new URL('../workers/audioStream.worker.ts', import.meta.url), { type: 'module' });
+    return new Promise((resolve, reject) => {
+      worker.onmessage = (event: MessageEvent) => {
+        const message = event.data;
+        if (message.type === 'READY') {
+          resolve(new WasmStreamingAnalyzer(worker, message.heap, message.inputLayout,
+                                            message.resultLayout, message.stride));
+        } else if (message.type === 'ERROR') {
+          worker.terminate();
+          reject(new Error(message.message));
+        }
+      };
+      worker.postMessage({ type: 'START', fftSize, hopSize, inputCapacity, resultRecords });
+    });
+  }
+
+  /**
+   * Connect an AudioWorkletNode running 'aeronav-stream' to the input ring
+   */
+  attachWorklet(node: AudioWorkletNode): void {
+    node.port.postMessage({
+      type: 'ATTACH_RING',
+      heap: this.heapF32.buffer,
+      layout: this.inputLayout,
+    });
+  }
+
+  /**
+   * Drain the result ring and return the newest result (or the last one seen)
+   */
+  readLatest(): StreamedAudioResult | null {
+    const { dataPtr, capacity, writeIndexPtr, readIndexPtr } = this.resultLayout;
+    const readSlot = readIndexPtr >> 2;
+    let read = Atomics.load(this.heapU32, readSlot);
+    const write = Atomics.load(this.heapU32, writeIndexPtr >> 2);
+    const pending = (write - read) >>> 0;
+    if (pending < this.stride) {
+      return this.latest;
+    }
+
+    // Skip to the newest complete record; older ones are stale for the UI
+    read = (read + pending - this.stride) >>> 0;
+    const base = (dataPtr >> 2) + (read & (capacity - 1));
+    const heap = this.heapF32;
+    this.latest = {
+      sequence: this.heapU32[base + STREAM_RESULT.SEQUENCE],
+      bass: heap[base + STREAM_RESULT.BASS],
+      mid: heap[base + STREAM_RESULT.MID],
+      treble: heap[base + STREAM_RESULT.TREBLE],
+      volume: heap[base + STREAM_RESULT.VOLUME],
+    };
+    Atomics.store(this.heapU32, readSlot, (read + this.stride) >>> 0);
+    return this.latest;
+  }
+
+  /** Results dropped because readLatest() fell behind (reported by the worker) */
+  getDroppedResults(): number {
+    return this.droppedResults;
+  }
+
+  setBassRange(endPercent: number): void {
+    this.worker.postMessage({ type: 'SET_RANGES', bassEndPercent: endPercent });
+  }
+
+  setMidRange(endPercent: number): void {
+    this.worker.postMessage({ type: 'SET_RANGES', midEndPercent: endPercent });
+  }
+
+  // The module and its rings go with the worker
+  dispose(): void {
+    this.worker.terminate();
+  }
+}
+
+// Detector record layout (matches BandDetectorLayout in band_bank.hpp)
+const BAND_DETECTOR = {
+  NOISE_LEVEL: 0,
+  FLUX: 1,
+  ONSET: 2,
+  NOISE_STATE: 3,
+} as const;
+
+export type BandScaleName = 'LOG' | 'MEL';
+
+export interface BandBankOptions {
+  bandCount?: number;
+  binCount?: number;               // analyser.frequencyBinCount
+  sampleRate?: number;
+  minHz?: number;
+  maxHz?: number;                  // clamped to Nyquist
+  scale?: BandScaleName;
+}
+
+export interface BandDetectorResult {
+  noiseState: 'LOW_NOISE' | 'HIGH_NOISE';
+  noiseLevel: number;              // mean raw level of the noise bands (0-1)
+  flux: number;                    // mean positive band rise since the last frame
+  onset: boolean;
+}
+
+/**
+ * N log/mel-spaced bands with smoothing, peak hold and noise/onset
+ * detection, computed natively in one pass per frame. `bands` and `peaks`
+ * are WASM-owned views refreshed in place, so visualizations read them
+ * directly instead of looping over bins.
+ */
+export class WasmBandBank {
+  private bank: WasmBandBankInstance;
+  private byteInput: Uint8Array | null = null;
+  private floatInput: Float32Array | null = null;
+  private bandView!: Float32Array;
+  private peakView!: Float32Array;
+  private detectorView!: Float32Array;
+
+  constructor(options: BandBankOptions = {}) {
+    if (!wasmModule) {
+      throw new Error('WASM module not loaded. Call loadWasmAudio() first.');
+    }
+    this.bank = new wasmModule.BandBank();
+    this.configure(options);
+  }
+
+  /**
+   * Lay out the bands; false (previous layout kept) if they do not fit the bins
+   */
+  configure(options: BandBankOptions = {}): boolean {
+    const {
+      bandCount = 24,
+      binCount = 1024,
+      sampleRate = 44100,
+      minHz = 40,
+      maxHz = 16000,
+      scale = 'LOG',
+    } = options;
+    const ok = this.bank.configure(
+      bandCount,
+      binCount,
+      sampleRate,
+      minHz,
+      maxHz,
+      scale === 'MEL' ? wasmModule!.BAND_SCALE_MEL : wasmModule!.BAND_SCALE_LOG
+    );
+    this.refreshViews();
+    return ok;
+  }
+
+  get bandCount(): number {
+    return this.bandView.length;
+  }
+
+  /** Smoothed band levels (0-1), refreshed by every process call */
+  get bands(): Float32Array {
+    if (this.bandView.byteLength === 0) this.refreshViews();
+    return this.bandView;
+  }
+
+  /** Held peaks of the smoothed bands */
+  get peaks(): Float32Array {
+    if (this.peakView.byteLength === 0) this.refreshViews();
+    return this.peakView;
+  }
+
+  /** Center frequency of each band in Hz (a copy, for labels) */
+  getBandCenters(): Float32Array {
+    return this.bank.getBandCenterView().slice();
+  }
+
+  /**
+   * Analyze one getByteFrequencyData spectrum
+   */
+  processUint8(data: Uint8Array): BandDetectorResult {
+    if (!this.byteInput || this.byteInput.length !== data.length || this.byteInput.byteLength === 0) {
+      this.byteInput = this.bank.getInputBuffer(data.length);
+    }
+    this.byteInput.set(data);
+    this.bank.process(data.length);
+    return this.readDetector();
+  }
+
+  /**
+   * Analyze one float spectrum
+   * @param normalized If true, expects 0-1 range; if false, expects -1 to 1
+   */
+  processFloat32(data: Float32Array, normalized: boolean = true): BandDetectorResult {
+    if (!this.floatInput || this.floatInput.length !== data.length || this.floatInput.byteLength === 0) {
+      this.floatInput = this.bank.getFloatInputBuffer(data.length);
+    }
+    this.floatInput.set(data);
+    this.bank.processFloat(data.length, normalized);
+    return this.readDetector();
+  }
+
+  setSmoothing(timeConstant: number): void {
+    this.bank.setSmoothing(timeConstant);
+  }
+
+  setPeakDecay(decay: number): void {
+    this.bank.setPeakDecay(decay);
+  }
+
+  setOnsetThreshold(ratio: number, minFlux: number = 0.02): void {
+    this.bank.setOnsetThreshold(ratio, minFlux);
+  }
+
+  /**
+   * Bands [begin, end) whose level drives the noise state
+   * (default: those below 10% of Nyquist, the JS bass band)
+   */
+  setNoiseBands(begin: number, end: number): void {
+    this.bank.setNoiseBands(begin, end);
+  }
+
+  /**
+   * HIGH_NOISE above `high`, back to LOW_NOISE at or below `low`
+   * (default 0.4 for both, the JS bass > 0.4 rule)
+   */
+  setNoiseThresholds(high: number, low: number = high): void {
+    this.bank.setNoiseThresholds(high, low);
+  }
+
+  reset(): void {
+    this.bank.reset();
+  }
+
+  dispose(): void {
+    this.bank.delete();
+  }
+
+  private refreshViews(): void {
+    this.bandView = this.bank.getBandView();
+    this.peakView = this.bank.getPeakView();
+    this.detectorView = this.bank.getDetectorView();
+  }
+
+  private readDetector(): BandDetectorResult {
+    if (this.detectorView.byteLength === 0) this.refreshViews();
+    const detector = this.detectorView;
+    return {
+      noiseState: detector[BAND_DETECTOR.NOISE_STATE] !== 0 ? 'HIGH_NOISE' : 'LOW_NOISE',
+      noiseLevel: detector[BAND_DETECTOR.NOISE_LEVEL],
+      flux: detector[BAND_DETECTOR.FLUX],
+      onset: detector[BAND_DETECTOR.ONSET] !== 0,
+    };
+  }
+}
+
 /**
  * Create audio analyzer, trying WASM first
  * Returns null if WASM unavailable (caller should use JS fallback)
@@ -0,0 +1,136 @@
+// WASM multi-agent system helpers for Aeronav
+// Zero-copy access to the native coordination event log
+
+import { registerProfiledModule, type WasmProfileExports } from './wasmProfiler';
+
+// Packed event record layout (matching WASM COORDINATION_EVENT_* constants)
+export const COORDINATION_EVENT_LAYOUT = {
+  TIMESTAMP: 0,
+  AGENT1_ID: 1,
+  AGENT2_ID: 2,
+  TYPE: 3,
+  STRIDE: 4,
+} as const;
+
+// CoordinationType values in the TYPE word
+export const COORDINATION_TYPES = ['cooperation', 'conflict', 'independence'] as const;
+
+// WASM module interface (subset of the embind exports used here)
+export interface WasmMultiAgentModule extends WasmProfileExports {
+  MultiAgentSystem: {
+    new (): WasmMultiAgentSystemInstance;
+    // Arena-backed for up to maxAgents agents (64-bit seed as two 32-bit halves)
+    new (seedLow: number, seedHigh: number, maxAgents: number): WasmMultiAgentSystemInstance;
+  };
+  COORDINATION_EVENT_STRIDE: number;
+  getAllocationStats(): WasmAllocationStats;
+}
+
+// Heap traffic of the module's native containers; a steady-state loop should
+// leave heapAllocations unchanged (memory growth detaches every typed-array view)
+export interface WasmAllocationStats {
+  heapAllocations: number;
+  heapFrees: number;
+  heapBytesInUse: number;
+  arenaAllocations: number;
+}
+
+export interface WasmMultiAgentSystemInstance {
+  detectCoordination(timestamp: number): void;
+  getCoordinationEventCount(): number;
+  clearCoordinationEvents(): void;
+  setCoordinationEventCapacity(capacity: number): void;
+  getCoordinationEventCapacity(): number;
+  getCoordinationSequence(): number;
+  getFirstCoordinationSequence(): number;
+  getCoordinationEventView(): Uint32Array;
+  getAgentCapacity(): number;
+  delete(): void;
+}
+
+export interface CoordinationEventBatch {
+  // Packed records (COORDINATION_EVENT_LAYOUT.STRIDE words each), oldest first
+  records: Uint32Array;
+  count: number;
+  // Sequence of records[0]; later than the requested one if events were overwritten
+  firstSequence: number;
+  // Pass this to the next readSince() call
+  nextSequence: number;
+}
+
+// Global module cache
+let wasmModule: WasmMultiAgentModule | null = null;
+let loadPromise: Promise<WasmMultiAgentModule> | null = null;
+
+/**
+ * Load the WASM multi-agent module
+ * Returns cached module if already loaded
+ */
+export async function loadWasmMultiAgent(): Promise<WasmMultiAgentModule> {
+  if (wasmModule) {
+    return wasmModule;
+  }
+
+  if (loadPromise) {
+    return loadPromise;
+  }
+
+  loadPromise = (async () => {
+    try {
+      // The module is expected to be at /wasm/multi_agent.js
+      const createModule = await import('/wasm/multi_agent.js');
+      wasmModule = await createModule.default();
+      registerProfiledModule('rl', wasmModule!);
+      console.log('[WasmMultiAgent] Module loaded successfully');
+      return wasmModule!;
+    } catch (error) {
+      console.error('[WasmMultiAgent] Failed to load module:', error);
+      loadPromise = null;
+      throw error;
+    }
+  })();
+
+  return loadPromise;
+}
+
+/**
+ * Incremental reader over a MultiAgentSystem's coordination event ring
+ * Event s lives in record s % capacity of the ring view, so readSince() makes
+ * three boundary calls regardless of how many events are returned.
+ */
+export class WasmCoordinationEventLog {
+  private system: WasmMultiAgentSystemInstance;
+  private view: Uint32Array;
+
+  constructor(system: WasmMultiAgentSystemInstance) {
+    this.system = system;
+    this.view = system.getCoordinationEventView();
+  }
+
+  /**
+   * Every retained event with sequence >= `sequence`, copied out in order
+   */
+  readSince(sequence: number): CoordinationEventBatch {
+    const stride = COORDINATION_EVENT_LAYOUT.STRIDE;
+    const capacity = this.system.getCoordinationEventCapacity();
+    const next = this.system.getCoordinationSequence();
+    const first = Math.max(sequence, this.system.getFirstCoordinationSequence());
+    const count = Math.max(0, next - first);
+
+    // Re-acquire if memory growth detached the view or the capacity changed
+    if (this.view.length !== capacity * stride) {
+      this.view = this.system.getCoordinationEventView();
+    }
+
+    // At most two contiguous runs (before and after the wrap point)
+    const records = new Uint32Array(count * stride);
+    const start = first % capacity;
+    const head = Math.min(count, capacity - start);
+    records.set(this.view.subarray(start * stride, (start + head) * stride), 0);
+    if (head < count) {
+      records.set(this.view.subarray(0, (count - head) * stride), head * stride);
+    }
+
+    return { records, count, firstSequence: first, nextSequence: next };
+  }
+}
@@ -0,0 +1,198 @@
+// WASM audio -> RL pipeline for Aeronav
+// One module holds the band analyzer and the multi-agent system, so a tick
+// (spectrum -> noise state -> stepAll) is a single WASM call
+
+import { registerProfiledModule } from './wasmProfiler';
+import type { WasmMultiAgentModule, WasmMultiAgentSystemInstance } from './wasmMultiAgentSystem';
+
+export type NoiseStateName = 'LOW_NOISE' | 'HIGH_NOISE';
+
+// Pipeline module interface: the RL exports plus the pipeline
+export interface WasmPipelineModule extends WasmMultiAgentModule {
+  NoisePipeline: {
+    new (system: WasmMultiAgentSystemInstance): WasmNoisePipelineInstance;
+  };
+  BAND_SCALE_LOG: number;
+  BAND_SCALE_MEL: number;
+}
+
+interface WasmNoisePipelineInstance {
+  configureBands(bandCount: number, binCount: number, sampleRate: number, minHz: number, maxHz: number, scale: number): boolean;
+  setNoiseBands(begin: number, end: number): void;
+  setNoiseThresholds(high: number, low: number): void;
+  setSmoothing(timeConstant: number): void;
+  getSpectrumBuffer(length: number): Uint8Array;
+  tick(length: number, isTraining: boolean): number;
+  getBatchBuffer(bytes: number): Uint8Array;
+  runSpectra(ticks: number, bins: number, isTraining: boolean): number;
+  runStates(ticks: number, isTraining: boolean): number;
+  getStateView(): Uint8Array;
+  getRewardView(): Float32Array;
+  getBandView(): Float32Array;
+  getDetectorView(): Float32Array;
+  getLastState(): number;
+  getTickCount(): number;
+  getHighNoiseTicks(): number;
+  resetCounters(): void;
+  delete(): void;
+}
+
+export interface PipelineBandOptions {
+  bandCount?: number;
+  binCount?: number;               // analyser.frequencyBinCount
+  sampleRate?: number;
+  minHz?: number;
+  maxHz?: number;
+  scale?: 'LOG' | 'MEL';
+}
+
+export interface PipelineBatchResult {
+  states: Uint8Array;              // noise state per tick (0 / 1)
+  meanRewards: Float32Array;       // mean agent reward after each tick
+}
+
+// Global module cache
+let wasmModule: WasmPipelineModule | null = null;
+let loadPromise: Promise<WasmPipelineModule> | null = null;
+
+/**
+ * Load the WASM pipeline module
+ * It carries its own MultiAgentSystem class: systems passed to the pipeline
+ * must be created from this module, not from multi_agent.js
+ */
+export async function loadWasmPipeline(): Promise<WasmPipelineModule> {
+  if (wasmModule) {
+    return wasmModule;
+  }
+
+  if (loadPromise) {
+    return loadPromise;
+  }
+
+  loadPromise = (async () => {
+    try {
+      // The module is expected to be at /wasm/noise_pipeline.js
+      const createModule = await import('/wasm/noise_pipeline.js');
+      wasmModule = await createModule.default();
+      registerProfiledModule('pipeline', wasmModule!);
+      console.log('[WasmPipeline] Module loaded successfully');
+      return wasmModule!;
+    } catch (error) {
+      console.error('[WasmPipeline] Failed to load module:', error);
+      loadPromise = null;
+      throw error;
+    }
+  })();
+
+  return loadPromise;
+}
+
+/**
+ * Sound-to-agent loop without a JS hop: tickUint8() copies the analyser's
+ * byte spectrum into WASM once, then band analysis, noise classification and
+ * stepAll run in the same call. The batch methods replay recorded spectra or
+ * noise-state streams for offline training.
+ */
+export class WasmNoisePipeline {
+  private pipeline: WasmNoisePipelineInstance;
+  private spectrum: Uint8Array | null = null;
+
+  constructor(system: WasmMultiAgentSystemInstance, bands: PipelineBandOptions = {}) {
+    if (!wasmModule) {
+      throw new Error('WASM module not loaded. Call loadWasmPipeline() first.');
+    }
+    this.pipeline = new wasmModule.NoisePipeline(system);
+    this.configureBands(bands);
+  }
+
+  /**
+   * Lay out the analysis bands; false (previous layout kept) if they do not fit
+   */
+  configureBands(options: PipelineBandOptions = {}): boolean {
+    const {
+      bandCount = 24,
+      binCount = 1024,
+      sampleRate = 44100,
+      minHz = 40,
+      maxHz = 16000,
+      scale = 'LOG',
+    } = options;
+    const scaleValue = scale === 'MEL' ? wasmModule!.BAND_SCALE_MEL : wasmModule!.BAND_SCALE_LOG;
+    return this.pipeline.configureBands(bandCount, binCount, sampleRate, minHz, maxHz, scaleValue);
+  }
+
+  /**
+   * HIGH_NOISE above `high`, back to LOW_NOISE at or below `low`
+   * (default 0.4 for both over the bass bands, the JS bass > 0.4 rule)
+   */
+  setNoiseThresholds(high: number, low: number = high): void {
+    this.pipeline.setNoiseThresholds(high, low);
+  }
+
+  setNoiseBands(begin: number, end: number): void {
+    this.pipeline.setNoiseBands(begin, end);
+  }
+
+  /**
+   * One tick from a getByteFrequencyData spectrum; returns the noise state
+   * the agents were stepped on
+   */
+  tickUint8(data: Uint8Array, isTraining: boolean): NoiseStateName {
+    if (!this.spectrum || this.spectrum.length !== data.length || this.spectrum.byteLength === 0) {
+      this.spectrum = this.pipeline.getSpectrumBuffer(data.length);
+    }
+    this.spectrum.set(data);
+    return this.pipeline.tick(data.length, isTraining) !== 0 ? 'HIGH_NOISE' : 'LOW_NOISE';
+  }
+
+  /**
+   * `spectra` holds spectra of `bins` bytes back to back, one per tick
+   */
+  runSpectra(spectra: Uint8Array, bins: number, isTraining: boolean = true): PipelineBatchResult {
+    this.pipeline.getBatchBuffer(spectra.length).set(spectra);
+    this.pipeline.runSpectra(Math.floor(spectra.length / bins), bins, isTraining);
+    return this.readBatch();
+  }
+
+  /**
+   * One tick per entry of a precomputed noise-state stream (0 = LOW_NOISE)
+   */
+  runStates(states: Uint8Array, isTraining: boolean = true): PipelineBatchResult {
+    this.pipeline.getBatchBuffer(states.length).set(states);
+    this.pipeline.runStates(states.length, isTraining);
+    return this.readBatch();
+  }
+
+  /** Smoothed bands of the last analyzed spectrum (WASM-owned view) */
+  get bands(): Float32Array {
+    return this.pipeline.getBandView();
+  }
+
+  get lastState(): NoiseStateName {
+    return this.pipeline.getLastState() !== 0 ? 'HIGH_NOISE' : 'LOW_NOISE';
+  }
+
+  get tickCount(): number {
+    return this.pipeline.getTickCount();
+  }
+
+  get highNoiseTicks(): number {
+    return this.pipeline.getHighNoiseTicks();
+  }
+
+  resetCounters(): void {
+    this.pipeline.resetCounters();
+  }
+
+  dispose(): void {
+    this.pipeline.delete();
+  }
+
+  private readBatch(): PipelineBatchResult {
+    // Copied out: the views are reused by the next batch
+    return {
+      states: this.pipeline.getStateView().slice(),
+      meanRewards: this.pipeline.getRewardView().slice(),
+    };
+  }
+}
@@ -2,6 +2,7 @@
 // Drop-in replacement for Cannon.js based physicsEngine.ts
 
 import type { PhysicsState, SpaceshipPhysicsConfig } from './physicsEngine';
+import { registerProfiledModule, type WasmProfileExports } from './wasmProfiler';
 
 // Re-export types for consistency
 export type { PhysicsState, SpaceshipPhysicsConfig };
@@ -26,8 +27,38 @@ const THRUST_ACTIONS = {
 
 type ThrustActionName = keyof typeof THRUST_ACTIONS;
 
+// Flat state record layout (matching WASM STATE_* constants / StateLayout)
+const STATE_LAYOUT = {
+  POSITION: 0,
+  VELOCITY: 3,
+  ROTATION: 6,
+  ANGULAR_VELOCITY: 9,
+  ROTATION_W: 12,
+  ROLL: 13,
+  YAW: 14,
+  SPEED: 15,
+  STRIDE: 16,
+} as const;
+
+// Packed command record (matching WASM COMMAND_* constants / CommandLayout)
+const COMMAND_LAYOUT = {
+  OPCODE: 0,
+  BODY: 1,
+  ARGS: 2,
+  STRIDE: 6,
+} as const;
+
+const COMMAND_OPS = {
+  NOP: 0,
+  SET_TARGET: 1,
+  APPLY_THRUST: 2,
+  APPLY_BANKING: 3,
+  STEP: 4,
+  RESET: 5,
+} as const;
+
 // WASM module interface (matches embind exports)
-interface WasmPhysicsModule {
+interface WasmPhysicsModule extends WasmProfileExports {
   PhysicsEngine: {
     new (): WasmPhysicsEngineInstance;
     new (
@@ -39,10 +70,26 @@ interface WasmPhysicsModule {
       dragCoefficient: number
     ): WasmPhysicsEngineInstance;
   };
+  TrajectoryRollout: {
+    new (): WasmTrajectoryRolloutInstance;
+    new (threads: number): WasmTrajectoryRolloutInstance;
+  };
+  TrajectoryRecorder: {
+    new (recordWords: number, chunkRecords: number, delta: boolean): WasmTrajectoryRecorderInstance;
+  };
+  RecordingChunkDecoder: {
+    new (recordWords: number, chunkRecords: number, delta: boolean): WasmRecordingChunkDecoderInstance;
+  };
   THRUST_IDLE: number;
   THRUST_GLIDE: number;
   THRUST_BOOST: number;
   THRUST_STABILIZE: number;
+  STATE_STRIDE: number;
+  COMMAND_STRIDE: number;
+  ROLLOUT_STRIDE: number;
+  RECORDING_HEADER_BYTES: number;
+  RECORDING_CHUNK_HEADER_BYTES: number;
+  RECORDING_DELTA: number;
 }
 
 interface WasmVector3 {
@@ -65,6 +112,17 @@ interface WasmPhysicsEngineInstance {
   applyThrust(action: number, intensity: number): void;
   applyBanking(desiredRoll: number, rollFactor: number): void;
   getState(): WasmPhysicsState;
+  getStateView(): Float32Array;
+  setFixedTimestep(rateHz: number, maxSubSteps: number): void;
+  isFixedTimestep(): boolean;
+  getInterpolationAlpha(): number;
+  getLastSubStepCount(): number;
+  getRenderStateView(): Float32Array;
+  getInterpolatedPosition(): WasmVector3;
+  saveSnapshot(): Uint8Array;
+  restoreSnapshot(bytes: Uint8Array): boolean;
+  getCommandView(capacity: number): Uint32Array;
+  execute(count: number): number;
   getPosition(): WasmVector3;
   getVelocity(): WasmVector3;
   getAngularVelocity(): WasmVector3;
@@ -72,6 +130,8 @@ interface WasmPhysicsEngineInstance {
   getPitch(): number;
   getYaw(): number;
   getSpeed(): number;
+  setDerivedStateExport(enabled: boolean): void;
+  isDerivedStateExport(): boolean;
   setMass(mass: number): void;
   setMaxThrust(thrust: number): void;
   setMaxAngularVelocity(maxAngVel: number): void;
@@ -81,6 +141,80 @@ interface WasmPhysicsEngineInstance {
   delete(): void;
 }
 
+interface WasmTrajectoryRolloutInstance {
+  setStartFromEngine(engine: WasmPhysicsEngineInstance): void;
+  setTarget(x: number, y: number, z: number): void;
+  getActionView(candidates: number, horizon: number): Uint8Array;
+  setSeed(seedLow: number, seedHigh: number): void;   // 64-bit seed as two 32-bit halves
+  sampleActions(candidates: number, horizon: number, switchProbability: number): void;
+  run(candidates: number, horizon: number, deltaTime: number, intensity: number): void;
+  getResultView(): Float32Array;
+  bestCandidate(energyWeight: number): number;
+  delete(): void;
+}
+
+interface WasmTrajectoryRecorderInstance {
+  getRecordView(): Float32Array;
+  commit(): void;
+  appendEngine(engine: WasmPhysicsEngineInstance): void;
+  finish(): void;
+  isValid(): boolean;
+  isFinished(): boolean;
+  getPendingView(): Uint8Array;
+  getPendingOffset(): number;
+  clearPending(): void;
+  getHeaderView(): Uint8Array;
+  getRecordCount(): number;
+  getBytesWritten(): number;
+  delete(): void;
+}
+
+interface WasmRecordingChunkDecoderInstance {
+  getInputView(bytes: number): Uint8Array;
+  decode(bytes: number): number;
+  getOutputView(): Float32Array;
+  delete(): void;
+}
+
+// Recording file header (matching RecordingHeader in trajectory_recorder.hpp)
+const RECORDING_HEADER = {
+  MAGIC: 0x52545641,
+  BYTES: 64,
+  CHUNK_HEADER_BYTES: 8,
+  DELTA_FLAG: 1,
+} as const;
+
+export interface TrajectoryRecorderOptions {
+  chunkRecords?: number;           // records per chunk (seek granularity)
+  delta?: boolean;                 // XOR-delta records within a chunk (lossless)
+}
+
+// Rollout result record layout (matching WASM ROLLOUT_* constants / RolloutLayout)
+const ROLLOUT_LAYOUT = {
+  END_POSITION: 0,
+  DISTANCE: 3,
+  MIN_DISTANCE: 4,
+  ENERGY: 5,
+  STRIDE: 6,
+} as const;
+
+const THRUST_ACTION_NAMES: ThrustActionName[] = ['IDLE', 'GLIDE', 'BOOST', 'STABILIZE'];
+
+export interface ThrustPlan {
+  actions: ThrustActionName[];     // best candidate's sequence, one action per step
+  endPosition: WasmVector3;
+  distance: number;                // to target after the last step
+  minDistance: number;             // closest approach over the horizon
+  energy: number;                  // thrust impulse spent (N*s)
+}
+
+export interface ThrustPlanOptions {
+  deltaTime?: number;
+  intensity?: number;
+  energyWeight?: number;           // score = distance + energyWeight * energy
+  switchProbability?: number;      // per-step chance a random sequence changes action
+}
+
 // Global module cache
 let wasmModule: WasmPhysicsModule | null = null;
 let loadPromise: Promise<WasmPhysicsModule> | null = null;
@@ -104,6 +238,7 @@ export async function loadWasmPhysics(): Promise<WasmPhysicsModule> {
       // The module is expected to be at /wasm/physics_engine.js
       const createModule = await import('/wasm/physics_engine.js');
       wasmModule = await createModule.default();
+      registerProfiledModule('physics', wasmModule!);
       console.log('[WasmPhysics] Module loaded successfully');
       return wasmModule!;
     } catch (error) {
@@ -129,6 +264,9 @@ export function isWasmPhysicsAvailable(): boolean {
 export class WasmSpaceshipPhysicsEngine {
   private engine: WasmPhysicsEngineInstance;
   private config: SpaceshipPhysicsConfig;
+  private stateView: Float32Array;
+  private renderStateView: Float32Array;
+  private derivedExport = false;
 
   constructor(config: SpaceshipPhysicsConfig = defaultSpaceshipConfig) {
     if (!wasmModule) {
@@ -144,6 +282,8 @@ export class WasmSpaceshipPhysicsEngine {
       config.angularDamping,
       config.dragCoefficient
     );
+    this.stateView = this.engine.getStateView();
+    this.renderStateView = this.engine.getRenderStateView();
   }
 
   /**
@@ -175,23 +315,111 @@ export class WasmSpaceshipPhysicsEngine {
     this.engine.step(deltaTime);
   }
 
+  /**
+   * Buffer for queueing this frame's target/thrust/banking/step updates and
+   * running them with a single execute() crossing
+   */
+  createCommandBuffer(capacity: number = 16): WasmPhysicsCommandBuffer {
+    return new WasmPhysicsCommandBuffer(this.engine, capacity);
+  }
+
+  /**
+   * Monte Carlo lookahead planner over this ship's current state and target
+   */
+  createPlanner(candidates: number = 256, horizon: number = 60): WasmThrustPlanner {
+    return new WasmThrustPlanner(this.engine, candidates, horizon);
+  }
+
+  /**
+   * Recorder of this ship's state buffer, one record per record() call,
+   * streamed to an OPFS file
+   */
+  createRecorder(fileName: string, options: TrajectoryRecorderOptions = {}): Promise<WasmTrajectoryRecorder> {
+    return WasmTrajectoryRecorder.create(this.engine, fileName, options);
+  }
+
   /**
    * Get current physics state
    */
   getState(): PhysicsState {
-    const state = this.engine.getState();
+    const s = this.getStateBuffer();
+    const p = STATE_LAYOUT.POSITION;
+    const v = STATE_LAYOUT.VELOCITY;
+    const r = STATE_LAYOUT.ROTATION;
+    const a = STATE_LAYOUT.ANGULAR_VELOCITY;
     return {
-      position: { ...state.position },
-      velocity: { ...state.velocity },
-      rotation: { ...state.rotation },
-      angularVelocity: { ...state.angularVelocity },
+      position: { x: s[p], y: s[p + 1], z: s[p + 2] },
+      velocity: { x: s[v], y: s[v + 1], z: s[v + 2] },
+      rotation: { x: s[r], y: s[r + 1], z: s[r + 2] },
+      angularVelocity: { x: s[a], y: s[a + 1], z: s[a + 2] },
     };
   }
 
+  /**
+   * Zero-copy view over the engine's flat state record (see STATE_LAYOUT)
+   * Updated in place by step()/reset(); re-acquired if WASM memory growth detached it
+   */
+  getStateBuffer(): Float32Array {
+    if (this.stateView.length === 0) {
+      this.stateView = this.engine.getStateView();
+    }
+    return this.stateView;
+  }
+
+  /**
+   * Run physics at a fixed rate independent of the display rate
+   * step() then accumulates frame time and sub-steps at 1/rateHz (rateHz <= 0 disables)
+   */
+  setFixedTimestep(rateHz: number = 60, maxSubSteps: number = 4): void {
+    this.engine.setFixedTimestep(rateHz, maxSubSteps);
+  }
+
+  /**
+   * Fraction of a fixed step the render state is past the last sub-step (1 when not fixed)
+   */
+  getInterpolationAlpha(): number {
+    return this.engine.getInterpolationAlpha();
+  }
+
+  /**
+   * Zero-copy view over the interpolated render record (same layout as getStateBuffer())
+   */
+  getRenderStateBuffer(): Float32Array {
+    if (this.renderStateView.length === 0) {
+      this.renderStateView = this.engine.getRenderStateView();
+    }
+    return this.renderStateView;
+  }
+
+  /**
+   * Capture the full engine state (body, config, fixed-timestep accumulator) as bytes
+   */
+  saveSnapshot(): Uint8Array {
+    // The WASM view is reused by the next save; keep a copy
+    return this.engine.saveSnapshot().slice();
+  }
+
+  /**
+   * Rewind to a saveSnapshot() result; false (state untouched) if the bytes are not a valid snapshot
+   */
+  restoreSnapshot(bytes: Uint8Array): boolean {
+    return this.engine.restoreSnapshot(bytes);
+  }
+
+  /**
+   * Have every step also write roll, yaw and speed into the state buffer, so
+   * getRoll()/getYaw()/getSpeed() read it instead of crossing into WASM
+   */
+  setDerivedStateExport(enabled: boolean): void {
+    this.engine.setDerivedStateExport(enabled);
+    this.derivedExport = enabled;
+  }
+
   /**
    * Get roll angle in radians
    */
   getRoll(): number {
+    if (this.derivedExport) return this.getStateBuffer()[STATE_LAYOUT.ROLL];
     return this.engine.getRoll();
   }
 
@@ -206,6 +434,7 @@ export class WasmSpaceshipPhysicsEngine {
    * Get yaw angle in radians
    */
   getYaw(): number {
+    if (this.derivedExport) return this.getStateBuffer()[STATE_LAYOUT.YAW];
     return this.engine.getYaw();
   }
 
@@ -213,6 +442,7 @@ export class WasmSpaceshipPhysicsEngine {
    * Get speed in m/s
    */
   getSpeed(): number {
+    if (this.derivedExport) return this.getStateBuffer()[STATE_LAYOUT.SPEED];
     return this.engine.getSpeed();
   }
 
@@ -261,6 +491,404 @@ export class WasmSpaceshipPhysicsEngine {
   }
 }
 
+/**
+ * Per-frame command queue written straight into WASM memory
+ * Commands run in order on submit(); results appear in the engine's state buffer.
+ */
+export class WasmPhysicsCommandBuffer {
+  private engine: WasmPhysicsEngineInstance;
+  private capacity: number;
+  private words: Uint32Array;
+  private args: Float32Array;
+  private count = 0;
+
+  constructor(engine: WasmPhysicsEngineInstance, capacity: number) {
+    this.engine = engine;
+    this.capacity = capacity;
+    this.words = engine.getCommandView(capacity);
+    this.args = new Float32Array(this.words.buffer, this.words.byteOffset, this.words.length);
+  }
+
+  setTarget(x: number, y: number, z: number = 0): this {
+    return this.push(COMMAND_OPS.SET_TARGET, x, y, z);
+  }
+
+  applyThrust(action: ThrustActionName, intensity: number = 1.0): this {
+    return this.push(COMMAND_OPS.APPLY_THRUST, THRUST_ACTIONS[action], intensity);
+  }
+
+  applyBanking(desiredRoll: number, rollFactor: number = 0.1): this {
+    return this.push(COMMAND_OPS.APPLY_BANKING, desiredRoll, rollFactor);
+  }
+
+  step(deltaTime: number = 0.016): this {
+    return this.push(COMMAND_OPS.STEP, deltaTime);
+  }
+
+  reset(x: number = 0, y: number = 0, z: number = 0): this {
+    return this.push(COMMAND_OPS.RESET, x, y, z);
+  }
+
+  /**
+   * Run the queued commands and clear the queue; returns how many executed
+   */
+  submit(): number {
+    const executed = this.count > 0 ? this.engine.execute(this.count) : 0;
+    this.count = 0;
+    return executed;
+  }
+
+  private push(opcode: number, a: number = 0, b: number = 0, c: number = 0): this {
+    // A full queue flushes early so no command is dropped
+    if (this.count === this.capacity) this.submit();
+    if (this.words.byteLength === 0) {
+      this.words = this.engine.getCommandView(this.capacity);
+      this.args = new Float32Array(this.words.buffer, this.words.byteOffset, this.words.length);
+    }
+    const base = this.count * COMMAND_LAYOUT.STRIDE;
+    const argBase = base + COMMAND_LAYOUT.ARGS;
+    this.words[base + COMMAND_LAYOUT.OPCODE] = opcode;
+    this.words[base + COMMAND_LAYOUT.BODY] = 0;
+    this.args[argBase] = a;
+    this.args[argBase + 1] = b;
+    this.args[argBase + 2] = c;
+    this.args[argBase + 3] = 0;
+    this.count++;
+    return this;
+  }
+}
+
+/**
+ * Model-predictive thrust planning: simulates random candidate thrust
+ * sequences from the ship's current state in one WASM call and returns the
+ * best (the first action is the one to fly now; replan every frame or two)
+ */
+export class WasmThrustPlanner {
+  private engine: WasmPhysicsEngineInstance;
+  private rollout: WasmTrajectoryRolloutInstance;
+  readonly candidates: number;
+  readonly horizon: number;
+
+  constructor(engine: WasmPhysicsEngineInstance, candidates: number, horizon: number) {
+    if (!wasmModule) {
+      throw new Error('WASM module not loaded. Call loadWasmPhysics() first.');
+    }
+    this.engine = engine;
+    this.rollout = new wasmModule.TrajectoryRollout();
+    this.candidates = candidates;
+    this.horizon = horizon;
+  }
+
+  /**
+   * Reseed action sampling with a 64-bit seed given as two 32-bit halves
+   */
+  setSeed(seedLow: number, seedHigh: number = 0): void {
+    this.rollout.setSeed(seedLow >>> 0, seedHigh >>> 0);
+  }
+
+  plan(options: ThrustPlanOptions = {}): ThrustPlan {
+    const { deltaTime = 0.016, intensity = 1.0, energyWeight = 0, switchProbability = 0.2 } = options;
+    this.rollout.setStartFromEngine(this.engine);
+    this.rollout.sampleActions(this.candidates, this.horizon, switchProbability);
+    this.rollout.run(this.candidates, this.horizon, deltaTime, intensity);
+
+    const best = this.rollout.bestCandidate(energyWeight);
+    // Both views are fetched after run(): sampling may have grown memory
+    const actions = this.rollout.getActionView(this.candidates, this.horizon);
+    const results = this.rollout.getResultView();
+    const record = best * ROLLOUT_LAYOUT.STRIDE;
+    const p = record + ROLLOUT_LAYOUT.END_POSITION;
+    const sequence = actions.subarray(best * this.horizon, (best + 1) * this.horizon);
+    return {
+      actions: Array.from(sequence, (a) => THRUST_ACTION_NAMES[a]),
+      endPosition: { x: results[p], y: results[p + 1], z: results[p + 2] },
+      distance: results[record + ROLLOUT_LAYOUT.DISTANCE],
+      minDistance: results[record + ROLLOUT_LAYOUT.MIN_DISTANCE],
+      energy: results[record + ROLLOUT_LAYOUT.ENERGY],
+    };
+  }
+
+  dispose(): void {
+    this.rollout.delete();
+  }
+}
+
+// OPFS sync access handle (dedicated workers only; not in the DOM lib typings)
+interface OpfsSyncAccessHandle {
+  write(buffer: BufferSource, options?: { at?: number }): number;
+  truncate(size: number): void;
+  flush(): void;
+  close(): void;
+}
+
+// Destination of the sealed recording bytes
+interface RecordingSink {
+  readonly durable: boolean;
+  write(data: Uint8Array, position: number): void;
+  sync(header: Uint8Array): void;            // after every drained chunk
+  close(header: Uint8Array): Promise<void>;
+}
+
+// In-place writes through a sync access handle, flushed with the current
+// header after every chunk: a recording cut short (tab closed or crashed)
+// still opens up to its last sealed chunk
+class SyncRecordingSink implements RecordingSink {
+  readonly durable = true;
+
+  constructor(private access: OpfsSyncAccessHandle) {}
+
+  write(data: Uint8Array, position: number): void {
+    this.access.write(data, { at: position });
+  }
+
+  sync(header: Uint8Array): void {
+    this.access.write(header, { at: 0 });
+    this.access.flush();
+  }
+
+  async close(header: Uint8Array): Promise<void> {
+    this.sync(header);
+    this.access.close();
+  }
+}
+
+// Main-thread fallback: a writable stream goes to a swap file that is only
+// committed on close(), so nothing persists until finish() has completed
+class StreamRecordingSink implements RecordingSink {
+  readonly durable = false;
+  // Writes are chained so they land in order without blocking the frame
+  private writes: Promise<void> = Promise.resolve();
+
+  constructor(private writable: FileSystemWritableFileStream) {}
+
+  write(data: Uint8Array, position: number): void {
+    // Copy out of WASM memory before the next append reuses it
+    const bytes = data.slice();
+    this.writes = this.writes.then(() => this.writable.write({ type: 'write', position, data: bytes }));
+  }
+
+  sync(): void {}
+
+  close(header: Uint8Array): Promise<void> {
+    const bytes = header.slice();
+    this.writes = this.writes
+      .then(() => this.writable.write({ type: 'write', position: 0, data: bytes }))
+      .then(() => this.writable.close());
+    return this.writes;
+  }
+}
+
+async function openRecordingSink(handle: FileSystemFileHandle): Promise<RecordingSink> {
+  const syncHandle = handle as FileSystemFileHandle & {
+    createSyncAccessHandle?: () => Promise<OpfsSyncAccessHandle>;
+  };
+  if (typeof syncHandle.createSyncAccessHandle === 'function') {
+    try {
+      const access = await syncHandle.createSyncAccessHandle();
+      access.truncate(0);
+      return new SyncRecordingSink(access);
+    } catch {
+      // Not a dedicated worker (or the file is locked): use a stream
+    }
+  }
+  return new StreamRecordingSink(await handle.createWritable({ keepExistingData: false }));
+}
+
+/**
+ * Records per-step state into a chunked binary file in the origin private
+ * file system. C++ encodes whole chunks; each sealed chunk is written at its
+ * file offset as it appears, so only one chunk is ever held in memory.
+ *
+ * Crash-safe (durable === true) only in a dedicated worker, where chunks go
+ * through a sync access handle and are flushed as they are sealed. On the
+ * main thread the file is committed by finish().
+ */
+export class WasmTrajectoryRecorder {
+  private engine: WasmPhysicsEngineInstance;
+  private recorder: WasmTrajectoryRecorderInstance;
+  private sink: RecordingSink;
+  private closed: Promise<void> | null = null;
+
+  private constructor(
+    engine: WasmPhysicsEngineInstance,
+    recorder: WasmTrajectoryRecorderInstance,
+    sink: RecordingSink
+  ) {
+    this.engine = engine;
+    this.recorder = recorder;
+    this.sink = sink;
+  }
+
+  static async create(
+    engine: WasmPhysicsEngineInstance,
+    fileName: string,
+    options: TrajectoryRecorderOptions = {}
+  ): Promise<WasmTrajectoryRecorder> {
+    if (!wasmModule) {
+      throw new Error('WASM module not loaded. Call loadWasmPhysics() first.');
+    }
+    const { chunkRecords = 256, delta = true } = options;
+    const recorder = new wasmModule.TrajectoryRecorder(STATE_LAYOUT.STRIDE, chunkRecords, delta);
+    if (!recorder.isValid()) {
+      recorder.delete();
+      throw new Error('Chunk payload exceeds 32 bits: use fewer chunkRecords');
+    }
+    const root = await navigator.storage.getDirectory();
+    const handle = await root.getFileHandle(fileName, { create: true });
+    const sink = await openRecordingSink(handle);
+    return new WasmTrajectoryRecorder(engine, recorder, sink);
+  }
+
+  /**
+   * Append the engine's current state record
+   */
+  record(): void {
+    if (this.closed) return;
+    this.recorder.appendEngine(this.engine);
+    this.drain();
+  }
+
+  get recordCount(): number {
+    return this.recorder.getRecordCount();
+  }
+
+  get bytesWritten(): number {
+    return this.recorder.getBytesWritten();
+  }
+
+  /** Whether sealed chunks survive an interrupted session */
+  get durable(): boolean {
+    return this.sink.durable;
+  }
+
+  /**
+   * Seal the last chunk, write the chunk index and final header, and close
+   * the file
+   */
+  finish(): Promise<void> {
+    if (this.closed) return this.closed;
+    this.recorder.finish();
+    this.drain();
+    const header = this.recorder.getHeaderView().slice();
+    this.recorder.delete();
+    this.closed = this.sink.close(header);
+    return this.closed;
+  }
+
+  private drain(): void {
+    const pending = this.recorder.getPendingView();
+    if (pending.length === 0) return;
+    this.sink.write(pending, this.recorder.getPendingOffset());
+    this.recorder.clearPending();
+    this.sink.sync(this.recorder.getHeaderView());
+  }
+}
+
+/**
+ * Random-access replay of a recording (finished or not): step K is found
+ * through the chunk index and its chunk is decoded once in WASM, so scrubbing
+ * within a chunk costs no further decoding.
+ */
+export class WasmTrajectoryReader {
+  private file: Blob;
+  private decoder: WasmRecordingChunkDecoderInstance;
+  private chunkOffsets: number[];
+  private cachedChunk = -1;
+  private cachedRecords: Float32Array = new Float32Array(0);
+  readonly recordWords: number;
+  readonly chunkRecords: number;
+  readonly recordCount: number;
+  readonly finished: boolean;
+
+  private constructor(file: Blob, header: DataView, chunkOffsets: number[], recordCount: number) {
+    if (!wasmModule) {
+      throw new Error('WASM module not loaded. Call loadWasmPhysics() first.');
+    }
+    this.file = file;
+    this.recordWords = header.getUint32(8, true);
+    this.chunkRecords = header.getUint32(12, true);
+    this.recordCount = recordCount;
+    this.finished = Number(header.getBigUint64(32, true)) !== 0;
+    this.chunkOffsets = chunkOffsets;
+    const delta = (header.getUint16(6, true) & RECORDING_HEADER.DELTA_FLAG) !== 0;
+    this.decoder = new wasmModule.RecordingChunkDecoder(this.recordWords, this.chunkRecords, delta);
+  }
+
+  static async open(fileName: string): Promise<WasmTrajectoryReader> {
+    const root = await navigator.storage.getDirectory();
+    const file = await (await root.getFileHandle(fileName)).getFile();
+    return WasmTrajectoryReader.fromBlob(file);
+  }
+
+  static async fromBlob(file: Blob): Promise<WasmTrajectoryReader> {
+    const header = new DataView(await file.slice(0, RECORDING_HEADER.BYTES).arrayBuffer());
+    if (header.byteLength < RECORDING_HEADER.BYTES || header.getUint32(0, true) !== RECORDING_HEADER.MAGIC) {
+      throw new Error('Not a trajectory recording');
+    }
+    const chunkCount = Number(header.getBigUint64(24, true));
+    const indexOffset = Number(header.getBigUint64(32, true));
+    const offsets: number[] = [];
+    let recordCount = 0;
+
+    if (indexOffset !== 0) {
+      const index = new DataView(await file.slice(indexOffset, indexOffset + chunkCount * 8).arrayBuffer());
+      for (let c = 0; c < chunkCount; c++) offsets.push(Number(index.getBigUint64(c * 8, true)));
+      recordCount = Number(header.getBigUint64(16, true));
+    } else {
+      // Unfinished: walk the chunk headers until the data runs out
+      let offset = RECORDING_HEADER.BYTES;
+      while (offset + RECORDING_HEADER.CHUNK_HEADER_BYTES <= file.size) {
+        const chunk = new DataView(
+          await file.slice(offset, offset + RECORDING_HEADER.CHUNK_HEADER_BYTES).arrayBuffer()
+        );
+        const records = chunk.getUint32(0, true);
+        const payloadBytes = chunk.getUint32(4, true);
+        const next = offset + RECORDING_HEADER.CHUNK_HEADER_BYTES + payloadBytes;
+        if (records === 0 || next > file.size) break;
+        offsets.push(offset);
+        recordCount += records;
+        offset = next;
+      }
+    }
+    return new WasmTrajectoryReader(file, header, offsets, recordCount);
+  }
+
+  /**
+   * State record of one step (a copy, recordWords floats), or null past the end
+   */
+  async read(step: number): Promise<Float32Array | null> {
+    if (step < 0 || step >= this.recordCount) return null;
+    const chunk = Math.floor(step / this.chunkRecords);
+    if (chunk !== this.cachedChunk && !(await this.loadChunk(chunk))) return null;
+    const base = (step - chunk * this.chunkRecords) * this.recordWords;
+    return this.cachedRecords.slice(base, base + this.recordWords);
+  }
+
+  dispose(): void {
+    this.decoder.delete();
+  }
+
+  private async loadChunk(chunk: number): Promise<boolean> {
+    const begin = this.chunkOffsets[chunk];
+    const end = chunk + 1 < this.chunkOffsets.length ? this.chunkOffsets[chunk + 1] : await this.chunkEnd(begin);
+    const bytes = new Uint8Array(await this.file.slice(begin, end).arrayBuffer());
+    this.decoder.getInputView(bytes.length).set(bytes);
+    const records = this.decoder.decode(bytes.length);
+    if (records === 0) return false;
+    // Copied out so later memory growth cannot detach it
+    this.cachedRecords = this.decoder.getOutputView().slice();
+    this.cachedChunk = chunk;
+    return true;
+  }
+
+  private async chunkEnd(begin: number): Promise<number> {
+    const chunk = new DataView(
+      await this.file.slice(begin, begin + RECORDING_HEADER.CHUNK_HEADER_BYTES).arrayBuffer()
+    );
+    return begin + RECORDING_HEADER.CHUNK_HEADER_BYTES + chunk.getUint32(4, true);
+  }
+}
+
 /**
  * Create a physics engine, preferring WASM if available
  * Falls back to callback for JS implementation if WASM unavailable
@@ -0,0 +1,132 @@
+// Zero-copy reader for the native profile buffers (native/common/profiler.hpp)
+// Each WASM module owns one Float64Array of stage records and counters; the
+// stages are only timed when the module was built with -DAERONAV_PROFILING=ON.
+
+// Embind exports shared by every profiled module (bindProfiler())
+export interface WasmProfileExports {
+  getProfileView(): Float64Array;
+  resetProfile(): void;
+  getProfileStageName(stage: number): string;
+  getProfileCounterName(counter: number): string;
+  PROFILE_STAGE_COUNT: number;
+  PROFILE_COUNTER_COUNT: number;
+  PROFILE_STAGE_CALLS: number;
+  PROFILE_STAGE_TOTAL_NS: number;
+  PROFILE_STAGE_SELF_NS: number;
+  PROFILE_STAGE_MAX_NS: number;
+  PROFILE_STAGE_STRIDE: number;
+  PROFILE_STAGES: number;
+  PROFILE_COUNTERS: number;
+  PROFILE_ENABLED: number;
+}
+
+export interface ProfileStageSample {
+  name: string;        // e.g. "physics.integrate"
+  calls: number;
+  totalMs: number;     // inclusive of nested stages
+  selfMs: number;      // exclusive: self times add up to the time spent in the module
+  maxMs: number;
+}
+
+export interface ProfileSample {
+  module: string;
+  enabled: boolean;
+  stages: ProfileStageSample[];
+  counters: Record<string, number>;  // steps, items, events, heapAllocations, boundaryCalls
+}
+
+/**
+ * Reads one module's profile buffer without a boundary call per value
+ * The view is fetched once and re-fetched only when memory growth detaches it.
+ */
+export class WasmProfileReader {
+  readonly module: string;
+  private exports: WasmProfileExports;
+  private view: Float64Array;
+  private stageNames: string[];
+  private counterNames: string[];
+
+  constructor(module: string, exports: WasmProfileExports) {
+    this.module = module;
+    this.exports = exports;
+    this.view = exports.getProfileView();
+    this.stageNames = Array.from({ length: exports.PROFILE_STAGE_COUNT }, (_, i) => exports.getProfileStageName(i));
+    this.counterNames = Array.from({ length: exports.PROFILE_COUNTER_COUNT }, (_, i) =>
+      exports.getProfileCounterName(i)
+    );
+  }
+
+  get enabled(): boolean {
+    return this.buffer()[this.exports.PROFILE_ENABLED] === 1;
+  }
+
+  read(): ProfileSample {
+    const view = this.buffer();
+    const e = this.exports;
+    const stages = this.stageNames.map((name, i) => {
+      const base = e.PROFILE_STAGES + i * e.PROFILE_STAGE_STRIDE;
+      return {
+        name,
+        calls: view[base + e.PROFILE_STAGE_CALLS],
+        totalMs: view[base + e.PROFILE_STAGE_TOTAL_NS] * 1e-6,
+        selfMs: view[base + e.PROFILE_STAGE_SELF_NS] * 1e-6,
+        maxMs: view[base + e.PROFILE_STAGE_MAX_NS] * 1e-6,
+      };
+    });
+    const counters: Record<string, number> = {};
+    this.counterNames.forEach((name, i) => {
+      counters[name] = view[e.PROFILE_COUNTERS + i];
+    });
+    return { module: this.module, enabled: view[e.PROFILE_ENABLED] === 1, stages, counters };
+  }
+
+  reset(): void {
+    this.exports.resetProfile();
+  }
+
+  private buffer(): Float64Array {
+    if (this.view.byteLength === 0) this.view = this.exports.getProfileView();
+    return this.view;
+  }
+}
+
+/**
+ * Difference between two samples of the same module (per-interval rates for a
+ * live chart); maxMs keeps the later sample's all-time maximum
+ */
+export function diffProfileSamples(later: ProfileSample, earlier: ProfileSample): ProfileSample {
+  return {
+    module: later.module,
+    enabled: later.enabled,
+    stages: later.stages.map((stage, i) => ({
+      name: stage.name,
+      calls: stage.calls - earlier.stages[i].calls,
+      totalMs: stage.totalMs - earlier.stages[i].totalMs,
+      selfMs: stage.selfMs - earlier.stages[i].selfMs,
+      maxMs: stage.maxMs,
+    })),
+    counters: Object.fromEntries(
+      Object.entries(later.counters).map(([name, value]) => [name, value - (earlier.counters[name] ?? 0)])
+    ),
+  };
+}
+
+// Readers for the modules loaded so far (the WASM loaders register themselves)
+const readers = new Map<string, WasmProfileReader>();
+
+export function registerProfiledModule(module: string, exports: WasmProfileExports): void {
+  if (typeof exports.getProfileView !== 'function') return;   // module built before profiling existed
+  readers.set(module, new WasmProfileReader(module, exports));
+}
+
+export function getProfileReaders(): WasmProfileReader[] {
+  return Array.from(readers.values());
+}
+
+export function readWasmProfiles(): ProfileSample[] {
+  return getProfileReaders().map((reader) => reader.read());
+}
+
+export function resetWasmProfiles(): void {
+  readers.forEach((reader) => reader.reset());
+}
@@ -0,0 +1,97 @@
+// Web Worker hosting the WASM streaming analyzer
+// Owns the shared-memory audio module: the AudioWorklet writes PCM into the
+// input ring, this worker wakes on the ring's write index (Atomics.wait) and
+// runs the native analysis on every complete hop, and the UI drains the
+// result ring straight from the shared heap. No analysis runs on the main thread.
+
+interface RingLayout {
+  dataPtr: number;
+  capacity: number;
+  writeIndexPtr: number;
+  readIndexPtr: number;
+}
+
+interface StartMessage {
+  type: 'START';
+  fftSize: number;
+  hopSize: number;
+  inputCapacity: number;
+  resultRecords: number;
+}
+
+interface SetRangesMessage {
+  type: 'SET_RANGES';
+  bassEndPercent?: number;
+  midEndPercent?: number;
+}
+
+type StreamWorkerMessage = StartMessage | SetRangesMessage;
+
+// Longest sleep between wake-ups, so control messages are still handled when no audio arrives
+const WAIT_TIMEOUT_MS = 50;
+
+let wasmModule: any = null;
+let stream: any = null;
+let heapI32: Int32Array | null = null;
+let inputWriteSlot = 0;
+let running = false;
+let droppedResults = 0;
+
+async function start(message: StartMessage): Promise<void> {
+  // @ts-ignore - Dynamic import in worker
+  const createModule = await import('/wasm/audio_fft.js');
+  wasmModule = await createModule.default();
+  if (!wasmModule.HEAPF32 || !(wasmModule.HEAPF32.buffer instanceof SharedArrayBuffer)) {
+    throw new Error('Streaming analysis requires the shared-memory audio build.');
+  }
+
+  stream = new wasmModule.StreamingAnalyzer(
+    message.fftSize, message.hopSize, message.inputCapacity, message.resultRecords,
+    wasmModule.STREAM_INPUT_PCM
+  );
+  const inputLayout: RingLayout = stream.getInputLayout();
+  heapI32 = new Int32Array(wasmModule.HEAPF32.buffer);
+  inputWriteSlot = inputLayout.writeIndexPtr >> 2;
+  running = true;
+
+  self.postMessage({
+    type: 'READY',
+    heap: wasmModule.HEAPF32.buffer,
+    inputLayout,
+    resultLayout: stream.getResultLayout(),
+    stride: wasmModule.STREAM_RESULT_STRIDE,
+  });
+  pump();
+}
+
+// One wake-up: sleep until the worklet advances the write index (or the
+// timeout), analyze every complete hop, then yield to the message loop
+function pump(): void {
+  if (!running || !stream || !heapI32) return;
+  const write = Atomics.load(heapI32, inputWriteSlot);
+  Atomics.wait(heapI32, inputWriteSlot, write, WAIT_TIMEOUT_MS);
+  stream.process(0);
+
+  const dropped = stream.getDroppedResults();
+  if (dropped !== droppedResults) {
+    droppedResults = dropped;
+    self.postMessage({ type: 'STATS', droppedResults });
+  }
+  setTimeout(pump, 0);
+}
+
+self.onmessage = (event: MessageEvent<StreamWorkerMessage>) => {
+  const message = event.data;
+  switch (message.type) {
+    case 'START':
+      start(message).catch((error) => {
+        self.postMessage({ type: 'ERROR', message: String(error) });
+      });
+      break;
+    case 'SET_RANGES':
+      if (!stream) break;
+      if (message.bassEndPercent !== undefined) stream.setBassRange(message.bassEndPercent);
+      if (message.midEndPercent !== undefined) stream.setMidRange(message.midEndPercent);
+      break;
+  }
+};
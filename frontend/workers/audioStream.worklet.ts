@@ -0,0 +1,75 @@
+// AudioWorklet producer for the WASM streaming analyzer
+// Writes mono PCM from each render quantum into the SPSC input ring that
+// lives in the (shared) WASM heap. Never blocks: samples are dropped when
+// the ring is full and reported back through the port.
+
+interface RingLayout {
+  dataPtr: number;
+  capacity: number;
+  writeIndexPtr: number;
+  readIndexPtr: number;
+}
+
+interface AttachRingMessage {
+  type: 'ATTACH_RING';
+  heap: SharedArrayBuffer;
+  layout: RingLayout;
+}
+
+declare class AudioWorkletProcessor {
+  readonly port: MessagePort;
+}
+declare function registerProcessor(name: string, ctor: unknown): void;
+
+class AeronavStreamProcessor extends AudioWorkletProcessor {
+  private heapF32: Float32Array | null = null;
+  private heapU32: Uint32Array | null = null;
+  private heapI32: Int32Array | null = null;
+  private layout: RingLayout | null = null;
+  private droppedSamples = 0;
+
+  constructor() {
+    super();
+    this.port.onmessage = (event: MessageEvent<AttachRingMessage>) => {
+      if (event.data.type === 'ATTACH_RING') {
+        this.heapF32 = new Float32Array(event.data.heap);
+        this.heapU32 = new Uint32Array(event.data.heap);
+        this.heapI32 = new Int32Array(event.data.heap);
+        this.layout = event.data.layout;
+      }
+    };
+  }
+
+  process(inputs: Float32Array[][]): boolean {
+    const channel = inputs[0]?.[0];
+    if (!channel || !this.heapF32 || !this.heapU32 || !this.heapI32 || !this.layout) {
+      return true;
+    }
+
+    const { dataPtr, capacity, writeIndexPtr, readIndexPtr } = this.layout;
+    const writeSlot = writeIndexPtr >> 2;
+    const write = Atomics.load(this.heapU32, writeSlot);
+    const read = Atomics.load(this.heapU32, readIndexPtr >> 2);
+    const free = capacity - ((write - read) >>> 0);
+    const count = Math.min(channel.length, free);
+
+    // Copy in at most two contiguous pieces (capacity is a power of two)
+    const base = dataPtr >> 2;
+    const start = write & (capacity - 1);
+    const first = Math.min(count, capacity - start);
+    this.heapF32.set(channel.subarray(0, first), base + start);
+    this.heapF32.set(channel.subarray(first, count), base);
+
+    Atomics.store(this.heapU32, writeSlot, (write + count) >>> 0);
+    // Wake the analysis worker (audioStream.worker.ts) waiting on the write index
+    Atomics.notify(this.heapI32, writeSlot);
+
+    if (count < channel.length) {
+      this.droppedSamples += channel.length - count;
+      this.port.postMessage({ type: 'DROPPED', samples: this.droppedSamples });
+    }
+    return true;
+  }
+}
+
+registerProcessor('aeronav-stream', AeronavStreamProcessor);
@@ -2,6 +2,12 @@
 #include <emscripten/val.h>
 #include "../src/audio_fft.hpp"
 #include "../src/audio_augmentation.hpp"
+#include "../src/spectrum_fft.hpp"
+#include "../src/audio_stream.hpp"
+#include "../src/band_bank.hpp"
+#include "arena.hpp"
+#include "profile_bindings.hpp"
+#include <algorithm>
 
 using namespace emscripten;
 using namespace aeronav;
@@ -19,45 +25,79 @@ struct AudioResultJS {
 };
 
 // Wrapper class for AudioFFTAnalyzer with JS-friendly interface
+// Owns persistent input buffers that JS fills with a single TypedArray.set(),
+// so analysis runs in place with no per-element crossings or per-call allocation.
 class AudioAnalyzerWrapper {
 public:
     AudioAnalyzerWrapper() : analyzer_() {}
 
-    // Analyze Uint8Array from Web Audio API
+    // Both inputs in one arena sized for maxBins (longer spectra fall back to the heap)
+    explicit AudioAnalyzerWrapper(unsigned int maxBins) : analyzer_() {
+        auto arena = std::make_shared<Arena>(Arena::bytesFor<uint8_t>(maxBins) + Arena::bytesFor<float>(maxBins));
+        reserveInArena(byteInput_, arena, maxBins);
+        reserveInArena(floatInput_, arena, maxBins);
+        byteInput_.resize(maxBins);
+        floatInput_.resize(maxBins);
+    }
+
+    // Uint8Array view over the persistent byte input (valid until it has to grow
+    // or WASM memory grows; re-fetch when the bin count changes)
+    val getInputBuffer(unsigned int length) {
+        if (byteInput_.size() < length) byteInput_.resize(length);
+        return val(typed_memory_view(length, byteInput_.data()));
+    }
+
+    // Float32Array view over the persistent float input
+    val getFloatInputBuffer(unsigned int length) {
+        if (floatInput_.size() < length) floatInput_.resize(length);
+        return val(typed_memory_view(length, floatInput_.data()));
+    }
+
+    // Analyze the first `length` bytes of the persistent byte input
+    AudioResultJS analyzeInput(unsigned int length) {
+        AERONAV_PROFILE_BOUNDARY();
+        length = std::min<unsigned int>(length, byteInput_.size());
+        return AudioResultJS::fromResult(analyzer_.analyzeFrequencies(byteInput_.data(), length));
+    }
+
+    // Analyze the first `length` floats of the persistent float input
+    AudioResultJS analyzeFloatInput(unsigned int length, bool normalized) {
+        AERONAV_PROFILE_BOUNDARY();
+        length = std::min<unsigned int>(length, floatInput_.size());
+        return AudioResultJS::fromResult(
+            analyzer_.analyzeFrequenciesFloat(floatInput_.data(), length, normalized));
+    }
+
+    // Analyze bytes already in the WASM heap (e.g. allocated with Module._malloc)
+    AudioResultJS analyzePointer(uintptr_t ptr, unsigned int length) {
+        AERONAV_PROFILE_BOUNDARY();
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(ptr);
+        return AudioResultJS::fromResult(analyzer_.analyzeFrequencies(data, length));
+    }
+
+    // Analyze Uint8Array from Web Audio API (one bulk copy into the persistent input)
     AudioResultJS analyzeUint8(const val& data) {
-        // Get the typed array length and data
+        AERONAV_PROFILE_BOUNDARY();
         unsigned int length = data["length"].as<unsigned int>();
         if (length == 0) {
             return { 0.0f, 0.0f, 0.0f, 0.0f };
         }
 
-        // Copy data from JS Uint8Array to C++ buffer
-        // This is necessary because we can't directly access JS typed array memory
-        std::vector<uint8_t> buffer(length);
-
-        // Use the [] operator to access elements
-        for (unsigned int i = 0; i < length; i++) {
-            buffer[i] = data[i].as<uint8_t>();
-        }
-
-        AudioAnalysisResult result = analyzer_.analyzeFrequencies(buffer.data(), length);
-        return AudioResultJS::fromResult(result);
+        getInputBuffer(length).call<void>("set", data);
+        return AudioResultJS::fromResult(analyzer_.analyzeFrequencies(byteInput_.data(), length));
     }
 
-    // Analyze Float32Array
+    // Analyze Float32Array (one bulk copy into the persistent input)
     AudioResultJS analyzeFloat32(const val& data, bool normalized) {
+        AERONAV_PROFILE_BOUNDARY();
         unsigned int length = data["length"].as<unsigned int>();
         if (length == 0) {
             return { 0.0f, 0.0f, 0.0f, 0.0f };
         }
 
-        std::vector<float> buffer(length);
-        for (unsigned int i = 0; i < length; i++) {
-            buffer[i] = data[i].as<float>();
-        }
-
-        AudioAnalysisResult result = analyzer_.analyzeFrequenciesFloat(buffer.data(), length, normalized);
-        return AudioResultJS::fromResult(result);
+        getFloatInputBuffer(length).call<void>("set", data);
+        return AudioResultJS::fromResult(
+            analyzer_.analyzeFrequenciesFloat(floatInput_.data(), length, normalized));
     }
 
     void setBassRange(float endPercent) {
@@ -70,23 +110,276 @@ public:
 
 private:
     AudioFFTAnalyzer analyzer_;
+    ArenaVector<uint8_t> byteInput_;
+    ArenaVector<float> floatInput_;
 };
 
-// Standalone function for simple one-shot analysis (no instance needed)
-AudioResultJS analyzeFrequenciesQuick(const val& data) {
-    unsigned int length = data["length"].as<unsigned int>();
-    if (length == 0) {
-        return { 0.0f, 0.0f, 0.0f, 0.0f };
+// Wrapper for raw PCM analysis (native FFT stage + band analysis)
+// JS writes one frame into the persistent PCM view, then calls analyze()
+class PcmAnalyzerWrapper {
+public:
+    PcmAnalyzerWrapper() : fft_(2048, WindowType::BLACKMAN), analyzer_() {
+        resizeInput();
+    }
+
+    PcmAnalyzerWrapper(unsigned int fftSize, int window)
+        : fft_(fftSize, toWindowType(window)), analyzer_() {
+        resizeInput();
     }
 
-    std::vector<uint8_t> buffer(length);
-    for (unsigned int i = 0; i < length; i++) {
-        buffer[i] = data[i].as<uint8_t>();
+    bool setFftSize(unsigned int fftSize) {
+        bool ok = fft_.setFftSize(fftSize);
+        resizeInput();
+        return ok;
     }
+    unsigned int getFftSize() const { return static_cast<unsigned int>(fft_.getFftSize()); }
+    unsigned int getBinCount() const { return static_cast<unsigned int>(fft_.getBinCount()); }
+
+    void setWindow(int window) { fft_.setWindow(toWindowType(window)); }
+    void setSmoothing(float timeConstant) { fft_.setSmoothing(timeConstant); }
+    void setDecibelRange(float minDecibels, float maxDecibels) { fft_.setDecibelRange(minDecibels, maxDecibels); }
+    void setBassRange(float endPercent) { analyzer_.setBassRange(endPercent); }
+    void setMidRange(float endPercent) { analyzer_.setMidRange(endPercent); }
 
-    AudioFFTAnalyzer analyzer;
-    AudioAnalysisResult result = analyzer.analyzeFrequencies(buffer.data(), length);
-    return AudioResultJS::fromResult(result);
+    // Float32Array view over the persistent PCM frame (getFftSize() samples)
+    val getPcmBuffer() {
+        return val(typed_memory_view(pcm_.size(), pcm_.data()));
+    }
+
+    // Uint8Array view over the latest byte spectrum (getBinCount() bins)
+    val getSpectrumView() const {
+        return val(typed_memory_view(fft_.getBinCount(), fft_.getByteSpectrum()));
+    }
+
+    // Transform the PCM frame in place and analyze the resulting spectrum
+    AudioResultJS analyze() {
+        AERONAV_PROFILE_BOUNDARY();
+        return AudioResultJS::fromResult(fft_.analyze(pcm_.data(), analyzer_));
+    }
+
+    // Analyze a PCM frame already in the WASM heap
+    AudioResultJS analyzePointer(uintptr_t ptr) {
+        AERONAV_PROFILE_BOUNDARY();
+        const float* pcm = reinterpret_cast<const float*>(ptr);
+        return AudioResultJS::fromResult(fft_.analyze(pcm, analyzer_));
+    }
+
+    const SpectrumFFT& getFft() const { return fft_; }
+
+private:
+    SpectrumFFT fft_;
+    AudioFFTAnalyzer analyzer_;
+    ArenaVector<float> pcm_;
+
+    void resizeInput() {
+        if (pcm_.size() != fft_.getFftSize()) pcm_.assign(fft_.getFftSize(), 0.0f);
+    }
+
+    static WindowType toWindowType(int window) {
+        if (window < 0 || window > 2) return WindowType::BLACKMAN;
+        return static_cast<WindowType>(window);
+    }
+};
+
+// Wrapper for the N-band bank
+// Bands, peaks and the detector record are zero-copy views that process()
+// refreshes in place (re-acquire after configure() or memory growth)
+class BandBankWrapper {
+public:
+    BandBankWrapper() : bank_() {}
+
+    BandBankWrapper(unsigned int bandCount, unsigned int binCount, float sampleRate,
+                    float minHz, float maxHz, int scale)
+        : bank_() {
+        configure(bandCount, binCount, sampleRate, minHz, maxHz, scale);
+    }
+
+    bool configure(unsigned int bandCount, unsigned int binCount, float sampleRate,
+                   float minHz, float maxHz, int scale) {
+        return bank_.configure(bandCount, binCount, sampleRate, minHz, maxHz,
+                               scale == static_cast<int>(BandScale::MEL) ? BandScale::MEL : BandScale::LOG);
+    }
+    unsigned int getBandCount() const { return static_cast<unsigned int>(bank_.getBandCount()); }
+
+    void setSmoothing(float timeConstant) { bank_.setSmoothing(timeConstant); }
+    void setPeakDecay(float decay) { bank_.setPeakDecay(decay); }
+    void setOnsetThreshold(float ratio, float minFlux) { bank_.setOnsetThreshold(ratio, minFlux); }
+    void setNoiseBands(unsigned int begin, unsigned int end) { bank_.setNoiseBands(begin, end); }
+    void setNoiseThresholds(float high, float low) { bank_.setNoiseThresholds(high, low); }
+    void reset() { bank_.reset(); }
+
+    // Persistent inputs, filled with one TypedArray.set()
+    val getInputBuffer(unsigned int length) {
+        if (byteInput_.size() < length) byteInput_.resize(length);
+        return val(typed_memory_view(length, byteInput_.data()));
+    }
+
+    val getFloatInputBuffer(unsigned int length) {
+        if (floatInput_.size() < length) floatInput_.resize(length);
+        return val(typed_memory_view(length, floatInput_.data()));
+    }
+
+    // Returns the NoiseState (0 / 1) of this frame
+    int process(unsigned int length) {
+        AERONAV_PROFILE_BOUNDARY();
+        bank_.process(byteInput_.data(), std::min<unsigned int>(length, byteInput_.size()));
+        return static_cast<int>(bank_.getNoiseState());
+    }
+
+    int processFloat(unsigned int length, bool normalized) {
+        AERONAV_PROFILE_BOUNDARY();
+        bank_.processFloat(floatInput_.data(), std::min<unsigned int>(length, floatInput_.size()), normalized);
+        return static_cast<int>(bank_.getNoiseState());
+    }
+
+    // Analyze the latest byte spectrum of a PcmAnalyzer without a copy through JS
+    int processPcmSpectrum(const PcmAnalyzerWrapper& pcm) {
+        AERONAV_PROFILE_BOUNDARY();
+        bank_.process(pcm.getFft().getByteSpectrum(), pcm.getFft().getBinCount());
+        return static_cast<int>(bank_.getNoiseState());
+    }
+
+    val getBandView() const { return val(typed_memory_view(bank_.getBandCount(), bank_.getBands())); }
+    val getPeakView() const { return val(typed_memory_view(bank_.getBandCount(), bank_.getPeaks())); }
+    val getBandEdgeView() const { return val(typed_memory_view(bank_.getBandCount() + 1, bank_.getBandEdges())); }
+    val getBandCenterView() const { return val(typed_memory_view(bank_.getBandCount(), bank_.getBandCenters())); }
+    // BAND_DETECTOR_STRIDE floats: noise level, flux, onset, noise state
+    val getDetectorView() const { return val(typed_memory_view(BandDetectorLayout::STRIDE, bank_.getDetector())); }
+
+private:
+    BandBank bank_;
+    ArenaVector<uint8_t> byteInput_;
+    ArenaVector<float> floatInput_;
+};
+
+// Heap addresses of one SPSC ring, for Atomics access from a worklet/UI thread
+// (indices are byte addresses into HEAPU32, data into HEAPF32)
+struct RingLayoutJS {
+    uintptr_t dataPtr;
+    unsigned int capacity;
+    uintptr_t writeIndexPtr;
+    uintptr_t readIndexPtr;
+
+    static RingLayoutJS fromRing(SpscRingBuffer& ring) {
+        return {
+            reinterpret_cast<uintptr_t>(ring.dataAddress()),
+            static_cast<unsigned int>(ring.capacity()),
+            reinterpret_cast<uintptr_t>(ring.writeIndexAddress()),
+            reinterpret_cast<uintptr_t>(ring.readIndexAddress())
+        };
+    }
+};
+
+// Wrapper for the streaming analyzer
+// The AudioWorklet produces into getInputLayout(), process() is pumped from a
+// worker, and the UI drains getResultLayout() records (STREAM_RESULT_STRIDE floats)
+class StreamingAnalyzerWrapper {
+public:
+    StreamingAnalyzerWrapper() : stream_() {}
+
+    StreamingAnalyzerWrapper(unsigned int fftSize, unsigned int hopSize,
+                             unsigned int inputCapacity, unsigned int resultRecords, int mode)
+        : stream_(fftSize, hopSize, inputCapacity, resultRecords,
+                  mode == static_cast<int>(StreamInputMode::SPECTRUM) ? StreamInputMode::SPECTRUM : StreamInputMode::PCM) {}
+
+    unsigned int process(unsigned int maxBlocks) {
+        AERONAV_PROFILE_BOUNDARY();
+        return static_cast<unsigned int>(stream_.process(maxBlocks == 0 ? SIZE_MAX : maxBlocks));
+    }
+
+    RingLayoutJS getInputLayout() { return RingLayoutJS::fromRing(stream_.input()); }
+    RingLayoutJS getResultLayout() { return RingLayoutJS::fromRing(stream_.results()); }
+
+    unsigned int getBlockSize() const { return static_cast<unsigned int>(stream_.getBlockSize()); }
+    unsigned int getHopSize() const { return static_cast<unsigned int>(stream_.getHopSize()); }
+    unsigned int getSequence() const { return stream_.getSequence(); }
+    unsigned int getDroppedResults() const { return stream_.getDroppedResults(); }
+
+    void setWindow(int window) {
+        if (window >= 0 && window <= 2) stream_.fft().setWindow(static_cast<WindowType>(window));
+    }
+    void setSmoothing(float timeConstant) { stream_.fft().setSmoothing(timeConstant); }
+    void setBassRange(float endPercent) { stream_.analyzer().setBassRange(endPercent); }
+    void setMidRange(float endPercent) { stream_.analyzer().setMidRange(endPercent); }
+
+private:
+    StreamingAnalyzer stream_;
+};
+
+// Wrapper for AudioAugmenter adding applyAll and seeded batch augmentation
+// Batches live in a persistent WASM-owned buffer of interleaved
+// [bass, mid, treble, volume] frames, augmented in place in one call
+class AudioAugmenterWrapper {
+public:
+    AudioAugmenterWrapper() : augmenter_() {}
+
+    AudioData applyNoise(const AudioData& data, float intensity, NoiseType type) {
+        return augmenter_.applyNoise(data, intensity, type);
+    }
+    AudioData applyFreqShift(const AudioData& data, float amount, ShiftDirection dir) {
+        return augmenter_.applyFreqShift(data, amount, dir);
+    }
+    AudioData applyGain(const AudioData& data, float multiplier) {
+        return augmenter_.applyGain(data, multiplier);
+    }
+    AudioData applyFilter(const AudioData& data, FilterType type, float cutoff) {
+        return augmenter_.applyFilter(data, type, cutoff);
+    }
+
+    AudioData applyAll(const AudioData& data, const AugmentationConfig& cfg) {
+        return augmenter_.applyAll(data, cfg, nullptr);
+    }
+    AudioData applyAllWithPrevious(const AudioData& data, const AugmentationConfig& cfg, const AudioData& prev) {
+        return augmenter_.applyAll(data, cfg, &prev);
+    }
+
+    void setSeed(unsigned int seedLow, unsigned int seedHigh) {
+        augmenter_.setSeed((static_cast<uint64_t>(seedHigh) << 32) | seedLow);
+    }
+
+    // Float32Array view over `frames` interleaved frames (4 floats each)
+    val getBatchBuffer(unsigned int frames) {
+        if (batch_.size() < frames) batch_.resize(frames);
+        return val(typed_memory_view(static_cast<size_t>(frames) * 4,
+                                     reinterpret_cast<float*>(batch_.data())));
+    }
+
+    // Augment the first `frames` frames of the batch buffer in place
+    void applyAllBatch(unsigned int frames, const AugmentationConfig& cfg) {
+        if (frames > batch_.size()) frames = static_cast<unsigned int>(batch_.size());
+        augmenter_.applyAllBatch(batch_.data(), batch_.data(), frames, cfg);
+    }
+
+    // Augment interleaved frames already in the WASM heap (in == out allowed)
+    void applyAllBatchPointer(uintptr_t inPtr, uintptr_t outPtr, unsigned int frames, const AugmentationConfig& cfg) {
+        augmenter_.applyAllBatch(reinterpret_cast<const AudioData*>(inPtr),
+                                 reinterpret_cast<AudioData*>(outPtr), frames, cfg);
+    }
+
+private:
+    AudioAugmenter augmenter_;
+    ArenaVector<AudioData> batch_;
+};
+
+// Standalone function for simple one-shot analysis (no instance needed)
+// Reuses a module-level analyzer and input buffer between calls
+AudioResultJS analyzeFrequenciesQuick(const val& data) {
+    static AudioAnalyzerWrapper quickAnalyzer;
+    return quickAnalyzer.analyzeUint8(data);
+}
+
+// Container heap traffic of this module (arena.hpp); doubles keep the counts exact
+struct AllocationStatsJS {
+    double heapAllocations;
+    double heapFrees;
+    double heapBytesInUse;
+    double arenaAllocations;
+};
+
+AllocationStatsJS getAllocationStatsJS() {
+    const AllocationStats stats = getAllocationStats();
+    return { static_cast<double>(stats.heapAllocations), static_cast<double>(stats.heapFrees),
+             static_cast<double>(stats.heapBytesInUse), static_cast<double>(stats.arenaAllocations) };
 }
 
 EMSCRIPTEN_BINDINGS(aeronav_audio) {
@@ -100,14 +393,114 @@ EMSCRIPTEN_BINDINGS(aeronav_audio) {
     // Bind the analyzer class
     class_<AudioAnalyzerWrapper>("AudioAnalyzer")
         .constructor<>()
+        .constructor<unsigned int>()
+        .function("getInputBuffer", &AudioAnalyzerWrapper::getInputBuffer)
+        .function("getFloatInputBuffer", &AudioAnalyzerWrapper::getFloatInputBuffer)
+        .function("analyzeInput", &AudioAnalyzerWrapper::analyzeInput)
+        .function("analyzeFloatInput", &AudioAnalyzerWrapper::analyzeFloatInput)
+        .function("analyzePointer", &AudioAnalyzerWrapper::analyzePointer)
         .function("analyzeUint8", &AudioAnalyzerWrapper::analyzeUint8)
         .function("analyzeFloat32", &AudioAnalyzerWrapper::analyzeFloat32)
         .function("setBassRange", &AudioAnalyzerWrapper::setBassRange)
         .function("setMidRange", &AudioAnalyzerWrapper::setMidRange);
 
+    // Bind the raw PCM analyzer class
+    class_<PcmAnalyzerWrapper>("PcmAnalyzer")
+        .constructor<>()
+        .constructor<unsigned int, int>()
+        .function("setFftSize", &PcmAnalyzerWrapper::setFftSize)
+        .function("getFftSize", &PcmAnalyzerWrapper::getFftSize)
+        .function("getBinCount", &PcmAnalyzerWrapper::getBinCount)
+        .function("setWindow", &PcmAnalyzerWrapper::setWindow)
+        .function("setSmoothing", &PcmAnalyzerWrapper::setSmoothing)
+        .function("setDecibelRange", &PcmAnalyzerWrapper::setDecibelRange)
+        .function("setBassRange", &PcmAnalyzerWrapper::setBassRange)
+        .function("setMidRange", &PcmAnalyzerWrapper::setMidRange)
+        .function("getPcmBuffer", &PcmAnalyzerWrapper::getPcmBuffer)
+        .function("getSpectrumView", &PcmAnalyzerWrapper::getSpectrumView)
+        .function("analyze", &PcmAnalyzerWrapper::analyze)
+        .function("analyzePointer", &PcmAnalyzerWrapper::analyzePointer);
+
+    // Window type constants
+    constant("WINDOW_RECTANGULAR", static_cast<int>(WindowType::RECTANGULAR));
+    constant("WINDOW_HANN", static_cast<int>(WindowType::HANN));
+    constant("WINDOW_BLACKMAN", static_cast<int>(WindowType::BLACKMAN));
+
+    // Bind the band bank
+    class_<BandBankWrapper>("BandBank")
+        .constructor<>()
+        .constructor<unsigned int, unsigned int, float, float, float, int>()
+        .function("configure", &BandBankWrapper::configure)
+        .function("getBandCount", &BandBankWrapper::getBandCount)
+        .function("setSmoothing", &BandBankWrapper::setSmoothing)
+        .function("setPeakDecay", &BandBankWrapper::setPeakDecay)
+        .function("setOnsetThreshold", &BandBankWrapper::setOnsetThreshold)
+        .function("setNoiseBands", &BandBankWrapper::setNoiseBands)
+        .function("setNoiseThresholds", &BandBankWrapper::setNoiseThresholds)
+        .function("reset", &BandBankWrapper::reset)
+        .function("getInputBuffer", &BandBankWrapper::getInputBuffer)
+        .function("getFloatInputBuffer", &BandBankWrapper::getFloatInputBuffer)
+        .function("process", &BandBankWrapper::process)
+        .function("processFloat", &BandBankWrapper::processFloat)
+        .function("processPcmSpectrum", &BandBankWrapper::processPcmSpectrum)
+        .function("getBandView", &BandBankWrapper::getBandView)
+        .function("getPeakView", &BandBankWrapper::getPeakView)
+        .function("getBandEdgeView", &BandBankWrapper::getBandEdgeView)
+        .function("getBandCenterView", &BandBankWrapper::getBandCenterView)
+        .function("getDetectorView", &BandBankWrapper::getDetectorView);
+
+    constant("BAND_SCALE_LOG", static_cast<int>(BandScale::LOG));
+    constant("BAND_SCALE_MEL", static_cast<int>(BandScale::MEL));
+    constant("BAND_DETECTOR_STRIDE", static_cast<int>(BandDetectorLayout::STRIDE));
+    constant("BAND_DETECTOR_NOISE_LEVEL", static_cast<int>(BandDetectorLayout::NOISE_LEVEL));
+    constant("BAND_DETECTOR_FLUX", static_cast<int>(BandDetectorLayout::FLUX));
+    constant("BAND_DETECTOR_ONSET", static_cast<int>(BandDetectorLayout::ONSET));
+    constant("BAND_DETECTOR_NOISE_STATE", static_cast<int>(BandDetectorLayout::NOISE_STATE));
+
+    // Streaming analysis
+    value_object<RingLayoutJS>("RingLayout")
+        .field("dataPtr", &RingLayoutJS::dataPtr)
+        .field("capacity", &RingLayoutJS::capacity)
+        .field("writeIndexPtr", &RingLayoutJS::writeIndexPtr)
+        .field("readIndexPtr", &RingLayoutJS::readIndexPtr);
+
+    class_<StreamingAnalyzerWrapper>("StreamingAnalyzer")
+        .constructor<>()
+        .constructor<unsigned int, unsigned int, unsigned int, unsigned int, int>()
+        .function("process", &StreamingAnalyzerWrapper::process)
+        .function("getInputLayout", &StreamingAnalyzerWrapper::getInputLayout)
+        .function("getResultLayout", &StreamingAnalyzerWrapper::getResultLayout)
+        .function("getBlockSize", &StreamingAnalyzerWrapper::getBlockSize)
+        .function("getHopSize", &StreamingAnalyzerWrapper::getHopSize)
+        .function("getSequence", &StreamingAnalyzerWrapper::getSequence)
+        .function("getDroppedResults", &StreamingAnalyzerWrapper::getDroppedResults)
+        .function("setWindow", &StreamingAnalyzerWrapper::setWindow)
+        .function("setSmoothing", &StreamingAnalyzerWrapper::setSmoothing)
+        .function("setBassRange", &StreamingAnalyzerWrapper::setBassRange)
+        .function("setMidRange", &StreamingAnalyzerWrapper::setMidRange);
+
+    constant("STREAM_INPUT_PCM", static_cast<int>(StreamInputMode::PCM));
+    constant("STREAM_INPUT_SPECTRUM", static_cast<int>(StreamInputMode::SPECTRUM));
+    constant("STREAM_RESULT_STRIDE", static_cast<int>(StreamResultLayout::STRIDE));
+    constant("STREAM_RESULT_SEQUENCE", static_cast<int>(StreamResultLayout::SEQUENCE));
+    constant("STREAM_RESULT_BASS", static_cast<int>(StreamResultLayout::BASS));
+    constant("STREAM_RESULT_MID", static_cast<int>(StreamResultLayout::MID));
+    constant("STREAM_RESULT_TREBLE", static_cast<int>(StreamResultLayout::TREBLE));
+    constant("STREAM_RESULT_VOLUME", static_cast<int>(StreamResultLayout::VOLUME));
+
     // Bind standalone function for quick analysis
     function("analyzeFrequencies", &analyzeFrequenciesQuick);
 
+    value_object<AllocationStatsJS>("AllocationStats")
+        .field("heapAllocations", &AllocationStatsJS::heapAllocations)
+        .field("heapFrees", &AllocationStatsJS::heapFrees)
+        .field("heapBytesInUse", &AllocationStatsJS::heapBytesInUse)
+        .field("arenaAllocations", &AllocationStatsJS::arenaAllocations);
+    function("getAllocationStats", &getAllocationStatsJS);
+
+    // Stage timers and counters (profiler.hpp; all zero unless built with profiling)
+    bindProfiler();
+
     // Augmentation enums
     enum_<NoiseType>("NoiseType")
         .value("WHITE", NoiseType::WHITE)
@@ -130,10 +523,31 @@ EMSCRIPTEN_BINDINGS(aeronav_audio) {
         .field("treble", &AudioData::treble)
         .field("volume", &AudioData::volume);
 
-    class_<AudioAugmenter>("AudioAugmenter")
+    value_object<AugmentationConfig>("AugmentationConfig")
+        .field("noiseEnabled", &AugmentationConfig::noiseEnabled)
+        .field("noiseIntensity", &AugmentationConfig::noiseIntensity)
+        .field("noiseType", &AugmentationConfig::noiseType)
+        .field("freqShiftEnabled", &AugmentationConfig::freqShiftEnabled)
+        .field("freqShiftAmount", &AugmentationConfig::freqShiftAmount)
+        .field("freqShiftDir", &AugmentationConfig::freqShiftDir)
+        .field("timeWarpEnabled", &AugmentationConfig::timeWarpEnabled)
+        .field("timeWarpFactor", &AugmentationConfig::timeWarpFactor)
+        .field("gainEnabled", &AugmentationConfig::gainEnabled)
+        .field("gainMultiplier", &AugmentationConfig::gainMultiplier)
+        .field("filterEnabled", &AugmentationConfig::filterEnabled)
+        .field("filterType", &AugmentationConfig::filterType)
+        .field("filterCutoff", &AugmentationConfig::filterCutoff);
+
+    class_<AudioAugmenterWrapper>("AudioAugmenter")
         .constructor<>()
-        .function("applyNoise", &AudioAugmenter::applyNoise)
-        .function("applyFreqShift", &AudioAugmenter::applyFreqShift)
-        .function("applyGain", &AudioAugmenter::applyGain)
-        .function("applyFilter", &AudioAugmenter::applyFilter);
+        .function("applyNoise", &AudioAugmenterWrapper::applyNoise)
+        .function("applyFreqShift", &AudioAugmenterWrapper::applyFreqShift)
+        .function("applyGain", &AudioAugmenterWrapper::applyGain)
+        .function("applyFilter", &AudioAugmenterWrapper::applyFilter)
+        .function("applyAll", &AudioAugmenterWrapper::applyAll)
+        .function("applyAllWithPrevious", &AudioAugmenterWrapper::applyAllWithPrevious)
+        .function("setSeed", &AudioAugmenterWrapper::setSeed)
+        .function("getBatchBuffer", &AudioAugmenterWrapper::getBatchBuffer)
+        .function("applyAllBatch", &AudioAugmenterWrapper::applyAllBatch)
+        .function("applyAllBatchPointer", &AudioAugmenterWrapper::applyAllBatchPointer);
 }
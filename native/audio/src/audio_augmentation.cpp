@@ -1,39 +1,42 @@
 #include "audio_augmentation.hpp"
 #include <algorithm>
-#include <cstdlib>
 #include <ctime>
 
 namespace aeronav {
 
 AudioAugmenter::AudioAugmenter()
     : b0_(0), b1_(0), b2_(0), b3_(0), b4_(0), b5_(0), b6_(0), brownLast_(0) {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    setSeed(static_cast<uint64_t>(std::time(nullptr)));
+}
+
+void AudioAugmenter::setSeed(uint64_t seed) {
+    rng_.reseed(seed, 0);
+    batchRng_.reseed(seed, 1);
 }
 
 float AudioAugmenter::randomFloat() {
-    return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+    return rng_.nextFloat();
 }
 
 static float clamp01(float v) { return std::max(0.0f, std::min(1.0f, v)); }
 
-AudioData AudioAugmenter::applyNoise(const AudioData& data, float intensity, NoiseType type) {
+static float noiseScale(float intensity, NoiseType type) {
     float mult = 1.0f;
     if (type == NoiseType::PINK) mult = 0.8f;
     else if (type == NoiseType::BROWN) mult = 0.6f;
-    float noise = intensity * mult;
+    return intensity * mult;
+}
+
+static AudioData addNoise(const AudioData& data, float noise, float r0, float r1, float r2, float r3) {
     return {
-        clamp01(data.bass + (randomFloat() - 0.5f) * noise),
-        clamp01(data.mid + (randomFloat() - 0.5f) * noise),
-        clamp01(data.treble + (randomFloat() - 0.5f) * noise),
-        clamp01(data.volume + (randomFloat() - 0.5f) * noise)
+        clamp01(data.bass + (r0 - 0.5f) * noise),
+        clamp01(data.mid + (r1 - 0.5f) * noise),
+        clamp01(data.treble + (r2 - 0.5f) * noise),
+        clamp01(data.volume + (r3 - 0.5f) * noise)
     };
 }
 
-AudioData AudioAugmenter::applyFreqShift(const AudioData& data, float amount, ShiftDirection dir) {
-    float shift = amount / 1000.0f;
-    float shiftAmt = shift;
-    if (dir == ShiftDirection::DOWN) shiftAmt = -shift;
-    else if (dir == ShiftDirection::BOTH) shiftAmt = (randomFloat() > 0.5f ? 1.0f : -1.0f) * shift;
+static AudioData shiftBands(const AudioData& data, float shiftAmt) {
     float energyShift = std::abs(shiftAmt) * 0.1f;
     return {
         clamp01(data.bass + (shiftAmt < 0 ? energyShift : -energyShift)),
@@ -43,6 +46,20 @@ AudioData AudioAugmenter::applyFreqShift(const AudioData& data, float amount, Sh
     };
 }
 
+AudioData AudioAugmenter::applyNoise(const AudioData& data, float intensity, NoiseType type) {
+    float noise = noiseScale(intensity, type);
+    float r0 = randomFloat(), r1 = randomFloat(), r2 = randomFloat(), r3 = randomFloat();
+    return addNoise(data, noise, r0, r1, r2, r3);
+}
+
+AudioData AudioAugmenter::applyFreqShift(const AudioData& data, float amount, ShiftDirection dir) {
+    float shift = amount / 1000.0f;
+    float shiftAmt = shift;
+    if (dir == ShiftDirection::DOWN) shiftAmt = -shift;
+    else if (dir == ShiftDirection::BOTH) shiftAmt = (randomFloat() > 0.5f ? 1.0f : -1.0f) * shift;
+    return shiftBands(data, shiftAmt);
+}
+
 AudioData AudioAugmenter::applyTimeWarp(const AudioData& data, const AudioData& prev, float factor) {
     if (factor == 1.0f) return data;
     return {
@@ -91,4 +108,51 @@ AudioData AudioAugmenter::applyAll(const AudioData& data, const AugmentationConf
     return result;
 }
 
+void AudioAugmenter::applyAllBatch(const AudioData* in, AudioData* out, size_t n,
+                                   const AugmentationConfig& cfg, const AudioData* prev) {
+    constexpr size_t CHUNK = 256;
+    alignas(16) uint32_t words[4 * CHUNK];
+
+    // Per-batch constants
+    const float noise = noiseScale(cfg.noiseIntensity, cfg.noiseType);
+    const float shift = cfg.freqShiftAmount / 1000.0f;
+    const bool warp = cfg.timeWarpEnabled && cfg.timeWarpFactor != 1.0f;
+
+    AudioData previous = prev ? *prev : AudioData{0, 0, 0, 0};
+    bool hasPrevious = prev != nullptr;
+
+    for (size_t begin = 0; begin < n; begin += CHUNK) {
+        const size_t count = std::min(CHUNK, n - begin);
+
+        // Four random words per frame, generated four frames per SIMD pass
+        batchRng_.fillBlocks(words, count);
+
+        for (size_t i = 0; i < count; i++) {
+            const AudioData input = in[begin + i];
+            const uint32_t* w = words + 4 * i;
+            AudioData result = input;
+
+            if (cfg.noiseEnabled) {
+                result = addNoise(result, noise,
+                                  Philox4x32::toFloat(w[0]), Philox4x32::toFloat(w[1]),
+                                  Philox4x32::toFloat(w[2]), Philox4x32::toFloat(w[3]));
+            }
+            if (cfg.freqShiftEnabled) {
+                float shiftAmt = shift;
+                if (cfg.freqShiftDir == ShiftDirection::DOWN) shiftAmt = -shift;
+                // toFloat() only uses the top 24 bits, so the low bit is free for the sign
+                else if (cfg.freqShiftDir == ShiftDirection::BOTH) shiftAmt = (w[0] & 1u) ? shift : -shift;
+                result = shiftBands(result, shiftAmt);
+            }
+            if (cfg.gainEnabled) result = applyGain(result, cfg.gainMultiplier);
+            if (cfg.filterEnabled) result = applyFilter(result, cfg.filterType, cfg.filterCutoff);
+            if (warp && hasPrevious) result = applyTimeWarp(result, previous, cfg.timeWarpFactor);
+
+            previous = input;
+            hasPrevious = true;
+            out[begin + i] = result;
+        }
+    }
+}
+
 } // namespace aeronav
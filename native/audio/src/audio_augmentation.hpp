@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cmath>
+#include "rng.hpp"
 
 namespace aeronav {
 
@@ -17,6 +18,9 @@ struct AudioData {
     float volume;
 };
 
+// Batches are passed as interleaved [bass, mid, treble, volume] float frames
+static_assert(sizeof(AudioData) == 4 * sizeof(float), "AudioData must be four packed floats");
+
 struct AugmentationConfig {
     bool noiseEnabled;
     float noiseIntensity;
@@ -42,8 +46,24 @@ public:
     AudioData applyGain(const AudioData& data, float multiplier);
     AudioData applyFilter(const AudioData& data, FilterType type, float cutoff);
     AudioData applyAll(const AudioData& data, const AugmentationConfig& cfg, const AudioData* prev);
+
+    /**
+     * Augment n frames with the same pipeline as applyAll()
+     * Draws one Philox block per frame from the batch stream, so a given
+     * seed and call sequence always produces the same batch.
+     * Time warp uses the preceding input frame (`prev` for the first one).
+     * `in` and `out` may alias.
+     */
+    void applyAllBatch(const AudioData* in, AudioData* out, size_t n,
+                       const AugmentationConfig& cfg, const AudioData* prev = nullptr);
+
+    // Reseed both random streams (single-frame and batch) for a reproducible run
+    void setSeed(uint64_t seed);
+    uint64_t getSeed() const { return rng_.getSeed(); }
 private:
     float randomFloat();
+    RngStream rng_;        // single-frame calls (stream 0)
+    RngStream batchRng_;   // applyAllBatch, one block per frame (stream 1)
     // Pink noise state
     float b0_, b1_, b2_, b3_, b4_, b5_, b6_;
     // Brown noise state
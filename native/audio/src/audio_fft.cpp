@@ -1,7 +1,12 @@
 #include "audio_fft.hpp"
+#include "profiler.hpp"
 #include <algorithm>
 #include <cmath>
 
+#if USE_SSE && defined(__SSE2__) && !USE_AVX2
+    #include <emmintrin.h>
+#endif
+
 namespace aeronav {
 
 AudioFFTAnalyzer::AudioFFTAnalyzer()
@@ -18,111 +23,217 @@ void AudioFFTAnalyzer::setMidRange(float endPercent) {
     midEndPercent_ = std::clamp(endPercent, bassEndPercent_ + 0.01f, 0.99f);
 }
 
-float AudioFFTAnalyzer::simdSum(const float* data, size_t length) {
-    float sum = 0.0f;
-
-#if USE_WASM_SIMD
-    // Process 4 floats at a time with WASM SIMD
-    size_t simdLength = length & ~3; // Round down to multiple of 4
-    v128_t accumulator = wasm_f32x4_splat(0.0f);
+namespace {
+
+// Loading a block at PREFIX_MASK + 32 - n yields n 0xFF bytes followed by zeros
+alignas(32) const uint8_t PREFIX_MASK[64] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// Sum bytes in [begin, end). `length` is the full buffer size: a band tail is
+// processed as one masked full-width block when that load stays inside the buffer.
+uint32_t sumRangeUint8(const uint8_t* data, size_t begin, size_t end, size_t length) {
+    size_t i = begin;
+    uint32_t sum = 0;
+
+#if USE_AVX2
+    // 32 bytes per iteration; SAD against zero widens u8 -> u64 partial sums
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i accumulator = _mm256_setzero_si256();
+
+    for (; i + 32 <= end; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[i]));
+        accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(bytes, zero));
+    }
 
-    for (size_t i = 0; i < simdLength; i += 4) {
-        v128_t values = wasm_v128_load(&data[i]);
-        accumulator = wasm_f32x4_add(accumulator, values);
+    // Masked tail
+    if (i < end && i + 32 <= length) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[i]));
+        __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&PREFIX_MASK[32 - (end - i)]));
+        accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(_mm256_and_si256(bytes, mask), zero));
+        i = end;
     }
 
-    // Horizontal sum of accumulator
-    float temp[4];
-    wasm_v128_store(temp, accumulator);
-    sum = temp[0] + temp[1] + temp[2] + temp[3];
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), accumulator);
+    sum = static_cast<uint32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
 
-    // Handle remaining elements
-    for (size_t i = simdLength; i < length; i++) {
-        sum += data[i];
-    }
+#elif USE_SSE && defined(__SSE2__)
+    // 16 bytes per iteration; SAD against zero widens u8 -> u64 partial sums
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accumulator = _mm_setzero_si128();
 
-#elif USE_SSE
-    // Process 4 floats at a time with SSE
-    size_t simdLength = length & ~3;
-    __m128 accumulator = _mm_setzero_ps();
+    for (; i + 16 <= end; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i]));
+        accumulator = _mm_add_epi64(accumulator, _mm_sad_epu8(bytes, zero));
+    }
 
-    for (size_t i = 0; i < simdLength; i += 4) {
-        __m128 values = _mm_loadu_ps(&data[i]);
-        accumulator = _mm_add_ps(accumulator, values);
+    // Masked tail
+    if (i < end && i + 16 <= length) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i]));
+        __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&PREFIX_MASK[32 - (end - i)]));
+        accumulator = _mm_add_epi64(accumulator, _mm_sad_epu8(_mm_and_si128(bytes, mask), zero));
+        i = end;
     }
 
-    // Horizontal sum
-    float temp[4];
-    _mm_storeu_ps(temp, accumulator);
-    sum = temp[0] + temp[1] + temp[2] + temp[3];
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), accumulator);
+    sum = static_cast<uint32_t>(lanes[0] + lanes[1]);
 
-    // Handle remaining elements
-    for (size_t i = simdLength; i < length; i++) {
-        sum += data[i];
+#elif USE_WASM_SIMD
+    // Widen u8 -> u16 with pairwise adds; u16 lanes hold up to 128 blocks
+    // (128 * 2 * 255 < 65536) before being widened to u32
+    v128_t accumulator = wasm_i32x4_splat(0);
+
+    while (i + 16 <= end) {
+        v128_t partial = wasm_i16x8_splat(0);
+        for (size_t n = 0; n < 128 && i + 16 <= end; n++, i += 16) {
+            partial = wasm_i16x8_add(partial, wasm_u16x8_extadd_pairwise_u8x16(wasm_v128_load(&data[i])));
+        }
+        accumulator = wasm_i32x4_add(accumulator, wasm_u32x4_extadd_pairwise_u16x8(partial));
     }
 
-#else
-    // Scalar fallback
-    for (size_t i = 0; i < length; i++) {
-        sum += data[i];
+    // Masked tail
+    if (i < end && i + 16 <= length) {
+        v128_t bytes = wasm_v128_and(wasm_v128_load(&data[i]), wasm_v128_load(&PREFIX_MASK[32 - (end - i)]));
+        accumulator = wasm_i32x4_add(accumulator,
+            wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(bytes)));
+        i = end;
     }
+
+    sum = wasm_u32x4_extract_lane(accumulator, 0) + wasm_u32x4_extract_lane(accumulator, 1)
+        + wasm_u32x4_extract_lane(accumulator, 2) + wasm_u32x4_extract_lane(accumulator, 3);
 #endif
 
+    // Scalar remainder (and full scalar fallback)
+    for (; i < end; i++) {
+        sum += data[i];
+    }
     return sum;
 }
 
-float AudioFFTAnalyzer::simdSumUint8(const uint8_t* data, size_t length) {
-    // For uint8, we need to convert to float for accurate summation
-    // This is slightly less efficient but more accurate
+// Sum clamp((x + offset) * scale, 0, 1) over [begin, end), adding raw x to rawSum
+float sumRangeFloat(const float* data, size_t begin, size_t end, float offset, float scale, float& rawSum) {
+    size_t i = begin;
+    float sum = 0.0f;
 
-#if USE_WASM_SIMD
-    // Process in chunks, converting to float
-    size_t simdLength = length & ~15; // Process 16 bytes at a time
-    v128_t accumulator = wasm_f32x4_splat(0.0f);
-    const v128_t scale = wasm_f32x4_splat(1.0f / 255.0f);
+#if USE_AVX2
+    const __m256 vOffset = _mm256_set1_ps(offset);
+    const __m256 vScale = _mm256_set1_ps(scale);
+    const __m256 vZero = _mm256_setzero_ps();
+    const __m256 vOne = _mm256_set1_ps(1.0f);
+    __m256 clampedAcc = _mm256_setzero_ps();
+    __m256 rawAcc = _mm256_setzero_ps();
+
+    for (; i + 8 <= end; i += 8) {
+        __m256 values = _mm256_loadu_ps(&data[i]);
+        rawAcc = _mm256_add_ps(rawAcc, values);
+        __m256 val = _mm256_mul_ps(_mm256_add_ps(values, vOffset), vScale);
+        clampedAcc = _mm256_add_ps(clampedAcc, _mm256_min_ps(_mm256_max_ps(val, vZero), vOne));
+    }
 
-    for (size_t i = 0; i < simdLength; i += 16) {
-        // Load 16 bytes
-        v128_t bytes = wasm_v128_load(&data[i]);
+    alignas(32) float clampedLanes[8], rawLanes[8];
+    _mm256_store_ps(clampedLanes, clampedAcc);
+    _mm256_store_ps(rawLanes, rawAcc);
+    for (int lane = 0; lane < 8; lane++) {
+        sum += clampedLanes[lane];
+        rawSum += rawLanes[lane];
+    }
 
-        // Unpack and accumulate in 4 groups of 4
-        // First 4 bytes
-        v128_t low8 = wasm_u16x8_extend_low_u8x16(bytes);
-        v128_t vals0 = wasm_f32x4_convert_u32x4(wasm_u32x4_extend_low_u16x8(low8));
-        accumulator = wasm_f32x4_add(accumulator, wasm_f32x4_mul(vals0, scale));
+#elif USE_SSE
+    const __m128 vOffset = _mm_set1_ps(offset);
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    __m128 clampedAcc = _mm_setzero_ps();
+    __m128 rawAcc = _mm_setzero_ps();
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 values = _mm_loadu_ps(&data[i]);
+        rawAcc = _mm_add_ps(rawAcc, values);
+        __m128 val = _mm_mul_ps(_mm_add_ps(values, vOffset), vScale);
+        clampedAcc = _mm_add_ps(clampedAcc, _mm_min_ps(_mm_max_ps(val, vZero), vOne));
+    }
 
-        v128_t vals1 = wasm_f32x4_convert_u32x4(wasm_u32x4_extend_high_u16x8(low8));
-        accumulator = wasm_f32x4_add(accumulator, wasm_f32x4_mul(vals1, scale));
+    alignas(16) float clampedLanes[4], rawLanes[4];
+    _mm_store_ps(clampedLanes, clampedAcc);
+    _mm_store_ps(rawLanes, rawAcc);
+    sum += clampedLanes[0] + clampedLanes[1] + clampedLanes[2] + clampedLanes[3];
+    rawSum += rawLanes[0] + rawLanes[1] + rawLanes[2] + rawLanes[3];
+
+#elif USE_WASM_SIMD
+    const v128_t vOffset = wasm_f32x4_splat(offset);
+    const v128_t vScale = wasm_f32x4_splat(scale);
+    const v128_t vZero = wasm_f32x4_splat(0.0f);
+    const v128_t vOne = wasm_f32x4_splat(1.0f);
+    v128_t clampedAcc = wasm_f32x4_splat(0.0f);
+    v128_t rawAcc = wasm_f32x4_splat(0.0f);
+
+    for (; i + 4 <= end; i += 4) {
+        v128_t values = wasm_v128_load(&data[i]);
+        rawAcc = wasm_f32x4_add(rawAcc, values);
+        v128_t val = wasm_f32x4_mul(wasm_f32x4_add(values, vOffset), vScale);
+        clampedAcc = wasm_f32x4_add(clampedAcc, wasm_f32x4_pmin(wasm_f32x4_pmax(val, vZero), vOne));
+    }
 
-        // Second 4 bytes
-        v128_t high8 = wasm_u16x8_extend_high_u8x16(bytes);
-        v128_t vals2 = wasm_f32x4_convert_u32x4(wasm_u32x4_extend_low_u16x8(high8));
-        accumulator = wasm_f32x4_add(accumulator, wasm_f32x4_mul(vals2, scale));
+    float clampedLanes[4], rawLanes[4];
+    wasm_v128_store(clampedLanes, clampedAcc);
+    wasm_v128_store(rawLanes, rawAcc);
+    sum += clampedLanes[0] + clampedLanes[1] + clampedLanes[2] + clampedLanes[3];
+    rawSum += rawLanes[0] + rawLanes[1] + rawLanes[2] + rawLanes[3];
+#endif
 
-        v128_t vals3 = wasm_f32x4_convert_u32x4(wasm_u32x4_extend_high_u16x8(high8));
-        accumulator = wasm_f32x4_add(accumulator, wasm_f32x4_mul(vals3, scale));
+    // Scalar remainder (and full scalar fallback)
+    for (; i < end; i++) {
+        rawSum += data[i];
+        sum += std::clamp((data[i] + offset) * scale, 0.0f, 1.0f);
     }
+    return sum;
+}
 
-    // Horizontal sum
-    float temp[4];
-    wasm_v128_store(temp, accumulator);
-    float sum = temp[0] + temp[1] + temp[2] + temp[3];
+} // namespace
 
-    // Handle remaining elements
-    for (size_t i = simdLength; i < length; i++) {
-        sum += data[i] / 255.0f;
-    }
+void sumBandsUint8(const uint8_t* data, size_t length, size_t bassEnd, size_t midEnd,
+                   uint32_t bandSums[3]) {
+    bandSums[0] = sumRangeUint8(data, 0, bassEnd, length);
+    bandSums[1] = sumRangeUint8(data, bassEnd, midEnd, length);
+    bandSums[2] = sumRangeUint8(data, midEnd, length, length);
+}
 
-    return sum;
+void sumBandsFloat(const float* data, size_t length, size_t bassEnd, size_t midEnd,
+                   float offset, float scale, float bandSums[3], float& rawTotal) {
+    rawTotal = 0.0f;
+    bandSums[0] = sumRangeFloat(data, 0, bassEnd, offset, scale, rawTotal);
+    bandSums[1] = sumRangeFloat(data, bassEnd, midEnd, offset, scale, rawTotal);
+    bandSums[2] = sumRangeFloat(data, midEnd, length, offset, scale, rawTotal);
+}
 
-#else
-    // Scalar fallback - accumulate as integers then divide
-    uint32_t intSum = 0;
-    for (size_t i = 0; i < length; i++) {
-        intSum += data[i];
+void sumBandRangesUint8(const uint8_t* data, size_t length, const uint32_t* edges, size_t bandCount,
+                        uint32_t* bandSums) {
+    for (size_t b = 0; b < bandCount; b++) {
+        const size_t begin = std::min<size_t>(edges[b], length);
+        const size_t end = std::min<size_t>(edges[b + 1], length);
+        bandSums[b] = sumRangeUint8(data, begin, end, length);
     }
-    return static_cast<float>(intSum) / 255.0f;
-#endif
+}
+
+void sumBandRangesFloat(const float* data, size_t length, const uint32_t* edges, size_t bandCount,
+                        float offset, float scale, float* bandSums) {
+    float rawTotal = 0.0f;
+    for (size_t b = 0; b < bandCount; b++) {
+        const size_t begin = std::min<size_t>(edges[b], length);
+        const size_t end = std::min<size_t>(edges[b + 1], length);
+        bandSums[b] = sumRangeFloat(data, begin, end, offset, scale, rawTotal);
+    }
+}
+
+void AudioFFTAnalyzer::bandBounds(size_t length, size_t& bassEnd, size_t& midEnd) const {
+    bassEnd = std::min(static_cast<size_t>(length * bassEndPercent_), length);
+    // Bands are contiguous: mid never starts before the end of bass
+    midEnd = std::clamp(static_cast<size_t>(length * midEndPercent_), bassEnd, length);
 }
 
 AudioAnalysisResult AudioFFTAnalyzer::analyzeFrequencies(const uint8_t* data, size_t length) {
@@ -130,71 +241,30 @@ AudioAnalysisResult AudioFFTAnalyzer::analyzeFrequencies(const uint8_t* data, si
         return { 0.0f, 0.0f, 0.0f, 0.0f };
     }
 
+    AERONAV_PROFILE_SCOPE(AUDIO_BANDS);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, length);
+
     // Calculate band boundaries
-    const size_t bassEnd = static_cast<size_t>(length * bassEndPercent_);
-    const size_t midEnd = static_cast<size_t>(length * midEndPercent_);
+    size_t bassEnd, midEnd;
+    bandBounds(length, bassEnd, midEnd);
 
     // Ensure we have valid ranges
     const size_t bassLen = std::max(bassEnd, size_t(1));
     const size_t midLen = std::max(midEnd - bassEnd, size_t(1));
     const size_t trebleLen = std::max(length - midEnd, size_t(1));
 
-    // Calculate sums using SIMD where possible
-    float bassSum = 0.0f;
-    float midSum = 0.0f;
-    float trebleSum = 0.0f;
-
-#if USE_WASM_SIMD || USE_SSE
-    // For SIMD, process each band separately
-    // Bass band
-    {
-        uint32_t sum = 0;
-        for (size_t i = 0; i < bassEnd; i++) {
-            sum += data[i];
-        }
-        bassSum = static_cast<float>(sum) / 255.0f;
-    }
-
-    // Mid band
-    {
-        uint32_t sum = 0;
-        for (size_t i = bassEnd; i < midEnd; i++) {
-            sum += data[i];
-        }
-        midSum = static_cast<float>(sum) / 255.0f;
-    }
-
-    // Treble band
-    {
-        uint32_t sum = 0;
-        for (size_t i = midEnd; i < length; i++) {
-            sum += data[i];
-        }
-        trebleSum = static_cast<float>(sum) / 255.0f;
-    }
-#else
-    // Scalar path
-    for (size_t i = 0; i < length; i++) {
-        float val = data[i] / 255.0f;
-        if (i < bassEnd) {
-            bassSum += val;
-        } else if (i < midEnd) {
-            midSum += val;
-        } else {
-            trebleSum += val;
-        }
-    }
-#endif
-
-    // Calculate overall volume
-    float totalSum = simdSumUint8(data, length);
+    // Single fused sweep over all bins (exact integer sums)
+    uint32_t sums[3];
+    sumBandsUint8(data, length, bassEnd, midEnd, sums);
+    const uint32_t total = sums[0] + sums[1] + sums[2];
 
     // Return averaged results
     AudioAnalysisResult result;
-    result.bass = bassSum / bassLen;
-    result.mid = midSum / midLen;
-    result.treble = trebleSum / trebleLen;
-    result.volume = totalSum / length;
+    result.bass = static_cast<float>(sums[0]) / 255.0f / bassLen;
+    result.mid = static_cast<float>(sums[1]) / 255.0f / midLen;
+    result.treble = static_cast<float>(sums[2]) / 255.0f / trebleLen;
+    result.volume = static_cast<float>(total) / 255.0f / length;
 
     return result;
 }
@@ -204,44 +274,35 @@ AudioAnalysisResult AudioFFTAnalyzer::analyzeFrequenciesFloat(const float* data,
         return { 0.0f, 0.0f, 0.0f, 0.0f };
     }
 
+    AERONAV_PROFILE_SCOPE(AUDIO_BANDS);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, length);
+
     // Calculate band boundaries
-    const size_t bassEnd = static_cast<size_t>(length * bassEndPercent_);
-    const size_t midEnd = static_cast<size_t>(length * midEndPercent_);
+    size_t bassEnd, midEnd;
+    bandBounds(length, bassEnd, midEnd);
 
     // Ensure we have valid ranges
     const size_t bassLen = std::max(bassEnd, size_t(1));
     const size_t midLen = std::max(midEnd - bassEnd, size_t(1));
     const size_t trebleLen = std::max(length - midEnd, size_t(1));
 
-    float bassSum = 0.0f;
-    float midSum = 0.0f;
-    float trebleSum = 0.0f;
-
-    // Process each band
-    for (size_t i = 0; i < length; i++) {
-        float val = normalized ? data[i] : (data[i] + 1.0f) * 0.5f;
-        val = std::clamp(val, 0.0f, 1.0f);
-
-        if (i < bassEnd) {
-            bassSum += val;
-        } else if (i < midEnd) {
-            midSum += val;
-        } else {
-            trebleSum += val;
-        }
-    }
-
-    // Calculate overall volume using SIMD
-    float totalSum = simdSum(data, length);
+    // Single fused sweep: clamped band sums plus the raw total for volume
+    // Non-normalized input (-1 to 1) is mapped to 0-1 as (x + 1) * 0.5
+    const float offset = normalized ? 0.0f : 1.0f;
+    const float scale = normalized ? 1.0f : 0.5f;
+    float sums[3];
+    float totalSum;
+    sumBandsFloat(data, length, bassEnd, midEnd, offset, scale, sums, totalSum);
     if (!normalized) {
         totalSum = (totalSum + static_cast<float>(length)) * 0.5f;
     }
 
     // Return averaged results
     AudioAnalysisResult result;
-    result.bass = bassSum / bassLen;
-    result.mid = midSum / midLen;
-    result.treble = trebleSum / trebleLen;
+    result.bass = sums[0] / bassLen;
+    result.mid = sums[1] / midLen;
+    result.treble = sums[2] / trebleLen;
     result.volume = std::clamp(totalSum / length, 0.0f, 1.0f);
 
     return result;
@@ -12,6 +12,12 @@
     #define USE_SSE 1
 #endif
 
+// Wide SIMD detection (native builds only)
+#if !defined(__EMSCRIPTEN__) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define USE_AVX2 1
+#endif
+
 namespace aeronav {
 
 // Audio analysis result (matching JS AudioAnalysisResult interface)
@@ -59,9 +65,32 @@ private:
     float bassEndPercent_;
     float midEndPercent_;
 
-    // SIMD-optimized sum calculation
-    float simdSum(const float* data, size_t length);
-    float simdSumUint8(const uint8_t* data, size_t length);
+    // Band boundaries (in bins) for a spectrum of the given length
+    void bandBounds(size_t length, size_t& bassEnd, size_t& midEnd) const;
 };
 
+/**
+ * Fused single-pass band kernels (SIMD with masked band tails)
+ * Sum [0, bassEnd), [bassEnd, midEnd) and [midEnd, length) in one sweep;
+ * the total is the sum of the three bands.
+ */
+void sumBandsUint8(const uint8_t* data, size_t length, size_t bassEnd, size_t midEnd,
+                   uint32_t bandSums[3]);
+
+// Sums clamp((x + offset) * scale, 0, 1) per band and the raw (unclamped) total
+void sumBandsFloat(const float* data, size_t length, size_t bassEnd, size_t midEnd,
+                   float offset, float scale, float bandSums[3], float& rawTotal);
+
+/**
+ * N contiguous bands in one ascending sweep: band b sums bins
+ * [edges[b], edges[b + 1]) (bandCount + 1 ascending edges; bins past
+ * `length` count as empty)
+ */
+void sumBandRangesUint8(const uint8_t* data, size_t length, const uint32_t* edges, size_t bandCount,
+                        uint32_t* bandSums);
+
+// Per-band sums of clamp((x + offset) * scale, 0, 1)
+void sumBandRangesFloat(const float* data, size_t length, const uint32_t* edges, size_t bandCount,
+                        float offset, float scale, float* bandSums);
+
 } // namespace aeronav
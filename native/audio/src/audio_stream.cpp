@@ -0,0 +1,136 @@
+#include "audio_stream.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace aeronav {
+
+namespace {
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+}
+
+SpscRingBuffer::SpscRingBuffer(size_t capacity)
+    : data_(nextPowerOfTwo(std::max(capacity, size_t(2))), 0.0f)
+    , mask_(static_cast<uint32_t>(data_.size() - 1))
+    , writeIndex_(0)
+    , readIndex_(0)
+{
+}
+
+size_t SpscRingBuffer::write(const float* data, size_t count) {
+    const uint32_t write = writeIndex_.load(std::memory_order_relaxed);
+    const uint32_t read = readIndex_.load(std::memory_order_acquire);
+    const size_t freeSpace = data_.size() - static_cast<uint32_t>(write - read);
+    count = std::min(count, freeSpace);
+
+    // Copy in at most two contiguous pieces
+    const size_t start = write & mask_;
+    const size_t first = std::min(count, data_.size() - start);
+    std::memcpy(&data_[start], data, first * sizeof(float));
+    std::memcpy(&data_[0], data + first, (count - first) * sizeof(float));
+
+    writeIndex_.store(write + static_cast<uint32_t>(count), std::memory_order_release);
+    return count;
+}
+
+size_t SpscRingBuffer::read(float* out, size_t count) {
+    const uint32_t read = readIndex_.load(std::memory_order_relaxed);
+    const uint32_t write = writeIndex_.load(std::memory_order_acquire);
+    count = std::min(count, static_cast<size_t>(static_cast<uint32_t>(write - read)));
+
+    const size_t start = read & mask_;
+    const size_t first = std::min(count, data_.size() - start);
+    std::memcpy(out, &data_[start], first * sizeof(float));
+    std::memcpy(out + first, &data_[0], (count - first) * sizeof(float));
+
+    readIndex_.store(read + static_cast<uint32_t>(count), std::memory_order_release);
+    return count;
+}
+
+bool SpscRingBuffer::readExact(float* out, size_t count) {
+    if (available() < count) return false;
+    read(out, count);
+    return true;
+}
+
+size_t SpscRingBuffer::available() const {
+    const uint32_t write = writeIndex_.load(std::memory_order_acquire);
+    const uint32_t read = readIndex_.load(std::memory_order_relaxed);
+    return static_cast<uint32_t>(write - read);
+}
+
+// Producer side: acquire the consumer's index (paired with the release store
+// in read(), or Atomics.store from JS) so its reads of the freed slots are
+// complete before the producer overwrites them
+size_t SpscRingBuffer::space() const {
+    const uint32_t write = writeIndex_.load(std::memory_order_relaxed);
+    const uint32_t read = readIndex_.load(std::memory_order_acquire);
+    return data_.size() - static_cast<uint32_t>(write - read);
+}
+
+void SpscRingBuffer::reset() {
+    writeIndex_.store(0, std::memory_order_relaxed);
+    readIndex_.store(0, std::memory_order_relaxed);
+}
+
+StreamingAnalyzer::StreamingAnalyzer(size_t fftSize, size_t hopSize,
+                                     size_t inputCapacity, size_t resultRecords,
+                                     StreamInputMode mode)
+    : fft_(fftSize)
+    , analyzer_()
+    , input_(inputCapacity)
+    , results_(resultRecords * StreamResultLayout::STRIDE)
+    , mode_(mode)
+    , hopSize_(std::clamp(hopSize, size_t(1), fft_.getFftSize()))
+    , frame_(mode == StreamInputMode::PCM ? fft_.getFftSize() : fft_.getBinCount(), 0.0f)
+    , sequence_(0)
+    , droppedResults_(0)
+{
+}
+
+size_t StreamingAnalyzer::getBlockSize() const {
+    return mode_ == StreamInputMode::PCM ? hopSize_ : fft_.getBinCount();
+}
+
+size_t StreamingAnalyzer::process(size_t maxBlocks) {
+    const size_t blockSize = getBlockSize();
+    size_t written = 0;
+
+    for (size_t block = 0; block < maxBlocks && input_.available() >= blockSize; block++) {
+        AudioAnalysisResult result;
+
+        if (mode_ == StreamInputMode::PCM) {
+            // Slide the window by one hop and append the new samples
+            std::memmove(frame_.data(), frame_.data() + hopSize_,
+                         (frame_.size() - hopSize_) * sizeof(float));
+            input_.read(frame_.data() + frame_.size() - hopSize_, hopSize_);
+            result = fft_.analyze(frame_.data(), analyzer_);
+        } else {
+            input_.read(frame_.data(), blockSize);
+            result = analyzer_.analyzeFrequenciesFloat(frame_.data(), blockSize, true);
+        }
+
+        float record[StreamResultLayout::STRIDE] = {};
+        const uint32_t sequence = sequence_++;
+        std::memcpy(&record[StreamResultLayout::SEQUENCE], &sequence, sizeof(sequence));
+        record[StreamResultLayout::BASS] = result.bass;
+        record[StreamResultLayout::MID] = result.mid;
+        record[StreamResultLayout::TREBLE] = result.treble;
+        record[StreamResultLayout::VOLUME] = result.volume;
+
+        // Never block on a slow UI: drop the result if its ring is full
+        if (results_.space() >= StreamResultLayout::STRIDE) {
+            results_.write(record, StreamResultLayout::STRIDE);
+            written++;
+        } else {
+            droppedResults_++;
+        }
+    }
+
+    return written;
+}
+
+} // namespace aeronav
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "audio_fft.hpp"
+#include "arena.hpp"
+#include "spectrum_fft.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace aeronav {
+
+/**
+ * Lock-free single-producer/single-consumer float ring buffer
+ *
+ * Read/write indices are free-running uint32 counters (wrapping is fine since
+ * capacity is a power of two). Both live in WASM linear memory, so with a
+ * SharedArrayBuffer-backed heap the other side can be driven from JS with
+ * Atomics.load/Atomics.store on HEAPU32 at writeIndexAddress()/readIndexAddress().
+ */
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(size_t capacity);
+
+    // Producer side: copies up to `count` floats, returns how many were written
+    size_t write(const float* data, size_t count);
+
+    // Consumer side: copies up to `count` floats, returns how many were read
+    size_t read(float* out, size_t count);
+
+    // Consumer side: reads exactly `count` floats or nothing
+    bool readExact(float* out, size_t count);
+
+    size_t available() const;   // consumer side: floats ready to read
+    size_t space() const;       // producer side: floats free to write
+    size_t capacity() const { return data_.size(); }
+    void reset();
+
+    // Raw layout for the JS side of the ring
+    float* dataAddress() { return data_.data(); }
+    uint32_t* writeIndexAddress() { return reinterpret_cast<uint32_t*>(&writeIndex_); }
+    uint32_t* readIndexAddress() { return reinterpret_cast<uint32_t*>(&readIndex_); }
+
+private:
+    ArenaVector<float> data_;
+    uint32_t mask_;
+
+    // Separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<uint32_t> writeIndex_;
+    alignas(64) std::atomic<uint32_t> readIndex_;
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "ring indices must be plain 32-bit words");
+};
+
+// What the producer (AudioWorklet) writes into the input ring
+enum class StreamInputMode : uint8_t {
+    PCM = 0,       // mono samples (-1 to 1), analyzed by the native FFT stage
+    SPECTRUM = 1   // normalized spectra (0-1), one getBinCount()-sized block per hop
+};
+
+// Result record layout in the output ring (32-bit words per record)
+struct StreamResultLayout {
+    static constexpr size_t SEQUENCE = 0;   // hop counter, uint32 bits (exact past 2^24 hops)
+    static constexpr size_t BASS = 1;
+    static constexpr size_t MID = 2;
+    static constexpr size_t TREBLE = 3;
+    static constexpr size_t VOLUME = 4;
+    static constexpr size_t STRIDE = 8;     // 5-7 reserved
+};
+
+/**
+ * Streaming band analysis between two SPSC rings
+ * Consumes hop-sized blocks from the input ring and writes one
+ * StreamResultLayout record per hop into the result ring, which the UI
+ * drains without blocking. Allocation-free after construction.
+ */
+class StreamingAnalyzer {
+public:
+    StreamingAnalyzer(size_t fftSize = 2048, size_t hopSize = 512,
+                      size_t inputCapacity = 16384, size_t resultRecords = 256,
+                      StreamInputMode mode = StreamInputMode::PCM);
+
+    // Process up to maxBlocks available hops; returns the number of results written
+    size_t process(size_t maxBlocks = SIZE_MAX);
+
+    SpscRingBuffer& input() { return input_; }
+    SpscRingBuffer& results() { return results_; }
+
+    StreamInputMode getMode() const { return mode_; }
+    size_t getHopSize() const { return hopSize_; }
+    size_t getBlockSize() const;   // floats consumed per hop from the input ring
+    uint32_t getSequence() const { return sequence_; }
+    uint32_t getDroppedResults() const { return droppedResults_; }
+
+    SpectrumFFT& fft() { return fft_; }
+    AudioFFTAnalyzer& analyzer() { return analyzer_; }
+
+private:
+    SpectrumFFT fft_;
+    AudioFFTAnalyzer analyzer_;
+    SpscRingBuffer input_;
+    SpscRingBuffer results_;
+    StreamInputMode mode_;
+    size_t hopSize_;
+
+    ArenaVector<float> frame_;   // sliding PCM window (fftSize) or one spectrum block
+    uint32_t sequence_;
+    uint32_t droppedResults_;
+};
+
+} // namespace aeronav
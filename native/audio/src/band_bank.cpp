@@ -0,0 +1,234 @@
+#include "band_bank.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace aeronav {
+
+namespace {
+
+// Running flux average rate (about a 10 frame window)
+constexpr float FLUX_AVERAGE_RATE = 0.1f;
+
+float toScale(float hz, BandScale scale) {
+    return scale == BandScale::MEL ? 2595.0f * std::log10(1.0f + hz / 700.0f) : std::log(hz);
+}
+
+float fromScale(float value, BandScale scale) {
+    return scale == BandScale::MEL ? 700.0f * (std::pow(10.0f, value / 2595.0f) - 1.0f) : std::exp(value);
+}
+
+} // namespace
+
+BandBank::BandBank()
+    : bandCount_(0)
+    , binCount_(0)
+    , smoothing_(0.5f)
+    , peakDecay_(0.95f)
+    , onsetRatio_(1.5f)
+    , onsetMinFlux_(0.02f)
+    , fluxAverage_(0.0f)
+    , noiseBegin_(0)
+    , noiseEnd_(0)
+    , noiseHigh_(0.4f)   // the JS classification: bass > 0.4 is HIGH_NOISE
+    , noiseLow_(0.4f)
+    , noiseState_(NoiseState::LOW_NOISE)
+    , detector_{0.0f, 0.0f, 0.0f, 0.0f}
+{
+    configure(24, 1024, 44100.0f, 40.0f, 16000.0f, BandScale::LOG);
+}
+
+bool BandBank::configure(size_t bandCount, size_t binCount, float sampleRate, float minHz, float maxHz,
+                         BandScale scale) {
+    if (bandCount == 0 || bandCount > MAX_BANDS || binCount == 0 || !(sampleRate > 0.0f)) {
+        return false;
+    }
+    const float nyquist = sampleRate * 0.5f;
+    maxHz = std::min(maxHz, nyquist);
+    if (!(minHz >= 0.0f) || !(maxHz > minHz) || (scale == BandScale::LOG && minHz <= 0.0f)) {
+        return false;
+    }
+
+    // Edges evenly spaced on the scale, then widened so every band owns a bin
+    const float binHz = nyquist / static_cast<float>(binCount);
+    const float low = toScale(minHz, scale);
+    const float high = toScale(maxHz, scale);
+    ArenaVector<uint32_t> edges(bandCount + 1);
+    edges[0] = static_cast<uint32_t>(std::lround(minHz / binHz));
+    for (size_t b = 1; b <= bandCount; b++) {
+        const float hz = fromScale(low + (high - low) * static_cast<float>(b) / static_cast<float>(bandCount), scale);
+        const uint32_t edge = static_cast<uint32_t>(std::lround(hz / binHz));
+        edges[b] = std::max(edge, edges[b - 1] + 1);
+    }
+    if (edges[bandCount] > binCount) return false;
+
+    bandCount_ = bandCount;
+    binCount_ = binCount;
+    edges_ = std::move(edges);
+    invWidth_.resize(bandCount);
+    centers_.resize(bandCount);
+    for (size_t b = 0; b < bandCount; b++) {
+        invWidth_[b] = 1.0f / static_cast<float>(edges_[b + 1] - edges_[b]);
+        centers_[b] = 0.5f * static_cast<float>(edges_[b] + edges_[b + 1]) * binHz;
+    }
+
+    // Default noise bands: those below 10% of Nyquist, the JS "bass" band
+    noiseBegin_ = 0;
+    noiseEnd_ = 1;
+    while (noiseEnd_ < bandCount && centers_[noiseEnd_] < 0.1f * nyquist) noiseEnd_++;
+
+    const size_t padded = (bandCount + 3) & ~size_t(3);
+    byteSums_.resize(padded);
+    raw_.resize(padded);
+    previous_.resize(padded);
+    bands_.resize(padded);
+    peaks_.resize(padded);
+    reset();
+    return true;
+}
+
+void BandBank::setSmoothing(float timeConstant) {
+    smoothing_ = std::clamp(timeConstant, 0.0f, 0.99f);
+}
+
+void BandBank::setPeakDecay(float decay) {
+    peakDecay_ = std::clamp(decay, 0.0f, 1.0f);
+}
+
+void BandBank::setOnsetThreshold(float ratio, float minFlux) {
+    onsetRatio_ = std::max(ratio, 0.0f);
+    onsetMinFlux_ = std::max(minFlux, 0.0f);
+}
+
+void BandBank::setNoiseBands(size_t begin, size_t end) {
+    end = std::clamp(end, size_t(1), bandCount_);
+    noiseBegin_ = std::min(begin, end - 1);
+    noiseEnd_ = end;
+}
+
+void BandBank::setNoiseThresholds(float high, float low) {
+    noiseHigh_ = high;
+    noiseLow_ = std::min(low, high);
+}
+
+void BandBank::reset() {
+    std::fill(byteSums_.begin(), byteSums_.end(), 0u);
+    std::fill(raw_.begin(), raw_.end(), 0.0f);
+    std::fill(previous_.begin(), previous_.end(), 0.0f);
+    std::fill(bands_.begin(), bands_.end(), 0.0f);
+    std::fill(peaks_.begin(), peaks_.end(), 0.0f);
+    fluxAverage_ = 0.0f;
+    noiseState_ = NoiseState::LOW_NOISE;
+    std::fill(detector_, detector_ + BandDetectorLayout::STRIDE, 0.0f);
+}
+
+void BandBank::process(const uint8_t* spectrum, size_t length) {
+    if (spectrum == nullptr || length == 0) return;
+
+    AERONAV_PROFILE_SCOPE(AUDIO_BANDS);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, length);
+
+    sumBandRangesUint8(spectrum, length, edges_.data(), bandCount_, byteSums_.data());
+    for (size_t b = 0; b < bandCount_; b++) {
+        raw_[b] = static_cast<float>(byteSums_[b]) * invWidth_[b] * (1.0f / 255.0f);
+    }
+    update();
+}
+
+void BandBank::processFloat(const float* spectrum, size_t length, bool normalized) {
+    if (spectrum == nullptr || length == 0) return;
+
+    AERONAV_PROFILE_SCOPE(AUDIO_BANDS);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, length);
+
+    // Same mapping as analyzeFrequenciesFloat: -1 to 1 becomes (x + 1) * 0.5
+    const float offset = normalized ? 0.0f : 1.0f;
+    const float scale = normalized ? 1.0f : 0.5f;
+    sumBandRangesFloat(spectrum, length, edges_.data(), bandCount_, offset, scale, raw_.data());
+    for (size_t b = 0; b < bandCount_; b++) {
+        raw_[b] *= invWidth_[b];
+    }
+    update();
+}
+
+void BandBank::update() {
+    // Padding bands stay zero, so the vector loops need no tail
+    const size_t padded = raw_.size();
+    const float keep = smoothing_;
+    const float take = 1.0f - smoothing_;
+    float flux = 0.0f;
+    size_t i = 0;
+
+#if USE_SSE
+    const __m128 vKeep = _mm_set1_ps(keep);
+    const __m128 vTake = _mm_set1_ps(take);
+    const __m128 vDecay = _mm_set1_ps(peakDecay_);
+    const __m128 vZero = _mm_setzero_ps();
+    __m128 fluxAcc = _mm_setzero_ps();
+
+    for (; i + 4 <= padded; i += 4) {
+        const __m128 raw = _mm_loadu_ps(&raw_[i]);
+        fluxAcc = _mm_add_ps(fluxAcc, _mm_max_ps(_mm_sub_ps(raw, _mm_loadu_ps(&previous_[i])), vZero));
+        _mm_storeu_ps(&previous_[i], raw);
+        const __m128 band = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&bands_[i]), vKeep), _mm_mul_ps(raw, vTake));
+        _mm_storeu_ps(&bands_[i], band);
+        _mm_storeu_ps(&peaks_[i], _mm_max_ps(band, _mm_mul_ps(_mm_loadu_ps(&peaks_[i]), vDecay)));
+    }
+
+    alignas(16) float fluxLanes[4];
+    _mm_store_ps(fluxLanes, fluxAcc);
+    flux = fluxLanes[0] + fluxLanes[1] + fluxLanes[2] + fluxLanes[3];
+
+#elif USE_WASM_SIMD
+    const v128_t vKeep = wasm_f32x4_splat(keep);
+    const v128_t vTake = wasm_f32x4_splat(take);
+    const v128_t vDecay = wasm_f32x4_splat(peakDecay_);
+    const v128_t vZero = wasm_f32x4_splat(0.0f);
+    v128_t fluxAcc = wasm_f32x4_splat(0.0f);
+
+    for (; i + 4 <= padded; i += 4) {
+        const v128_t raw = wasm_v128_load(&raw_[i]);
+        fluxAcc = wasm_f32x4_add(fluxAcc, wasm_f32x4_pmax(wasm_f32x4_sub(raw, wasm_v128_load(&previous_[i])), vZero));
+        wasm_v128_store(&previous_[i], raw);
+        const v128_t band = wasm_f32x4_add(wasm_f32x4_mul(wasm_v128_load(&bands_[i]), vKeep),
+                                           wasm_f32x4_mul(raw, vTake));
+        wasm_v128_store(&bands_[i], band);
+        wasm_v128_store(&peaks_[i], wasm_f32x4_pmax(band, wasm_f32x4_mul(wasm_v128_load(&peaks_[i]), vDecay)));
+    }
+
+    float fluxLanes[4];
+    wasm_v128_store(fluxLanes, fluxAcc);
+    flux = fluxLanes[0] + fluxLanes[1] + fluxLanes[2] + fluxLanes[3];
+#endif
+
+    // Scalar fallback
+    for (; i < padded; i++) {
+        flux += std::max(raw_[i] - previous_[i], 0.0f);
+        previous_[i] = raw_[i];
+        bands_[i] = bands_[i] * keep + raw_[i] * take;
+        peaks_[i] = std::max(bands_[i], peaks_[i] * peakDecay_);
+    }
+    flux /= static_cast<float>(bandCount_);
+
+    // Detectors read the raw levels: smoothing is for display
+    float noise = 0.0f;
+    for (size_t b = noiseBegin_; b < noiseEnd_; b++) noise += raw_[b];
+    noise /= static_cast<float>(noiseEnd_ - noiseBegin_);
+    if (noiseState_ == NoiseState::LOW_NOISE && noise > noiseHigh_) {
+        noiseState_ = NoiseState::HIGH_NOISE;
+    } else if (noiseState_ == NoiseState::HIGH_NOISE && noise <= noiseLow_) {
+        noiseState_ = NoiseState::LOW_NOISE;
+    }
+
+    const bool onset = flux > fluxAverage_ * onsetRatio_ + onsetMinFlux_;
+    fluxAverage_ += (flux - fluxAverage_) * FLUX_AVERAGE_RATE;
+
+    detector_[BandDetectorLayout::NOISE_LEVEL] = noise;
+    detector_[BandDetectorLayout::FLUX] = flux;
+    detector_[BandDetectorLayout::ONSET] = onset ? 1.0f : 0.0f;
+    detector_[BandDetectorLayout::NOISE_STATE] = noiseState_ == NoiseState::HIGH_NOISE ? 1.0f : 0.0f;
+}
+
+} // namespace aeronav
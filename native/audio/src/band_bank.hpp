@@ -0,0 +1,113 @@
+#pragma once
+
+#include "audio_fft.hpp"
+#include "arena.hpp"
+#include "noise_state.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace aeronav {
+
+// Band edge spacing
+enum class BandScale : uint8_t {
+    LOG = 0,
+    MEL = 1
+};
+
+// Detector record (float offsets), refreshed by every process()
+struct BandDetectorLayout {
+    static constexpr size_t NOISE_LEVEL = 0;   // mean raw level of the noise bands (0-1)
+    static constexpr size_t FLUX = 1;          // mean positive rise of the raw bands since the last frame
+    static constexpr size_t ONSET = 2;         // 1 when flux jumped above its running average
+    static constexpr size_t NOISE_STATE = 3;   // NoiseState as 0 / 1
+    static constexpr size_t STRIDE = 4;
+};
+
+/**
+ * Bank of N log- or mel-spaced frequency bands over a byte (AnalyserNode) or
+ * float spectrum, with temporal smoothing, peak hold and an onset / noise
+ * level detector that yields the NoiseState the RL system consumes.
+ *
+ * configure() builds the bin-to-band edge table; process() sums every band
+ * in one ascending SIMD sweep and updates the smoothed bands, peaks and
+ * detector in place, so no per-bin work is left to the caller.
+ */
+class BandBank {
+public:
+    static constexpr size_t MAX_BANDS = 256;
+
+    // 24 log bands, 40 Hz - 16 kHz, over 1024 bins of a 44.1 kHz spectrum
+    BandBank();
+
+    /**
+     * Lay out bandCount bands between minHz and maxHz (clamped to Nyquist)
+     * over binCount bins. Every band covers at least one bin. Returns false
+     * and keeps the previous layout if the bands do not fit.
+     */
+    bool configure(size_t bandCount, size_t binCount, float sampleRate, float minHz, float maxHz,
+                   BandScale scale = BandScale::LOG);
+
+    size_t getBandCount() const { return bandCount_; }
+    size_t getBinCount() const { return binCount_; }
+
+    // Weight of the previous frame in the smoothed bands (0 = none, like AnalyserNode)
+    void setSmoothing(float timeConstant);
+    // Per-frame multiplier applied to held peaks before they are compared to the bands
+    void setPeakDecay(float decay);
+    // Onset when flux > average * ratio + minFlux
+    void setOnsetThreshold(float ratio, float minFlux);
+    // Bands [begin, end) whose mean raw level drives the noise state
+    void setNoiseBands(size_t begin, size_t end);
+    // HIGH_NOISE above `high`, back to LOW_NOISE at or below `low` (equal = no hysteresis)
+    void setNoiseThresholds(float high, float low);
+    void reset();
+
+    // Analyze one AnalyserNode byte spectrum (0-255)
+    void process(const uint8_t* spectrum, size_t length);
+    // Analyze one float spectrum (0-1, or -1 to 1 when not normalized)
+    void processFloat(const float* spectrum, size_t length, bool normalized = true);
+
+    const float* getBands() const { return bands_.data(); }
+    const float* getPeaks() const { return peaks_.data(); }
+    const float* getRawBands() const { return raw_.data(); }
+    const uint32_t* getBandEdges() const { return edges_.data(); }     // bandCount + 1 bins
+    const float* getBandCenters() const { return centers_.data(); }    // Hz
+    const float* getDetector() const { return detector_; }
+
+    float getNoiseLevel() const { return detector_[BandDetectorLayout::NOISE_LEVEL]; }
+    float getFlux() const { return detector_[BandDetectorLayout::FLUX]; }
+    bool isOnset() const { return detector_[BandDetectorLayout::ONSET] != 0.0f; }
+    NoiseState getNoiseState() const { return noiseState_; }
+
+private:
+    size_t bandCount_;
+    size_t binCount_;
+    float smoothing_;
+    float peakDecay_;
+    float onsetRatio_;
+    float onsetMinFlux_;
+    float fluxAverage_;
+    size_t noiseBegin_;
+    size_t noiseEnd_;
+    float noiseHigh_;
+    float noiseLow_;
+    NoiseState noiseState_;
+    float detector_[BandDetectorLayout::STRIDE];
+
+    // Tables from configure()
+    ArenaVector<uint32_t> edges_;
+    ArenaVector<float> invWidth_;
+    ArenaVector<float> centers_;
+
+    // Per-band state, padded to a multiple of 4 with zero bands
+    ArenaVector<uint32_t> byteSums_;
+    ArenaVector<float> raw_;
+    ArenaVector<float> previous_;
+    ArenaVector<float> bands_;
+    ArenaVector<float> peaks_;
+
+    // raw_ holds this frame's 0-1 levels; update the rest from it
+    void update();
+};
+
+} // namespace aeronav
@@ -0,0 +1,235 @@
+#include "spectrum_fft.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace aeronav {
+
+namespace {
+const float PI = 3.14159265358979f;
+}
+
+SpectrumFFT::SpectrumFFT(size_t fftSize, WindowType window)
+    : fftSize_(0)
+    , log2Half_(0)
+    , window_(window)
+    , smoothing_(0.8f)
+    , minDecibels_(-100.0f)
+    , maxDecibels_(-30.0f)
+{
+    if (!setFftSize(fftSize)) {
+        setFftSize(2048);
+    }
+}
+
+bool SpectrumFFT::setFftSize(size_t fftSize) {
+    if (fftSize < 32 || fftSize > 32768 || (fftSize & (fftSize - 1)) != 0) {
+        return false;
+    }
+
+    fftSize_ = fftSize;
+    const size_t half = fftSize / 2;
+    log2Half_ = 0;
+    while ((size_t(1) << log2Half_) < half) log2Half_++;
+
+    // Bit-reversal permutation for the half-size complex FFT
+    bitReverse_.resize(half);
+    for (size_t i = 0; i < half; i++) {
+        uint32_t reversed = 0;
+        for (size_t bit = 0; bit < log2Half_; bit++) {
+            if (i & (size_t(1) << bit)) reversed |= 1u << (log2Half_ - 1 - bit);
+        }
+        bitReverse_[i] = reversed;
+    }
+
+    // Per-stage twiddles W = exp(-i*pi*j/h) for butterfly half-size h, concatenated
+    stageCos_.resize(half);
+    stageSin_.resize(half);
+    size_t offset = 0;
+    for (size_t h = 1; h < half; h *= 2) {
+        for (size_t j = 0; j < h; j++) {
+            double angle = -3.14159265358979323846 * static_cast<double>(j) / static_cast<double>(h);
+            stageCos_[offset + j] = static_cast<float>(std::cos(angle));
+            stageSin_[offset + j] = static_cast<float>(std::sin(angle));
+        }
+        offset += h;
+    }
+
+    // Split twiddles for recovering the real-input spectrum
+    splitCos_.resize(half);
+    splitSin_.resize(half);
+    for (size_t k = 0; k < half; k++) {
+        double angle = 2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(fftSize);
+        splitCos_[k] = static_cast<float>(std::cos(angle));
+        splitSin_[k] = static_cast<float>(std::sin(angle));
+    }
+
+    re_.assign(half, 0.0f);
+    im_.assign(half, 0.0f);
+    magnitudes_.assign(half, 0.0f);
+    byteSpectrum_.assign(half, 0);
+
+    buildWindow();
+    return true;
+}
+
+void SpectrumFFT::setWindow(WindowType window) {
+    window_ = window;
+    buildWindow();
+}
+
+void SpectrumFFT::buildWindow() {
+    windowTable_.resize(fftSize_);
+    for (size_t n = 0; n < fftSize_; n++) {
+        float phase = 2.0f * PI * static_cast<float>(n) / static_cast<float>(fftSize_);
+        switch (window_) {
+            case WindowType::HANN:
+                windowTable_[n] = 0.5f * (1.0f - std::cos(phase));
+                break;
+            case WindowType::BLACKMAN:
+                // alpha = 0.16 (same as AnalyserNode)
+                windowTable_[n] = 0.42f - 0.5f * std::cos(phase) + 0.08f * std::cos(2.0f * phase);
+                break;
+            case WindowType::RECTANGULAR:
+            default:
+                windowTable_[n] = 1.0f;
+                break;
+        }
+    }
+}
+
+void SpectrumFFT::setSmoothing(float timeConstant) {
+    smoothing_ = std::clamp(timeConstant, 0.0f, 1.0f);
+}
+
+void SpectrumFFT::setDecibelRange(float minDecibels, float maxDecibels) {
+    if (maxDecibels > minDecibels) {
+        minDecibels_ = minDecibels;
+        maxDecibels_ = maxDecibels;
+    }
+}
+
+void SpectrumFFT::resetSmoothing() {
+    std::fill(magnitudes_.begin(), magnitudes_.end(), 0.0f);
+}
+
+void SpectrumFFT::complexFFT() {
+    const size_t half = fftSize_ / 2;
+    float* re = re_.data();
+    float* im = im_.data();
+    size_t offset = 0;
+
+    for (size_t h = 1; h < half; h *= 2) {
+        const float* wr = &stageCos_[offset];
+        const float* wi = &stageSin_[offset];
+
+        for (size_t group = 0; group < half; group += 2 * h) {
+            float* aRe = re + group;
+            float* aIm = im + group;
+            float* bRe = aRe + h;
+            float* bIm = aIm + h;
+            size_t j = 0;
+
+#if USE_WASM_SIMD
+            // 4 butterflies at a time once the half-size allows it
+            for (; j + 4 <= h; j += 4) {
+                v128_t cr = wasm_v128_load(&wr[j]);
+                v128_t ci = wasm_v128_load(&wi[j]);
+                v128_t br = wasm_v128_load(&bRe[j]);
+                v128_t bi = wasm_v128_load(&bIm[j]);
+                v128_t tr = wasm_f32x4_sub(wasm_f32x4_mul(br, cr), wasm_f32x4_mul(bi, ci));
+                v128_t ti = wasm_f32x4_add(wasm_f32x4_mul(br, ci), wasm_f32x4_mul(bi, cr));
+                v128_t ar = wasm_v128_load(&aRe[j]);
+                v128_t ai = wasm_v128_load(&aIm[j]);
+                wasm_v128_store(&bRe[j], wasm_f32x4_sub(ar, tr));
+                wasm_v128_store(&bIm[j], wasm_f32x4_sub(ai, ti));
+                wasm_v128_store(&aRe[j], wasm_f32x4_add(ar, tr));
+                wasm_v128_store(&aIm[j], wasm_f32x4_add(ai, ti));
+            }
+#elif USE_SSE
+            // 4 butterflies at a time once the half-size allows it
+            for (; j + 4 <= h; j += 4) {
+                __m128 cr = _mm_loadu_ps(&wr[j]);
+                __m128 ci = _mm_loadu_ps(&wi[j]);
+                __m128 br = _mm_loadu_ps(&bRe[j]);
+                __m128 bi = _mm_loadu_ps(&bIm[j]);
+                __m128 tr = _mm_sub_ps(_mm_mul_ps(br, cr), _mm_mul_ps(bi, ci));
+                __m128 ti = _mm_add_ps(_mm_mul_ps(br, ci), _mm_mul_ps(bi, cr));
+                __m128 ar = _mm_loadu_ps(&aRe[j]);
+                __m128 ai = _mm_loadu_ps(&aIm[j]);
+                _mm_storeu_ps(&bRe[j], _mm_sub_ps(ar, tr));
+                _mm_storeu_ps(&bIm[j], _mm_sub_ps(ai, ti));
+                _mm_storeu_ps(&aRe[j], _mm_add_ps(ar, tr));
+                _mm_storeu_ps(&aIm[j], _mm_add_ps(ai, ti));
+            }
+#endif
+
+            // Scalar butterflies (early stages and fallback)
+            for (; j < h; j++) {
+                float tr = bRe[j] * wr[j] - bIm[j] * wi[j];
+                float ti = bRe[j] * wi[j] + bIm[j] * wr[j];
+                bRe[j] = aRe[j] - tr;
+                bIm[j] = aIm[j] - ti;
+                aRe[j] += tr;
+                aIm[j] += ti;
+            }
+        }
+        offset += h;
+    }
+}
+
+void SpectrumFFT::process(const float* pcm) {
+    AERONAV_PROFILE_SCOPE(AUDIO_FFT);
+    const size_t half = fftSize_ / 2;
+
+    // Window and pack even/odd samples as one half-size complex sequence,
+    // written directly in bit-reversed order
+    const float* w = windowTable_.data();
+    for (size_t n = 0; n < half; n++) {
+        size_t src = 2 * static_cast<size_t>(bitReverse_[n]);
+        re_[n] = pcm[src] * w[src];
+        im_[n] = pcm[src + 1] * w[src + 1];
+    }
+
+    complexFFT();
+
+    // Split into the real-input spectrum, then smooth and convert to bytes
+    // (AnalyserNode: |X| / N, exponential smoothing, linear dB-to-byte mapping)
+    const float invSize = 1.0f / static_cast<float>(fftSize_);
+    const float tau = smoothing_;
+    const float byteScale = 255.0f / (maxDecibels_ - minDecibels_);
+
+    for (size_t k = 0; k < half; k++) {
+        size_t mirror = (half - k) & (half - 1);
+        float ar = re_[k], ai = im_[k];
+        float br = re_[mirror], bi = im_[mirror];
+
+        // Even / odd sample spectra
+        float er = 0.5f * (ar + br);
+        float ei = 0.5f * (ai - bi);
+        float orr = 0.5f * (ai + bi);
+        float oi = -0.5f * (ar - br);
+
+        float c = splitCos_[k], s = splitSin_[k];
+        float xr = er + c * orr + s * oi;
+        float xi = ei + c * oi - s * orr;
+
+        float magnitude = std::sqrt(xr * xr + xi * xi) * invSize;
+        float smoothed = tau * magnitudes_[k] + (1.0f - tau) * magnitude;
+        magnitudes_[k] = smoothed;
+
+        float byteValue = 0.0f;
+        if (smoothed > 0.0f) {
+            float db = 20.0f * std::log10(smoothed);
+            byteValue = std::clamp(std::floor(byteScale * (db - minDecibels_)), 0.0f, 255.0f);
+        }
+        byteSpectrum_[k] = static_cast<uint8_t>(byteValue);
+    }
+}
+
+AudioAnalysisResult SpectrumFFT::analyze(const float* pcm, AudioFFTAnalyzer& analyzer) {
+    process(pcm);
+    return analyzer.analyzeFrequencies(byteSpectrum_.data(), getBinCount());
+}
+
+} // namespace aeronav
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "audio_fft.hpp"
+#include "arena.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace aeronav {
+
+// Analysis window applied to each PCM frame
+enum class WindowType : uint8_t {
+    RECTANGULAR = 0,
+    HANN = 1,
+    BLACKMAN = 2
+};
+
+/**
+ * Real-input radix-2 FFT for raw PCM frames
+ * Produces smoothed magnitudes and AnalyserNode-compatible byte spectra
+ * (getByteFrequencyData scaling), so frames from an AudioWorklet can feed
+ * AudioFFTAnalyzer without a main-thread AnalyserNode.
+ *
+ * Twiddle, bit-reversal and window tables are built in setFftSize();
+ * process() does not allocate.
+ */
+class SpectrumFFT {
+public:
+    explicit SpectrumFFT(size_t fftSize = 2048, WindowType window = WindowType::BLACKMAN);
+
+    // FFT size must be a power of two in [32, 32768]; returns false otherwise
+    bool setFftSize(size_t fftSize);
+    size_t getFftSize() const { return fftSize_; }
+    size_t getBinCount() const { return fftSize_ / 2; }
+
+    void setWindow(WindowType window);
+    WindowType getWindow() const { return window_; }
+
+    // Matching AnalyserNode defaults: smoothing 0.8, range -100..-30 dB
+    void setSmoothing(float timeConstant);
+    void setDecibelRange(float minDecibels, float maxDecibels);
+    void resetSmoothing();
+
+    /**
+     * Transform one frame of getFftSize() PCM samples (-1 to 1)
+     * Updates getMagnitudes() and getByteSpectrum()
+     */
+    void process(const float* pcm);
+
+    // Transform one frame and run band analysis on the resulting byte spectrum
+    AudioAnalysisResult analyze(const float* pcm, AudioFFTAnalyzer& analyzer);
+
+    const float* getMagnitudes() const { return magnitudes_.data(); }
+    const uint8_t* getByteSpectrum() const { return byteSpectrum_.data(); }
+
+private:
+    size_t fftSize_;
+    size_t log2Half_;
+    WindowType window_;
+    float smoothing_;
+    float minDecibels_;
+    float maxDecibels_;
+
+    // Precomputed tables
+    ArenaVector<float> windowTable_;
+    ArenaVector<uint32_t> bitReverse_;   // half-size permutation
+    ArenaVector<float> stageCos_;        // per-stage twiddles, concatenated
+    ArenaVector<float> stageSin_;
+    ArenaVector<float> splitCos_;        // real-FFT split twiddles
+    ArenaVector<float> splitSin_;
+
+    // Working buffers (split complex, half size)
+    ArenaVector<float> re_;
+    ArenaVector<float> im_;
+
+    // Outputs
+    ArenaVector<float> magnitudes_;
+    ArenaVector<uint8_t> byteSpectrum_;
+
+    void buildWindow();
+    void complexFFT();
+};
+
+} // namespace aeronav
@@ -0,0 +1,239 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <thread>
+
+// Global allocation counting: every operator new in the binary (std::vector,
+// std::string, new, ArenaVector heap blocks, thread-pool tasks) goes through
+// these, so allocs/op covers the whole measured code, not just the arena
+namespace {
+
+std::atomic<uint64_t> globalAllocations{0};
+
+void* countedAlloc(std::size_t bytes) {
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(bytes == 0 ? 1 : bytes);
+}
+
+void* countedAlignedAlloc(std::size_t bytes, std::align_val_t align) {
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t alignment = std::max(static_cast<std::size_t>(align), sizeof(void*));
+    // aligned_alloc wants a size that is a multiple of the alignment
+    return std::aligned_alloc(alignment, (std::max<std::size_t>(bytes, 1) + alignment - 1) / alignment * alignment);
+}
+
+} // namespace
+
+void* operator new(std::size_t bytes) {
+    void* p = countedAlloc(bytes);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t bytes) { return ::operator new(bytes); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept { return countedAlloc(bytes); }
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept { return countedAlloc(bytes); }
+void* operator new(std::size_t bytes, std::align_val_t align) {
+    void* p = countedAlignedAlloc(bytes, align);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t bytes, std::align_val_t align) { return ::operator new(bytes, align); }
+void* operator new(std::size_t bytes, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(bytes, align);
+}
+void* operator new[](std::size_t bytes, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(bytes, align);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace aeronav {
+namespace bench {
+
+uint64_t processAllocations() { return globalAllocations.load(std::memory_order_relaxed); }
+
+namespace {
+
+std::vector<Benchmark*>& registry() {
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+struct Result {
+    std::string name;
+    std::string label;
+    uint64_t iterations;
+    double nsPerOp;
+    double itemsPerSecond;
+    double bytesPerSecond;
+    double heapAllocationsPerOp;
+    double arenaHeapAllocationsPerOp;
+};
+
+struct Options {
+    std::string filter;
+    std::string jsonPath;
+    double minTimeSeconds = 0.2;
+};
+
+const char* flagValue(const char* arg, const char* flag) {
+    const size_t length = std::strlen(flag);
+    return std::strncmp(arg, flag, length) == 0 ? arg + length : nullptr;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        if (const char* value = flagValue(argv[i], "--filter=")) {
+            options.filter = value;
+        } else if (const char* value = flagValue(argv[i], "--json=")) {
+            options.jsonPath = value;
+        } else if (const char* value = flagValue(argv[i], "--min-time=")) {
+            options.minTimeSeconds = std::atof(value);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--json=<path>|-]\n",
+                         argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string runName(const Benchmark& benchmark, const std::vector<int64_t>& args) {
+    std::string name = benchmark.name();
+    for (int64_t value : args) name += "/" + std::to_string(value);
+    return name;
+}
+
+// Grow the iteration count until one run lasts minTime, then report that run
+Result runOne(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTimeSeconds) {
+    const double minTimeNs = minTimeSeconds * 1e9;
+    uint64_t iterations = 1;
+    for (;;) {
+        State state(args, iterations);
+        benchmark.fn()(state);
+
+        const double elapsed = state.elapsedNs();
+        if (elapsed >= minTimeNs || iterations >= (uint64_t(1) << 40)) {
+            Result result;
+            result.name = runName(benchmark, args);
+            result.label = state.label();
+            result.iterations = iterations;
+            result.nsPerOp = elapsed / static_cast<double>(iterations);
+            const double seconds = elapsed * 1e-9;
+            result.itemsPerSecond = seconds > 0.0 ? state.itemsPerIteration() * iterations / seconds : 0.0;
+            result.bytesPerSecond = seconds > 0.0 ? state.bytesPerIteration() * iterations / seconds : 0.0;
+            result.heapAllocationsPerOp = static_cast<double>(state.heapAllocations()) / static_cast<double>(iterations);
+            result.arenaHeapAllocationsPerOp =
+                static_cast<double>(state.arenaHeapAllocations()) / static_cast<double>(iterations);
+            return result;
+        }
+
+        // Aim 40% past the target from the last run's rate, at most 10x more
+        const double perOp = elapsed > 0.0 ? elapsed / static_cast<double>(iterations) : 0.0;
+        uint64_t next = perOp > 0.0 ? static_cast<uint64_t>(minTimeNs * 1.4 / perOp) : iterations * 10;
+        next = std::min(std::max(next, iterations + 1), iterations * 10);
+        iterations = next;
+    }
+}
+
+void writeJsonString(FILE* out, const std::string& value) {
+    std::fputc('"', out);
+    for (char c : value) {
+        if (c == '"' || c == '\\') std::fputc('\\', out);
+        std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+void writeJson(FILE* out, const std::vector<Result>& results, const Options& options) {
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+#if defined(__EMSCRIPTEN__)
+    std::fprintf(out, "    \"platform\": \"wasm\",\n");
+#else
+    std::fprintf(out, "    \"platform\": \"native\",\n");
+#endif
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(out, "    \"min_time\": %g\n  },\n  \"benchmarks\": [\n", options.minTimeSeconds);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        std::fprintf(out, "    {\"name\": ");
+        writeJsonString(out, r.name);
+        std::fprintf(out, ", \"label\": ");
+        writeJsonString(out, r.label);
+        std::fprintf(out, ", \"iterations\": %llu, \"time_unit\": \"ns\", \"ns_per_op\": %.3f, "
+                          "\"items_per_second\": %.6g, \"bytes_per_second\": %.6g, \"heap_allocations_per_op\": %.6g, "
+                          "\"arena_heap_allocations_per_op\": %.6g}%s\n",
+                     static_cast<unsigned long long>(r.iterations), r.nsPerOp, r.itemsPerSecond,
+                     r.bytesPerSecond, r.heapAllocationsPerOp, r.arenaHeapAllocationsPerOp,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+Benchmark* registerBenchmark(const char* name, BenchmarkFn fn) {
+    registry().push_back(new Benchmark(name, fn));
+    return registry().back();
+}
+
+int runBenchmarks(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 2;
+
+    // Table to stderr when the JSON goes to stdout
+    FILE* table = options.jsonPath == "-" ? stderr : stdout;
+    std::fprintf(table, "%-48s %14s %14s %14s %10s\n", "benchmark", "ns/op", "items/s", "iterations", "allocs/op");
+
+    std::vector<Result> results;
+    for (const Benchmark* benchmark : registry()) {
+        std::vector<std::vector<int64_t>> argSets = benchmark->argSets();
+        if (argSets.empty()) argSets.push_back({});
+        for (const std::vector<int64_t>& args : argSets) {
+            if (!options.filter.empty() && runName(*benchmark, args).find(options.filter) == std::string::npos) continue;
+            const Result result = runOne(*benchmark, args, options.minTimeSeconds);
+            std::fprintf(table, "%-48s %14.1f %14.4g %14llu %10.3g%s%s\n", result.name.c_str(), result.nsPerOp,
+                         result.itemsPerSecond, static_cast<unsigned long long>(result.iterations),
+                         result.heapAllocationsPerOp, result.label.empty() ? "" : "  ", result.label.c_str());
+            std::fflush(table);
+            results.push_back(result);
+        }
+    }
+
+    if (options.jsonPath.empty()) return 0;
+    FILE* out = options.jsonPath == "-" ? stdout : std::fopen(options.jsonPath.c_str(), "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+    writeJson(out, results, options);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
+
+} // namespace bench
+} // namespace aeronav
+
+int main(int argc, char** argv) {
+    return aeronav::bench::runBenchmarks(argc, argv);
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "arena.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace aeronav {
+namespace bench {
+
+// Every global operator new in the bench binary (bench.cpp replaces them), any thread
+uint64_t processAllocations();
+
+/**
+ * Per-run state handed to a benchmark function (Google Benchmark style)
+ * Setup goes before the loop; only the `while (state.keepRunning())` body is
+ * timed. The runner calls the function with growing iteration counts until
+ * one run lasts at least the minimum time, then reports that run.
+ */
+class State {
+public:
+    State(const std::vector<int64_t>& args, uint64_t iterations)
+        : args_(args), iterations_(iterations), remaining_(iterations), itemsPerIteration_(1),
+          bytesPerIteration_(0), started_(false), elapsedNs_(0), startAllocations_(0), heapAllocations_(0),
+          startArenaAllocations_(0), arenaHeapAllocations_(0) {}
+
+    bool keepRunning() {
+        if (!started_) {
+            started_ = true;
+            resumeTiming();
+        }
+        if (remaining_ > 0) {
+            remaining_--;
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+
+    // Exclude per-iteration setup from the timing (and the allocation count)
+    void pauseTiming() {
+        elapsedNs_ += std::chrono::duration<double, std::nano>(Clock::now() - start_).count();
+        heapAllocations_ += processAllocations() - startAllocations_;
+        arenaHeapAllocations_ += getAllocationStats().heapAllocations - startArenaAllocations_;
+    }
+    void resumeTiming() {
+        startAllocations_ = processAllocations();
+        startArenaAllocations_ = getAllocationStats().heapAllocations;
+        start_ = Clock::now();
+    }
+
+    int64_t arg(size_t index = 0) const { return index < args_.size() ? args_[index] : 0; }
+    uint64_t iterations() const { return iterations_; }
+
+    // Items (bodies, bins, agents, ...) and bytes one iteration processes
+    void setItemsPerIteration(int64_t items) { itemsPerIteration_ = items; }
+    void setBytesPerIteration(int64_t bytes) { bytesPerIteration_ = bytes; }
+    void setLabel(const std::string& label) { label_ = label; }
+
+    int64_t itemsPerIteration() const { return itemsPerIteration_; }
+    int64_t bytesPerIteration() const { return bytesPerIteration_; }
+    const std::string& label() const { return label_; }
+    double elapsedNs() const { return elapsedNs_; }
+    uint64_t heapAllocations() const { return heapAllocations_; }             // operator new calls inside the timed loop
+    uint64_t arenaHeapAllocations() const { return arenaHeapAllocations_; }   // of which ArenaVector heap blocks
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<int64_t> args_;
+    uint64_t iterations_;
+    uint64_t remaining_;
+    int64_t itemsPerIteration_;
+    int64_t bytesPerIteration_;
+    std::string label_;
+    bool started_;
+    Clock::time_point start_;
+    double elapsedNs_;
+    uint64_t startAllocations_;
+    uint64_t heapAllocations_;
+    uint64_t startArenaAllocations_;
+    uint64_t arenaHeapAllocations_;
+};
+
+using BenchmarkFn = void (*)(State&);
+
+// One registered benchmark and its argument sets (a run per set)
+class Benchmark {
+public:
+    Benchmark(const char* name, BenchmarkFn fn) : name_(name), fn_(fn) {}
+
+    Benchmark* arg(int64_t value) { argSets_.push_back({value}); return this; }
+    Benchmark* args(std::initializer_list<int64_t> values) { argSets_.emplace_back(values); return this; }
+    // lo, lo * multiplier, ... and hi itself
+    Benchmark* range(int64_t lo, int64_t hi, int64_t multiplier = 10) {
+        for (int64_t value = lo; value < hi; value *= multiplier) arg(value);
+        return arg(hi);
+    }
+
+    const std::string& name() const { return name_; }
+    BenchmarkFn fn() const { return fn_; }
+    const std::vector<std::vector<int64_t>>& argSets() const { return argSets_; }
+
+private:
+    std::string name_;
+    BenchmarkFn fn_;
+    std::vector<std::vector<int64_t>> argSets_;
+};
+
+Benchmark* registerBenchmark(const char* name, BenchmarkFn fn);
+
+// Runs the registered benchmarks; flags: --filter=<substring> --min-time=<seconds>
+// --json=<path> (machine-readable results, "-" for stdout)
+int runBenchmarks(int argc, char** argv);
+
+// Keep a value (or the memory behind it) alive against dead-code elimination
+// (WASM has no inline asm: fall back to a volatile sink and a signal fence)
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+inline void clobberMemory() {
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+} // namespace bench
+} // namespace aeronav
+
+#define AERONAV_BENCH_CONCAT_(a, b) a##b
+#define AERONAV_BENCH_CONCAT(a, b) AERONAV_BENCH_CONCAT_(a, b)
+
+// AERONAV_BENCHMARK(BM_Name)->range(1, 100000);
+#define AERONAV_BENCHMARK(fn) \
+    static ::aeronav::bench::Benchmark* AERONAV_BENCH_CONCAT(benchmark_, __LINE__) = \
+        ::aeronav::bench::registerBenchmark(#fn, fn)
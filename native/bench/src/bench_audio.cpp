@@ -0,0 +1,136 @@
+#include "bench.hpp"
+#include "audio_fft.hpp"
+#include "spectrum_fft.hpp"
+#include "band_bank.hpp"
+#include "rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace aeronav;
+using aeronav::bench::State;
+
+namespace {
+
+std::vector<uint8_t> byteSpectrum(size_t bins) {
+    RngStream rng(7, 0);
+    std::vector<uint8_t> data(bins);
+    for (uint8_t& value : data) value = static_cast<uint8_t>(rng.nextFloat() * 255.0f);
+    return data;
+}
+
+std::vector<float> pcmFrame(size_t samples) {
+    std::vector<float> pcm(samples);
+    for (size_t i = 0; i < samples; i++) {
+        pcm[i] = 0.5f * std::sin(0.031f * i) + 0.25f * std::sin(0.377f * i);
+    }
+    return pcm;
+}
+
+// Band analysis of an AnalyserNode byte spectrum (fused SIMD kernel)
+void BM_AnalyzeFrequencies(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    const std::vector<uint8_t> data = byteSpectrum(bins);
+    AudioFFTAnalyzer analyzer;
+    while (state.keepRunning()) {
+        bench::doNotOptimize(analyzer.analyzeFrequencies(data.data(), bins));
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+    state.setBytesPerIteration(static_cast<int64_t>(bins));
+}
+
+void BM_AnalyzeFrequenciesFloat(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    std::vector<float> data(bins);
+    const std::vector<uint8_t> bytes = byteSpectrum(bins);
+    for (size_t i = 0; i < bins; i++) data[i] = bytes[i] / 255.0f;
+    AudioFFTAnalyzer analyzer;
+    while (state.keepRunning()) {
+        bench::doNotOptimize(analyzer.analyzeFrequenciesFloat(data.data(), bins, true));
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+    state.setBytesPerIteration(static_cast<int64_t>(bins * sizeof(float)));
+}
+
+// Plain per-bin loop over the same bands (the scalar baseline for the kernel)
+void BM_BandSumsScalar(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    const std::vector<uint8_t> data = byteSpectrum(bins);
+    const size_t bassEnd = bins / 10, midEnd = bins * 4 / 10;
+    while (state.keepRunning()) {
+        uint32_t sums[3] = {0, 0, 0};
+        for (size_t i = 0; i < bins; i++) {
+            sums[i < bassEnd ? 0 : (i < midEnd ? 1 : 2)] += data[i];
+        }
+        bench::doNotOptimize(sums);
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+    state.setBytesPerIteration(static_cast<int64_t>(bins));
+}
+
+// PCM frame -> windowed real FFT -> smoothed byte spectrum -> bands
+void BM_SpectrumAnalyze(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    SpectrumFFT fft(bins * 2, WindowType::BLACKMAN);
+    AudioFFTAnalyzer analyzer;
+    const std::vector<float> pcm = pcmFrame(bins * 2);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(fft.analyze(pcm.data(), analyzer));
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+}
+
+// 32 log bands with smoothing, peaks and the noise / onset detector
+void BM_BandBank(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    const std::vector<uint8_t> data = byteSpectrum(bins);
+    BandBank bank;
+    bank.configure(32, bins, 44100.0f, 40.0f, 16000.0f, BandScale::LOG);
+    while (state.keepRunning()) {
+        bank.process(data.data(), bins);
+        bench::doNotOptimize(bank.getNoiseState());
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+    state.setBytesPerIteration(static_cast<int64_t>(bins));
+}
+
+// The same bands the way JS computes them: per-bin band lookup, then smoothing
+void BM_BandBankScalar(State& state) {
+    const size_t bins = static_cast<size_t>(state.arg());
+    const std::vector<uint8_t> data = byteSpectrum(bins);
+    BandBank layout;
+    layout.configure(32, bins, 44100.0f, 40.0f, 16000.0f, BandScale::LOG);
+    const size_t bands = layout.getBandCount();
+    std::vector<int> binBand(bins, -1);
+    for (size_t b = 0; b < bands; b++) {
+        const uint32_t* edges = layout.getBandEdges();
+        for (uint32_t bin = edges[b]; bin < edges[b + 1]; bin++) binBand[bin] = static_cast<int>(b);
+    }
+    std::vector<float> sums(bands), counts(bands), smoothed(bands), peaks(bands);
+    while (state.keepRunning()) {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        std::fill(counts.begin(), counts.end(), 0.0f);
+        for (size_t i = 0; i < bins; i++) {
+            if (binBand[i] < 0) continue;
+            sums[binBand[i]] += data[i] / 255.0f;
+            counts[binBand[i]] += 1.0f;
+        }
+        for (size_t b = 0; b < bands; b++) {
+            smoothed[b] = smoothed[b] * 0.5f + sums[b] / counts[b] * 0.5f;
+            peaks[b] = std::max(smoothed[b], peaks[b] * 0.95f);
+        }
+        bench::doNotOptimize(peaks[0]);
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(bins));
+    state.setBytesPerIteration(static_cast<int64_t>(bins));
+}
+
+} // namespace
+
+AERONAV_BENCHMARK(BM_AnalyzeFrequencies)->range(256, 32768, 2);
+AERONAV_BENCHMARK(BM_AnalyzeFrequenciesFloat)->range(256, 32768, 2);
+AERONAV_BENCHMARK(BM_BandSumsScalar)->range(256, 32768, 2);
+AERONAV_BENCHMARK(BM_BandBank)->range(256, 32768, 2);
+AERONAV_BENCHMARK(BM_BandBankScalar)->range(256, 32768, 2);
+// SpectrumFFT sizes stop at 32768 samples (16384 bins)
+AERONAV_BENCHMARK(BM_SpectrumAnalyze)->range(256, 16384, 2);
@@ -0,0 +1,258 @@
+#include "bench.hpp"
+#include "command_buffer.hpp"
+#include "physics_engine.hpp"
+#include "physics_world.hpp"
+#include "rigid_body.hpp"
+#include "simd_integrator.hpp"
+#include "trajectory_rollout.hpp"
+#include "trajectory_recorder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace aeronav;
+using aeronav::bench::State;
+
+namespace {
+
+constexpr float DT = 0.016f;
+
+// World of `count` ships spread on a line, all boosting
+void fillWorld(PhysicsWorld& world, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t index = world.createBody(SpaceshipConfig());
+        world.resetBody(index, static_cast<float>(i) * 2.0f, 0.0f, 0.0f);
+    }
+}
+
+// Single ship: thrust, banking and one step (the per-frame call in the UI)
+void BM_PhysicsEngineStep(State& state) {
+    PhysicsEngine engine;
+    engine.setTarget(100.0f, 50.0f, -200.0f);
+    while (state.keepRunning()) {
+        engine.applyThrust(ThrustAction::BOOST, 0.8f);
+        engine.applyBanking(0.3f);
+        engine.step(DT);
+    }
+    bench::doNotOptimize(engine.getPosition());
+}
+
+// UI frame: the step plus the per-frame state and attitude polling
+void BM_PhysicsEngineFrameReads(State& state) {
+    PhysicsEngine engine;
+    engine.setTarget(100.0f, 50.0f, -200.0f);
+    float sink = 0.0f;
+    while (state.keepRunning()) {
+        engine.applyThrust(ThrustAction::BOOST, 0.8f);
+        engine.applyBanking(0.3f);
+        engine.step(DT);
+        const PhysicsState s = engine.getState();
+        sink += s.position.x + engine.getRoll() + engine.getPitch() + engine.getYaw() + engine.getSpeed();
+    }
+    bench::doNotOptimize(sink);
+}
+
+// The same frame as one command batch (the dispatch cost execute() adds)
+void BM_CommandBufferExecute(State& state) {
+    PhysicsEngine engine;
+    const PhysicsCommand frame[] = {
+        {static_cast<uint32_t>(CommandOp::SET_TARGET), 0, {100.0f, 50.0f, -200.0f, 0.0f}},
+        {static_cast<uint32_t>(CommandOp::APPLY_THRUST), 0, {2.0f, 0.8f, 0.0f, 0.0f}},
+        {static_cast<uint32_t>(CommandOp::APPLY_BANKING), 0, {0.3f, 0.1f, 0.0f, 0.0f}},
+        {static_cast<uint32_t>(CommandOp::STEP), 0, {DT, 0.0f, 0.0f, 0.0f}},
+    };
+    while (state.keepRunning()) {
+        bench::doNotOptimize(executeCommands(engine, frame, 4));
+    }
+    bench::doNotOptimize(engine.getPosition());
+}
+
+// One RigidBody::integrate per body (the object-per-ship layout)
+void BM_RigidBodyIntegrate(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    std::vector<RigidBody> bodies(count);
+    const Vector3 force(0.0f, 0.0f, -5000.0f), torque(0.1f, 0.2f, 0.0f);
+    while (state.keepRunning()) {
+        for (RigidBody& body : bodies) {
+            body.applyForce(force);
+            body.applyTorque(torque);
+            body.integrate(DT);
+        }
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Batched world step: thrust, drag, default integrator, state export
+void BM_WorldStepAll(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    while (state.keepRunning()) {
+        world.applyThrustAll(ThrustAction::BOOST, 1.0f);
+        world.stepAll(DT);
+    }
+    bench::doNotOptimize(world.getStateBuffer()[0]);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// The same step with roll/yaw/speed exported into the state buffer
+void BM_WorldStepAllDerived(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    world.setDerivedStateExport(true);
+    while (state.keepRunning()) {
+        world.applyThrustAll(ThrustAction::BOOST, 1.0f);
+        world.stepAll(DT);
+    }
+    bench::doNotOptimize(world.getStateBuffer()[StateLayout::SPEED]);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+template <typename Integrator>
+void BM_WorldStepAllWith(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    while (state.keepRunning()) {
+        world.applyThrustAll(ThrustAction::BOOST, 1.0f);
+        world.stepAllWith<Integrator>(DT);
+    }
+    bench::doNotOptimize(world.getStateBuffer()[0]);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Raw integrator kernels over the world's arrays (SIMD vs scalar reference)
+void BM_IntegrateBodiesSimd(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    const BodyArrays arrays = world.getArrays();
+    while (state.keepRunning()) {
+        integrateBodiesSimd(arrays, DT);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+    state.setLabel("lanes=" + std::to_string(integratorLaneWidth()));
+}
+
+void BM_IntegrateBodiesScalar(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    const BodyArrays arrays = world.getArrays();
+    while (state.keepRunning()) {
+        integrateBodiesScalar(arrays, DT);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Spatial-hash broadphase: sync plus all pairs within 5 m (ships 2 m apart)
+void BM_ProximityPairs(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    world.setProximityRadius(5.0f);
+    size_t pairs = 0;
+    while (state.keepRunning()) {
+        world.stepAll(DT);
+        pairs = world.findProximityPairs();
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+    state.setLabel("pairs=" + std::to_string(pairs));
+}
+
+// K random 60-step candidates from one ship (items = candidate steps)
+void BM_TrajectoryRollout(State& state, size_t threads) {
+    const size_t candidates = static_cast<size_t>(state.arg());
+    constexpr size_t HORIZON = 60;
+    std::vector<uint8_t> actions(candidates * HORIZON);
+    RngStream rng(42);
+    TrajectoryRollout::sampleActions(rng, actions.data(), candidates, HORIZON);
+    TrajectoryRollout rollout(threads);
+    rollout.setTarget(100.0f, 50.0f, -200.0f);
+    while (state.keepRunning()) {
+        rollout.run(actions.data(), candidates, HORIZON, DT);
+        bench::doNotOptimize(rollout.getResults()[0]);
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(candidates * HORIZON));
+    state.setLabel("threads=" + std::to_string(rollout.getThreadCount()));
+}
+
+void BM_TrajectoryRolloutSerial(State& state) { BM_TrajectoryRollout(state, 1); }
+void BM_TrajectoryRolloutParallel(State& state) { BM_TrajectoryRollout(state, 0); }
+
+// World step plus one recorded state frame, drained like the WASM OPFS path
+// (label = recorded file bytes per frame, header and index included)
+void BM_RecordWorld(State& state, bool delta) {
+    const size_t count = static_cast<size_t>(state.arg());
+    PhysicsWorld world(count);
+    fillWorld(world, count);
+    TrajectoryRecorder recorder(static_cast<uint32_t>(world.getStateBufferLength()),
+                                TrajectoryRecorder::DEFAULT_CHUNK_RECORDS, delta);
+    while (state.keepRunning()) {
+        world.applyThrustAll(ThrustAction::BOOST, 1.0f);
+        world.stepAll(DT);
+        recorder.append(world.getStateBuffer());
+        recorder.clearPending();
+    }
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+    // Seal the open chunk first: getBytesWritten() only counts sealed chunks
+    recorder.finish();
+    const uint64_t records = std::max<uint64_t>(recorder.getRecordCount(), 1);
+    state.setLabel("bytes/frame=" + std::to_string(recorder.getBytesWritten() / records));
+}
+
+void BM_RecordWorldRaw(State& state) { BM_RecordWorld(state, false); }
+void BM_RecordWorldDelta(State& state) { BM_RecordWorld(state, true); }
+
+// Random step reads from a 4096-step delta recording of 100 ships
+void BM_RecordingSeek(State& state) {
+    constexpr size_t SHIPS = 100, STEPS = 4096;
+    PhysicsWorld world(SHIPS);
+    fillWorld(world, SHIPS);
+    TrajectoryRecorder recorder(static_cast<uint32_t>(world.getStateBufferLength()));
+    std::vector<uint8_t> file;
+    for (size_t step = 0; step < STEPS; step++) {
+        world.applyThrustAll(ThrustAction::BOOST, 1.0f);
+        world.stepAll(DT);
+        recorder.append(world.getStateBuffer());
+        file.insert(file.end(), recorder.getPendingBytes(), recorder.getPendingBytes() + recorder.getPendingSize());
+        recorder.clearPending();
+    }
+    recorder.finish();
+    file.insert(file.end(), recorder.getPendingBytes(), recorder.getPendingBytes() + recorder.getPendingSize());
+    std::memcpy(file.data(), &recorder.getHeader(), sizeof(RecordingHeader));
+
+    TrajectoryReader reader;
+    reader.openMemory(file.data(), file.size());
+    std::vector<float> record(world.getStateBufferLength());
+    RngStream rng(7);
+    while (state.keepRunning()) {
+        reader.read(rng.nextBelow(STEPS), record.data());
+        bench::doNotOptimize(record[0]);
+    }
+}
+
+} // namespace
+
+AERONAV_BENCHMARK(BM_PhysicsEngineStep);
+AERONAV_BENCHMARK(BM_PhysicsEngineFrameReads);
+AERONAV_BENCHMARK(BM_CommandBufferExecute);
+AERONAV_BENCHMARK(BM_RigidBodyIntegrate)->range(1, 100000);
+AERONAV_BENCHMARK(BM_WorldStepAll)->range(1, 100000);
+AERONAV_BENCHMARK(BM_WorldStepAllDerived)->range(1, 100000);
+AERONAV_BENCHMARK(BM_WorldStepAllWith<VelocityVerlet>)->range(1, 100000);
+AERONAV_BENCHMARK(BM_WorldStepAllWith<RungeKutta4>)->range(1, 100000);
+AERONAV_BENCHMARK(BM_WorldStepAllWith<ExactDamping>)->range(1, 100000);
+AERONAV_BENCHMARK(BM_IntegrateBodiesSimd)->range(1, 100000);
+AERONAV_BENCHMARK(BM_IntegrateBodiesScalar)->range(1, 100000);
+AERONAV_BENCHMARK(BM_ProximityPairs)->range(10, 100000);
+AERONAV_BENCHMARK(BM_TrajectoryRolloutSerial)->range(16, 4096, 4);
+AERONAV_BENCHMARK(BM_TrajectoryRolloutParallel)->range(16, 4096, 4);
+AERONAV_BENCHMARK(BM_RecordWorldRaw)->range(1, 10000);
+AERONAV_BENCHMARK(BM_RecordWorldDelta)->range(1, 10000);
+AERONAV_BENCHMARK(BM_RecordingSeek);
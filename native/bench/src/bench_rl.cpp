@@ -0,0 +1,123 @@
+#include "bench.hpp"
+#include "multi_agent.hpp"
+#include "noise_pipeline.hpp"
+#include "rng.hpp"
+#include <string>
+#include <vector>
+
+using namespace aeronav;
+using aeronav::bench::State;
+
+namespace {
+
+// `count` agents cycling through the policies, spread on a line 1 m apart
+void fillAgents(MultiAgentSystem& system, size_t count) {
+    AgentConfig config;
+    for (size_t i = 0; i < count; i++) {
+        config.policy = static_cast<AgentPolicy>(i % 5);
+        const uint32_t id = system.createAgent(config);
+        system.setAgentPosition(id, static_cast<float>(i), 0.0f, 0.0f);
+    }
+}
+
+NoiseState noiseFor(uint64_t step) {
+    return step % 2 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE;
+}
+
+// Fused SoA kernel (select, reward, Q-update, energy) on the calling thread
+void BM_AgentsStepAll(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    system.setThreadCount(1);
+    uint64_t step = 0;
+    while (state.keepRunning()) system.stepAll(noiseFor(step++), true);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Every agent AGGRESSIVE: stepAll picks the kernel specialized on that policy
+void BM_AgentsStepAllUniform(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    AgentConfig config;
+    config.policy = AgentPolicy::AGGRESSIVE;
+    for (size_t i = 0; i < count; i++) system.createAgent(config);
+    system.setThreadCount(1);
+    uint64_t step = 0;
+    while (state.keepRunning()) system.stepAll(noiseFor(step++), true);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Same step through the per-agent member functions (scalar reference)
+void BM_AgentsStepAllReference(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    uint64_t step = 0;
+    while (state.keepRunning()) system.stepAllReference(noiseFor(step++), true);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Fused kernel across the thread pool (serial unless built with threads)
+void BM_AgentsStepAllParallel(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    system.setThreadCount(0);
+    uint64_t step = 0;
+    while (state.keepRunning()) system.stepAll(noiseFor(step++), true);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+    state.setLabel("threads=" + std::to_string(system.getThreadCount()));
+}
+
+// O(N) binned coordination after a step
+void BM_DetectCoordination(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    system.stepAll(NoiseState::LOW_NOISE, true);
+    uint32_t timestamp = 0;
+    while (state.keepRunning()) system.detectCoordination(timestamp++);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Spatial-hash coordination, ~6 neighbours per agent
+void BM_DetectCoordinationInRadius(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    system.stepAll(NoiseState::LOW_NOISE, true);
+    uint32_t timestamp = 0;
+    while (state.keepRunning()) system.detectCoordinationInRadius(timestamp++, 3.0f);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+// Spectrum -> band bank -> noise state -> stepAll in one call (1024 bins per
+// tick, alternating quiet and loud frames so the state flips)
+void BM_NoisePipelineTick(State& state) {
+    const size_t count = static_cast<size_t>(state.arg());
+    constexpr size_t BINS = 1024;
+    MultiAgentSystem system(42, count);
+    fillAgents(system, count);
+    system.setThreadCount(1);
+    NoisePipeline pipeline(system);
+
+    RngStream rng(7, 0);
+    std::vector<uint8_t> spectra(2 * BINS);
+    for (size_t i = 0; i < spectra.size(); i++) {
+        spectra[i] = static_cast<uint8_t>(rng.nextFloat() * (i < BINS ? 80.0f : 255.0f));
+    }
+    uint64_t step = 0;
+    while (state.keepRunning()) pipeline.tick(spectra.data() + (step++ % 2) * BINS, BINS, true);
+    state.setItemsPerIteration(static_cast<int64_t>(count));
+}
+
+} // namespace
+
+AERONAV_BENCHMARK(BM_NoisePipelineTick)->range(10, 10000);
+AERONAV_BENCHMARK(BM_AgentsStepAll)->range(10, 10000);
+AERONAV_BENCHMARK(BM_AgentsStepAllUniform)->range(10, 10000);
+AERONAV_BENCHMARK(BM_AgentsStepAllReference)->range(10, 10000);
+AERONAV_BENCHMARK(BM_AgentsStepAllParallel)->range(10, 10000);
+AERONAV_BENCHMARK(BM_DetectCoordination)->range(10, 10000);
+AERONAV_BENCHMARK(BM_DetectCoordinationInRadius)->range(10, 10000);
@@ -0,0 +1,265 @@
+// JS <-> WASM boundary benchmarks for the embind modules (headless, Node)
+// Usage: node boundary_bench.mjs <module dir> [--filter=<substring>] [--min-time=<seconds>] [--json=<path>|-]
+// <module dir> holds the node builds of physics_engine.mjs, audio_fft.mjs and
+// multi_agent.mjs (the bench CMake project's Emscripten branch produces them).
+// Output uses the same JSON schema as the native aeronav_bench executable.
+
+import { writeFileSync } from 'node:fs';
+import { cpus } from 'node:os';
+import { pathToFileURL } from 'node:url';
+import path from 'node:path';
+
+const args = process.argv.slice(2);
+const moduleDir = args.find((a) => !a.startsWith('--'));
+const flag = (name, fallback) => {
+  const hit = args.find((a) => a.startsWith(`--${name}=`));
+  return hit ? hit.slice(name.length + 3) : fallback;
+};
+const filter = flag('filter', '');
+const minTime = Number(flag('min-time', '0.2'));
+const jsonPath = flag('json', '');
+
+if (!moduleDir) {
+  console.error('usage: node boundary_bench.mjs <module dir> [--filter=] [--min-time=] [--json=]');
+  process.exit(2);
+}
+
+async function loadModule(file) {
+  const url = pathToFileURL(path.resolve(moduleDir, file)).href;
+  const factory = (await import(url)).default;
+  return factory();
+}
+
+// Grow the iteration count until one run lasts minTime (same policy as bench.cpp)
+function runOne(name, label, items, module, setup) {
+  const minTimeNs = minTime * 1e9;
+  let iterations = 1;
+  for (;;) {
+    const { body, teardown } = setup();
+    const allocations = module.getAllocationStats().heapAllocations;
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < iterations; i++) body(i);
+    const elapsed = Number(process.hrtime.bigint() - start);
+    const heapAllocations = module.getAllocationStats().heapAllocations - allocations;
+    if (teardown) teardown();
+    if (elapsed >= minTimeNs || iterations >= 2 ** 40) {
+      const seconds = elapsed * 1e-9;
+      return {
+        name,
+        label,
+        iterations,
+        time_unit: 'ns',
+        ns_per_op: elapsed / iterations,
+        items_per_second: seconds > 0 ? (items * iterations) / seconds : 0,
+        bytes_per_second: 0,
+        // Only the module's ArenaVector heap blocks are visible from JS
+        arena_heap_allocations_per_op: heapAllocations / iterations,
+      };
+    }
+    const perOp = elapsed / iterations;
+    let next = perOp > 0 ? Math.floor((minTimeNs * 1.4) / perOp) : iterations * 10;
+    next = Math.min(Math.max(next, iterations + 1), iterations * 10);
+    iterations = next;
+  }
+}
+
+const cases = [];
+const bench = (name, items, module, setup, label = '') => cases.push({ name, items, module, setup, label });
+
+const physics = await loadModule('physics_engine.mjs');
+const audio = await loadModule('audio_fft.mjs');
+const rl = await loadModule('multi_agent.mjs');
+
+// ---- Physics ----
+bench('JS_PhysicsNoopCall', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  return { body: () => engine.isFixedTimestep(), teardown: () => engine.delete() };
+}, 'bare embind call');
+
+bench('JS_PhysicsEngineStep', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  return {
+    body: () => {
+      engine.applyThrust(physics.THRUST_BOOST, 0.8);
+      engine.step(0.016);
+    },
+    teardown: () => engine.delete(),
+  };
+});
+
+// State read-back: value-object marshaling vs the zero-copy record
+bench('JS_PhysicsGetState', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  let sink = 0;
+  return { body: () => { sink += engine.getState().position.x; }, teardown: () => engine.delete() };
+});
+
+bench('JS_PhysicsGetStateView', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  const view = engine.getStateView();
+  let sink = 0;
+  return { body: () => { sink += view[physics.STATE_POSITION]; }, teardown: () => engine.delete() };
+});
+
+// One frame's updates: four crossings vs one execute() over a command buffer
+bench('JS_PhysicsFramePerCall', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  return {
+    body: () => {
+      engine.setTarget(100, 50, 0);
+      engine.applyThrust(physics.THRUST_BOOST, 0.8);
+      engine.applyBanking(0.2, 0.1);
+      engine.step(0.016);
+    },
+    teardown: () => engine.delete(),
+  };
+});
+
+bench('JS_PhysicsFrameCommandBuffer', 1, physics, () => {
+  const engine = new physics.PhysicsEngine();
+  const stride = physics.COMMAND_STRIDE;
+  const words = engine.getCommandView(4);
+  const args = new Float32Array(words.buffer, words.byteOffset, words.length);
+  const put = (i, opcode, a, b = 0, c = 0) => {
+    words[i * stride + physics.COMMAND_OPCODE] = opcode;
+    args.set([a, b, c, 0], i * stride + physics.COMMAND_ARGS);
+  };
+  return {
+    body: () => {
+      put(0, physics.COMMAND_SET_TARGET, 100, 50, 0);
+      put(1, physics.COMMAND_APPLY_THRUST, physics.THRUST_BOOST, 0.8);
+      put(2, physics.COMMAND_APPLY_BANKING, 0.2, 0.1);
+      put(3, physics.COMMAND_STEP, 0.016);
+      engine.execute(4);
+    },
+    teardown: () => engine.delete(),
+  };
+}, 'one crossing per frame');
+
+for (const count of [1, 10, 100, 1000, 10000, 100000]) {
+  const makeWorld = () => {
+    const world = new physics.PhysicsWorld(count);
+    for (let i = 0; i < count; i++) world.createBody(1000, 5000, 2, 0.8, 0.9, 0.1);
+    return world;
+  };
+  bench(`JS_WorldStepAll/${count}`, count, physics, () => {
+    const world = makeWorld();
+    return {
+      body: () => {
+        world.applyThrustAll(physics.THRUST_BOOST, 1);
+        world.stepAll(0.016);
+      },
+      teardown: () => world.delete(),
+    };
+  });
+  // Reading every body back: one getState() per body vs one view
+  if (count <= 10000) {
+    bench(`JS_WorldGetStatePerBody/${count}`, count, physics, () => {
+      const world = makeWorld();
+      let sink = 0;
+      return {
+        body: () => { for (let i = 0; i < count; i++) sink += world.getState(i).position.x; },
+        teardown: () => world.delete(),
+      };
+    });
+  }
+  bench(`JS_WorldGetStateView/${count}`, count, physics, () => {
+    const world = makeWorld();
+    const view = world.getStateView();
+    const stride = physics.STATE_STRIDE;
+    let sink = 0;
+    return {
+      body: () => { for (let i = 0; i < count; i++) sink += view[i * stride]; },
+      teardown: () => world.delete(),
+    };
+  });
+}
+
+// ---- Audio ----
+for (let bins = 256; bins <= 32768; bins *= 2) {
+  const spectrum = new Uint8Array(bins).map((_, i) => (i * 37) & 255);
+  // Copy in through a val argument vs a persistent input view filled with set()
+  bench(`JS_AnalyzeUint8/${bins}`, bins, audio, () => {
+    const analyzer = new audio.AudioAnalyzer(bins);
+    return { body: () => analyzer.analyzeUint8(spectrum), teardown: () => analyzer.delete() };
+  });
+  bench(`JS_AnalyzeInputView/${bins}`, bins, audio, () => {
+    const analyzer = new audio.AudioAnalyzer(bins);
+    const input = analyzer.getInputBuffer(bins);
+    return {
+      body: () => {
+        input.set(spectrum);
+        analyzer.analyzeInput(bins);
+      },
+      teardown: () => analyzer.delete(),
+    };
+  });
+}
+
+// ---- RL ----
+for (const count of [10, 100, 1000, 10000]) {
+  const makeSystem = () => {
+    const system = new rl.MultiAgentSystem(42, 0, count);
+    const config = {
+      policy: rl.AgentPolicy.BALANCED,
+      epsilonNormal: 0.05,
+      epsilonTraining: 0.3,
+      learningRate: 0.1,
+      energy: { max: 100, regen: 1.5, costGlide: 0.5, costBoost: 5, costStabilize: 3 },
+    };
+    for (let i = 0; i < count; i++) system.createAgent(config);
+    return system;
+  };
+  bench(`JS_AgentsStepAll/${count}`, count, rl, () => {
+    const system = makeSystem();
+    return {
+      body: (i) => system.stepAll(i & 1 ? rl.NoiseState.HIGH_NOISE : rl.NoiseState.LOW_NOISE, true),
+      teardown: () => system.delete(),
+    };
+  });
+  // Per-agent boundary crossings for the same step
+  bench(`JS_AgentsSelectActionPerAgent/${count}`, count, rl, () => {
+    const system = makeSystem();
+    return {
+      body: () => {
+        for (let id = 0; id < count; id++) system.selectAction(id, rl.NoiseState.LOW_NOISE, true);
+      },
+      teardown: () => system.delete(),
+    };
+  });
+  bench(`JS_AgentsGetAgentAt/${count}`, count, rl, () => {
+    const system = makeSystem();
+    let sink = 0;
+    return {
+      body: () => { for (let i = 0; i < count; i++) sink += system.getAgentAt(i).energy; },
+      teardown: () => system.delete(),
+    };
+  });
+}
+
+const results = [];
+for (const { name, items, module, setup, label } of cases) {
+  if (filter && !name.includes(filter)) continue;
+  const result = runOne(name, label, items, module, setup);
+  const line = `${name.padEnd(48)} ${result.ns_per_op.toFixed(1).padStart(14)} ${result.items_per_second
+    .toPrecision(4)
+    .padStart(14)} ${String(result.iterations).padStart(14)}${label ? '  ' + label : ''}`;
+  (jsonPath === '-' ? console.error : console.log)(line);
+  results.push(result);
+}
+
+if (jsonPath) {
+  const report = {
+    context: {
+      date: new Date().toISOString().replace(/\.\d+Z$/, 'Z'),
+      platform: 'wasm-boundary',
+      num_cpus: cpus().length,
+      min_time: minTime,
+      node: process.version,
+    },
+    benchmarks: results,
+  };
+  const text = JSON.stringify(report, null, 2) + '\n';
+  if (jsonPath === '-') process.stdout.write(text);
+  else writeFileSync(jsonPath, text);
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace aeronav {
+
+// Heap traffic of every ArenaVector in the process (arena backing blocks
+// included), so callers can check that a steady-state loop allocates nothing
+struct AllocationStats {
+    uint64_t heapAllocations;    // blocks taken from the heap (no arena, arena full, arena blocks)
+    uint64_t heapFrees;
+    uint64_t heapBytesInUse;
+    uint64_t arenaAllocations;   // blocks carved from an arena (never freed individually)
+};
+
+namespace detail {
+
+struct AllocationCounters {
+    std::atomic<uint64_t> heapAllocations{0};
+    std::atomic<uint64_t> heapFrees{0};
+    std::atomic<uint64_t> heapBytesInUse{0};
+    std::atomic<uint64_t> arenaAllocations{0};
+};
+
+inline AllocationCounters& allocationCounters() {
+    static AllocationCounters counters;
+    return counters;
+}
+
+inline void* countedHeapAllocate(size_t bytes) {
+    AllocationCounters& counters = allocationCounters();
+    counters.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.heapBytesInUse.fetch_add(bytes, std::memory_order_relaxed);
+    return ::operator new(bytes);
+}
+
+inline void countedHeapFree(void* ptr, size_t bytes) {
+    AllocationCounters& counters = allocationCounters();
+    counters.heapFrees.fetch_add(1, std::memory_order_relaxed);
+    counters.heapBytesInUse.fetch_sub(bytes, std::memory_order_relaxed);
+    ::operator delete(ptr);
+}
+
+} // namespace detail
+
+inline AllocationStats getAllocationStats() {
+    const detail::AllocationCounters& counters = detail::allocationCounters();
+    AllocationStats stats;
+    stats.heapAllocations = counters.heapAllocations.load(std::memory_order_relaxed);
+    stats.heapFrees = counters.heapFrees.load(std::memory_order_relaxed);
+    stats.heapBytesInUse = counters.heapBytesInUse.load(std::memory_order_relaxed);
+    stats.arenaAllocations = counters.arenaAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * Monotonic arena over one heap block sized at construction
+ * allocate() bumps an offset (ALIGNMENT-aligned, so SIMD loads and per-thread
+ * partitions never straddle two arrays' cache lines) and returns null once
+ * the block is full; memory comes back only when the arena is destroyed.
+ * Not thread-safe: an arena belongs to the object that sized it.
+ */
+class Arena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit Arena(size_t capacity)
+        : block_(nullptr), base_(nullptr), blockBytes_(0), capacity_(roundUp(capacity)), used_(0) {
+        if (capacity_ == 0) return;
+        blockBytes_ = capacity_ + ALIGNMENT;
+        block_ = static_cast<uint8_t*>(detail::countedHeapAllocate(blockBytes_));
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block_);
+        base_ = block_ + ((ALIGNMENT - address % ALIGNMENT) % ALIGNMENT);
+    }
+
+    ~Arena() {
+        if (block_ != nullptr) detail::countedHeapFree(block_, blockBytes_);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Null when `bytes` no longer fits
+    void* allocate(size_t bytes) {
+        const size_t rounded = roundUp(bytes);
+        if (rounded > capacity_ - used_) return nullptr;
+        void* ptr = base_ + used_;
+        used_ += rounded;
+        detail::allocationCounters().arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    bool owns(const void* ptr) const {
+        const uint8_t* p = static_cast<const uint8_t*>(ptr);
+        return base_ != nullptr && p >= base_ && p < base_ + capacity_;
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+
+    // Arena bytes that `count` values of T take (including alignment padding)
+    template <typename T>
+    static size_t bytesFor(size_t count) { return roundUp(count * sizeof(T)); }
+
+private:
+    uint8_t* block_;
+    uint8_t* base_;
+    size_t blockBytes_;
+    size_t capacity_;
+    size_t used_;
+
+    static size_t roundUp(size_t bytes) { return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+};
+
+/**
+ * Standard allocator drawing from a shared Arena, falling back to the
+ * (counted) heap when there is no arena or it is full
+ * Every container holding the allocator keeps the arena alive. Copies of a
+ * container go to the heap rather than sharing the source's arena; moves and
+ * swaps take the arena along.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(std::shared_ptr<Arena> arena) noexcept : arena_(std::move(arena)) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t count) {
+        static_assert(alignof(T) <= Arena::ALIGNMENT, "arena alignment too small");
+        const size_t bytes = count * sizeof(T);
+        if (arena_) {
+            if (void* ptr = arena_->allocate(bytes)) return static_cast<T*>(ptr);
+        }
+        return static_cast<T*>(detail::countedHeapAllocate(bytes));
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept {
+        if (arena_ && arena_->owns(ptr)) return;
+        detail::countedHeapFree(ptr, count * sizeof(T));
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    const std::shared_ptr<Arena>& arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.arena(); }
+
+private:
+    std::shared_ptr<Arena> arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Move `values` into `arena` with room for `capacity` elements (contents kept).
+// Growth past the capacity later falls back to the heap.
+template <typename T>
+void reserveInArena(ArenaVector<T>& values, const std::shared_ptr<Arena>& arena, size_t capacity) {
+    ArenaVector<T> bound{ArenaAllocator<T>(arena)};
+    bound.reserve(std::max(capacity, values.size()));
+    bound.assign(values.begin(), values.end());
+    values.swap(bound);
+}
+
+} // namespace aeronav
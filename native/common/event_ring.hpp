@@ -0,0 +1,83 @@
+#pragma once
+
+#include "arena.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace aeronav {
+
+/**
+ * Preallocated ring of fixed-size event records with monotonic sequence numbers
+ * Event n (counted from construction, never reset) lives in slot n % capacity
+ * until it is overwritten, so the raw slots can be exported as one typed array
+ * and a reader holding the last sequence it saw picks up everything newer in a
+ * single pass. push() never allocates or shifts.
+ */
+template <typename T>
+class EventRing {
+public:
+    explicit EventRing(size_t capacity = 1)
+        : slots_(capacity < 1 ? 1 : capacity), sequence_(0), count_(0) {}
+
+    // Resize (drops retained events; the sequence keeps counting)
+    void setCapacity(size_t capacity) {
+        slots_.assign(capacity < 1 ? 1 : capacity, T());
+        count_ = 0;
+    }
+
+    // Move the slots into `arena` (setCapacity() afterwards may fall back to the heap)
+    void reserveIn(const std::shared_ptr<Arena>& arena) { reserveInArena(slots_, arena, slots_.size()); }
+
+    void push(const T& event) {
+        slots_[sequence_ % slots_.size()] = event;
+        sequence_++;
+        if (count_ < slots_.size()) count_++;
+    }
+
+    // Drop retained events; the sequence keeps counting so readers stay in step
+    void clear() { count_ = 0; }
+
+    size_t capacity() const { return slots_.size(); }
+    size_t size() const { return count_; }
+
+    // Sequence the next push() will get, and the oldest one still retained
+    uint64_t getSequence() const { return sequence_; }
+    uint64_t getFirstSequence() const { return sequence_ - count_; }
+
+    // index 0 = oldest retained event
+    const T& at(size_t index) const {
+        return slots_[(getFirstSequence() + index) % slots_.size()];
+    }
+
+    // Copy retained events with sequence >= `sequence` (oldest first), returns
+    // how many were written; events already overwritten are skipped
+    size_t copySince(uint64_t sequence, T* out, size_t maxCount) const {
+        uint64_t first = getFirstSequence();
+        if (sequence > first) first = sequence;
+        size_t written = 0;
+        for (uint64_t s = first; s < sequence_ && written < maxCount; s++) {
+            out[written++] = slots_[s % slots_.size()];
+        }
+        return written;
+    }
+
+    // Raw slots (sequence s at s % capacity())
+    const T* data() const { return slots_.data(); }
+
+    // Snapshot restore: resize (allocates only on a capacity change) and set the
+    // counters; the caller then fills all capacity() raw slots through slots()
+    void restore(size_t capacity, uint64_t sequence, size_t count) {
+        if (capacity < 1) capacity = 1;
+        if (capacity != slots_.size()) slots_.assign(capacity, T());
+        sequence_ = sequence;
+        count_ = count < capacity ? count : capacity;
+    }
+    T* slots() { return slots_.data(); }
+
+private:
+    ArenaVector<T> slots_;
+    uint64_t sequence_;
+    size_t count_;
+};
+
+} // namespace aeronav
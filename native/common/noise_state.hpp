@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace aeronav {
+
+// Noise state the RL policies condition on, produced by audio analysis
+enum class NoiseState : uint8_t {
+    LOW_NOISE = 0,
+    HIGH_NOISE = 1
+};
+
+} // namespace aeronav
@@ -0,0 +1,50 @@
+#pragma once
+
+// Embind exports for profiler.hpp, shared by every WASM module's bindings
+// (each module has its own memory, so its own profile buffer)
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "profiler.hpp"
+#include <string>
+
+namespace aeronav {
+
+// Zero-copy Float64Array over the ProfileLayout buffer. Fetch once and read it
+// each frame; re-fetch if memory growth detaches it (byteLength becomes 0).
+inline emscripten::val getProfileView() {
+    return emscripten::val(emscripten::typed_memory_view(ProfileLayout::SIZE, getProfileBuffer()));
+}
+
+inline std::string getProfileStageName(unsigned int stage) {
+    return stage < PROFILE_STAGE_COUNT ? PROFILE_STAGE_NAMES[stage] : "";
+}
+
+inline std::string getProfileCounterName(unsigned int counter) {
+    return counter < PROFILE_COUNTER_COUNT ? PROFILE_COUNTER_NAMES[counter] : "";
+}
+
+// Call from the module's EMSCRIPTEN_BINDINGS block
+inline void bindProfiler() {
+    using emscripten::constant;
+    using emscripten::function;
+
+    function("getProfileView", &getProfileView);
+    function("resetProfile", &resetProfile);
+    function("getProfileStageName", &getProfileStageName);
+    function("getProfileCounterName", &getProfileCounterName);
+
+    constant("PROFILE_STAGE_COUNT", static_cast<int>(PROFILE_STAGE_COUNT));
+    constant("PROFILE_COUNTER_COUNT", static_cast<int>(PROFILE_COUNTER_COUNT));
+    constant("PROFILE_STAGE_CALLS", static_cast<int>(ProfileLayout::STAGE_CALLS));
+    constant("PROFILE_STAGE_TOTAL_NS", static_cast<int>(ProfileLayout::STAGE_TOTAL_NS));
+    constant("PROFILE_STAGE_SELF_NS", static_cast<int>(ProfileLayout::STAGE_SELF_NS));
+    constant("PROFILE_STAGE_MAX_NS", static_cast<int>(ProfileLayout::STAGE_MAX_NS));
+    constant("PROFILE_STAGE_STRIDE", static_cast<int>(ProfileLayout::STAGE_STRIDE));
+    constant("PROFILE_STAGES", static_cast<int>(ProfileLayout::STAGES));
+    constant("PROFILE_COUNTERS", static_cast<int>(ProfileLayout::COUNTERS));
+    constant("PROFILE_ENABLED", static_cast<int>(ProfileLayout::ENABLED));
+    constant("PROFILE_SIZE", static_cast<int>(ProfileLayout::SIZE));
+}
+
+} // namespace aeronav
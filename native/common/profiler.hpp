@@ -0,0 +1,212 @@
+#pragma once
+
+#include "arena.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Hot-path instrumentation is opt-in per module (AERONAV_ENABLE_PROFILING from
+// CMake). Without it the AERONAV_PROFILE_* macros expand to nothing; the buffer
+// below still exists (all zero, ENABLED = 0) so readers need no second layout.
+
+namespace aeronav {
+
+// Timed stages. Scopes nest at run time: each stage's self time excludes the
+// stages opened inside it, so self times add up to the time spent in the module.
+enum class ProfileStage : uint32_t {
+    BOUNDARY = 0,        // whole JS -> WASM call (self time = argument/result marshaling)
+    PHYSICS_STEP,
+    PHYSICS_INTEGRATE,
+    PHYSICS_THRUST,
+    PHYSICS_DRAG,
+    PHYSICS_PROXIMITY,
+    PHYSICS_ROLLOUT,     // whole TrajectoryRollout::run (candidates are stepped inside pool tasks)
+    AUDIO_FFT,
+    AUDIO_BANDS,
+    RL_STEP,             // fused stepAll kernel (selection, reward and Q-update in one pass)
+    RL_SELECT,
+    RL_REWARD,
+    RL_Q_UPDATE,
+    RL_COORDINATION,
+    COUNT
+};
+
+enum class ProfileCounter : uint32_t {
+    STEPS = 0,           // step / stepAll / analysis calls
+    ITEMS,               // bodies, agents or bins those calls processed
+    EVENTS,              // coordination events and proximity pairs produced
+    HEAP_ALLOCATIONS,    // ArenaVector heap blocks since the last reset
+    BOUNDARY_CALLS,
+    COUNT
+};
+
+constexpr size_t PROFILE_STAGE_COUNT = static_cast<size_t>(ProfileStage::COUNT);
+constexpr size_t PROFILE_COUNTER_COUNT = static_cast<size_t>(ProfileCounter::COUNT);
+
+constexpr const char* PROFILE_STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "boundary", "physics.step", "physics.integrate", "physics.thrust", "physics.drag", "physics.proximity",
+    "physics.rollout", "audio.fft", "audio.bands", "rl.step", "rl.select", "rl.reward", "rl.qUpdate",
+    "rl.coordination",
+};
+
+constexpr const char* PROFILE_COUNTER_NAMES[PROFILE_COUNTER_COUNT] = {
+    "steps", "items", "events", "heapAllocations", "boundaryCalls",
+};
+
+// Double offsets within the profile buffer (doubles keep ns totals and counts exact to 2^53)
+struct ProfileLayout {
+    // One record per ProfileStage
+    static constexpr size_t STAGE_CALLS = 0;
+    static constexpr size_t STAGE_TOTAL_NS = 1;   // inclusive
+    static constexpr size_t STAGE_SELF_NS = 2;    // exclusive of nested stages
+    static constexpr size_t STAGE_MAX_NS = 3;     // longest single call
+    static constexpr size_t STAGE_STRIDE = 4;
+
+    static constexpr size_t STAGES = 0;
+    static constexpr size_t COUNTERS = STAGES + PROFILE_STAGE_COUNT * STAGE_STRIDE;
+    static constexpr size_t ENABLED = COUNTERS + PROFILE_COUNTER_COUNT;   // 1 when compiled in
+    static constexpr size_t SIZE = ENABLED + 1;
+};
+
+namespace detail {
+
+struct ProfileState {
+    double buffer[ProfileLayout::SIZE];
+    uint64_t allocationBaseline;
+};
+
+inline ProfileState& profileState() {
+    static ProfileState state = [] {
+        ProfileState s = {};
+#if AERONAV_ENABLE_PROFILING
+        s.buffer[ProfileLayout::ENABLED] = 1.0;
+#endif
+        return s;
+    }();
+    return state;
+}
+
+} // namespace detail
+
+// The module's profile buffer (ProfileLayout::SIZE doubles, fixed address for
+// its lifetime), for zero-copy readers. Written by one thread at a time (the
+// caller of the instrumented API; scopes are never opened inside pool tasks).
+inline const double* getProfileBuffer() { return detail::profileState().buffer; }
+
+// Zero every stage and counter
+inline void resetProfile() {
+    detail::ProfileState& state = detail::profileState();
+    for (size_t i = 0; i < ProfileLayout::ENABLED; i++) state.buffer[i] = 0.0;
+    state.allocationBaseline = getAllocationStats().heapAllocations;
+}
+
+inline void profileCount(ProfileCounter counter, double amount) {
+    detail::profileState().buffer[ProfileLayout::COUNTERS + static_cast<size_t>(counter)] += amount;
+}
+
+/**
+ * RAII timer for one stage
+ * Adds the scope's wall time to the stage record and charges it to the
+ * enclosing scope's children, so the parent's self time excludes it. The
+ * clock is steady_clock (performance.now() under Emscripten, whose resolution
+ * the browser may coarsen: read totals over many calls, not single ones).
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage)
+        : stage_(stage), parent_(current()), childNs_(0.0), start_(Clock::now()) {
+        current() = this;
+    }
+
+    ~ProfileScope() {
+        const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start_).count();
+        current() = parent_;
+        if (parent_ != nullptr) parent_->childNs_ += elapsed;
+
+        double* record = detail::profileState().buffer + ProfileLayout::STAGES +
+                         static_cast<size_t>(stage_) * ProfileLayout::STAGE_STRIDE;
+        record[ProfileLayout::STAGE_CALLS] += 1.0;
+        record[ProfileLayout::STAGE_TOTAL_NS] += elapsed;
+        record[ProfileLayout::STAGE_SELF_NS] += elapsed - childNs_;
+        if (elapsed > record[ProfileLayout::STAGE_MAX_NS]) record[ProfileLayout::STAGE_MAX_NS] = elapsed;
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static ProfileScope*& current() {
+        thread_local ProfileScope* scope = nullptr;
+        return scope;
+    }
+
+    ProfileStage stage_;
+    ProfileScope* parent_;
+    double childNs_;
+    Clock::time_point start_;
+};
+
+// Outermost scope of a binding call: counts the crossing and, on the way out,
+// refreshes the allocation counter so readers never need a call to see it
+class BoundaryScope {
+public:
+    BoundaryScope() : scope_(ProfileStage::BOUNDARY) { profileCount(ProfileCounter::BOUNDARY_CALLS, 1.0); }
+
+    ~BoundaryScope() {
+        detail::ProfileState& state = detail::profileState();
+        state.buffer[ProfileLayout::COUNTERS + static_cast<size_t>(ProfileCounter::HEAP_ALLOCATIONS)] =
+            static_cast<double>(getAllocationStats().heapAllocations - state.allocationBaseline);
+    }
+
+private:
+    ProfileScope scope_;
+};
+
+/**
+ * Free-function form of a member call wrapped in a BoundaryScope, for bindings
+ * that bind core methods directly:
+ *   .function("stepAll", &ProfiledCall<&MultiAgentSystem::stepAll>::call)
+ */
+template <auto Method>
+struct ProfiledCall;
+
+template <typename C, typename R, typename... Args, R (C::*Method)(Args...)>
+struct ProfiledCall<Method> {
+    static R call(C& self, Args... args) {
+#if AERONAV_ENABLE_PROFILING
+        BoundaryScope boundary;
+#endif
+        return (self.*Method)(args...);
+    }
+};
+
+template <typename C, typename R, typename... Args, R (C::*Method)(Args...) const>
+struct ProfiledCall<Method> {
+    static R call(const C& self, Args... args) {
+#if AERONAV_ENABLE_PROFILING
+        BoundaryScope boundary;
+#endif
+        return (self.*Method)(args...);
+    }
+};
+
+} // namespace aeronav
+
+#define AERONAV_PROFILE_CONCAT_(a, b) a##b
+#define AERONAV_PROFILE_CONCAT(a, b) AERONAV_PROFILE_CONCAT_(a, b)
+
+#if AERONAV_ENABLE_PROFILING
+    // AERONAV_PROFILE_SCOPE(PHYSICS_INTEGRATE); times the rest of the enclosing block
+    #define AERONAV_PROFILE_SCOPE(stage) \
+        ::aeronav::ProfileScope AERONAV_PROFILE_CONCAT(profileScope_, __LINE__)(::aeronav::ProfileStage::stage)
+    #define AERONAV_PROFILE_BOUNDARY() \
+        ::aeronav::BoundaryScope AERONAV_PROFILE_CONCAT(profileBoundary_, __LINE__)
+    #define AERONAV_PROFILE_COUNT(counter, amount) \
+        ::aeronav::profileCount(::aeronav::ProfileCounter::counter, static_cast<double>(amount))
+#else
+    #define AERONAV_PROFILE_SCOPE(stage) ((void)0)
+    #define AERONAV_PROFILE_BOUNDARY() ((void)0)
+    #define AERONAV_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// SIMD detection for the batched generator (integer lanes needed)
+#if defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define AERONAV_RNG_WASM_SIMD 1
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define AERONAV_RNG_SSE2 1
+#endif
+
+namespace aeronav {
+
+/**
+ * Philox4x32-10 counter-based generator (Salmon et al., Random123)
+ * Stateless: every 128-bit counter maps to four independent 32-bit words
+ * under a 64-bit key, so any frame/agent/step can be drawn directly and
+ * batches vectorize across counters.
+ */
+struct Philox4x32 {
+    static constexpr uint32_t M0 = 0xD2511F53u;
+    static constexpr uint32_t M1 = 0xCD9E8D57u;
+    static constexpr uint32_t W0 = 0x9E3779B9u;
+    static constexpr uint32_t W1 = 0xBB67AE85u;
+    static constexpr int ROUNDS = 10;
+
+    // One block for counter (c0, c1, c2, c3) and key (k0, k1)
+    static void block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+
+        for (int round = 0; round < ROUNDS; round++) {
+            const uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+            const uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+            const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<uint32_t>(p1);
+            c3 = static_cast<uint32_t>(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += W0;
+            k1 += W1;
+        }
+
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+
+    /**
+     * Blocks for `count` consecutive counters starting at (first, c2, c3),
+     * where `first` fills words 0-1 of the counter. Four words per block are
+     * written interleaved: out[4 * i + j] is word j of counter first + i.
+     */
+    static void blocks(uint64_t first, uint32_t c2, uint32_t c3, const uint32_t key[2],
+                       uint32_t* out, size_t count);
+
+    // Uniform float in [0, 1) from the top 24 bits of a word
+    static float toFloat(uint32_t word) {
+        return static_cast<float>(word >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+#if AERONAV_RNG_WASM_SIMD
+namespace detail {
+// Lane-wise 32x32->64 multiply by a constant, split into high/low words
+inline void philoxMulHiLo(v128_t a, v128_t m, v128_t& hi, v128_t& lo) {
+    const v128_t p01 = wasm_u64x2_extmul_low_u32x4(a, m);
+    const v128_t p23 = wasm_u64x2_extmul_high_u32x4(a, m);
+    lo = wasm_i32x4_shuffle(p01, p23, 0, 2, 4, 6);
+    hi = wasm_i32x4_shuffle(p01, p23, 1, 3, 5, 7);
+}
+}
+#elif AERONAV_RNG_SSE2
+namespace detail {
+inline void philoxMulHiLo(__m128i a, __m128i m, __m128i& hi, __m128i& lo) {
+    const __m128i even = _mm_mul_epu32(a, m);                       // lanes 0, 2
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);    // lanes 1, 3
+    lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 3, 1)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 3, 1)));
+}
+}
+#endif
+
+inline void Philox4x32::blocks(uint64_t first, uint32_t c2, uint32_t c3, const uint32_t key[2],
+                               uint32_t* out, size_t count) {
+    size_t i = 0;
+
+#if AERONAV_RNG_WASM_SIMD || AERONAV_RNG_SSE2
+    // Four counters per iteration, one per lane
+    for (; i + 4 <= count; i += 4) {
+        alignas(16) uint32_t lo[4], hi[4];
+        for (int lane = 0; lane < 4; lane++) {
+            const uint64_t counter = first + i + lane;
+            lo[lane] = static_cast<uint32_t>(counter);
+            hi[lane] = static_cast<uint32_t>(counter >> 32);
+        }
+
+#if AERONAV_RNG_WASM_SIMD
+        v128_t x0 = wasm_v128_load(lo), x1 = wasm_v128_load(hi);
+        v128_t x2 = wasm_i32x4_splat(static_cast<int32_t>(c2));
+        v128_t x3 = wasm_i32x4_splat(static_cast<int32_t>(c3));
+        const v128_t m0 = wasm_i32x4_splat(static_cast<int32_t>(M0));
+        const v128_t m1 = wasm_i32x4_splat(static_cast<int32_t>(M1));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < ROUNDS; round++) {
+            v128_t hi0, lo0, hi1, lo1;
+            detail::philoxMulHiLo(x0, m0, hi0, lo0);
+            detail::philoxMulHiLo(x2, m1, hi1, lo1);
+            x0 = wasm_v128_xor(wasm_v128_xor(hi1, x1), wasm_i32x4_splat(static_cast<int32_t>(k0)));
+            x2 = wasm_v128_xor(wasm_v128_xor(hi0, x3), wasm_i32x4_splat(static_cast<int32_t>(k1)));
+            x1 = lo1;
+            x3 = lo0;
+            k0 += W0;
+            k1 += W1;
+        }
+
+        // Transpose lanes (one counter each) to interleaved blocks
+        const v128_t t0 = wasm_i32x4_shuffle(x0, x1, 0, 4, 1, 5);
+        const v128_t t1 = wasm_i32x4_shuffle(x2, x3, 0, 4, 1, 5);
+        const v128_t t2 = wasm_i32x4_shuffle(x0, x1, 2, 6, 3, 7);
+        const v128_t t3 = wasm_i32x4_shuffle(x2, x3, 2, 6, 3, 7);
+        wasm_v128_store(out + 4 * i + 0, wasm_i64x2_shuffle(t0, t1, 0, 2));
+        wasm_v128_store(out + 4 * i + 4, wasm_i64x2_shuffle(t0, t1, 1, 3));
+        wasm_v128_store(out + 4 * i + 8, wasm_i64x2_shuffle(t2, t3, 0, 2));
+        wasm_v128_store(out + 4 * i + 12, wasm_i64x2_shuffle(t2, t3, 1, 3));
+#else
+        __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(lo));
+        __m128i x1 = _mm_load_si128(reinterpret_cast<const __m128i*>(hi));
+        __m128i x2 = _mm_set1_epi32(static_cast<int32_t>(c2));
+        __m128i x3 = _mm_set1_epi32(static_cast<int32_t>(c3));
+        const __m128i m0 = _mm_set1_epi32(static_cast<int32_t>(M0));
+        const __m128i m1 = _mm_set1_epi32(static_cast<int32_t>(M1));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < ROUNDS; round++) {
+            __m128i hi0, lo0, hi1, lo1;
+            detail::philoxMulHiLo(x0, m0, hi0, lo0);
+            detail::philoxMulHiLo(x2, m1, hi1, lo1);
+            x0 = _mm_xor_si128(_mm_xor_si128(hi1, x1), _mm_set1_epi32(static_cast<int32_t>(k0)));
+            x2 = _mm_xor_si128(_mm_xor_si128(hi0, x3), _mm_set1_epi32(static_cast<int32_t>(k1)));
+            x1 = lo1;
+            x3 = lo0;
+            k0 += W0;
+            k1 += W1;
+        }
+
+        // Transpose lanes (one counter each) to interleaved blocks
+        const __m128i t0 = _mm_unpacklo_epi32(x0, x1);
+        const __m128i t1 = _mm_unpacklo_epi32(x2, x3);
+        const __m128i t2 = _mm_unpackhi_epi32(x0, x1);
+        const __m128i t3 = _mm_unpackhi_epi32(x2, x3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i + 0), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i + 4), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i + 8), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i + 12), _mm_unpackhi_epi64(t2, t3));
+#endif
+    }
+#endif
+
+    // Scalar tail
+    for (; i < count; i++) {
+        const uint64_t counter = first + i;
+        const uint32_t ctr[4] = {
+            static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), c2, c3
+        };
+        block(ctr, key, out + 4 * i);
+    }
+}
+
+/**
+ * Seedable random stream over Philox4x32
+ * The seed is the key and the stream id fills counter words 2-3, so streams
+ * with different ids never overlap; words 0-1 count blocks. Streams are
+ * independent per instance (no global state) and can be split for workers.
+ */
+class RngStream {
+public:
+    explicit RngStream(uint64_t seed = 0, uint64_t streamId = 0) { reseed(seed, streamId); }
+
+    void reseed(uint64_t seed, uint64_t streamId) {
+        key_[0] = static_cast<uint32_t>(seed);
+        key_[1] = static_cast<uint32_t>(seed >> 32);
+        streamId_ = streamId;
+        counter_ = 0;
+        bufferPos_ = 4;
+    }
+
+    uint64_t getSeed() const { return (static_cast<uint64_t>(key_[1]) << 32) | key_[0]; }
+    uint64_t getStreamId() const { return streamId_; }
+
+    // Block position, for replays (setting it discards buffered words)
+    uint64_t getCounter() const { return counter_; }
+    void setCounter(uint64_t counter) { counter_ = counter; bufferPos_ = 4; }
+
+    // Next full block of four words (does not touch buffered words)
+    void nextBlock(uint32_t out[4]) {
+        const uint32_t ctr[4] = {
+            static_cast<uint32_t>(counter_), static_cast<uint32_t>(counter_ >> 32),
+            static_cast<uint32_t>(streamId_), static_cast<uint32_t>(streamId_ >> 32)
+        };
+        Philox4x32::block(ctr, key_, out);
+        counter_++;
+    }
+
+    // `count` consecutive blocks, interleaved four words each
+    void fillBlocks(uint32_t* out, size_t count) {
+        Philox4x32::blocks(counter_, static_cast<uint32_t>(streamId_),
+                           static_cast<uint32_t>(streamId_ >> 32), key_, out, count);
+        counter_ += count;
+    }
+
+    uint32_t nextUint32() {
+        if (bufferPos_ == 4) {
+            nextBlock(buffer_);
+            bufferPos_ = 0;
+        }
+        return buffer_[bufferPos_++];
+    }
+
+    // Uniform float in [0, 1)
+    float nextFloat() { return Philox4x32::toFloat(nextUint32()); }
+
+    // Unbiased integer in [0, bound) (Lemire's multiply-and-reject)
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t m = static_cast<uint64_t>(nextUint32()) * bound;
+        if (static_cast<uint32_t>(m) < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (static_cast<uint32_t>(m) < threshold) {
+                m = static_cast<uint64_t>(nextUint32()) * bound;
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    /**
+     * Unbiased integer in [0, bound) from a fixed set of words
+     * Tries each word in turn with Lemire's rejection test, so callers that
+     * must consume a fixed number of blocks stay exact (a rejection needs
+     * bound/2^32 odds on every word).
+     */
+    static uint32_t belowFromWords(const uint32_t* words, size_t count, uint32_t bound) {
+        const uint32_t threshold = (0u - bound) % bound;
+        uint64_t m = 0;
+        for (size_t i = 0; i < count; i++) {
+            m = static_cast<uint64_t>(words[i]) * bound;
+            if (static_cast<uint32_t>(m) >= threshold) break;
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Fill n uniform floats in [0, 1), four per block
+    void fillUniform(float* out, size_t n) {
+        constexpr size_t CHUNK = 64;
+        alignas(16) uint32_t words[4 * CHUNK];
+        for (size_t begin = 0; begin < n; begin += 4 * CHUNK) {
+            const size_t floats = (n - begin) < 4 * CHUNK ? (n - begin) : 4 * CHUNK;
+            fillBlocks(words, (floats + 3) / 4);
+            for (size_t i = 0; i < floats; i++) out[begin + i] = Philox4x32::toFloat(words[i]);
+        }
+    }
+
+    // Child stream for a parallel worker (same seed, derived stream id)
+    RngStream split(uint64_t index) const {
+        return RngStream(getSeed(), mixStreamId(streamId_, index));
+    }
+
+private:
+    uint32_t key_[2];
+    uint64_t streamId_;
+    uint64_t counter_;
+    uint32_t buffer_[4];
+    uint32_t bufferPos_;
+
+    // SplitMix64 finalizer over (parent, index)
+    static uint64_t mixStreamId(uint64_t parent, uint64_t index) {
+        uint64_t z = parent + (index + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+} // namespace aeronav
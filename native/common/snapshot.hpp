@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace aeronav {
+
+// What a snapshot blob holds (each kind versions its own layout)
+enum class SnapshotKind : uint16_t {
+    PHYSICS_ENGINE = 1,
+    PHYSICS_WORLD = 2,
+    MULTI_AGENT = 3
+};
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x534E5641u;   // "AVNS" as little-endian bytes
+
+// Header at the start of every snapshot blob
+struct SnapshotHeader {
+    uint32_t magic;
+    SnapshotKind kind;
+    uint16_t version;
+    uint64_t size;      // total blob bytes, header included
+};
+
+static_assert(sizeof(SnapshotHeader) == 16, "snapshot header must stay 16 bytes");
+
+inline SnapshotHeader makeSnapshotHeader(SnapshotKind kind, uint16_t version, uint64_t size) {
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.kind = kind;
+    header.version = version;
+    header.size = size;
+    return header;
+}
+
+// Blob starts with a header of this kind and version whose size matches `size`
+inline bool checkSnapshotHeader(const uint8_t* data, size_t size, SnapshotKind kind, uint16_t version,
+                                SnapshotHeader& out) {
+    if (data == nullptr || size < sizeof(SnapshotHeader)) return false;
+    std::memcpy(&out, data, sizeof(SnapshotHeader));
+    return out.magic == SNAPSHOT_MAGIC && out.kind == kind && out.version == version && out.size == size;
+}
+
+/**
+ * Sequential memcpy writer / reader over a snapshot blob
+ * Values are copied as raw bytes (host endianness and float format), so a
+ * blob restores bit-exactly on the build that wrote it. The writer with a
+ * null buffer only counts bytes.
+ */
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(uint8_t* out = nullptr) : out_(out), offset_(0) {}
+
+    template <typename T>
+    void write(const T& value) { writeArray(&value, 1); }
+
+    template <typename T>
+    void writeArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        const size_t bytes = count * sizeof(T);
+        if (out_ != nullptr && bytes > 0) std::memcpy(out_ + offset_, values, bytes);
+        offset_ += bytes;
+    }
+
+    size_t size() const { return offset_; }
+
+private:
+    uint8_t* out_;
+    size_t offset_;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const uint8_t* data) : data_(data), offset_(0) {}
+
+    template <typename T>
+    void read(T& value) { readArray(&value, 1); }
+
+    template <typename T>
+    void readArray(T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        const size_t bytes = count * sizeof(T);
+        if (bytes > 0) std::memcpy(values, data_ + offset_, bytes);
+        offset_ += bytes;
+    }
+
+    size_t offset() const { return offset_; }
+
+private:
+    const uint8_t* data_;
+    size_t offset_;
+};
+
+} // namespace aeronav
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Threads are opt-in per module (AERONAV_ENABLE_THREADS from CMake). Without
+// them the pool has no workers and parallelFor() runs inline on the caller.
+#if AERONAV_ENABLE_THREADS
+    #include <atomic>
+    #include <condition_variable>
+    #include <deque>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+#endif
+
+namespace aeronav {
+
+/**
+ * Small work-stealing thread pool for data-parallel loops
+ * parallelFor() splits [0, count) into grain-sized ranges, deals them across
+ * per-worker queues, and blocks until all are done; the calling thread works
+ * too. Idle workers steal from the back of other queues. Range boundaries
+ * depend only on count and grain, never on timing. One parallelFor() at a
+ * time per pool.
+ */
+class ThreadPool {
+public:
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // threads = total participants including the caller (<= 1 means serial)
+    explicit ThreadPool(size_t threads = 1);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const { return threadCount_; }
+
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+    // Hardware threads available (1 when threads are disabled)
+    static size_t hardwareThreads();
+
+private:
+    size_t threadCount_;
+
+#if AERONAV_ENABLE_THREADS
+    struct Range { size_t begin, end; };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<Queue>> queues_;   // one per participant (index 0 = caller)
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const RangeFn* job_;
+    uint64_t generation_;
+    std::atomic<size_t> pending_;
+    bool stopping_;
+
+    bool popOwn(size_t self, Range& range);
+    bool steal(size_t self, Range& range);
+    void drain(size_t self);
+    void workerLoop(size_t self);
+#endif
+};
+
+#if AERONAV_ENABLE_THREADS
+
+inline ThreadPool::ThreadPool(size_t threads)
+    : threadCount_(threads < 1 ? 1 : threads)
+    , job_(nullptr)
+    , generation_(0)
+    , pending_(0)
+    , stopping_(false)
+{
+    for (size_t i = 0; i < threadCount_; i++) queues_.push_back(std::make_unique<Queue>());
+    for (size_t i = 1; i < threadCount_; i++) workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+inline size_t ThreadPool::hardwareThreads() {
+    const unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+inline bool ThreadPool::popOwn(size_t self, Range& range) {
+    Queue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.ranges.empty()) return false;
+    range = queue.ranges.front();
+    queue.ranges.pop_front();
+    return true;
+}
+
+inline bool ThreadPool::steal(size_t self, Range& range) {
+    for (size_t offset = 1; offset < threadCount_; offset++) {
+        Queue& queue = *queues_[(self + offset) % threadCount_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.ranges.empty()) continue;
+        range = queue.ranges.back();
+        queue.ranges.pop_back();
+        return true;
+    }
+    return false;
+}
+
+inline void ThreadPool::drain(size_t self) {
+    Range range;
+    while (popOwn(self, range) || steal(self, range)) {
+        (*job_)(range.begin, range.end);
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_.notify_all();
+        }
+    }
+}
+
+inline void ThreadPool::workerLoop(size_t self) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        drain(self);
+    }
+}
+
+inline void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    const size_t rangeCount = (count + grain - 1) / grain;
+    if (threadCount_ == 1 || rangeCount == 1) {
+        fn(0, count);
+        return;
+    }
+
+    // Publish the job before any range becomes visible in a queue
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        pending_.store(rangeCount, std::memory_order_release);
+    }
+
+    // Deal ranges round-robin so every participant starts with local work
+    for (size_t r = 0; r < rangeCount; r++) {
+        const size_t begin = r * grain;
+        const size_t end = begin + grain < count ? begin + grain : count;
+        Queue& queue = *queues_[r % threadCount_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back({begin, end});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+    }
+    wake_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_.load(std::memory_order_acquire) == 0; });
+    job_ = nullptr;
+}
+
+#else
+
+inline ThreadPool::ThreadPool(size_t) : threadCount_(1) {}
+inline ThreadPool::~ThreadPool() {}
+inline size_t ThreadPool::hardwareThreads() { return 1; }
+
+inline void ThreadPool::parallelFor(size_t count, size_t, const RangeFn& fn) {
+    if (count > 0) fn(0, count);
+}
+
+#endif
+
+} // namespace aeronav
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aeronav {
+
+// Thrust actions (matching JS implementation), shared by physics and RL
+enum class ThrustAction : uint8_t {
+    IDLE = 0,
+    GLIDE = 1,
+    BOOST = 2,
+    STABILIZE = 3
+};
+
+constexpr size_t THRUST_ACTION_COUNT = 4;
+
+// Integer action from JS/Python/command buffers (out of range = IDLE)
+constexpr ThrustAction toThrustAction(int action) {
+    return action < 0 || action > 3 ? ThrustAction::IDLE : static_cast<ThrustAction>(action);
+}
+
+// What an action does to a ship (every thrust implementation reads this table)
+struct ThrustTraits {
+    float thrustScale;       // thrust toward the target, fraction of maxThrust
+    bool applyDrag;          // aerodynamic drag while the action is held
+    float angularDamping;    // angular velocity multiplier (1 = untouched)
+};
+
+constexpr ThrustTraits THRUST_TRAITS[THRUST_ACTION_COUNT] = {
+    {0.0f, true, 1.0f},    // IDLE: just drag
+    {0.3f, true, 1.0f},    // GLIDE: minimal thrust, mostly coasting
+    {1.5f, false, 1.0f},   // BOOST: maximum thrust
+    {0.5f, false, 0.7f},   // STABILIZE: half thrust plus extra angular damping
+};
+
+constexpr const ThrustTraits& thrustTraits(ThrustAction action) {
+    return THRUST_TRAITS[static_cast<size_t>(action) < THRUST_ACTION_COUNT ? static_cast<size_t>(action) : 0];
+}
+
+// Compile-time view of one action, for loops specialized on it
+template <ThrustAction Action>
+struct ThrustActionTraits {
+    static constexpr ThrustAction ACTION = Action;
+    static constexpr float THRUST_SCALE = thrustTraits(Action).thrustScale;
+    static constexpr bool APPLY_DRAG = thrustTraits(Action).applyDrag;
+    static constexpr float ANGULAR_DAMPING = thrustTraits(Action).angularDamping;
+    static constexpr bool HAS_THRUST = THRUST_SCALE != 0.0f;
+    static constexpr bool DAMPS_ROTATION = ANGULAR_DAMPING != 1.0f;
+};
+
+// Run fn(ThrustActionTraits<A>{}) for a runtime action (one switch per call or batch)
+template <typename Fn>
+void withThrustAction(ThrustAction action, Fn&& fn) {
+    switch (action) {
+        case ThrustAction::GLIDE: fn(ThrustActionTraits<ThrustAction::GLIDE>{}); break;
+        case ThrustAction::BOOST: fn(ThrustActionTraits<ThrustAction::BOOST>{}); break;
+        case ThrustAction::STABILIZE: fn(ThrustActionTraits<ThrustAction::STABILIZE>{}); break;
+        case ThrustAction::IDLE:
+        default: fn(ThrustActionTraits<ThrustAction::IDLE>{}); break;
+    }
+}
+
+} // namespace aeronav
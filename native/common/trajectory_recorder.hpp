@@ -0,0 +1,625 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// File-backed recordings use mmap on native POSIX builds; everywhere else the
+// recorder streams its bytes to the caller (WASM: JS writes them to OPFS)
+#if !defined(__EMSCRIPTEN__) && (defined(__unix__) || defined(__APPLE__))
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define AERONAV_RECORDER_MMAP 1
+#endif
+
+namespace aeronav {
+
+constexpr uint32_t RECORDING_MAGIC = 0x52545641u;   // "AVTR" as little-endian bytes
+constexpr uint16_t RECORDING_VERSION = 1;
+constexpr uint16_t RECORDING_DELTA = 1;             // flag: records after a chunk's first are XOR deltas
+
+/**
+ * Recording file layout (raw host-endian bytes, like snapshot.hpp)
+ *   RecordingHeader
+ *   chunk 0 .. chunk n-1    RecordingChunkHeader + payload
+ *   chunk index             uint64 file offset of each chunk (indexOffset, written by finish())
+ * Every chunk holds chunkRecords records (the last may hold fewer), so step K
+ * is in chunk K / chunkRecords. A chunk payload starts with its first record
+ * verbatim; with RECORDING_DELTA each following record is XORed against the
+ * one before and stored as one mask byte per two words (bit 4k+b: byte b of
+ * word k is non-zero) followed by the non-zero bytes. Decoding is exact.
+ * A recording that was never finished has indexOffset 0 and is read by
+ * walking the chunk headers.
+ */
+struct RecordingHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t recordWords;    // 32-bit words per record
+    uint32_t chunkRecords;   // records per chunk
+    uint64_t recordCount;    // records in sealed chunks
+    uint64_t chunkCount;
+    uint64_t indexOffset;    // 0 until finish()
+    uint8_t reserved[24];
+};
+
+static_assert(sizeof(RecordingHeader) == 64, "recording header must stay 64 bytes");
+
+struct RecordingChunkHeader {
+    uint32_t records;
+    uint32_t payloadBytes;
+};
+
+static_assert(sizeof(RecordingChunkHeader) == 8, "chunk header must stay 8 bytes");
+
+// Largest payload a chunk of `records` records can take (64-bit so it cannot
+// wrap on 32-bit WASM; it must fit RecordingChunkHeader::payloadBytes)
+inline uint64_t maxChunkPayload(uint32_t recordWords, uint32_t records, bool delta) {
+    const uint64_t raw = static_cast<uint64_t>(recordWords) * sizeof(uint32_t);
+    if (!delta || records == 0) return raw * records;
+    return raw + (records - 1) * (raw + (recordWords + 1) / 2);
+}
+
+// Largest payload one record can add to a chunk
+inline size_t maxRecordPayload(uint32_t recordWords, bool delta) {
+    const size_t raw = static_cast<size_t>(recordWords) * sizeof(uint32_t);
+    return delta ? raw + (recordWords + 1) / 2 : raw;
+}
+
+// XOR delta of `current` against `previous`, returns the bytes written
+inline size_t encodeRecordDelta(const uint32_t* current, const uint32_t* previous, uint32_t recordWords,
+                                uint8_t* out) {
+    size_t pos = 0;
+    for (uint32_t w = 0; w < recordWords; w += 2) {
+        uint8_t& mask = out[pos++];
+        mask = 0;
+        for (uint32_t k = 0; k < 2 && w + k < recordWords; k++) {
+            const uint32_t x = current[w + k] ^ previous[w + k];
+            for (uint32_t b = 0; b < 4; b++) {
+                const uint8_t byte = static_cast<uint8_t>(x >> (8 * b));
+                if (byte != 0) {
+                    mask |= static_cast<uint8_t>(1u << (4 * k + b));
+                    out[pos++] = byte;
+                }
+            }
+        }
+    }
+    return pos;
+}
+
+// Inverse of encodeRecordDelta; returns the bytes consumed (0 if `size` runs out)
+inline size_t decodeRecordDelta(const uint8_t* in, size_t size, const uint32_t* previous, uint32_t recordWords,
+                                uint32_t* out) {
+    size_t pos = 0;
+    for (uint32_t w = 0; w < recordWords; w += 2) {
+        if (pos >= size) return 0;
+        const uint8_t mask = in[pos++];
+        for (uint32_t k = 0; k < 2 && w + k < recordWords; k++) {
+            uint32_t x = 0;
+            for (uint32_t b = 0; b < 4; b++) {
+                if (mask & (1u << (4 * k + b))) {
+                    if (pos >= size) return 0;
+                    x |= static_cast<uint32_t>(in[pos++]) << (8 * b);
+                }
+            }
+            out[w + k] = previous[w + k] ^ x;
+        }
+    }
+    return pos;
+}
+
+/**
+ * Decode one chunk (header included) into records * recordWords words
+ * Returns the record count, 0 if the chunk is malformed or holds more than
+ * maxRecords records. Also the entry point for readers that fetch single
+ * chunks themselves (the WASM reader slices them out of an OPFS file).
+ */
+inline size_t decodeRecordingChunk(const uint8_t* chunk, size_t size, uint32_t recordWords, bool delta,
+                                   uint32_t* out, size_t maxRecords) {
+    RecordingChunkHeader header;
+    if (chunk == nullptr || recordWords == 0 || size < sizeof(header)) return 0;
+    std::memcpy(&header, chunk, sizeof(header));
+    if (header.records == 0 || header.records > maxRecords ||
+        header.payloadBytes > size - sizeof(header)) {
+        return 0;
+    }
+
+    // 64-bit record size, and a division rather than records * rawBytes, so no
+    // corrupt count can wrap into a match; a matching size fits size_t
+    const uint64_t rawBytes = static_cast<uint64_t>(recordWords) * sizeof(uint32_t);
+    if (delta ? header.payloadBytes < rawBytes
+              : header.payloadBytes % rawBytes != 0 || header.payloadBytes / rawBytes != header.records) {
+        return 0;
+    }
+
+    const uint8_t* payload = chunk + sizeof(header);
+    const size_t recordBytes = static_cast<size_t>(rawBytes);
+    if (!delta) {
+        std::memcpy(out, payload, header.payloadBytes);
+        return header.records;
+    }
+
+    std::memcpy(out, payload, recordBytes);
+    size_t pos = recordBytes;
+    for (uint32_t r = 1; r < header.records; r++) {
+        uint32_t* record = out + static_cast<size_t>(r) * recordWords;
+        const size_t used = decodeRecordDelta(payload + pos, header.payloadBytes - pos,
+                                              record - recordWords, recordWords, record);
+        if (used == 0) return 0;
+        pos += used;
+    }
+    return pos == header.payloadBytes ? header.records : 0;
+}
+
+/**
+ * Append-only recorder of fixed-size per-step records
+ * Records are `recordWords` 32-bit words (floats or integers: state records,
+ * actions, rewards, Q-values, as the caller lays them out). They are packed
+ * into a chunk buffer that grows to the largest chunk actually seen (delta
+ * chunks of slowly changing state stay far below the worst case); each full
+ * chunk is sealed straight into the output, so memory stays at one chunk
+ * however long the session runs.
+ *
+ * A configuration whose worst-case chunk payload does not fit the 32-bit
+ * chunk header is rejected: isValid() is false, nothing is written and
+ * append() is ignored. Use fewer chunkRecords for very wide records.
+ *
+ * Output is either a file opened with open() (native: written through a
+ * growing shared mapping, the page cache does the I/O) or, without a file, a
+ * pending byte range in file order that the caller drains with
+ * getPendingBytes()/clearPending() and writes at getPendingOffset(). After
+ * finish(), write getHeader() at offset 0 to complete a streamed file.
+ *
+ * An unfinished recording opens up to its last sealed chunk only if those
+ * bytes reached storage: a file does (its header is rewritten after every
+ * chunk), a streamed file does if the caller also writes getHeader() at
+ * offset 0 after each drain and flushes durably (the WASM recorder does so
+ * through an OPFS sync access handle when it runs in a worker).
+ */
+class TrajectoryRecorder {
+public:
+    static constexpr uint32_t DEFAULT_CHUNK_RECORDS = 256;
+
+    explicit TrajectoryRecorder(uint32_t recordWords, uint32_t chunkRecords = DEFAULT_CHUNK_RECORDS,
+                                bool delta = true)
+        : recordWords_(recordWords < 1 ? 1 : recordWords)
+        , chunkRecords_(chunkRecords < 1 ? 1 : chunkRecords)
+        , chunkFill_(0)
+        , chunkPayload_(0)
+        , fileSize_(0)
+        , pendingOffset_(0)
+        , finished_(false)
+        , writeError_(false)
+        , valid_(true)
+    {
+        std::memset(&header_, 0, sizeof(header_));
+        header_.magic = RECORDING_MAGIC;
+        header_.version = RECORDING_VERSION;
+        header_.flags = delta ? RECORDING_DELTA : 0;
+        header_.recordWords = recordWords_;
+        header_.chunkRecords = chunkRecords_;
+
+        valid_ = maxChunkPayload(recordWords_, chunkRecords_, delta) <= std::numeric_limits<uint32_t>::max();
+        if (!valid_) {
+            finished_ = true;
+            return;
+        }
+        chunk_.resize(sizeof(RecordingChunkHeader) + maxRecordPayload(recordWords_, delta));
+        previous_.resize(recordWords_);
+        current_.resize(recordWords_);
+        emit(&header_, sizeof(header_));
+    }
+
+    ~TrajectoryRecorder() {
+        finish();
+#if AERONAV_RECORDER_MMAP
+        closeFile();
+#endif
+    }
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    // Record into a file (created or truncated) instead of the pending range.
+    // Only before the first append(); false where mmap is unavailable.
+    bool open(const char* path) {
+#if AERONAV_RECORDER_MMAP
+        if (path == nullptr || file_.fd >= 0 || header_.recordCount > 0 || chunkFill_ > 0 || finished_) {
+            return false;
+        }
+        if (!file_.create(path)) return false;
+        pending_.clear();
+        pendingOffset_ = 0;
+        return file_.write(0, &header_, sizeof(header_));
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    bool isFileBacked() const {
+#if AERONAV_RECORDER_MMAP
+        return file_.fd >= 0;
+#else
+        return false;
+#endif
+    }
+
+    // One record of recordWords words; ignored after finish()
+    void append(const void* record) {
+        if (finished_ || record == nullptr) return;
+        std::memcpy(current_.data(), record, recordWords_ * sizeof(uint32_t));
+
+        // Grows geometrically up to the largest chunk, then never reallocates
+        const size_t needed = sizeof(RecordingChunkHeader) + chunkPayload_ + maxRecordPayload(recordWords_, isDelta());
+        if (chunk_.size() < needed) chunk_.resize(std::max(needed, chunk_.size() * 2));
+
+        uint8_t* payload = chunk_.data() + sizeof(RecordingChunkHeader);
+        if (chunkFill_ == 0 || !isDelta()) {
+            std::memcpy(payload + chunkPayload_, current_.data(), recordWords_ * sizeof(uint32_t));
+            chunkPayload_ += recordWords_ * sizeof(uint32_t);
+        } else {
+            chunkPayload_ += encodeRecordDelta(current_.data(), previous_.data(), recordWords_,
+                                               payload + chunkPayload_);
+        }
+        previous_.swap(current_);
+        if (++chunkFill_ == chunkRecords_) sealChunk();
+    }
+
+    // Seal the partial chunk and write the chunk index; the recording is then
+    // complete (a file is trimmed to size and closed)
+    void finish() {
+        if (finished_) return;
+        if (chunkFill_ > 0) sealChunk();
+
+        header_.indexOffset = fileSize_;
+        emit(chunkOffsets_.data(), chunkOffsets_.size() * sizeof(uint64_t));
+        finished_ = true;
+        writeHeader();
+#if AERONAV_RECORDER_MMAP
+        closeFile();
+#endif
+    }
+
+    bool isValid() const { return valid_; }
+    bool isFinished() const { return finished_; }
+    bool hasWriteError() const { return writeError_; }   // a file write failed (file truncated or full)
+    bool isDelta() const { return (header_.flags & RECORDING_DELTA) != 0; }
+    uint32_t getRecordWords() const { return recordWords_; }
+    uint32_t getChunkRecords() const { return chunkRecords_; }
+    uint64_t getRecordCount() const { return header_.recordCount + chunkFill_; }   // including the open chunk
+    uint64_t getChunkCount() const { return header_.chunkCount; }
+    uint64_t getBytesWritten() const { return fileSize_; }
+
+    // Bytes sealed since the last clearPending(), to be written at getPendingOffset()
+    const uint8_t* getPendingBytes() const { return pending_.data(); }
+    size_t getPendingSize() const { return pending_.size(); }
+    uint64_t getPendingOffset() const { return pendingOffset_; }
+    void clearPending() {
+        pendingOffset_ += pending_.size();
+        pending_.clear();
+    }
+
+    // Current header (final once isFinished())
+    const RecordingHeader& getHeader() const { return header_; }
+
+private:
+#if AERONAV_RECORDER_MMAP
+    // Read-write shared mapping grown in doubling steps, trimmed on close
+    struct MappedFile {
+        static constexpr size_t INITIAL_BYTES = 1u << 20;
+
+        int fd = -1;
+        uint8_t* data = nullptr;
+        size_t mapped = 0;
+
+        bool create(const char* path) {
+            fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+            return fd >= 0 && remap(INITIAL_BYTES);
+        }
+
+        bool remap(size_t bytes) {
+            if (data != nullptr) ::munmap(data, mapped);
+            data = nullptr;
+            mapped = 0;
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) return false;
+            void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) return false;
+            data = static_cast<uint8_t*>(map);
+            mapped = bytes;
+            return true;
+        }
+
+        bool write(uint64_t offset, const void* bytes, size_t size) {
+            if (fd < 0) return false;
+            if (offset + size > mapped) {
+                size_t grown = std::max<size_t>(mapped, INITIAL_BYTES);
+                while (offset + size > grown) grown *= 2;
+                if (!remap(grown)) return false;
+            }
+            if (size > 0) std::memcpy(data + offset, bytes, size);
+            return true;
+        }
+
+        void close(uint64_t size) {
+            if (fd < 0) return;
+            if (data != nullptr) ::munmap(data, mapped);
+            // If trimming fails the file keeps the mapping's zero tail; readers stop at the index
+            const int trimmed = ::ftruncate(fd, static_cast<off_t>(size));
+            (void)trimmed;
+            ::close(fd);
+            fd = -1;
+            data = nullptr;
+            mapped = 0;
+        }
+    };
+
+    MappedFile file_;
+
+    void closeFile() { file_.close(fileSize_); }
+#endif
+
+    RecordingHeader header_;
+    uint32_t recordWords_;
+    uint32_t chunkRecords_;
+
+    std::vector<uint8_t> chunk_;          // chunk header + payload being filled
+    std::vector<uint32_t> previous_;      // last appended record (delta reference)
+    std::vector<uint32_t> current_;
+    uint32_t chunkFill_;
+    size_t chunkPayload_;
+
+    std::vector<uint64_t> chunkOffsets_;
+    uint64_t fileSize_;
+    std::vector<uint8_t> pending_;
+    uint64_t pendingOffset_;
+    bool finished_;
+    bool writeError_;
+    bool valid_;
+
+    // Append bytes at the end of the recording
+    void emit(const void* bytes, size_t size) {
+#if AERONAV_RECORDER_MMAP
+        if (file_.fd >= 0) {
+            if (!file_.write(fileSize_, bytes, size)) writeError_ = true;
+            fileSize_ += size;
+            return;
+        }
+#endif
+        const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+        pending_.insert(pending_.end(), begin, begin + size);
+        fileSize_ += size;
+    }
+
+    // A file keeps its header current after every chunk, so a recording that
+    // is never finished still opens up to its last sealed chunk
+    void writeHeader() {
+#if AERONAV_RECORDER_MMAP
+        if (file_.fd >= 0 && !file_.write(0, &header_, sizeof(header_))) writeError_ = true;
+#endif
+    }
+
+    void sealChunk() {
+        RecordingChunkHeader chunkHeader;
+        chunkHeader.records = chunkFill_;
+        chunkHeader.payloadBytes = static_cast<uint32_t>(chunkPayload_);
+        std::memcpy(chunk_.data(), &chunkHeader, sizeof(chunkHeader));
+
+        chunkOffsets_.push_back(fileSize_);
+        emit(chunk_.data(), sizeof(chunkHeader) + chunkPayload_);
+        header_.recordCount += chunkFill_;
+        header_.chunkCount++;
+        chunkFill_ = 0;
+        chunkPayload_ = 0;
+        writeHeader();
+    }
+};
+
+/**
+ * Random access over a recording
+ * Step K is found in O(1) through the chunk index (chunk K / chunkRecords);
+ * raw recordings copy the record straight out, delta recordings decode that
+ * one chunk and keep it, so sequential reads decode each chunk once. Opens a
+ * file through a read-only mapping (native) or a caller-owned byte range.
+ */
+class TrajectoryReader {
+public:
+    TrajectoryReader() : data_(nullptr), size_(0), cachedChunk_(NO_CHUNK) {
+        std::memset(&header_, 0, sizeof(header_));
+    }
+
+    ~TrajectoryReader() { close(); }
+
+    TrajectoryReader(const TrajectoryReader&) = delete;
+    TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+    bool open(const char* path) {
+#if AERONAV_RECORDER_MMAP
+        close();
+        if (path == nullptr) return false;
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(RecordingHeader))) {
+            ::close(fd);
+            return false;
+        }
+        const size_t size = static_cast<size_t>(info.st_size);
+        void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+        mapping_ = static_cast<uint8_t*>(map);
+        mappedSize_ = size;
+        if (openMemory(mapping_, size)) return true;
+        close();
+        return false;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // The bytes must outlive the reader (or the next open/close)
+    bool openMemory(const uint8_t* data, size_t size) {
+        release();
+        if (data == nullptr || size < sizeof(RecordingHeader)) return false;
+        std::memcpy(&header_, data, sizeof(header_));
+        if (header_.magic != RECORDING_MAGIC || header_.version != RECORDING_VERSION ||
+            header_.recordWords == 0 || header_.chunkRecords == 0 ||
+            maxChunkPayload(header_.recordWords, header_.chunkRecords, (header_.flags & RECORDING_DELTA) != 0) >
+                std::numeric_limits<uint32_t>::max()) {
+            return false;   // also bounds decoded_; a valid recorder never writes such a header
+        }
+        data_ = data;
+        size_ = size;
+        if (!loadIndex()) {
+            release();
+            return false;
+        }
+        decoded_.resize(static_cast<size_t>(header_.chunkRecords) * header_.recordWords);
+        return true;
+    }
+
+    void close() {
+        release();
+#if AERONAV_RECORDER_MMAP
+        if (mapping_ != nullptr) ::munmap(mapping_, mappedSize_);
+        mapping_ = nullptr;
+        mappedSize_ = 0;
+#endif
+    }
+
+    bool isOpen() const { return data_ != nullptr; }
+    uint32_t getRecordWords() const { return header_.recordWords; }
+    uint32_t getChunkRecords() const { return header_.chunkRecords; }
+    uint64_t getRecordCount() const { return recordCount_; }
+    size_t getChunkCount() const { return chunkOffsets_.size(); }
+    bool isFinished() const { return header_.indexOffset != 0; }
+    const RecordingHeader& getHeader() const { return header_; }
+
+    // Copy record `step` (recordWords words) into out
+    bool read(uint64_t step, void* out) { return readRange(step, 1, out) == 1; }
+
+    // Copy up to `count` records from `first` on; returns how many were copied
+    size_t readRange(uint64_t first, size_t count, void* out) {
+        if (!isOpen() || out == nullptr || first >= recordCount_) return 0;
+        count = static_cast<size_t>(std::min<uint64_t>(count, recordCount_ - first));
+
+        const size_t recordBytes = static_cast<size_t>(header_.recordWords) * sizeof(uint32_t);
+        uint8_t* dst = static_cast<uint8_t*>(out);
+        size_t copied = 0;
+        while (copied < count) {
+            const uint64_t step = first + copied;
+            const size_t chunk = static_cast<size_t>(step / header_.chunkRecords);
+            const size_t inChunk = static_cast<size_t>(step % header_.chunkRecords);
+            const size_t take = std::min<size_t>(count - copied, chunkRecordCount(chunk) - inChunk);
+
+            const uint8_t* src;
+            if ((header_.flags & RECORDING_DELTA) == 0) {
+                src = data_ + chunkOffsets_[chunk] + sizeof(RecordingChunkHeader) + inChunk * recordBytes;
+            } else {
+                if (!decodeChunk(chunk)) break;
+                src = reinterpret_cast<const uint8_t*>(decoded_.data()) + inChunk * recordBytes;
+            }
+            std::memcpy(dst + copied * recordBytes, src, take * recordBytes);
+            copied += take;
+        }
+        return copied;
+    }
+
+private:
+    static constexpr size_t NO_CHUNK = ~static_cast<size_t>(0);
+
+    RecordingHeader header_;
+    const uint8_t* data_;
+    size_t size_;
+    uint64_t recordCount_ = 0;
+    std::vector<uint64_t> chunkOffsets_;
+    std::vector<uint32_t> decoded_;   // records of cachedChunk_
+    size_t cachedChunk_;
+#if AERONAV_RECORDER_MMAP
+    uint8_t* mapping_ = nullptr;
+    size_t mappedSize_ = 0;
+#endif
+
+    void release() {
+        data_ = nullptr;
+        size_ = 0;
+        recordCount_ = 0;
+        chunkOffsets_.clear();
+        cachedChunk_ = NO_CHUNK;
+    }
+
+    size_t chunkRecordCount(size_t chunk) const {
+        const uint64_t before = static_cast<uint64_t>(chunk) * header_.chunkRecords;
+        return static_cast<size_t>(std::min<uint64_t>(header_.chunkRecords, recordCount_ - before));
+    }
+
+    // Chunk at `offset` fits the data and holds 1..chunkRecords records
+    bool readChunkHeader(uint64_t offset, uint64_t end, RecordingChunkHeader& out) const {
+        if (offset > end || end - offset < sizeof(out)) return false;
+        std::memcpy(&out, data_ + offset, sizeof(out));
+        return out.records > 0 && out.records <= header_.chunkRecords &&
+               out.payloadBytes <= end - offset - sizeof(out);
+    }
+
+    // Offsets from the index, or by walking the chunks of an unfinished recording.
+    // Only the last chunk may be partial, which keeps step -> chunk a division.
+    bool loadIndex() {
+        const uint64_t end = header_.indexOffset != 0 ? header_.indexOffset : size_;
+        if (end > size_ || end < sizeof(RecordingHeader)) return false;
+
+        if (header_.indexOffset != 0) {
+            if ((size_ - end) / sizeof(uint64_t) < header_.chunkCount) return false;
+            chunkOffsets_.resize(static_cast<size_t>(header_.chunkCount));
+            if (!chunkOffsets_.empty()) {
+                std::memcpy(chunkOffsets_.data(), data_ + end, chunkOffsets_.size() * sizeof(uint64_t));
+            }
+        } else {
+            RecordingChunkHeader chunk;
+            uint64_t offset = sizeof(RecordingHeader);
+            while (readChunkHeader(offset, end, chunk)) {
+                chunkOffsets_.push_back(offset);
+                offset += sizeof(chunk) + chunk.payloadBytes;
+                if (chunk.records < header_.chunkRecords) break;
+            }
+        }
+
+        // 64-bit sizes (records * recordBytes <= the UINT32_MAX bound checked in
+        // openMemory), so a corrupt record count cannot wrap past these checks
+        const uint64_t recordBytes = static_cast<uint64_t>(header_.recordWords) * sizeof(uint32_t);
+        recordCount_ = 0;
+        for (size_t c = 0; c < chunkOffsets_.size(); c++) {
+            RecordingChunkHeader chunk;
+            if (!readChunkHeader(chunkOffsets_[c], end, chunk)) return false;
+            if (chunk.records != header_.chunkRecords && c + 1 != chunkOffsets_.size()) return false;
+            if ((header_.flags & RECORDING_DELTA) == 0) {
+                const uint64_t chunkBytes = static_cast<uint64_t>(chunk.records) * recordBytes;
+                if (chunkBytes > end - chunkOffsets_[c] - sizeof(chunk) || chunk.payloadBytes != chunkBytes) {
+                    return false;
+                }
+            }
+            recordCount_ += chunk.records;
+        }
+        return true;
+    }
+
+    bool decodeChunk(size_t chunk) {
+        if (chunk == cachedChunk_) return true;
+        const uint64_t offset = chunkOffsets_[chunk];
+        const size_t end = header_.indexOffset != 0 ? static_cast<size_t>(header_.indexOffset) : size_;
+        if (decodeRecordingChunk(data_ + offset, end - static_cast<size_t>(offset), header_.recordWords, true,
+                                 decoded_.data(), header_.chunkRecords) != chunkRecordCount(chunk)) {
+            return false;
+        }
+        cachedChunk_ = chunk;
+        return true;
+    }
+};
+
+} // namespace aeronav
@@ -1,5 +1,14 @@
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 #include "../src/physics_engine.hpp"
+#include "../src/physics_world.hpp"
+#include "../src/command_buffer.hpp"
+#include "../src/trajectory_rollout.hpp"
+#include "trajectory_recorder.hpp"
+#include "profile_bindings.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 using namespace emscripten;
 using namespace aeronav;
@@ -30,7 +39,13 @@ struct PhysicsStateJS {
     }
 };
 
+static IntegratorType toIntegratorType(int integrator) {
+    if (integrator < 0 || integrator > 3) return IntegratorType::SEMI_IMPLICIT_EULER;
+    return static_cast<IntegratorType>(integrator);
+}
+
 // Wrapper class for PhysicsEngine with JS-friendly interface
+// (per-frame methods open a boundary scope: profiled builds count the crossing and its glue time)
 class PhysicsEngineWrapper {
 public:
     PhysicsEngineWrapper() : engine_() {}
@@ -48,9 +63,16 @@ public:
     }
 
     void step(float deltaTime) {
-        engine_.step(deltaTime);
+        AERONAV_PROFILE_BOUNDARY();
+        withIntegrator(integrator_, [&](auto policy) {
+            engine_.stepWith<decltype(policy)>(deltaTime);
+        });
     }
 
+    // Integrator as integer: 0=SEMI_IMPLICIT_EULER, 1=VELOCITY_VERLET, 2=RUNGE_KUTTA_4, 3=EXACT_DAMPING
+    void setIntegrator(int integrator) { integrator_ = toIntegratorType(integrator); }
+    int getIntegrator() const { return static_cast<int>(integrator_); }
+
     void reset(float x, float y, float z) {
         engine_.reset(x, y, z);
     }
@@ -61,17 +83,75 @@ public:
 
     // Action as integer: 0=IDLE, 1=GLIDE, 2=BOOST, 3=STABILIZE
     void applyThrust(int action, float intensity) {
+        AERONAV_PROFILE_BOUNDARY();
         engine_.applyThrustByName(action, intensity);
     }
 
     void applyBanking(float desiredRoll, float rollFactor) {
+        AERONAV_PROFILE_BOUNDARY();
         engine_.applyBanking(desiredRoll, rollFactor);
     }
 
     PhysicsStateJS getState() const {
+        AERONAV_PROFILE_BOUNDARY();
         return PhysicsStateJS::fromPhysicsState(engine_.getState());
     }
 
+    // Zero-copy Float32Array view over the engine's StateLayout record.
+    // Fetch once and re-read each frame; re-fetch if memory growth detaches it.
+    val getStateView() const {
+        return val(typed_memory_view(StateLayout::STRIDE, engine_.getStateBuffer()));
+    }
+
+    // Uint32Array over `capacity` packed commands (CommandLayout words; write the
+    // args through a Float32Array on the same buffer). Valid until a larger
+    // capacity is requested or WASM memory grows.
+    val getCommandView(unsigned int capacity) {
+        if (commands_.size() < capacity) commands_.resize(capacity);
+        return val(typed_memory_view(capacity * CommandLayout::STRIDE,
+                                     reinterpret_cast<uint32_t*>(commands_.data())));
+    }
+
+    // Run the first `count` commands in one call; returns how many were executed
+    unsigned int execute(unsigned int count) {
+        AERONAV_PROFILE_BOUNDARY();
+        count = std::min<unsigned int>(count, commands_.size());
+        return static_cast<unsigned int>(executeCommands(engine_, commands_.data(), count, integrator_));
+    }
+
+    // Fixed-timestep mode: rateHz <= 0 returns to one step per frame
+    void setFixedTimestep(float rateHz, int maxSubSteps) {
+        engine_.setFixedTimestep(rateHz, static_cast<uint32_t>(std::max(maxSubSteps, 1)));
+    }
+    bool isFixedTimestep() const { return engine_.isFixedTimestep(); }
+    float getInterpolationAlpha() const { return engine_.getInterpolationAlpha(); }
+    int getLastSubStepCount() const { return static_cast<int>(engine_.getLastSubStepCount()); }
+
+    // Zero-copy view over the interpolated render record (StateLayout); same
+    // lifetime rules as getStateView()
+    val getRenderStateView() const {
+        return val(typed_memory_view(StateLayout::STRIDE, engine_.getRenderStateBuffer()));
+    }
+
+    // Snapshot into the wrapper's record; returns a Uint8Array view over it that is
+    // overwritten by the next saveSnapshot() (copy with slice() to keep it)
+    val saveSnapshot() {
+        engine_.saveSnapshot(snapshot_);
+        return val(typed_memory_view(sizeof(snapshot_), reinterpret_cast<const uint8_t*>(&snapshot_)));
+    }
+
+    // Fixed-size record: copied straight into snapshot_ with one TypedArray.set()
+    bool restoreSnapshot(const val& bytes) {
+        AERONAV_PROFILE_BOUNDARY();
+        if (bytes["length"].as<unsigned int>() != sizeof(snapshot_)) return false;
+        val(typed_memory_view(sizeof(snapshot_), reinterpret_cast<uint8_t*>(&snapshot_))).call<void>("set", bytes);
+        return engine_.restoreSnapshot(snapshot_);
+    }
+
+    Vector3JS getInterpolatedPosition() const {
+        return Vector3JS::fromVector3(engine_.getInterpolatedPosition());
+    }
+
     Vector3JS getPosition() const {
         return Vector3JS::fromVector3(engine_.getPosition());
     }
@@ -89,6 +169,10 @@ public:
     float getYaw() const { return engine_.getYaw(); }
     float getSpeed() const { return engine_.getSpeed(); }
 
+    // Fill STATE_ROLL/YAW/SPEED in the state view on every refresh
+    void setDerivedStateExport(bool enabled) { engine_.setDerivedStateExport(enabled); }
+    bool isDerivedStateExport() const { return engine_.isDerivedStateExport(); }
+
     // Configuration setters
     void setMass(float mass) { engine_.setMass(mass); }
     void setMaxThrust(float thrust) { engine_.setMaxThrust(thrust); }
@@ -97,10 +181,317 @@ public:
     void setAngularDamping(float damping) { engine_.setAngularDamping(damping); }
     void setDragCoefficient(float drag) { engine_.setDragCoefficient(drag); }
 
+    // Native access for TrajectoryRolloutWrapper (not bound)
+    const PhysicsEngine& getEngine() const { return engine_; }
+
 private:
     PhysicsEngine engine_;
+    IntegratorType integrator_ = IntegratorType::SEMI_IMPLICIT_EULER;
+    PhysicsEngineSnapshot snapshot_;
+    std::vector<PhysicsCommand> commands_;
+};
+
+// Wrapper class for PhysicsWorld (batched multi-ship simulation)
+class PhysicsWorldWrapper {
+public:
+    PhysicsWorldWrapper() : world_() {}
+    explicit PhysicsWorldWrapper(unsigned int maxBodies) : world_(maxBodies) {}
+
+    unsigned int createBody(float mass, float maxThrust, float maxAngularVelocity,
+                            float linearDamping, float angularDamping, float dragCoefficient) {
+        SpaceshipConfig config;
+        config.mass = mass;
+        config.maxThrust = maxThrust;
+        config.maxAngularVelocity = maxAngularVelocity;
+        config.linearDamping = linearDamping;
+        config.angularDamping = angularDamping;
+        config.dragCoefficient = dragCoefficient;
+        return world_.createBody(config);
+    }
+
+    unsigned int getBodyCount() const { return static_cast<unsigned int>(world_.getBodyCount()); }
+    void clear() { world_.clear(); }
+
+    void stepAll(float deltaTime) {
+        AERONAV_PROFILE_BOUNDARY();
+        withIntegrator(integrator_, [&](auto policy) {
+            world_.stepAllWith<decltype(policy)>(deltaTime);
+        });
+    }
+
+    // Same integers as PhysicsEngine.setIntegrator
+    void setIntegrator(int integrator) { integrator_ = toIntegratorType(integrator); }
+    int getIntegrator() const { return static_cast<int>(integrator_); }
+
+    void resetBody(unsigned int index, float x, float y, float z) {
+        world_.resetBody(index, x, y, z);
+    }
+
+    void setTarget(unsigned int index, float x, float y, float z) {
+        world_.setTarget(index, x, y, z);
+    }
+
+    // Action as integer: 0=IDLE, 1=GLIDE, 2=BOOST, 3=STABILIZE
+    void applyThrust(unsigned int index, int action, float intensity) {
+        AERONAV_PROFILE_BOUNDARY();
+        world_.applyThrust(index, toThrustAction(action), intensity);
+    }
+
+    void applyThrustAll(int action, float intensity) {
+        AERONAV_PROFILE_BOUNDARY();
+        world_.applyThrustAll(toThrustAction(action), intensity);
+    }
+
+    void applyBanking(unsigned int index, float desiredRoll, float rollFactor) {
+        AERONAV_PROFILE_BOUNDARY();
+        world_.applyBanking(index, desiredRoll, rollFactor);
+    }
+
+    PhysicsStateJS getState(unsigned int index) const {
+        AERONAV_PROFILE_BOUNDARY();
+        return PhysicsStateJS::fromPhysicsState(world_.getState(index));
+    }
+
+    // Zero-copy Float32Array view over all bodies' StateLayout records.
+    // Invalidated by createBody()/clear() and by WASM memory growth.
+    val getStateView() const {
+        return val(typed_memory_view(world_.getStateBufferLength(), world_.getStateBuffer()));
+    }
+
+    // Same contract as PhysicsEngine.getCommandView / execute (the body word selects the ship)
+    val getCommandView(unsigned int capacity) {
+        if (commands_.size() < capacity) commands_.resize(capacity);
+        return val(typed_memory_view(capacity * CommandLayout::STRIDE,
+                                     reinterpret_cast<uint32_t*>(commands_.data())));
+    }
+
+    unsigned int execute(unsigned int count) {
+        AERONAV_PROFILE_BOUNDARY();
+        count = std::min<unsigned int>(count, commands_.size());
+        return static_cast<unsigned int>(executeCommands(world_, commands_.data(), count, integrator_));
+    }
+
+    // Same contract as PhysicsEngine.saveSnapshot / restoreSnapshot
+    val saveSnapshot() {
+        snapshot_.resize(world_.getSnapshotSize());
+        world_.saveSnapshot(snapshot_.data(), snapshot_.size());
+        return val(typed_memory_view(snapshot_.size(), snapshot_.data()));
+    }
+
+    // Staged in snapshot_ (one TypedArray.set(), no per-restore allocation once
+    // it has grown to the blob size); invalidates the last saveSnapshot() view
+    bool restoreSnapshot(const val& bytes) {
+        AERONAV_PROFILE_BOUNDARY();
+        const unsigned int length = bytes["length"].as<unsigned int>();
+        snapshot_.resize(length);
+        val(typed_memory_view(length, snapshot_.data())).call<void>("set", bytes);
+        return world_.restoreSnapshot(snapshot_.data(), length);
+    }
+
+    float getRoll(unsigned int index) const { return world_.getRoll(index); }
+    float getSpeed(unsigned int index) const { return world_.getSpeed(index); }
+
+    void setDerivedStateExport(bool enabled) { world_.setDerivedStateExport(enabled); }
+    bool isDerivedStateExport() const { return world_.isDerivedStateExport(); }
+
+    void setProximityRadius(float radius) { world_.setProximityRadius(radius); }
+    float getProximityRadius() const { return world_.getProximityRadius(); }
+
+    // Returns the pair count; read the pairs with getProximityPairView()
+    unsigned int findProximityPairs() {
+        AERONAV_PROFILE_BOUNDARY();
+        proximityPairCount_ = world_.findProximityPairs();
+        return static_cast<unsigned int>(proximityPairCount_);
+    }
+
+    // Zero-copy Uint32Array [i0, j0, i1, j1, ...] from the last findProximityPairs()
+    val getProximityPairView() const {
+        return val(typed_memory_view(proximityPairCount_ * 2, world_.getProximityPairs()));
+    }
+
+    // Zero-copy Uint32Array of body indices, valid until the next call
+    val findNeighbors(unsigned int index, float radius) {
+        AERONAV_PROFILE_BOUNDARY();
+        world_.findNeighbors(index, radius, neighbors_);
+        return val(typed_memory_view(neighbors_.size(), neighbors_.data()));
+    }
+
+    // Native access for TrajectoryRolloutWrapper (not bound)
+    const PhysicsWorld& getWorld() const { return world_; }
+
+private:
+    PhysicsWorld world_;
+    IntegratorType integrator_ = IntegratorType::SEMI_IMPLICIT_EULER;
+    std::vector<uint8_t> snapshot_;
+    size_t proximityPairCount_ = 0;
+    std::vector<uint32_t> neighbors_;
+    std::vector<PhysicsCommand> commands_;
 };
 
+// Wrapper class for TrajectoryRollout (Monte Carlo thrust lookahead)
+class TrajectoryRolloutWrapper {
+public:
+    TrajectoryRolloutWrapper() : rollout_(1) {}
+    // threads > 1 only helps in a pthreads build (AERONAV_PHYSICS_THREADS)
+    explicit TrajectoryRolloutWrapper(unsigned int threads) : rollout_(threads) {}
+
+    // Plan from a live ship (state, config and target)
+    void setStartFromEngine(const PhysicsEngineWrapper& engine) { rollout_.setStart(engine.getEngine()); }
+    void setStartFromWorld(const PhysicsWorldWrapper& world, unsigned int index) {
+        rollout_.setStart(world.getWorld(), index);
+    }
+
+    void setTarget(float x, float y, float z) { rollout_.setTarget(x, y, z); }
+
+    // Zero-copy Uint8Array of candidates * horizon ThrustActions, candidate-major.
+    // Invalidated by a larger request and by WASM memory growth.
+    val getActionView(unsigned int candidates, unsigned int horizon) {
+        const size_t size = static_cast<size_t>(candidates) * horizon;
+        if (actions_.size() < size) actions_.resize(size);
+        return val(typed_memory_view(size, actions_.data()));
+    }
+
+    // Fill the action buffer with random sequences (TrajectoryRollout::sampleActions)
+    // 64-bit seed as two 32-bit halves (JS numbers are exact only to 2^53)
+    void setSeed(unsigned int seedLow, unsigned int seedHigh) {
+        rng_.reseed((static_cast<uint64_t>(seedHigh) << 32) | seedLow, 0);
+    }
+    void sampleActions(unsigned int candidates, unsigned int horizon, float switchProbability) {
+        AERONAV_PROFILE_BOUNDARY();
+        getActionView(candidates, horizon);
+        TrajectoryRollout::sampleActions(rng_, actions_.data(), candidates, horizon, switchProbability);
+    }
+
+    // Simulate the action buffer; read the records with getResultView()
+    void run(unsigned int candidates, unsigned int horizon, float deltaTime, float intensity) {
+        AERONAV_PROFILE_BOUNDARY();
+        if (horizon > 0) candidates = std::min<unsigned int>(candidates, actions_.size() / horizon);
+        rollout_.run(actions_.data(), candidates, horizon, deltaTime, intensity);
+    }
+
+    // Zero-copy Float32Array of RolloutLayout records from the last run()
+    val getResultView() const {
+        return val(typed_memory_view(rollout_.getCandidateCount() * RolloutLayout::STRIDE, rollout_.getResults()));
+    }
+
+    unsigned int bestCandidate(float energyWeight) const {
+        return static_cast<unsigned int>(rollout_.bestCandidate(energyWeight));
+    }
+
+private:
+    TrajectoryRollout rollout_;
+    std::vector<uint8_t> actions_;
+    RngStream rng_;
+};
+
+// Streaming recorder: sealed chunks surface as a pending byte range that JS
+// writes to OPFS at getPendingOffset(), so only one chunk lives in WASM memory
+class TrajectoryRecorderWrapper {
+public:
+    TrajectoryRecorderWrapper(unsigned int recordWords, unsigned int chunkRecords, bool delta)
+        : recorder_(recordWords, chunkRecords, delta), record_(recorder_.getRecordWords(), 0.0f) {}
+
+    // Zero-copy Float32Array of the next record (fill it, then commit()).
+    // Re-acquire after memory growth.
+    val getRecordView() { return val(typed_memory_view(record_.size(), record_.data())); }
+
+    void commit() {
+        AERONAV_PROFILE_BOUNDARY();
+        recorder_.append(record_.data());
+    }
+
+    // Copy a state record (or a world's records) to the start of the next record, then commit()
+    void appendEngine(const PhysicsEngineWrapper& engine) {
+        appendFloats(engine.getEngine().getStateBuffer(), StateLayout::STRIDE);
+    }
+
+    void appendWorld(const PhysicsWorldWrapper& world) {
+        appendFloats(world.getWorld().getStateBuffer(), world.getWorld().getStateBufferLength());
+    }
+
+    void finish() { recorder_.finish(); }
+    bool isValid() const { return recorder_.isValid(); }
+    bool isFinished() const { return recorder_.isFinished(); }
+
+    // Uint8Array of the bytes to write at getPendingOffset(); clearPending() once written
+    val getPendingView() const {
+        return val(typed_memory_view(recorder_.getPendingSize(), recorder_.getPendingBytes()));
+    }
+    double getPendingOffset() const { return static_cast<double>(recorder_.getPendingOffset()); }
+    void clearPending() { recorder_.clearPending(); }
+
+    // Header bytes for offset 0 (final after finish())
+    val getHeaderView() const {
+        return val(typed_memory_view(sizeof(RecordingHeader),
+                                     reinterpret_cast<const uint8_t*>(&recorder_.getHeader())));
+    }
+
+    double getRecordCount() const { return static_cast<double>(recorder_.getRecordCount()); }
+    double getBytesWritten() const { return static_cast<double>(recorder_.getBytesWritten()); }
+
+private:
+    TrajectoryRecorder recorder_;
+    std::vector<float> record_;
+
+    void appendFloats(const float* values, size_t count) {
+        AERONAV_PROFILE_BOUNDARY();
+        std::memcpy(record_.data(), values, std::min(count, record_.size()) * sizeof(float));
+        recorder_.append(record_.data());
+    }
+};
+
+// Chunk decoder for replay: JS slices one chunk out of the recording file
+// (through the chunk index), copies it into getInputView() and decodes it
+class RecordingChunkDecoderWrapper {
+public:
+    RecordingChunkDecoderWrapper(unsigned int recordWords, unsigned int chunkRecords, bool delta)
+        : recordWords_(std::max(recordWords, 1u))
+        , chunkRecords_(std::max(chunkRecords, 1u))
+        , delta_(delta)
+        , records_(0)
+        , output_(static_cast<size_t>(recordWords_) * chunkRecords_) {}
+
+    // Uint8Array of `bytes` bytes for the chunk (header included)
+    val getInputView(unsigned int bytes) {
+        if (input_.size() < bytes) input_.resize(bytes);
+        return val(typed_memory_view(bytes, input_.data()));
+    }
+
+    // Records decoded (0 if the chunk is malformed)
+    unsigned int decode(unsigned int bytes) {
+        AERONAV_PROFILE_BOUNDARY();
+        bytes = std::min<unsigned int>(bytes, input_.size());
+        records_ = decodeRecordingChunk(input_.data(), bytes, recordWords_, delta_,
+                                        reinterpret_cast<uint32_t*>(output_.data()), chunkRecords_);
+        return static_cast<unsigned int>(records_);
+    }
+
+    // Float32Array of the decoded records (recordWords floats each)
+    val getOutputView() const { return val(typed_memory_view(records_ * recordWords_, output_.data())); }
+
+private:
+    uint32_t recordWords_;
+    uint32_t chunkRecords_;
+    bool delta_;
+    size_t records_;
+    std::vector<uint8_t> input_;
+    std::vector<float> output_;
+};
+
+// Container heap traffic of this module (arena.hpp); doubles keep the counts exact
+struct AllocationStatsJS {
+    double heapAllocations;
+    double heapFrees;
+    double heapBytesInUse;
+    double arenaAllocations;
+};
+
+AllocationStatsJS getAllocationStatsJS() {
+    const AllocationStats stats = getAllocationStats();
+    return { static_cast<double>(stats.heapAllocations), static_cast<double>(stats.heapFrees),
+             static_cast<double>(stats.heapBytesInUse), static_cast<double>(stats.arenaAllocations) };
+}
+
 EMSCRIPTEN_BINDINGS(aeronav_physics) {
     // Bind Vector3JS as a value object
     value_object<Vector3JS>("Vector3")
@@ -120,11 +511,24 @@ EMSCRIPTEN_BINDINGS(aeronav_physics) {
         .constructor<>()
         .constructor<float, float, float, float, float, float>()
         .function("step", &PhysicsEngineWrapper::step)
+        .function("setIntegrator", &PhysicsEngineWrapper::setIntegrator)
+        .function("getIntegrator", &PhysicsEngineWrapper::getIntegrator)
         .function("reset", &PhysicsEngineWrapper::reset)
         .function("setTarget", &PhysicsEngineWrapper::setTarget)
         .function("applyThrust", &PhysicsEngineWrapper::applyThrust)
         .function("applyBanking", &PhysicsEngineWrapper::applyBanking)
         .function("getState", &PhysicsEngineWrapper::getState)
+        .function("getStateView", &PhysicsEngineWrapper::getStateView)
+        .function("getCommandView", &PhysicsEngineWrapper::getCommandView)
+        .function("execute", &PhysicsEngineWrapper::execute)
+        .function("setFixedTimestep", &PhysicsEngineWrapper::setFixedTimestep)
+        .function("isFixedTimestep", &PhysicsEngineWrapper::isFixedTimestep)
+        .function("getInterpolationAlpha", &PhysicsEngineWrapper::getInterpolationAlpha)
+        .function("getLastSubStepCount", &PhysicsEngineWrapper::getLastSubStepCount)
+        .function("getRenderStateView", &PhysicsEngineWrapper::getRenderStateView)
+        .function("saveSnapshot", &PhysicsEngineWrapper::saveSnapshot)
+        .function("restoreSnapshot", &PhysicsEngineWrapper::restoreSnapshot)
+        .function("getInterpolatedPosition", &PhysicsEngineWrapper::getInterpolatedPosition)
         .function("getPosition", &PhysicsEngineWrapper::getPosition)
         .function("getVelocity", &PhysicsEngineWrapper::getVelocity)
         .function("getAngularVelocity", &PhysicsEngineWrapper::getAngularVelocity)
@@ -132,6 +536,8 @@ EMSCRIPTEN_BINDINGS(aeronav_physics) {
         .function("getPitch", &PhysicsEngineWrapper::getPitch)
         .function("getYaw", &PhysicsEngineWrapper::getYaw)
         .function("getSpeed", &PhysicsEngineWrapper::getSpeed)
+        .function("setDerivedStateExport", &PhysicsEngineWrapper::setDerivedStateExport)
+        .function("isDerivedStateExport", &PhysicsEngineWrapper::isDerivedStateExport)
         .function("setMass", &PhysicsEngineWrapper::setMass)
         .function("setMaxThrust", &PhysicsEngineWrapper::setMaxThrust)
         .function("setMaxAngularVelocity", &PhysicsEngineWrapper::setMaxAngularVelocity)
@@ -139,9 +545,129 @@ EMSCRIPTEN_BINDINGS(aeronav_physics) {
         .function("setAngularDamping", &PhysicsEngineWrapper::setAngularDamping)
         .function("setDragCoefficient", &PhysicsEngineWrapper::setDragCoefficient);
 
+    // Bind the batched PhysicsWorld wrapper class
+    class_<PhysicsWorldWrapper>("PhysicsWorld")
+        .constructor<>()
+        .constructor<unsigned int>()
+        .function("createBody", &PhysicsWorldWrapper::createBody)
+        .function("getBodyCount", &PhysicsWorldWrapper::getBodyCount)
+        .function("clear", &PhysicsWorldWrapper::clear)
+        .function("stepAll", &PhysicsWorldWrapper::stepAll)
+        .function("setIntegrator", &PhysicsWorldWrapper::setIntegrator)
+        .function("getIntegrator", &PhysicsWorldWrapper::getIntegrator)
+        .function("resetBody", &PhysicsWorldWrapper::resetBody)
+        .function("setTarget", &PhysicsWorldWrapper::setTarget)
+        .function("applyThrust", &PhysicsWorldWrapper::applyThrust)
+        .function("applyThrustAll", &PhysicsWorldWrapper::applyThrustAll)
+        .function("applyBanking", &PhysicsWorldWrapper::applyBanking)
+        .function("getState", &PhysicsWorldWrapper::getState)
+        .function("getStateView", &PhysicsWorldWrapper::getStateView)
+        .function("getCommandView", &PhysicsWorldWrapper::getCommandView)
+        .function("execute", &PhysicsWorldWrapper::execute)
+        .function("saveSnapshot", &PhysicsWorldWrapper::saveSnapshot)
+        .function("restoreSnapshot", &PhysicsWorldWrapper::restoreSnapshot)
+        .function("getRoll", &PhysicsWorldWrapper::getRoll)
+        .function("getSpeed", &PhysicsWorldWrapper::getSpeed)
+        .function("setDerivedStateExport", &PhysicsWorldWrapper::setDerivedStateExport)
+        .function("isDerivedStateExport", &PhysicsWorldWrapper::isDerivedStateExport)
+        .function("setProximityRadius", &PhysicsWorldWrapper::setProximityRadius)
+        .function("getProximityRadius", &PhysicsWorldWrapper::getProximityRadius)
+        .function("findProximityPairs", &PhysicsWorldWrapper::findProximityPairs)
+        .function("getProximityPairView", &PhysicsWorldWrapper::getProximityPairView)
+        .function("findNeighbors", &PhysicsWorldWrapper::findNeighbors);
+
+    // Bind the trajectory rollout (lookahead planning) wrapper class
+    class_<TrajectoryRolloutWrapper>("TrajectoryRollout")
+        .constructor<>()
+        .constructor<unsigned int>()
+        .function("setStartFromEngine", &TrajectoryRolloutWrapper::setStartFromEngine)
+        .function("setStartFromWorld", &TrajectoryRolloutWrapper::setStartFromWorld)
+        .function("setTarget", &TrajectoryRolloutWrapper::setTarget)
+        .function("getActionView", &TrajectoryRolloutWrapper::getActionView)
+        .function("setSeed", &TrajectoryRolloutWrapper::setSeed)
+        .function("sampleActions", &TrajectoryRolloutWrapper::sampleActions)
+        .function("run", &TrajectoryRolloutWrapper::run)
+        .function("getResultView", &TrajectoryRolloutWrapper::getResultView)
+        .function("bestCandidate", &TrajectoryRolloutWrapper::bestCandidate);
+
+    // Bind the trajectory recorder and the replay chunk decoder
+    class_<TrajectoryRecorderWrapper>("TrajectoryRecorder")
+        .constructor<unsigned int, unsigned int, bool>()
+        .function("getRecordView", &TrajectoryRecorderWrapper::getRecordView)
+        .function("commit", &TrajectoryRecorderWrapper::commit)
+        .function("appendEngine", &TrajectoryRecorderWrapper::appendEngine)
+        .function("appendWorld", &TrajectoryRecorderWrapper::appendWorld)
+        .function("finish", &TrajectoryRecorderWrapper::finish)
+        .function("isValid", &TrajectoryRecorderWrapper::isValid)
+        .function("isFinished", &TrajectoryRecorderWrapper::isFinished)
+        .function("getPendingView", &TrajectoryRecorderWrapper::getPendingView)
+        .function("getPendingOffset", &TrajectoryRecorderWrapper::getPendingOffset)
+        .function("clearPending", &TrajectoryRecorderWrapper::clearPending)
+        .function("getHeaderView", &TrajectoryRecorderWrapper::getHeaderView)
+        .function("getRecordCount", &TrajectoryRecorderWrapper::getRecordCount)
+        .function("getBytesWritten", &TrajectoryRecorderWrapper::getBytesWritten);
+
+    class_<RecordingChunkDecoderWrapper>("RecordingChunkDecoder")
+        .constructor<unsigned int, unsigned int, bool>()
+        .function("getInputView", &RecordingChunkDecoderWrapper::getInputView)
+        .function("decode", &RecordingChunkDecoderWrapper::decode)
+        .function("getOutputView", &RecordingChunkDecoderWrapper::getOutputView);
+
+    value_object<AllocationStatsJS>("AllocationStats")
+        .field("heapAllocations", &AllocationStatsJS::heapAllocations)
+        .field("heapFrees", &AllocationStatsJS::heapFrees)
+        .field("heapBytesInUse", &AllocationStatsJS::heapBytesInUse)
+        .field("arenaAllocations", &AllocationStatsJS::arenaAllocations);
+    function("getAllocationStats", &getAllocationStatsJS);
+
+    // Stage timers and counters (profiler.hpp; all zero unless built with profiling)
+    bindProfiler();
+
     // Thrust action constants
     constant("THRUST_IDLE", 0);
     constant("THRUST_GLIDE", 1);
     constant("THRUST_BOOST", 2);
     constant("THRUST_STABILIZE", 3);
+
+    // Integrator policy constants (setIntegrator)
+    constant("INTEGRATOR_SEMI_IMPLICIT_EULER", static_cast<int>(IntegratorType::SEMI_IMPLICIT_EULER));
+    constant("INTEGRATOR_VELOCITY_VERLET", static_cast<int>(IntegratorType::VELOCITY_VERLET));
+    constant("INTEGRATOR_RUNGE_KUTTA_4", static_cast<int>(IntegratorType::RUNGE_KUTTA_4));
+    constant("INTEGRATOR_EXACT_DAMPING", static_cast<int>(IntegratorType::EXACT_DAMPING));
+
+    // State buffer layout constants (float offsets within one body record)
+    constant("STATE_POSITION", static_cast<int>(StateLayout::POSITION));
+    constant("STATE_VELOCITY", static_cast<int>(StateLayout::VELOCITY));
+    constant("STATE_ROTATION", static_cast<int>(StateLayout::ROTATION));
+    constant("STATE_ANGULAR_VELOCITY", static_cast<int>(StateLayout::ANGULAR_VELOCITY));
+    constant("STATE_ROTATION_W", static_cast<int>(StateLayout::ROTATION_W));
+    constant("STATE_ROLL", static_cast<int>(StateLayout::ROLL));
+    constant("STATE_YAW", static_cast<int>(StateLayout::YAW));
+    constant("STATE_SPEED", static_cast<int>(StateLayout::SPEED));
+    constant("STATE_STRIDE", static_cast<int>(StateLayout::STRIDE));
+
+    // Command buffer layout (32-bit word offsets within one command) and opcodes
+    constant("COMMAND_OPCODE", static_cast<int>(CommandLayout::OPCODE));
+    constant("COMMAND_BODY", static_cast<int>(CommandLayout::BODY));
+    constant("COMMAND_ARGS", static_cast<int>(CommandLayout::ARGS));
+    constant("COMMAND_STRIDE", static_cast<int>(CommandLayout::STRIDE));
+    constant("COMMAND_NOP", static_cast<int>(CommandOp::NOP));
+    constant("COMMAND_SET_TARGET", static_cast<int>(CommandOp::SET_TARGET));
+    constant("COMMAND_APPLY_THRUST", static_cast<int>(CommandOp::APPLY_THRUST));
+    constant("COMMAND_APPLY_BANKING", static_cast<int>(CommandOp::APPLY_BANKING));
+    constant("COMMAND_STEP", static_cast<int>(CommandOp::STEP));
+    constant("COMMAND_RESET", static_cast<int>(CommandOp::RESET));
+    constant("COMMAND_THRUST_ALL", static_cast<int>(CommandOp::THRUST_ALL));
+
+    // Rollout result layout (float offsets within one candidate record)
+    constant("ROLLOUT_END_POSITION", static_cast<int>(RolloutLayout::END_POSITION));
+    constant("ROLLOUT_DISTANCE", static_cast<int>(RolloutLayout::DISTANCE));
+    constant("ROLLOUT_MIN_DISTANCE", static_cast<int>(RolloutLayout::MIN_DISTANCE));
+    constant("ROLLOUT_ENERGY", static_cast<int>(RolloutLayout::ENERGY));
+    constant("ROLLOUT_STRIDE", static_cast<int>(RolloutLayout::STRIDE));
+
+    // Recording file framing (bytes), see trajectory_recorder.hpp
+    constant("RECORDING_HEADER_BYTES", static_cast<int>(sizeof(RecordingHeader)));
+    constant("RECORDING_CHUNK_HEADER_BYTES", static_cast<int>(sizeof(RecordingChunkHeader)));
+    constant("RECORDING_DELTA", static_cast<int>(RECORDING_DELTA));
 }
@@ -0,0 +1,88 @@
+#include "command_buffer.hpp"
+
+namespace aeronav {
+
+namespace {
+
+// Action arrives as a float argument (same integers as applyThrustByName)
+ThrustAction actionArg(float value) {
+    return toThrustAction(static_cast<int>(value));
+}
+
+} // namespace
+
+size_t executeCommands(PhysicsEngine& engine, const PhysicsCommand* commands, size_t count,
+                       IntegratorType integrator) {
+    size_t executed = 0;
+    for (size_t i = 0; i < count; i++) {
+        const PhysicsCommand& command = commands[i];
+        const float* args = command.args;
+        switch (static_cast<CommandOp>(command.opcode)) {
+            case CommandOp::NOP:
+                break;
+            case CommandOp::SET_TARGET:
+                engine.setTarget(args[0], args[1], args[2]);
+                break;
+            case CommandOp::APPLY_THRUST:
+            case CommandOp::THRUST_ALL:
+                engine.applyThrust(actionArg(args[0]), args[1]);
+                break;
+            case CommandOp::APPLY_BANKING:
+                engine.applyBanking(args[0], args[1]);
+                break;
+            case CommandOp::STEP:
+                withIntegrator(integrator, [&](auto policy) { engine.stepWith<decltype(policy)>(args[0]); });
+                break;
+            case CommandOp::RESET:
+                engine.reset(args[0], args[1], args[2]);
+                break;
+            default:
+                continue;
+        }
+        executed++;
+    }
+    return executed;
+}
+
+size_t executeCommands(PhysicsWorld& world, const PhysicsCommand* commands, size_t count,
+                       IntegratorType integrator) {
+    size_t executed = 0;
+    const size_t bodyCount = world.getBodyCount();
+    for (size_t i = 0; i < count; i++) {
+        const PhysicsCommand& command = commands[i];
+        const float* args = command.args;
+        const CommandOp op = static_cast<CommandOp>(command.opcode);
+        const bool perBody = op == CommandOp::SET_TARGET || op == CommandOp::APPLY_THRUST ||
+                             op == CommandOp::APPLY_BANKING || op == CommandOp::RESET;
+        if (perBody && command.body >= bodyCount) continue;
+
+        switch (op) {
+            case CommandOp::NOP:
+                break;
+            case CommandOp::SET_TARGET:
+                world.setTarget(command.body, args[0], args[1], args[2]);
+                break;
+            case CommandOp::APPLY_THRUST:
+                world.applyThrust(command.body, actionArg(args[0]), args[1]);
+                break;
+            case CommandOp::APPLY_BANKING:
+                world.applyBanking(command.body, args[0], args[1]);
+                break;
+            case CommandOp::STEP:
+                withIntegrator(integrator, [&](auto policy) { world.stepAllWith<decltype(policy)>(args[0]); });
+                break;
+            case CommandOp::RESET:
+                world.resetBody(command.body, args[0], args[1], args[2]);
+                break;
+            case CommandOp::THRUST_ALL:
+                world.applyThrustAll(actionArg(args[0]), args[1]);
+                break;
+            default:
+                continue;
+        }
+        executed++;
+    }
+    return executed;
+}
+
+} // namespace aeronav
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "physics_engine.hpp"
+#include "physics_world.hpp"
+#include "integrators.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace aeronav {
+
+// Per-frame commands, executed in order
+enum class CommandOp : uint32_t {
+    NOP = 0,
+    SET_TARGET = 1,      // args: x, y, z
+    APPLY_THRUST = 2,    // args: action (0=IDLE .. 3=STABILIZE), intensity
+    APPLY_BANKING = 3,   // args: desiredRoll, rollFactor
+    STEP = 4,            // args: deltaTime (a PhysicsWorld steps every body; body is ignored)
+    RESET = 5,           // args: x, y, z
+    THRUST_ALL = 6       // args: action, intensity (every body; body is ignored)
+};
+
+// One packed command: 32-bit words, so JS fills a Uint32Array (opcode, body)
+// and a Float32Array (args) over the same memory
+struct PhysicsCommand {
+    uint32_t opcode;     // CommandOp
+    uint32_t body;       // PhysicsWorld body index (ignored by PhysicsEngine)
+    float args[4];
+};
+
+// Word offsets within one PhysicsCommand
+struct CommandLayout {
+    static constexpr size_t OPCODE = 0;
+    static constexpr size_t BODY = 1;
+    static constexpr size_t ARGS = 2;      // 4 floats
+    static constexpr size_t STRIDE = 6;    // words per command
+};
+
+static_assert(sizeof(PhysicsCommand) == CommandLayout::STRIDE * sizeof(uint32_t),
+              "command records must stay packed");
+static_assert(std::is_trivially_copyable<PhysicsCommand>::value, "commands are raw memory shared with JS");
+
+/**
+ * Run `count` commands against an engine or a world in one call
+ * Results land where the per-call API puts them (STEP and RESET refresh the
+ * state buffer). Unknown opcodes and out-of-range bodies are skipped; returns
+ * the number of commands executed. STEP uses `integrator`.
+ */
+size_t executeCommands(PhysicsEngine& engine, const PhysicsCommand* commands, size_t count,
+                       IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER);
+size_t executeCommands(PhysicsWorld& world, const PhysicsCommand* commands, size_t count,
+                       IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER);
+
+} // namespace aeronav
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace aeronav {
+
+// Kinematic state advanced by an integrator policy
+struct MotionState {
+    Vector3 position;
+    Vector3 velocity;
+    Quaternion rotation;
+    Vector3 angularVelocity;
+};
+
+// Per-step inputs (forces are held constant over the step)
+struct MotionInputs {
+    Vector3 linearAcceleration;    // F / m
+    Vector3 angularAcceleration;   // torque (unit moment of inertia)
+    float linearDamping;           // 1/s
+    float angularDamping;          // 1/s
+    float maxAngularVelocity;      // rad/s, 0 = unclamped
+};
+
+namespace detail {
+
+inline Vector3 clampAngularVelocity(const Vector3& angularVelocity, float maxAngularVelocity) {
+    return maxAngularVelocity > 0.0f ? angularVelocity.clampMagnitude(maxAngularVelocity) : angularVelocity;
+}
+
+// Rotate by a constant angular velocity over dt (axis-angle delta, then renormalize)
+inline Quaternion integrateRotation(const Quaternion& rotation, const Vector3& angularVelocity, float dt) {
+    if (angularVelocity.lengthSquared() <= 1e-10f) return rotation;
+    float angVelMag = angularVelocity.length();
+    Vector3 axis = angularVelocity / angVelMag;
+    return (rotation * Quaternion::fromAxisAngle(axis, angVelMag * dt)).normalized();
+}
+
+// dv/dt = a - k*v over dt with RK4; returns v(dt), meanVelocity = (1/dt) * integral of v
+inline Vector3 rk4Damped(const Vector3& v0, const Vector3& a, float k, float dt, Vector3& meanVelocity) {
+    const float halfDt = 0.5f * dt;
+    const Vector3 v1 = v0;
+    const Vector3 a1 = a - v1 * k;
+    const Vector3 v2 = v0 + a1 * halfDt;
+    const Vector3 a2 = a - v2 * k;
+    const Vector3 v3 = v0 + a2 * halfDt;
+    const Vector3 a3 = a - v3 * k;
+    const Vector3 v4 = v0 + a3 * dt;
+    const Vector3 a4 = a - v4 * k;
+    meanVelocity = (v1 + (v2 + v3) * 2.0f + v4) / 6.0f;
+    return v0 + (a1 + (a2 + a3) * 2.0f + a4) * (dt / 6.0f);
+}
+
+// dv/dt = a - k*v over dt in closed form; same outputs as rk4Damped
+inline Vector3 exactDamped(const Vector3& v0, const Vector3& a, float k, float dt, Vector3& meanVelocity) {
+    const float kdt = k * dt;
+    if (kdt < 1e-4f) {
+        // Second-order series (the closed form loses precision as k -> 0)
+        const Vector3 a0 = a - v0 * k;
+        meanVelocity = v0 + a0 * (0.5f * dt);
+        return v0 + a0 * dt;
+    }
+    const float decay = std::exp(-kdt);
+    const Vector3 terminal = a / k;
+    const Vector3 excess = v0 - terminal;
+    meanVelocity = terminal + excess * ((1.0f - decay) / kdt);
+    return terminal + excess * decay;
+}
+
+} // namespace detail
+
+/**
+ * Integrator policies for RigidBody::integrate / PhysicsEngine::stepWith /
+ * PhysicsWorld::stepAllWith
+ *
+ * All solve dv/dt = a - linearDamping*v, dx/dt = v (and the same for the
+ * angular pair and the rotation) with forces held over the step, then clamp
+ * the angular velocity. MAX_DELTA_TIME is the step each one is clamped to.
+ *
+ *   SemiImplicitEuler  velocity, then position from the new velocity; damping
+ *                      as the factor max(1 - k*dt, 0). The reference path.
+ *   VelocityVerlet     position from the start-of-step acceleration, velocity
+ *                      from the mean of start and predicted end acceleration
+ *   RungeKutta4        classic RK4 on the (x, v) and (q, w) pairs
+ *   ExactDamping       closed-form solution for constant force and linear
+ *                      damping (exact exponential decay at any dt)
+ */
+struct SemiImplicitEuler {
+    static constexpr float MAX_DELTA_TIME = 0.1f;
+
+    static void integrate(MotionState& s, const MotionInputs& in, float dt) {
+        s.velocity += in.linearAcceleration * dt;
+        s.angularVelocity += in.angularAcceleration * dt;
+        s.angularVelocity = detail::clampAngularVelocity(s.angularVelocity, in.maxAngularVelocity);
+
+        s.velocity *= std::max(1.0f - in.linearDamping * dt, 0.0f);
+        s.angularVelocity *= std::max(1.0f - in.angularDamping * dt, 0.0f);
+
+        s.position += s.velocity * dt;
+        s.rotation = detail::integrateRotation(s.rotation, s.angularVelocity, dt);
+    }
+};
+
+struct VelocityVerlet {
+    static constexpr float MAX_DELTA_TIME = 0.2f;
+
+    static void integrate(MotionState& s, const MotionInputs& in, float dt) {
+        const float halfDt = 0.5f * dt;
+
+        const Vector3 a0 = in.linearAcceleration - s.velocity * in.linearDamping;
+        s.position += (s.velocity + a0 * halfDt) * dt;
+        const Vector3 a1 = in.linearAcceleration - (s.velocity + a0 * dt) * in.linearDamping;
+        s.velocity += (a0 + a1) * halfDt;
+
+        const Vector3 w0 = s.angularVelocity;
+        const Vector3 alpha0 = in.angularAcceleration - w0 * in.angularDamping;
+        const Vector3 alpha1 = in.angularAcceleration - (w0 + alpha0 * dt) * in.angularDamping;
+        s.rotation = detail::integrateRotation(s.rotation, w0 + alpha0 * halfDt, dt);
+        s.angularVelocity = detail::clampAngularVelocity(w0 + (alpha0 + alpha1) * halfDt, in.maxAngularVelocity);
+    }
+};
+
+struct RungeKutta4 {
+    static constexpr float MAX_DELTA_TIME = 0.4f;
+
+    static void integrate(MotionState& s, const MotionInputs& in, float dt) {
+        Vector3 meanVelocity, meanAngularVelocity;
+        s.velocity = detail::rk4Damped(s.velocity, in.linearAcceleration, in.linearDamping, dt, meanVelocity);
+        s.position += meanVelocity * dt;
+
+        const Vector3 w = detail::rk4Damped(s.angularVelocity, in.angularAcceleration, in.angularDamping,
+                                            dt, meanAngularVelocity);
+        s.rotation = detail::integrateRotation(s.rotation, meanAngularVelocity, dt);
+        s.angularVelocity = detail::clampAngularVelocity(w, in.maxAngularVelocity);
+    }
+};
+
+struct ExactDamping {
+    static constexpr float MAX_DELTA_TIME = 0.4f;
+
+    static void integrate(MotionState& s, const MotionInputs& in, float dt) {
+        Vector3 meanVelocity, meanAngularVelocity;
+        s.velocity = detail::exactDamped(s.velocity, in.linearAcceleration, in.linearDamping, dt, meanVelocity);
+        s.position += meanVelocity * dt;
+
+        const Vector3 w = detail::exactDamped(s.angularVelocity, in.angularAcceleration, in.angularDamping,
+                                              dt, meanAngularVelocity);
+        s.rotation = detail::integrateRotation(s.rotation, meanAngularVelocity, dt);
+        s.angularVelocity = detail::clampAngularVelocity(w, in.maxAngularVelocity);
+    }
+};
+
+// Largest MAX_DELTA_TIME of any policy (bounds fixed-timestep rates)
+constexpr float MAX_INTEGRATOR_DELTA_TIME = 0.4f;
+
+// Runtime tag for bindings; native callers pick the policy type directly
+enum class IntegratorType : uint8_t {
+    SEMI_IMPLICIT_EULER = 0,
+    VELOCITY_VERLET = 1,
+    RUNGE_KUTTA_4 = 2,
+    EXACT_DAMPING = 3
+};
+
+// Call fn(Policy{}) for the policy named by type (one branch per call, not per body)
+template <typename Fn>
+void withIntegrator(IntegratorType type, Fn&& fn) {
+    switch (type) {
+        case IntegratorType::VELOCITY_VERLET: fn(VelocityVerlet{}); break;
+        case IntegratorType::RUNGE_KUTTA_4: fn(RungeKutta4{}); break;
+        case IntegratorType::EXACT_DAMPING: fn(ExactDamping{}); break;
+        case IntegratorType::SEMI_IMPLICIT_EULER:
+        default: fn(SemiImplicitEuler{}); break;
+    }
+}
+
+} // namespace aeronav
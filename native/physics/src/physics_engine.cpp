@@ -1,9 +1,30 @@
 #include "physics_engine.hpp"
+#include "profiler.hpp"
 #include <algorithm>
 #include <cmath>
 
 namespace aeronav {
 
+namespace {
+
+void storeVector(const Vector3& v, float out[3]) {
+    out[0] = v.x; out[1] = v.y; out[2] = v.z;
+}
+
+Vector3 loadVector(const float in[3]) {
+    return Vector3(in[0], in[1], in[2]);
+}
+
+void storeQuaternion(const Quaternion& q, float out[4]) {
+    out[0] = q.w; out[1] = q.x; out[2] = q.y; out[3] = q.z;
+}
+
+Quaternion loadQuaternion(const float in[4]) {
+    return Quaternion(in[0], in[1], in[2], in[3]);
+}
+
+} // namespace
+
 PhysicsEngine::PhysicsEngine()
     : body_()
     , config_()
@@ -15,6 +36,8 @@ PhysicsEngine::PhysicsEngine()
     body_.setAngularDamping(config_.angularDamping);
     body_.setDragCoefficient(config_.dragCoefficient);
     body_.setMaxAngularVelocity(config_.maxAngularVelocity);
+    updateStateBuffer();
+    resetAccumulator();
 }
 
 PhysicsEngine::PhysicsEngine(const SpaceshipConfig& config)
@@ -28,42 +51,198 @@ PhysicsEngine::PhysicsEngine(const SpaceshipConfig& config)
     body_.setAngularDamping(config_.angularDamping);
     body_.setDragCoefficient(config_.dragCoefficient);
     body_.setMaxAngularVelocity(config_.maxAngularVelocity);
+    updateStateBuffer();
+    resetAccumulator();
 }
 
 void PhysicsEngine::step(float deltaTime) {
-    // Clamp delta time to prevent instability (matching JS: max 0.1s)
-    deltaTime = std::min(deltaTime, 0.1f);
+    stepWith<SemiImplicitEuler>(deltaTime);
+}
+
+template <typename Integrator>
+void PhysicsEngine::stepWith(float deltaTime) {
+    AERONAV_PROFILE_SCOPE(PHYSICS_STEP);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, 1);
+
+    if (isFixedTimestep()) {
+        stepFixed<Integrator>(deltaTime);
+        return;
+    }
+
+    // Clamp delta time to prevent instability (Euler matches JS: max 0.1s)
+    deltaTime = std::min(deltaTime, Integrator::MAX_DELTA_TIME);
 
     if (deltaTime <= 0.0f) return;
 
     // Integrate physics
-    body_.integrate(deltaTime);
+    {
+        AERONAV_PROFILE_SCOPE(PHYSICS_INTEGRATE);
+        body_.integrate<Integrator>(deltaTime);
+    }
+    targetCacheValid_ = false;
+    updateStateBuffer();
 }
 
 void PhysicsEngine::reset(float x, float y, float z) {
     body_.reset();
     body_.setPosition(Vector3(x, y, z));
     targetPosition_ = Vector3::zero();
+    targetCacheValid_ = false;
+    updateStateBuffer();
+    resetAccumulator();
 }
 
-void PhysicsEngine::setTarget(float x, float y, float z) {
-    targetPosition_ = Vector3(x, y, z);
+void PhysicsEngine::setFixedTimestep(float rateHz, uint32_t maxSubSteps) {
+    // Sub-steps longer than the integrator's MAX_DELTA_TIME are clamped by the policy
+    fixedDeltaTime_ = rateHz > 0.0f ? 1.0f / std::max(rateHz, 1.0f / MAX_INTEGRATOR_DELTA_TIME) : 0.0f;
+    maxSubSteps_ = std::max(maxSubSteps, 1u);
+    resetAccumulator();
+}
+
+template <typename Integrator>
+void PhysicsEngine::stepFixed(float frameDeltaTime) {
+    lastSubSteps_ = 0;
+    if (frameDeltaTime <= 0.0f) return;
+
+    // Hold this frame's forces as impulse so frames that run no sub-step still count
+    heldForce_ += body_.getAccumulatedForce() * frameDeltaTime;
+    heldTorque_ += body_.getAccumulatedTorque() * frameDeltaTime;
+    heldTime_ += frameDeltaTime;
+    body_.clearForces();
+
+    accumulator_ += frameDeltaTime;
+    if (accumulator_ < fixedDeltaTime_) {
+        updateRenderBuffer();
+        return;
+    }
+
+    const Vector3 force = heldForce_ / heldTime_;
+    const Vector3 torque = heldTorque_ / heldTime_;
+    {
+        AERONAV_PROFILE_SCOPE(PHYSICS_INTEGRATE);
+        while (accumulator_ >= fixedDeltaTime_ && lastSubSteps_ < maxSubSteps_) {
+            previousPosition_ = body_.getPosition();
+            previousRotation_ = body_.getRotation();
+            body_.applyForce(force);
+            body_.applyTorque(torque);
+            body_.integrate<Integrator>(fixedDeltaTime_);
+            accumulator_ -= fixedDeltaTime_;
+            lastSubSteps_++;
+        }
+    }
+    heldForce_ = Vector3::zero();
+    heldTorque_ = Vector3::zero();
+    heldTime_ = 0.0f;
+
+    // Drop time the sub-step cap could not absorb (no spiral of death), keeping the phase
+    if (accumulator_ >= fixedDeltaTime_) {
+        accumulator_ = std::fmod(accumulator_, fixedDeltaTime_);
+    }
+    targetCacheValid_ = false;
+    updateStateBuffer();
+}
+
+void PhysicsEngine::resetAccumulator() {
+    accumulator_ = 0.0f;
+    lastSubSteps_ = 0;
+    previousPosition_ = body_.getPosition();
+    previousRotation_ = body_.getRotation();
+    heldForce_ = Vector3::zero();
+    heldTorque_ = Vector3::zero();
+    heldTime_ = 0.0f;
+    updateRenderBuffer();
+}
+
+void PhysicsEngine::saveSnapshot(PhysicsEngineSnapshot& out) const {
+    out.header = makeSnapshotHeader(SnapshotKind::PHYSICS_ENGINE, PhysicsEngineSnapshot::VERSION,
+                                    sizeof(PhysicsEngineSnapshot));
+
+    const MotionState state = body_.getMotionState();
+    storeVector(state.position, out.position);
+    storeVector(state.velocity, out.velocity);
+    storeQuaternion(state.rotation, out.rotation);
+    storeVector(state.angularVelocity, out.angularVelocity);
+    storeVector(body_.getAccumulatedForce(), out.force);
+    storeVector(body_.getAccumulatedTorque(), out.torque);
+    storeVector(targetPosition_, out.target);
+    out.config = config_;
+
+    out.fixedDeltaTime = fixedDeltaTime_;
+    out.maxSubSteps = maxSubSteps_;
+    out.lastSubSteps = lastSubSteps_;
+    out.accumulator = accumulator_;
+    storeVector(previousPosition_, out.previousPosition);
+    storeQuaternion(previousRotation_, out.previousRotation);
+    storeVector(heldForce_, out.heldForce);
+    storeVector(heldTorque_, out.heldTorque);
+    out.heldTime = heldTime_;
 }
 
-Vector3 PhysicsEngine::getDirectionToTarget() const {
-    Vector3 direction = targetPosition_ - body_.getPosition();
-    float length = direction.length();
-    if (length > 1e-6f) {
-        return direction / length;
+bool PhysicsEngine::restoreSnapshot(const PhysicsEngineSnapshot& snapshot) {
+    const SnapshotHeader& header = snapshot.header;
+    if (header.magic != SNAPSHOT_MAGIC || header.kind != SnapshotKind::PHYSICS_ENGINE ||
+        header.version != PhysicsEngineSnapshot::VERSION || header.size != sizeof(PhysicsEngineSnapshot)) {
+        return false;
     }
-    return Vector3::zero();
+
+    setConfig(snapshot.config);
+    MotionState state;
+    state.position = loadVector(snapshot.position);
+    state.velocity = loadVector(snapshot.velocity);
+    state.rotation = loadQuaternion(snapshot.rotation);
+    state.angularVelocity = loadVector(snapshot.angularVelocity);
+    body_.setMotionState(state);
+    body_.clearForces();
+    body_.applyForce(loadVector(snapshot.force));
+    body_.applyTorque(loadVector(snapshot.torque));
+    targetPosition_ = loadVector(snapshot.target);
+    targetCacheValid_ = false;
+
+    fixedDeltaTime_ = snapshot.fixedDeltaTime;
+    maxSubSteps_ = snapshot.maxSubSteps;
+    lastSubSteps_ = snapshot.lastSubSteps;
+    accumulator_ = snapshot.accumulator;
+    previousPosition_ = loadVector(snapshot.previousPosition);
+    previousRotation_ = loadQuaternion(snapshot.previousRotation);
+    heldForce_ = loadVector(snapshot.heldForce);
+    heldTorque_ = loadVector(snapshot.heldTorque);
+    heldTime_ = snapshot.heldTime;
+
+    updateStateBuffer();
+    return true;
+}
+
+float PhysicsEngine::getInterpolationAlpha() const {
+    return isFixedTimestep() ? accumulator_ / fixedDeltaTime_ : 1.0f;
+}
+
+Vector3 PhysicsEngine::getInterpolatedPosition() const {
+    if (!isFixedTimestep()) return body_.getPosition();
+    return Vector3::lerp(previousPosition_, body_.getPosition(), getInterpolationAlpha());
 }
 
-float PhysicsEngine::getDistanceToTarget() const {
-    return (targetPosition_ - body_.getPosition()).length();
+Quaternion PhysicsEngine::getInterpolatedRotation() const {
+    if (!isFixedTimestep()) return body_.getRotation();
+    return Quaternion::nlerp(previousRotation_, body_.getRotation(), getInterpolationAlpha());
+}
+
+void PhysicsEngine::setTarget(float x, float y, float z) {
+    targetPosition_ = Vector3(x, y, z);
+    targetCacheValid_ = false;
+}
+
+// One square root for both (the direction is the same toTarget / length as before)
+void PhysicsEngine::refreshTargetCache() {
+    if (targetCacheValid_) return;
+    const Vector3 toTarget = targetPosition_ - body_.getPosition();
+    targetDistance_ = toTarget.length();
+    targetDirection_ = targetDistance_ > 1e-6f ? toTarget / targetDistance_ : Vector3::zero();
+    targetCacheValid_ = true;
 }
 
 void PhysicsEngine::applyDragForce() {
+    AERONAV_PROFILE_SCOPE(PHYSICS_DRAG);
     Vector3 velocity = body_.getVelocity();
     float speed = velocity.length();
     if (speed > 1e-6f) {
@@ -75,50 +254,26 @@ void PhysicsEngine::applyDragForce() {
 }
 
 void PhysicsEngine::applyThrust(ThrustAction action, float intensity) {
-    float distance = getDistanceToTarget();
+    AERONAV_PROFILE_SCOPE(PHYSICS_THRUST);
+    refreshTargetCache();
 
     // Don't apply thrust if very close to target (matching JS: 0.1)
-    if (distance <= 0.1f) return;
+    if (targetDistance_ <= 0.1f) return;
 
-    Vector3 direction = getDirectionToTarget();
+    // Multipliers and side effects per action come from THRUST_TRAITS
+    const ThrustTraits& traits = thrustTraits(action);
     Vector3 force = Vector3::zero();
-
-    switch (action) {
-        case ThrustAction::BOOST:
-            // Maximum thrust towards target (1.5x multiplier)
-            {
-                float boostForce = config_.maxThrust * intensity * 1.5f;
-                force = direction * boostForce;
-            }
-            break;
-
-        case ThrustAction::GLIDE:
-            // Minimal thrust, mostly coasting (0.3x multiplier)
-            {
-                float glideForce = config_.maxThrust * intensity * 0.3f;
-                force = direction * glideForce;
-                // Apply additional drag during glide
-                applyDragForce();
-            }
-            break;
-
-        case ThrustAction::STABILIZE:
-            // Stabilizing thrust with angular damping (0.5x multiplier)
-            {
-                float stabilizeForce = config_.maxThrust * intensity * 0.5f;
-                force = direction * stabilizeForce;
-
-                // Apply extra angular damping for stabilization
-                Vector3 angVel = body_.getAngularVelocity();
-                body_.setAngularVelocity(angVel * 0.7f);
-            }
-            break;
-
-        case ThrustAction::IDLE:
-        default:
-            // Just apply drag
-            applyDragForce();
-            break;
+    if (traits.thrustScale != 0.0f) {
+        float thrustForce = config_.maxThrust * intensity * traits.thrustScale;
+        force = targetDirection_ * thrustForce;
+    }
+    if (traits.applyDrag) {
+        applyDragForce();
+    }
+    if (traits.angularDamping != 1.0f) {
+        Vector3 angVel = body_.getAngularVelocity();
+        body_.setAngularVelocity(angVel * traits.angularDamping);
+        updateStateBuffer();
     }
 
     if (force.lengthSquared() > 1e-6f) {
@@ -127,15 +282,7 @@ void PhysicsEngine::applyThrust(ThrustAction action, float intensity) {
 }
 
 void PhysicsEngine::applyThrustByName(int action, float intensity) {
-    ThrustAction thrustAction;
-    switch (action) {
-        case 0: thrustAction = ThrustAction::IDLE; break;
-        case 1: thrustAction = ThrustAction::GLIDE; break;
-        case 2: thrustAction = ThrustAction::BOOST; break;
-        case 3: thrustAction = ThrustAction::STABILIZE; break;
-        default: thrustAction = ThrustAction::IDLE; break;
-    }
-    applyThrust(thrustAction, intensity);
+    applyThrust(toThrustAction(action), intensity);
 }
 
 void PhysicsEngine::applyBanking(float desiredRoll, float rollFactor) {
@@ -161,31 +308,56 @@ PhysicsState PhysicsEngine::getState() const {
     return state;
 }
 
+void PhysicsEngine::updateStateBuffer() {
+    writeStateRecord(stateBuffer_, body_.getPosition(), body_.getVelocity(),
+                     body_.getRotation(), body_.getAngularVelocity());
+    // Every body change lands here, so this is the one place the cache goes stale
+    derivedValid_ = false;
+    if (derivedExport_) {
+        refreshDerived();
+        writeDerivedRecord(stateBuffer_, roll_, yaw_, speed_);
+    }
+    updateRenderBuffer();
+}
+
+void PhysicsEngine::setDerivedStateExport(bool enabled) {
+    derivedExport_ = enabled;
+    updateStateBuffer();
+}
+
+void PhysicsEngine::updateRenderBuffer() {
+    writeStateRecord(renderBuffer_, getInterpolatedPosition(), body_.getVelocity(),
+                     getInterpolatedRotation(), body_.getAngularVelocity());
+}
+
+void PhysicsEngine::refreshDerived() const {
+    if (derivedValid_) return;
+    const Vector3 euler = body_.getRotation().toEuler();
+    roll_ = euler.x;
+    pitch_ = euler.y;
+    yaw_ = euler.z;
+    speed_ = body_.getSpeed();
+    derivedValid_ = true;
+}
+
 float PhysicsEngine::getRoll() const {
-    Quaternion q = body_.getRotation();
-    float sinr_cosp = 2.0f * (q.w * q.x + q.y * q.z);
-    float cosr_cosp = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
-    return std::atan2(sinr_cosp, cosr_cosp);
+    refreshDerived();
+    return roll_;
 }
 
 float PhysicsEngine::getPitch() const {
-    Quaternion q = body_.getRotation();
-    float sinp = 2.0f * (q.w * q.y - q.z * q.x);
-    if (std::abs(sinp) >= 1.0f) {
-        return std::copysign(3.14159265358979f * 0.5f, sinp);
-    }
-    return std::asin(sinp);
+    refreshDerived();
+    return pitch_;
 }
 
 float PhysicsEngine::getYaw() const {
-    Quaternion q = body_.getRotation();
-    float siny_cosp = 2.0f * (q.w * q.z + q.x * q.y);
-    float cosy_cosp = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
-    return std::atan2(siny_cosp, cosy_cosp);
+    refreshDerived();
+    return yaw_;
 }
 
 float PhysicsEngine::getSpeed() const {
-    return body_.getVelocity().length();
+    refreshDerived();
+    return speed_;
 }
 
 void PhysicsEngine::setConfig(const SpaceshipConfig& config) {
@@ -226,4 +398,10 @@ void PhysicsEngine::setDragCoefficient(float drag) {
     body_.setDragCoefficient(drag);
 }
 
+// Integrator policies available to stepWith()
+template void PhysicsEngine::stepWith<SemiImplicitEuler>(float);
+template void PhysicsEngine::stepWith<VelocityVerlet>(float);
+template void PhysicsEngine::stepWith<RungeKutta4>(float);
+template void PhysicsEngine::stepWith<ExactDamping>(float);
+
 } // namespace aeronav
@@ -3,17 +3,14 @@
 #include "vector3.hpp"
 #include "quaternion.hpp"
 #include "rigid_body.hpp"
+#include "thrust_action.hpp"
+#include "snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace aeronav {
 
-// Thrust action types (matching JS implementation)
-enum class ThrustAction {
-    IDLE = 0,
-    GLIDE = 1,
-    BOOST = 2,
-    STABILIZE = 3
-};
-
 // Configuration for the spaceship physics
 struct SpaceshipConfig {
     float mass = 1000.0f;           // kg
@@ -32,13 +29,88 @@ struct PhysicsState {
     Vector3 angularVelocity;
 };
 
+// Flat float32 state record layout shared with JS (one record per body)
+struct StateLayout {
+    static constexpr size_t POSITION = 0;          // x, y, z
+    static constexpr size_t VELOCITY = 3;          // x, y, z
+    static constexpr size_t ROTATION = 6;          // quaternion x, y, z (matching PhysicsState)
+    static constexpr size_t ANGULAR_VELOCITY = 9;  // x, y, z
+    static constexpr size_t ROTATION_W = 12;       // quaternion w
+    static constexpr size_t ROLL = 13;             // derived, radians (0 unless derived export is on)
+    static constexpr size_t YAW = 14;              // derived, radians
+    static constexpr size_t SPEED = 15;            // derived, m/s
+    static constexpr size_t STRIDE = 16;           // floats per record
+};
+
+// Derived slots of a record, from the same math as PhysicsEngine::getRoll/getYaw/getSpeed
+inline void writeDerivedRecord(float* record, float roll, float yaw, float speed) {
+    record[StateLayout::ROLL] = roll;
+    record[StateLayout::YAW] = yaw;
+    record[StateLayout::SPEED] = speed;
+}
+
+// Write one StateLayout record
+inline void writeStateRecord(float* record, const Vector3& position, const Vector3& velocity,
+                             const Quaternion& rotation, const Vector3& angularVelocity) {
+    record[StateLayout::POSITION + 0] = position.x;
+    record[StateLayout::POSITION + 1] = position.y;
+    record[StateLayout::POSITION + 2] = position.z;
+    record[StateLayout::VELOCITY + 0] = velocity.x;
+    record[StateLayout::VELOCITY + 1] = velocity.y;
+    record[StateLayout::VELOCITY + 2] = velocity.z;
+    record[StateLayout::ROTATION + 0] = rotation.x;
+    record[StateLayout::ROTATION + 1] = rotation.y;
+    record[StateLayout::ROTATION + 2] = rotation.z;
+    record[StateLayout::ANGULAR_VELOCITY + 0] = angularVelocity.x;
+    record[StateLayout::ANGULAR_VELOCITY + 1] = angularVelocity.y;
+    record[StateLayout::ANGULAR_VELOCITY + 2] = angularVelocity.z;
+    record[StateLayout::ROTATION_W] = rotation.w;
+    for (size_t i = StateLayout::ROTATION_W + 1; i < StateLayout::STRIDE; i++) {
+        record[i] = 0.0f;
+    }
+}
+
+// Complete PhysicsEngine state as one POD record (memcpy-able, see snapshot.hpp)
+struct PhysicsEngineSnapshot {
+    static constexpr uint16_t VERSION = 1;
+
+    SnapshotHeader header;
+
+    // Body
+    float position[3];
+    float velocity[3];
+    float rotation[4];          // w, x, y, z
+    float angularVelocity[3];
+    float force[3];             // accumulated since the last step
+    float torque[3];
+    float target[3];
+    SpaceshipConfig config;
+
+    // Fixed-timestep state
+    float fixedDeltaTime;
+    uint32_t maxSubSteps;
+    uint32_t lastSubSteps;
+    float accumulator;
+    float previousPosition[3];
+    float previousRotation[4];  // w, x, y, z
+    float heldForce[3];
+    float heldTorque[3];
+    float heldTime;
+};
+
+static_assert(std::is_trivially_copyable<PhysicsEngineSnapshot>::value,
+              "engine snapshots must be memcpy-able");
+
 class PhysicsEngine {
 public:
     PhysicsEngine();
     explicit PhysicsEngine(const SpaceshipConfig& config);
 
-    // Core simulation
+    // Core simulation. step() uses SemiImplicitEuler; stepWith<Policy>() takes
+    // any integrators.hpp policy (instantiated in physics_engine.cpp)
     void step(float deltaTime);
+    template <typename Integrator>
+    void stepWith(float deltaTime);
     void reset(float x = 0.0f, float y = 0.0f, float z = 0.0f);
 
     // Target navigation
@@ -50,13 +122,43 @@ public:
     void applyThrustByName(int action, float intensity = 1.0f); // For WASM binding
     void applyBanking(float desiredRoll, float rollFactor = 0.1f);
 
-    // State queries
+    // Fixed-timestep mode (off by default: step() integrates the frame delta once).
+    // step() then feeds a time accumulator and integrates in 1/rateHz sub-steps,
+    // at most maxSubSteps per call; time beyond that is dropped. Forces applied
+    // between calls are time-averaged and act on every sub-step that follows.
+    void setFixedTimestep(float rateHz, uint32_t maxSubSteps = 4);  // rateHz <= 0 disables
+    bool isFixedTimestep() const { return fixedDeltaTime_ > 0.0f; }
+    float getFixedDeltaTime() const { return fixedDeltaTime_; }
+    uint32_t getMaxSubSteps() const { return maxSubSteps_; }
+    uint32_t getLastSubStepCount() const { return lastSubSteps_; }
+
+    // Render state between the last two sub-steps (the current state when not fixed).
+    // Alpha is the leftover accumulator as a fraction of the fixed step, in [0, 1)
+    // (1 when not fixed).
+    float getInterpolationAlpha() const;
+    Vector3 getInterpolatedPosition() const;
+    Quaternion getInterpolatedRotation() const;
+    const float* getRenderStateBuffer() const { return renderBuffer_; } // StateLayout, refreshed by step()/reset()
+
+    // Snapshot / restore of the full engine state (bit-exact on the same build).
+    // restoreSnapshot() rejects a header of another kind, version or size.
+    void saveSnapshot(PhysicsEngineSnapshot& out) const;
+    bool restoreSnapshot(const PhysicsEngineSnapshot& snapshot);
+
+    // State queries. Roll, pitch, yaw and speed are computed at most once per
+    // state change (step, reset, restore) and cached until the next one
     PhysicsState getState() const;
+    const float* getStateBuffer() const { return stateBuffer_; } // Refreshed by step()/reset()
     float getRoll() const;
     float getPitch() const;
     float getYaw() const;
     float getSpeed() const;
 
+    // While on, every state buffer refresh also fills StateLayout::ROLL/YAW/SPEED,
+    // so readers of the buffer need no getter calls (off: those slots stay 0)
+    void setDerivedStateExport(bool enabled);
+    bool isDerivedStateExport() const { return derivedExport_; }
+
     // Direct state access
     Vector3 getPosition() const { return body_.getPosition(); }
     Vector3 getVelocity() const { return body_.getVelocity(); }
@@ -80,9 +182,45 @@ private:
     SpaceshipConfig config_;
     Vector3 targetPosition_;
 
+    // Flat state record (StateLayout), stable for the lifetime of the engine
+    alignas(16) float stateBuffer_[StateLayout::STRIDE];
+
+    // Fixed-timestep state
+    float fixedDeltaTime_ = 0.0f;   // 0 = variable step
+    uint32_t maxSubSteps_ = 4;
+    uint32_t lastSubSteps_ = 0;
+    float accumulator_ = 0.0f;
+    Vector3 previousPosition_;
+    Quaternion previousRotation_;
+    Vector3 heldForce_;             // sum of force * frame time since the last sub-step
+    Vector3 heldTorque_;
+    float heldTime_ = 0.0f;
+
+    // Interpolated render record (StateLayout)
+    alignas(16) float renderBuffer_[StateLayout::STRIDE];
+
+    // Direction and distance to the target, recomputed once after the body or
+    // the target moves (applyThrust reads them on every call)
+    Vector3 targetDirection_;
+    float targetDistance_ = 0.0f;
+    bool targetCacheValid_ = false;
+
+    // Euler angles and speed of the current state (valid until the state buffer is refreshed)
+    mutable float roll_ = 0.0f;
+    mutable float pitch_ = 0.0f;
+    mutable float yaw_ = 0.0f;
+    mutable float speed_ = 0.0f;
+    mutable bool derivedValid_ = false;
+    bool derivedExport_ = false;
+
+    template <typename Integrator>
+    void stepFixed(float frameDeltaTime);
+    void resetAccumulator();
     void applyDragForce();
-    Vector3 getDirectionToTarget() const;
-    float getDistanceToTarget() const;
+    void updateStateBuffer();
+    void updateRenderBuffer();
+    void refreshTargetCache();
+    void refreshDerived() const;
 };
 
 } // namespace aeronav
@@ -0,0 +1,483 @@
+#include "physics_world.hpp"
+#include "simd_integrator.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace aeronav {
+
+PhysicsWorld::PhysicsWorld()
+    : count_(0)
+    , derivedExport_(false)
+    , proximityRadius_(0.0f)
+    , proximityDirty_(true)
+{
+}
+
+PhysicsWorld::PhysicsWorld(size_t maxBodies)
+    : count_(0)
+    , derivedExport_(false)
+    , proximityRadius_(0.0f)
+    , proximityDirty_(true)
+{
+    reserve(maxBodies);
+}
+
+template <typename Self, typename Fn>
+void PhysicsWorld::forEachBodyArray(Self& self, Fn&& fn) {
+    for (auto* arr : { &self.px_, &self.py_, &self.pz_, &self.vx_, &self.vy_, &self.vz_,
+                       &self.qw_, &self.qx_, &self.qy_, &self.qz_, &self.wx_, &self.wy_, &self.wz_,
+                       &self.fx_, &self.fy_, &self.fz_, &self.tx_, &self.ty_, &self.tz_,
+                       &self.mass_, &self.maxThrust_, &self.maxAngularVelocity_,
+                       &self.linearDamping_, &self.angularDamping_, &self.dragCoefficient_,
+                       &self.targetX_, &self.targetY_, &self.targetZ_ }) {
+        fn(*arr);
+    }
+}
+
+void PhysicsWorld::reserve(size_t capacity) {
+    size_t arrays = 0;
+    forEachBodyArray(*this, [&arrays](const ArenaVector<float>&) { arrays++; });
+    const size_t stateFloats = capacity * StateLayout::STRIDE;
+    const size_t pairWords = 2 * capacity;
+    auto arena = std::make_shared<Arena>(arrays * Arena::bytesFor<float>(capacity) +
+                                         Arena::bytesFor<float>(stateFloats) +
+                                         Arena::bytesFor<uint32_t>(pairWords) +
+                                         SpatialHash::arenaBytesFor(capacity));
+
+    forEachBodyArray(*this, [&arena, capacity](ArenaVector<float>& values) {
+        reserveInArena(values, arena, capacity);
+    });
+    reserveInArena(stateBuffer_, arena, stateFloats);
+    reserveInArena(proximityPairs_, arena, pairWords);
+    proximity_.reserve(capacity, arena);
+}
+
+uint32_t PhysicsWorld::createBody(const SpaceshipConfig& config) {
+    // State: at origin, identity rotation, at rest
+    for (auto* arr : { &px_, &py_, &pz_, &vx_, &vy_, &vz_,
+                       &qx_, &qy_, &qz_, &wx_, &wy_, &wz_,
+                       &fx_, &fy_, &fz_, &tx_, &ty_, &tz_,
+                       &targetX_, &targetY_, &targetZ_ }) {
+        arr->push_back(0.0f);
+    }
+    qw_.push_back(1.0f);
+
+    // Configuration
+    mass_.push_back(config.mass);
+    maxThrust_.push_back(config.maxThrust);
+    maxAngularVelocity_.push_back(config.maxAngularVelocity);
+    linearDamping_.push_back(config.linearDamping);
+    angularDamping_.push_back(config.angularDamping);
+    dragCoefficient_.push_back(config.dragCoefficient);
+
+    uint32_t index = static_cast<uint32_t>(count_++);
+    stateBuffer_.resize(count_ * StateLayout::STRIDE, 0.0f);
+    updateStateRecord(index);
+    proximityDirty_ = true;
+    return index;
+}
+
+void PhysicsWorld::clear() {
+    forEachBodyArray(*this, [](ArenaVector<float>& values) { values.clear(); });
+    stateBuffer_.clear();
+    proximityPairs_.clear();
+    count_ = 0;
+    proximityDirty_ = true;
+}
+
+BodyArrays PhysicsWorld::getArrays() {
+    BodyArrays arrays;
+    arrays.px = px_.data(); arrays.py = py_.data(); arrays.pz = pz_.data();
+    arrays.vx = vx_.data(); arrays.vy = vy_.data(); arrays.vz = vz_.data();
+    arrays.qw = qw_.data(); arrays.qx = qx_.data(); arrays.qy = qy_.data(); arrays.qz = qz_.data();
+    arrays.wx = wx_.data(); arrays.wy = wy_.data(); arrays.wz = wz_.data();
+    arrays.fx = fx_.data(); arrays.fy = fy_.data(); arrays.fz = fz_.data();
+    arrays.tx = tx_.data(); arrays.ty = ty_.data(); arrays.tz = tz_.data();
+    arrays.mass = mass_.data();
+    arrays.linearDamping = linearDamping_.data();
+    arrays.angularDamping = angularDamping_.data();
+    arrays.maxAngularVelocity = maxAngularVelocity_.data();
+    arrays.count = count_;
+    return arrays;
+}
+
+void PhysicsWorld::stepAll(float deltaTime) {
+    stepAllWith<SemiImplicitEuler>(deltaTime);
+}
+
+template <typename Integrator>
+void PhysicsWorld::stepAllWith(float deltaTime) {
+    // Clamp delta time to prevent instability (matching PhysicsEngine::step)
+    deltaTime = std::min(deltaTime, Integrator::MAX_DELTA_TIME);
+
+    if (deltaTime <= 0.0f || count_ == 0) return;
+
+    AERONAV_PROFILE_SCOPE(PHYSICS_STEP);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, count_);
+    {
+        AERONAV_PROFILE_SCOPE(PHYSICS_INTEGRATE);
+        integrateBodies<Integrator>(getArrays(), deltaTime);
+    }
+    updateStateBuffer();
+
+    proximityDirty_ = true;
+    if (proximityRadius_ > 0.0f) syncProximity();
+}
+
+size_t PhysicsWorld::getSnapshotSize() const {
+    size_t arrays = 0;
+    forEachBodyArray(*this, [&arrays](const ArenaVector<float>&) { arrays++; });
+    return sizeof(SnapshotHeader) + sizeof(uint64_t) + sizeof(float) + arrays * count_ * sizeof(float);
+}
+
+size_t PhysicsWorld::saveSnapshot(uint8_t* out, size_t capacity) const {
+    const size_t size = getSnapshotSize();
+    if (out == nullptr || capacity < size) return 0;
+
+    SnapshotWriter writer(out);
+    writer.write(makeSnapshotHeader(SnapshotKind::PHYSICS_WORLD, SNAPSHOT_VERSION, size));
+    writer.write(static_cast<uint64_t>(count_));
+    writer.write(proximityRadius_);
+    forEachBodyArray(*this, [&writer](const ArenaVector<float>& values) {
+        writer.writeArray(values.data(), values.size());
+    });
+    return writer.size();
+}
+
+bool PhysicsWorld::restoreSnapshot(const uint8_t* data, size_t size) {
+    SnapshotHeader header;
+    if (!checkSnapshotHeader(data, size, SnapshotKind::PHYSICS_WORLD, SNAPSHOT_VERSION, header)) return false;
+
+    SnapshotReader reader(data);
+    reader.read(header);
+    uint64_t count = 0;
+    float proximityRadius = 0.0f;
+    if (size < sizeof(SnapshotHeader) + sizeof(count) + sizeof(proximityRadius)) return false;
+    reader.read(count);
+    reader.read(proximityRadius);
+
+    size_t arrays = 0;
+    forEachBodyArray(*this, [&arrays](ArenaVector<float>&) { arrays++; });
+    if (count > size || reader.offset() + arrays * count * sizeof(float) != size) return false;
+
+    count_ = static_cast<size_t>(count);
+    forEachBodyArray(*this, [&reader, this](ArenaVector<float>& values) {
+        values.resize(count_);
+        reader.readArray(values.data(), count_);
+    });
+    stateBuffer_.resize(count_ * StateLayout::STRIDE, 0.0f);
+    updateStateBuffer();
+
+    setProximityRadius(proximityRadius);
+    proximityPairs_.clear();
+    return true;
+}
+
+void PhysicsWorld::setProximityRadius(float radius) {
+    proximityRadius_ = std::max(0.0f, radius);
+    if (proximityRadius_ > 0.0f) proximity_.setCellSize(proximityRadius_);
+    proximityDirty_ = true;
+}
+
+void PhysicsWorld::syncProximity() {
+    if (!proximityDirty_) return;
+    proximity_.update(px_.data(), py_.data(), pz_.data(), count_);
+    proximityDirty_ = false;
+}
+
+size_t PhysicsWorld::findProximityPairs() {
+    proximityPairs_.clear();
+    if (proximityRadius_ <= 0.0f) return 0;
+
+    AERONAV_PROFILE_SCOPE(PHYSICS_PROXIMITY);
+    syncProximity();
+    proximity_.forEachPair(proximityRadius_, [this](uint32_t i, uint32_t j, float) {
+        proximityPairs_.push_back(i);
+        proximityPairs_.push_back(j);
+    });
+    AERONAV_PROFILE_COUNT(EVENTS, proximityPairs_.size() / 2);
+    return proximityPairs_.size() / 2;
+}
+
+size_t PhysicsWorld::findNeighbors(uint32_t index, float radius, std::vector<uint32_t>& out) {
+    out.clear();
+    if (index >= count_ || radius <= 0.0f) return 0;
+
+    // Without a broadphase (or for radii past the cell size) a linear scan is as cheap
+    if (proximityRadius_ <= 0.0f || radius > proximityRadius_) {
+        const float radiusSq = radius * radius;
+        for (uint32_t j = 0; j < count_; j++) {
+            const float dx = px_[j] - px_[index], dy = py_[j] - py_[index], dz = pz_[j] - pz_[index];
+            if (j != index && dx * dx + dy * dy + dz * dz <= radiusSq) out.push_back(j);
+        }
+        return out.size();
+    }
+
+    syncProximity();
+    proximity_.forEachNeighbor(px_[index], py_[index], pz_[index], radius, [&](uint32_t j, float) {
+        if (j != index) out.push_back(j);
+    });
+    std::sort(out.begin(), out.end());
+    return out.size();
+}
+
+void PhysicsWorld::updateStateBuffer() {
+    float* record = stateBuffer_.data();
+    for (size_t i = 0; i < count_; i++, record += StateLayout::STRIDE) {
+        record[StateLayout::POSITION + 0] = px_[i];
+        record[StateLayout::POSITION + 1] = py_[i];
+        record[StateLayout::POSITION + 2] = pz_[i];
+        record[StateLayout::VELOCITY + 0] = vx_[i];
+        record[StateLayout::VELOCITY + 1] = vy_[i];
+        record[StateLayout::VELOCITY + 2] = vz_[i];
+        record[StateLayout::ROTATION + 0] = qx_[i];
+        record[StateLayout::ROTATION + 1] = qy_[i];
+        record[StateLayout::ROTATION + 2] = qz_[i];
+        record[StateLayout::ANGULAR_VELOCITY + 0] = wx_[i];
+        record[StateLayout::ANGULAR_VELOCITY + 1] = wy_[i];
+        record[StateLayout::ANGULAR_VELOCITY + 2] = wz_[i];
+        record[StateLayout::ROTATION_W] = qw_[i];
+    }
+    if (derivedExport_) updateDerivedState(0, count_);
+}
+
+void PhysicsWorld::updateStateRecord(uint32_t index) {
+    writeStateRecord(&stateBuffer_[index * StateLayout::STRIDE], getPosition(index),
+                     getVelocity(index), getRotation(index), getAngularVelocity(index));
+    if (derivedExport_) updateDerivedState(index, index + 1);
+}
+
+// Same expressions as Quaternion::toEuler and Vector3::length, so the slots
+// match getRoll()/getSpeed() exactly; pitch (the asin) is not exported
+void PhysicsWorld::updateDerivedState(size_t begin, size_t end) {
+    float* record = stateBuffer_.data() + begin * StateLayout::STRIDE;
+    for (size_t i = begin; i < end; i++, record += StateLayout::STRIDE) {
+        const float w = qw_[i], x = qx_[i], y = qy_[i], z = qz_[i];
+        const float sinrCosp = 2.0f * (w * x + y * z);
+        const float cosrCosp = 1.0f - 2.0f * (x * x + y * y);
+        const float sinyCosp = 2.0f * (w * z + x * y);
+        const float cosyCosp = 1.0f - 2.0f * (y * y + z * z);
+        const float speed = std::sqrt(vx_[i] * vx_[i] + vy_[i] * vy_[i] + vz_[i] * vz_[i]);
+        writeDerivedRecord(record, std::atan2(sinrCosp, cosrCosp), std::atan2(sinyCosp, cosyCosp), speed);
+    }
+}
+
+void PhysicsWorld::setDerivedStateExport(bool enabled) {
+    derivedExport_ = enabled;
+    if (enabled) {
+        updateDerivedState(0, count_);
+        return;
+    }
+    float* record = stateBuffer_.data();
+    for (size_t i = 0; i < count_; i++, record += StateLayout::STRIDE) {
+        writeDerivedRecord(record, 0.0f, 0.0f, 0.0f);
+    }
+}
+
+void PhysicsWorld::resetBody(uint32_t index, float x, float y, float z) {
+    if (index >= count_) return;
+    px_[index] = x; py_[index] = y; pz_[index] = z;
+    vx_[index] = 0.0f; vy_[index] = 0.0f; vz_[index] = 0.0f;
+    qw_[index] = 1.0f; qx_[index] = 0.0f; qy_[index] = 0.0f; qz_[index] = 0.0f;
+    wx_[index] = 0.0f; wy_[index] = 0.0f; wz_[index] = 0.0f;
+    fx_[index] = 0.0f; fy_[index] = 0.0f; fz_[index] = 0.0f;
+    tx_[index] = 0.0f; ty_[index] = 0.0f; tz_[index] = 0.0f;
+    targetX_[index] = 0.0f; targetY_[index] = 0.0f; targetZ_[index] = 0.0f;
+    updateStateRecord(index);
+    proximityDirty_ = true;
+}
+
+void PhysicsWorld::setTarget(uint32_t index, float x, float y, float z) {
+    if (index >= count_) return;
+    targetX_[index] = x;
+    targetY_[index] = y;
+    targetZ_[index] = z;
+}
+
+Vector3 PhysicsWorld::getTarget(uint32_t index) const {
+    if (index >= count_) return Vector3::zero();
+    return Vector3(targetX_[index], targetY_[index], targetZ_[index]);
+}
+
+void PhysicsWorld::applyForce(uint32_t index, const Vector3& force) {
+    if (index >= count_) return;
+    fx_[index] += force.x;
+    fy_[index] += force.y;
+    fz_[index] += force.z;
+}
+
+void PhysicsWorld::applyTorque(uint32_t index, const Vector3& torque) {
+    if (index >= count_) return;
+    tx_[index] += torque.x;
+    ty_[index] += torque.y;
+    tz_[index] += torque.z;
+}
+
+void PhysicsWorld::applyDragForce(uint32_t index) {
+    Vector3 velocity = getVelocity(index);
+    float speed = velocity.length();
+    if (speed > 1e-6f) {
+        float dragMagnitude = dragCoefficient_[index] * speed;
+        applyForce(index, velocity.normalized() * (-dragMagnitude));
+    }
+}
+
+void PhysicsWorld::applyThrust(uint32_t index, ThrustAction action, float intensity) {
+    if (index >= count_) return;
+
+    AERONAV_PROFILE_SCOPE(PHYSICS_THRUST);
+    withThrustAction(action, [&](auto traits) { thrustBody<decltype(traits)>(index, intensity); });
+}
+
+// Drag here runs per body inside the thrust pass, so it is timed as part of
+// PHYSICS_THRUST (a scope per body would cost more than the drag itself)
+template <typename Traits>
+void PhysicsWorld::thrustBody(uint32_t index, float intensity) {
+    Vector3 toTarget = getTarget(index) - getPosition(index);
+    float distance = toTarget.length();
+
+    // Don't apply thrust if very close to target (matching PhysicsEngine)
+    if (distance <= 0.1f) return;
+
+    Vector3 force = Vector3::zero();
+    if constexpr (Traits::HAS_THRUST) {
+        Vector3 direction = (distance > 1e-6f) ? toTarget / distance : Vector3::zero();
+        force = direction * (maxThrust_[index] * intensity * Traits::THRUST_SCALE);
+    }
+    if constexpr (Traits::APPLY_DRAG) {
+        applyDragForce(index);
+    }
+    if constexpr (Traits::DAMPS_ROTATION) {
+        wx_[index] *= Traits::ANGULAR_DAMPING;
+        wy_[index] *= Traits::ANGULAR_DAMPING;
+        wz_[index] *= Traits::ANGULAR_DAMPING;
+        // Keep the exported record in step (roll/yaw/speed do not depend on the rates)
+        float* record = &stateBuffer_[index * StateLayout::STRIDE];
+        record[StateLayout::ANGULAR_VELOCITY + 0] = wx_[index];
+        record[StateLayout::ANGULAR_VELOCITY + 1] = wy_[index];
+        record[StateLayout::ANGULAR_VELOCITY + 2] = wz_[index];
+    }
+
+    if (force.lengthSquared() > 1e-6f) {
+        applyForce(index, force);
+    }
+}
+
+// Every body holds the same action: one dispatch, then a loop with no per-body action branches
+void PhysicsWorld::applyThrustAll(ThrustAction action, float intensity) {
+    AERONAV_PROFILE_SCOPE(PHYSICS_THRUST);
+    withThrustAction(action, [&](auto traits) {
+        for (size_t i = 0; i < count_; i++) {
+            thrustBody<decltype(traits)>(static_cast<uint32_t>(i), intensity);
+        }
+    });
+}
+
+void PhysicsWorld::applyBanking(uint32_t index, float desiredRoll, float rollFactor) {
+    if (index >= count_) return;
+    float rollDifference = desiredRoll - getRoll(index);
+    tz_[index] += rollDifference * rollFactor * 100.0f;
+}
+
+PhysicsState PhysicsWorld::getState(uint32_t index) const {
+    PhysicsState state;
+    state.position = getPosition(index);
+    state.velocity = getVelocity(index);
+
+    // Match PhysicsEngine::getState: quaternion x,y,z (not w) in rotation
+    Quaternion q = getRotation(index);
+    state.rotation = Vector3(q.x, q.y, q.z);
+
+    state.angularVelocity = getAngularVelocity(index);
+    return state;
+}
+
+Vector3 PhysicsWorld::getPosition(uint32_t index) const {
+    if (index >= count_) return Vector3::zero();
+    return Vector3(px_[index], py_[index], pz_[index]);
+}
+
+Vector3 PhysicsWorld::getVelocity(uint32_t index) const {
+    if (index >= count_) return Vector3::zero();
+    return Vector3(vx_[index], vy_[index], vz_[index]);
+}
+
+Quaternion PhysicsWorld::getRotation(uint32_t index) const {
+    if (index >= count_) return Quaternion::identity();
+    return Quaternion(qw_[index], qx_[index], qy_[index], qz_[index]);
+}
+
+Vector3 PhysicsWorld::getAngularVelocity(uint32_t index) const {
+    if (index >= count_) return Vector3::zero();
+    return Vector3(wx_[index], wy_[index], wz_[index]);
+}
+
+float PhysicsWorld::getRoll(uint32_t index) const {
+    Quaternion q = getRotation(index);
+    float sinr_cosp = 2.0f * (q.w * q.x + q.y * q.z);
+    float cosr_cosp = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+    return std::atan2(sinr_cosp, cosr_cosp);
+}
+
+float PhysicsWorld::getSpeed(uint32_t index) const {
+    return getVelocity(index).length();
+}
+
+void PhysicsWorld::setPosition(uint32_t index, const Vector3& pos) {
+    if (index >= count_) return;
+    px_[index] = pos.x; py_[index] = pos.y; pz_[index] = pos.z;
+    updateStateRecord(index);
+    proximityDirty_ = true;
+}
+
+void PhysicsWorld::setVelocity(uint32_t index, const Vector3& vel) {
+    if (index >= count_) return;
+    vx_[index] = vel.x; vy_[index] = vel.y; vz_[index] = vel.z;
+    updateStateRecord(index);
+}
+
+void PhysicsWorld::setRotation(uint32_t index, const Quaternion& rot) {
+    if (index >= count_) return;
+    Quaternion q = rot.normalized();
+    qw_[index] = q.w; qx_[index] = q.x; qy_[index] = q.y; qz_[index] = q.z;
+    updateStateRecord(index);
+}
+
+void PhysicsWorld::setAngularVelocity(uint32_t index, const Vector3& angVel) {
+    if (index >= count_) return;
+    wx_[index] = angVel.x; wy_[index] = angVel.y; wz_[index] = angVel.z;
+    updateStateRecord(index);
+}
+
+// Config is not part of the state record: nothing to refresh
+void PhysicsWorld::setConfig(uint32_t index, const SpaceshipConfig& config) {
+    if (index >= count_) return;
+    mass_[index] = config.mass;
+    maxThrust_[index] = config.maxThrust;
+    maxAngularVelocity_[index] = config.maxAngularVelocity;
+    linearDamping_[index] = config.linearDamping;
+    angularDamping_[index] = config.angularDamping;
+    dragCoefficient_[index] = config.dragCoefficient;
+}
+
+SpaceshipConfig PhysicsWorld::getConfig(uint32_t index) const {
+    SpaceshipConfig config;
+    if (index >= count_) return config;
+    config.mass = mass_[index];
+    config.maxThrust = maxThrust_[index];
+    config.maxAngularVelocity = maxAngularVelocity_[index];
+    config.linearDamping = linearDamping_[index];
+    config.angularDamping = angularDamping_[index];
+    config.dragCoefficient = dragCoefficient_[index];
+    return config;
+}
+
+// Integrator policies available to stepAllWith()
+template void PhysicsWorld::stepAllWith<SemiImplicitEuler>(float);
+template void PhysicsWorld::stepAllWith<VelocityVerlet>(float);
+template void PhysicsWorld::stepAllWith<RungeKutta4>(float);
+template void PhysicsWorld::stepAllWith<ExactDamping>(float);
+
+} // namespace aeronav
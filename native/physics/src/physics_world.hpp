@@ -0,0 +1,176 @@
+#pragma once
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "physics_engine.hpp"
+#include "spatial_hash.hpp"
+#include "snapshot.hpp"
+#include "arena.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aeronav {
+
+// Raw structure-of-arrays view over N bodies (consumed by the batched integrator)
+struct BodyArrays {
+    // State
+    float* px; float* py; float* pz;
+    float* vx; float* vy; float* vz;
+    float* qw; float* qx; float* qy; float* qz;
+    float* wx; float* wy; float* wz;
+
+    // Accumulated forces/torques (cleared each step)
+    float* fx; float* fy; float* fz;
+    float* tx; float* ty; float* tz;
+
+    // Per-body configuration
+    const float* mass;
+    const float* linearDamping;
+    const float* angularDamping;
+    const float* maxAngularVelocity;
+
+    size_t count;
+};
+
+/**
+ * Batched multi-ship physics world
+ * Holds N spaceship bodies in structure-of-arrays form and integrates
+ * all of them with a single stepAll() call (same math as RigidBody::integrate)
+ */
+class PhysicsWorld {
+public:
+    PhysicsWorld();
+    // Every per-body array, the state export, the broadphase and room for
+    // maxBodies proximity pairs in one arena, so stepping up to maxBodies
+    // bodies never allocates (more bodies or pairs fall back to the heap)
+    explicit PhysicsWorld(size_t maxBodies);
+
+    // Body management (bodies are addressed by dense index)
+    uint32_t createBody(const SpaceshipConfig& config);
+    size_t getBodyCount() const { return count_; }
+    void clear();
+
+    // Core simulation
+    void stepAll(float deltaTime);
+    template <typename Integrator>
+    void stepAllWith(float deltaTime);   // integrators.hpp policy (instantiated in physics_world.cpp)
+    void resetBody(uint32_t index, float x = 0.0f, float y = 0.0f, float z = 0.0f);
+
+    // Target navigation
+    void setTarget(uint32_t index, float x, float y, float z);
+    Vector3 getTarget(uint32_t index) const;
+
+    // Force application (matching PhysicsEngine API)
+    void applyForce(uint32_t index, const Vector3& force);
+    void applyTorque(uint32_t index, const Vector3& torque);
+    void applyThrust(uint32_t index, ThrustAction action, float intensity = 1.0f);
+    void applyThrustAll(ThrustAction action, float intensity = 1.0f);
+    void applyBanking(uint32_t index, float desiredRoll, float rollFactor = 0.1f);
+
+    // State queries
+    PhysicsState getState(uint32_t index) const;
+
+    // Flat state records (StateLayout, one per body), kept current by stepAll() and
+    // every call that changes a body's exported state (reset, setters, STABILIZE).
+    // The pointer is stable until the next createBody()/clear()/restoreSnapshot().
+    const float* getStateBuffer() const { return stateBuffer_.data(); }
+    size_t getStateBufferLength() const { return stateBuffer_.size(); }
+
+    Vector3 getPosition(uint32_t index) const;
+    Vector3 getVelocity(uint32_t index) const;
+    Quaternion getRotation(uint32_t index) const;
+    Vector3 getAngularVelocity(uint32_t index) const;
+    float getRoll(uint32_t index) const;
+    float getSpeed(uint32_t index) const;
+
+    // While on, every state buffer refresh also fills StateLayout::ROLL/YAW/SPEED
+    // for all bodies in one pass over the arrays (off: those slots stay 0)
+    void setDerivedStateExport(bool enabled);
+    bool isDerivedStateExport() const { return derivedExport_; }
+
+    // Direct state setters
+    void setPosition(uint32_t index, const Vector3& pos);
+    void setVelocity(uint32_t index, const Vector3& vel);
+    void setRotation(uint32_t index, const Quaternion& rot);
+    void setAngularVelocity(uint32_t index, const Vector3& angVel);
+
+    // Configuration
+    void setConfig(uint32_t index, const SpaceshipConfig& config);
+    SpaceshipConfig getConfig(uint32_t index) const;
+
+    // Ship-ship proximity: while a radius is set, stepAll() keeps a spatial-hash
+    // broadphase (cell size = radius) in sync with the body positions
+    void setProximityRadius(float radius);   // 0 disables
+    float getProximityRadius() const { return proximityRadius_; }
+
+    // Pairs (i < j) within the proximity radius, flat [i0, j0, i1, j1, ...];
+    // returns the pair count, valid until the next call
+    size_t findProximityPairs();
+    const uint32_t* getProximityPairs() const { return proximityPairs_.data(); }
+
+    // Bodies within radius of body `index` (excluding it), ascending index
+    size_t findNeighbors(uint32_t index, float radius, std::vector<uint32_t>& out);
+
+    // Raw SoA access for batched consumers
+    BodyArrays getArrays();
+
+    // Snapshot / restore of every body (see snapshot.hpp): header, body count,
+    // proximity radius, then each per-body array. restoreSnapshot() validates
+    // the blob before touching the world and allocates only when the world
+    // has never held that many bodies.
+    static constexpr uint16_t SNAPSHOT_VERSION = 1;
+    size_t getSnapshotSize() const;
+    size_t saveSnapshot(uint8_t* out, size_t capacity) const;   // bytes written, 0 if capacity is too small
+    bool restoreSnapshot(const uint8_t* data, size_t size);
+
+private:
+    size_t count_;
+
+    // State
+    ArenaVector<float> px_, py_, pz_;
+    ArenaVector<float> vx_, vy_, vz_;
+    ArenaVector<float> qw_, qx_, qy_, qz_;
+    ArenaVector<float> wx_, wy_, wz_;
+
+    // Accumulated forces/torques
+    ArenaVector<float> fx_, fy_, fz_;
+    ArenaVector<float> tx_, ty_, tz_;
+
+    // Per-body configuration
+    ArenaVector<float> mass_;
+    ArenaVector<float> maxThrust_;
+    ArenaVector<float> maxAngularVelocity_;
+    ArenaVector<float> linearDamping_;
+    ArenaVector<float> angularDamping_;
+    ArenaVector<float> dragCoefficient_;
+
+    // Per-body navigation target
+    ArenaVector<float> targetX_, targetY_, targetZ_;
+
+    // Flat state export (count_ * StateLayout::STRIDE floats)
+    ArenaVector<float> stateBuffer_;
+    bool derivedExport_;
+
+    // Proximity broadphase (stale when positions changed outside stepAll())
+    SpatialHash proximity_;
+    float proximityRadius_;
+    bool proximityDirty_;
+    ArenaVector<uint32_t> proximityPairs_;
+
+    // Apply fn to every per-body array (fixed order; snapshots depend on it)
+    template <typename Self, typename Fn>
+    static void forEachBodyArray(Self& self, Fn&& fn);
+
+    void reserve(size_t capacity);
+    void updateStateBuffer();
+    void updateStateRecord(uint32_t index);
+    void updateDerivedState(size_t begin, size_t end);
+    void applyDragForce(uint32_t index);
+    // One body's thrust and drag, specialized on the action (Traits = ThrustActionTraits<A>)
+    template <typename Traits>
+    void thrustBody(uint32_t index, float intensity);
+    void syncProximity();
+};
+
+} // namespace aeronav
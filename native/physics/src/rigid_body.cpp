@@ -62,63 +62,6 @@ void RigidBody::clearForces() {
     accumulatedTorque_ = Vector3::zero();
 }
 
-void RigidBody::integrate(float deltaTime) {
-    if (deltaTime <= 0.0f) return;
-
-    // Clamp delta time to prevent instability
-    deltaTime = std::min(deltaTime, 0.1f);
-
-    // Calculate linear acceleration: F = ma, a = F/m
-    Vector3 linearAcceleration = Vector3::zero();
-    if (config_.mass > 0.0f) {
-        linearAcceleration = accumulatedForce_ / config_.mass;
-    }
-
-    // Update velocity: v = v + a * dt
-    velocity_ += linearAcceleration * deltaTime;
-
-    // Calculate angular acceleration
-    // Simplified: assuming unit moment of inertia tensor
-    Vector3 angularAcceleration = accumulatedTorque_;
-
-    // Update angular velocity
-    angularVelocity_ += angularAcceleration * deltaTime;
-    clampAngularVelocity();
-
-    // Apply damping
-    applyDamping(deltaTime);
-
-    // Update position: x = x + v * dt
-    position_ += velocity_ * deltaTime;
-
-    // Update rotation from angular velocity
-    // Using small angle approximation for quaternion integration
-    if (angularVelocity_.lengthSquared() > 1e-10f) {
-        float angVelMag = angularVelocity_.length();
-        Vector3 axis = angularVelocity_ / angVelMag;
-        float angle = angVelMag * deltaTime;
-
-        Quaternion deltaRotation = Quaternion::fromAxisAngle(axis, angle);
-        rotation_ = (rotation_ * deltaRotation).normalized();
-    }
-
-    // Clear accumulated forces for next frame
-    clearForces();
-}
-
-void RigidBody::applyDamping(float deltaTime) {
-    // Linear damping: velocity *= (1 - damping)^dt
-    // Approximated as: velocity *= 1 - damping * dt for small dt
-    float linearFactor = 1.0f - config_.linearDamping * deltaTime;
-    linearFactor = std::max(linearFactor, 0.0f);
-    velocity_ *= linearFactor;
-
-    // Angular damping
-    float angularFactor = 1.0f - config_.angularDamping * deltaTime;
-    angularFactor = std::max(angularFactor, 0.0f);
-    angularVelocity_ *= angularFactor;
-}
-
 void RigidBody::clampAngularVelocity() {
     float maxAngVel = config_.maxAngularVelocity;
     if (maxAngVel > 0.0f) {
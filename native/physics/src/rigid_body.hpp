@@ -2,6 +2,8 @@
 
 #include "vector3.hpp"
 #include "quaternion.hpp"
+#include "integrators.hpp"
+#include <algorithm>
 
 namespace aeronav {
 
@@ -34,6 +36,15 @@ public:
     Vector3 getAngularVelocity() const { return angularVelocity_; }
     void setAngularVelocity(const Vector3& angVel) { angularVelocity_ = angVel; }
 
+    // Whole kinematic state, stored as-is (no renormalization; for snapshots)
+    MotionState getMotionState() const { return MotionState{position_, velocity_, rotation_, angularVelocity_}; }
+    void setMotionState(const MotionState& state) {
+        position_ = state.position;
+        velocity_ = state.velocity;
+        rotation_ = state.rotation;
+        angularVelocity_ = state.angularVelocity;
+    }
+
     // Configuration
     float getMass() const { return config_.mass; }
     void setMass(float mass) { config_.mass = mass; }
@@ -60,7 +71,12 @@ public:
     // Clear accumulated forces
     void clearForces();
 
-    // Integration step
+    // Forces/torques applied since the last integrate()
+    Vector3 getAccumulatedForce() const { return accumulatedForce_; }
+    Vector3 getAccumulatedTorque() const { return accumulatedTorque_; }
+
+    // Integration step (policy from integrators.hpp; dt clamped to its MAX_DELTA_TIME)
+    template <typename Integrator = SemiImplicitEuler>
     void integrate(float deltaTime);
 
     // Speed helpers
@@ -84,9 +100,29 @@ private:
     // Configuration
     RigidBodyConfig config_;
 
-    // Apply damping
-    void applyDamping(float deltaTime);
     void clampAngularVelocity();
 };
 
+template <typename Integrator>
+void RigidBody::integrate(float deltaTime) {
+    if (deltaTime <= 0.0f) return;
+
+    // Clamp delta time to the policy's stable range
+    deltaTime = std::min(deltaTime, Integrator::MAX_DELTA_TIME);
+
+    MotionInputs inputs;
+    inputs.linearAcceleration = config_.mass > 0.0f ? accumulatedForce_ / config_.mass : Vector3::zero();
+    inputs.angularAcceleration = accumulatedTorque_;
+    inputs.linearDamping = config_.linearDamping;
+    inputs.angularDamping = config_.angularDamping;
+    inputs.maxAngularVelocity = config_.maxAngularVelocity;
+
+    MotionState state = getMotionState();
+    Integrator::integrate(state, inputs, deltaTime);
+    setMotionState(state);
+
+    // Clear accumulated forces for next frame
+    clearForces();
+}
+
 } // namespace aeronav
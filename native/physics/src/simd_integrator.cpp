@@ -0,0 +1,318 @@
+#include "simd_integrator.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if USE_SSE && !USE_AVX
+    #include <emmintrin.h>
+#endif
+
+namespace aeronav {
+
+// Per-body reference integrator (same math as RigidBody::integrate)
+static void integrateRangeScalar(const BodyArrays& b, size_t begin, size_t end, float deltaTime) {
+    for (size_t i = begin; i < end; i++) {
+        // Linear acceleration: a = F/m
+        float ax = 0.0f, ay = 0.0f, az = 0.0f;
+        if (b.mass[i] > 0.0f) {
+            float invMass = 1.0f / b.mass[i];
+            ax = b.fx[i] * invMass;
+            ay = b.fy[i] * invMass;
+            az = b.fz[i] * invMass;
+        }
+
+        // v = v + a * dt
+        float vx = b.vx[i] + ax * deltaTime;
+        float vy = b.vy[i] + ay * deltaTime;
+        float vz = b.vz[i] + az * deltaTime;
+
+        // Angular velocity (unit moment of inertia)
+        float wx = b.wx[i] + b.tx[i] * deltaTime;
+        float wy = b.wy[i] + b.ty[i] * deltaTime;
+        float wz = b.wz[i] + b.tz[i] * deltaTime;
+
+        // Clamp angular velocity magnitude
+        float maxAngVel = b.maxAngularVelocity[i];
+        if (maxAngVel > 0.0f) {
+            float sqrLen = wx * wx + wy * wy + wz * wz;
+            if (sqrLen > maxAngVel * maxAngVel) {
+                float scale = maxAngVel / std::sqrt(sqrLen);
+                wx *= scale; wy *= scale; wz *= scale;
+            }
+        }
+
+        // Damping (1 - damping * dt approximation)
+        float linearFactor = std::max(1.0f - b.linearDamping[i] * deltaTime, 0.0f);
+        vx *= linearFactor; vy *= linearFactor; vz *= linearFactor;
+
+        float angularFactor = std::max(1.0f - b.angularDamping[i] * deltaTime, 0.0f);
+        wx *= angularFactor; wy *= angularFactor; wz *= angularFactor;
+
+        // x = x + v * dt
+        b.px[i] += vx * deltaTime;
+        b.py[i] += vy * deltaTime;
+        b.pz[i] += vz * deltaTime;
+
+        // Rotation from angular velocity (axis-angle delta, then renormalize)
+        float angVelSq = wx * wx + wy * wy + wz * wz;
+        if (angVelSq > 1e-10f) {
+            float angVelMag = std::sqrt(angVelSq);
+            Vector3 axis = Vector3(wx, wy, wz) / angVelMag;
+            Quaternion delta = Quaternion::fromAxisAngle(axis, angVelMag * deltaTime);
+            Quaternion q(b.qw[i], b.qx[i], b.qy[i], b.qz[i]);
+            q = (q * delta).normalized();
+            b.qw[i] = q.w; b.qx[i] = q.x; b.qy[i] = q.y; b.qz[i] = q.z;
+        }
+
+        b.vx[i] = vx; b.vy[i] = vy; b.vz[i] = vz;
+        b.wx[i] = wx; b.wy[i] = wy; b.wz[i] = wz;
+
+        // Clear accumulated forces for next frame
+        b.fx[i] = 0.0f; b.fy[i] = 0.0f; b.fz[i] = 0.0f;
+        b.tx[i] = 0.0f; b.ty[i] = 0.0f; b.tz[i] = 0.0f;
+    }
+}
+
+void integrateBodiesScalar(const BodyArrays& bodies, float deltaTime) {
+    integrateRangeScalar(bodies, 0, bodies.count, deltaTime);
+}
+
+#if USE_WASM_SIMD || USE_SSE || USE_AVX
+
+namespace {
+
+// Thin lane wrappers so the kernel below is written once for every ISA
+#if USE_AVX
+struct Lanes {
+    using V = __m256;
+    static constexpr size_t WIDTH = 8;
+    static V load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    static V splat(float s) { return _mm256_set1_ps(s); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static V lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V bitAnd(V a, V b) { return _mm256_and_ps(a, b); }
+    static V bitOr(V a, V b) { return _mm256_or_ps(a, b); }
+    static V select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+    static V round(V a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+};
+#elif USE_WASM_SIMD
+struct Lanes {
+    using V = v128_t;
+    static constexpr size_t WIDTH = 4;
+    static V load(const float* p) { return wasm_v128_load(p); }
+    static void store(float* p, V v) { wasm_v128_store(p, v); }
+    static V splat(float s) { return wasm_f32x4_splat(s); }
+    static V add(V a, V b) { return wasm_f32x4_add(a, b); }
+    static V sub(V a, V b) { return wasm_f32x4_sub(a, b); }
+    static V mul(V a, V b) { return wasm_f32x4_mul(a, b); }
+    static V div(V a, V b) { return wasm_f32x4_div(a, b); }
+    static V sqrt(V a) { return wasm_f32x4_sqrt(a); }
+    static V max(V a, V b) { return wasm_f32x4_max(a, b); }
+    static V gt(V a, V b) { return wasm_f32x4_gt(a, b); }
+    static V lt(V a, V b) { return wasm_f32x4_lt(a, b); }
+    static V bitAnd(V a, V b) { return wasm_v128_and(a, b); }
+    static V bitOr(V a, V b) { return wasm_v128_or(a, b); }
+    static V select(V mask, V a, V b) { return wasm_v128_bitselect(a, b, mask); }
+    static V round(V a) { return wasm_f32x4_nearest(a); }
+};
+#else // USE_SSE
+struct Lanes {
+    using V = __m128;
+    static constexpr size_t WIDTH = 4;
+    static V load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+    static V splat(float s) { return _mm_set1_ps(s); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static V lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V bitAnd(V a, V b) { return _mm_and_ps(a, b); }
+    static V bitOr(V a, V b) { return _mm_or_ps(a, b); }
+    static V select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static V round(V a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+};
+#endif
+
+using V = Lanes::V;
+
+// Vectorized sin/cos: reduce to [-pi, pi], reflect into [-pi/2, pi/2],
+// then Taylor polynomials (error < 1e-7 on the reduced range)
+inline void sinCos(V x, V& sinOut, V& cosOut) {
+    const float PI = 3.14159265358979f;
+    const float TWO_PI_HI = 6.28125f;
+    const float TWO_PI_LO = 1.9353071795864769e-3f;
+
+    V k = Lanes::round(Lanes::mul(x, Lanes::splat(1.0f / (2.0f * PI))));
+    x = Lanes::sub(x, Lanes::mul(k, Lanes::splat(TWO_PI_HI)));
+    x = Lanes::sub(x, Lanes::mul(k, Lanes::splat(TWO_PI_LO)));
+
+    V above = Lanes::gt(x, Lanes::splat(PI * 0.5f));
+    V below = Lanes::lt(x, Lanes::splat(-PI * 0.5f));
+    x = Lanes::select(above, Lanes::sub(Lanes::splat(PI), x),
+        Lanes::select(below, Lanes::sub(Lanes::splat(-PI), x), x));
+    V cosSign = Lanes::select(Lanes::bitOr(above, below), Lanes::splat(-1.0f), Lanes::splat(1.0f));
+
+    V x2 = Lanes::mul(x, x);
+
+    V s = Lanes::splat(-1.0f / 39916800.0f);
+    s = Lanes::add(Lanes::mul(s, x2), Lanes::splat(1.0f / 362880.0f));
+    s = Lanes::add(Lanes::mul(s, x2), Lanes::splat(-1.0f / 5040.0f));
+    s = Lanes::add(Lanes::mul(s, x2), Lanes::splat(1.0f / 120.0f));
+    s = Lanes::add(Lanes::mul(s, x2), Lanes::splat(-1.0f / 6.0f));
+    s = Lanes::add(Lanes::mul(s, x2), Lanes::splat(1.0f));
+    sinOut = Lanes::mul(s, x);
+
+    V c = Lanes::splat(1.0f / 479001600.0f);
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(-1.0f / 3628800.0f));
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(1.0f / 40320.0f));
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(-1.0f / 720.0f));
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(1.0f / 24.0f));
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(-0.5f));
+    c = Lanes::add(Lanes::mul(c, x2), Lanes::splat(1.0f));
+    cosOut = Lanes::mul(c, cosSign);
+}
+
+// Integrate bodies [0, end) in groups of Lanes::WIDTH (end must be a multiple of WIDTH)
+void integrateLanes(const BodyArrays& b, size_t end, float deltaTime) {
+    const V dt = Lanes::splat(deltaTime);
+    const V zero = Lanes::splat(0.0f);
+    const V one = Lanes::splat(1.0f);
+    const V minAngVelSq = Lanes::splat(1e-10f);
+    const V minQuatLen = Lanes::splat(1e-8f);
+
+    for (size_t i = 0; i < end; i += Lanes::WIDTH) {
+        // Linear acceleration: a = F/m (zero for massless bodies)
+        V mass = Lanes::load(b.mass + i);
+        V invMass = Lanes::select(Lanes::gt(mass, zero), Lanes::div(one, mass), zero);
+
+        // v = v + a * dt
+        V vx = Lanes::add(Lanes::load(b.vx + i), Lanes::mul(Lanes::mul(Lanes::load(b.fx + i), invMass), dt));
+        V vy = Lanes::add(Lanes::load(b.vy + i), Lanes::mul(Lanes::mul(Lanes::load(b.fy + i), invMass), dt));
+        V vz = Lanes::add(Lanes::load(b.vz + i), Lanes::mul(Lanes::mul(Lanes::load(b.fz + i), invMass), dt));
+
+        // Angular velocity (unit moment of inertia)
+        V wx = Lanes::add(Lanes::load(b.wx + i), Lanes::mul(Lanes::load(b.tx + i), dt));
+        V wy = Lanes::add(Lanes::load(b.wy + i), Lanes::mul(Lanes::load(b.ty + i), dt));
+        V wz = Lanes::add(Lanes::load(b.wz + i), Lanes::mul(Lanes::load(b.tz + i), dt));
+
+        // Clamp angular velocity magnitude
+        V maxAngVel = Lanes::load(b.maxAngularVelocity + i);
+        V sqrLen = Lanes::add(Lanes::add(Lanes::mul(wx, wx), Lanes::mul(wy, wy)), Lanes::mul(wz, wz));
+        V clampMask = Lanes::bitAnd(Lanes::gt(maxAngVel, zero),
+                                    Lanes::gt(sqrLen, Lanes::mul(maxAngVel, maxAngVel)));
+        V clampScale = Lanes::select(clampMask, Lanes::div(maxAngVel, Lanes::sqrt(sqrLen)), one);
+        wx = Lanes::mul(wx, clampScale);
+        wy = Lanes::mul(wy, clampScale);
+        wz = Lanes::mul(wz, clampScale);
+
+        // Damping (1 - damping * dt approximation)
+        V linearFactor = Lanes::max(Lanes::sub(one, Lanes::mul(Lanes::load(b.linearDamping + i), dt)), zero);
+        vx = Lanes::mul(vx, linearFactor);
+        vy = Lanes::mul(vy, linearFactor);
+        vz = Lanes::mul(vz, linearFactor);
+
+        V angularFactor = Lanes::max(Lanes::sub(one, Lanes::mul(Lanes::load(b.angularDamping + i), dt)), zero);
+        wx = Lanes::mul(wx, angularFactor);
+        wy = Lanes::mul(wy, angularFactor);
+        wz = Lanes::mul(wz, angularFactor);
+
+        // x = x + v * dt
+        Lanes::store(b.px + i, Lanes::add(Lanes::load(b.px + i), Lanes::mul(vx, dt)));
+        Lanes::store(b.py + i, Lanes::add(Lanes::load(b.py + i), Lanes::mul(vy, dt)));
+        Lanes::store(b.pz + i, Lanes::add(Lanes::load(b.pz + i), Lanes::mul(vz, dt)));
+
+        // Rotation delta from angular velocity: (cos(h), axis * sin(h)) with h = |w| * dt / 2
+        V angVelSq = Lanes::add(Lanes::add(Lanes::mul(wx, wx), Lanes::mul(wy, wy)), Lanes::mul(wz, wz));
+        V rotating = Lanes::gt(angVelSq, minAngVelSq);
+        V angVelMag = Lanes::sqrt(angVelSq);
+        V halfAngle = Lanes::mul(Lanes::mul(angVelMag, dt), Lanes::splat(0.5f));
+
+        V sinHalf, cosHalf;
+        sinCos(halfAngle, sinHalf, cosHalf);
+        V axisScale = Lanes::select(rotating, Lanes::div(sinHalf, angVelMag), zero);
+        V dw = cosHalf;
+        V dx = Lanes::mul(wx, axisScale);
+        V dy = Lanes::mul(wy, axisScale);
+        V dz = Lanes::mul(wz, axisScale);
+
+        // q = q * delta (Hamilton product)
+        V qw = Lanes::load(b.qw + i);
+        V qx = Lanes::load(b.qx + i);
+        V qy = Lanes::load(b.qy + i);
+        V qz = Lanes::load(b.qz + i);
+        V nw = Lanes::sub(Lanes::sub(Lanes::sub(Lanes::mul(qw, dw), Lanes::mul(qx, dx)), Lanes::mul(qy, dy)), Lanes::mul(qz, dz));
+        V nx = Lanes::sub(Lanes::add(Lanes::add(Lanes::mul(qw, dx), Lanes::mul(qx, dw)), Lanes::mul(qy, dz)), Lanes::mul(qz, dy));
+        V ny = Lanes::add(Lanes::add(Lanes::sub(Lanes::mul(qw, dy), Lanes::mul(qx, dz)), Lanes::mul(qy, dw)), Lanes::mul(qz, dx));
+        V nz = Lanes::add(Lanes::sub(Lanes::add(Lanes::mul(qw, dz), Lanes::mul(qx, dy)), Lanes::mul(qy, dx)), Lanes::mul(qz, dw));
+
+        // Renormalize (identity for degenerate quaternions)
+        V quatLen = Lanes::sqrt(Lanes::add(Lanes::add(Lanes::add(Lanes::mul(nw, nw), Lanes::mul(nx, nx)),
+                                                      Lanes::mul(ny, ny)), Lanes::mul(nz, nz)));
+        V valid = Lanes::gt(quatLen, minQuatLen);
+        V invLen = Lanes::div(one, quatLen);
+        nw = Lanes::select(valid, Lanes::mul(nw, invLen), one);
+        nx = Lanes::select(valid, Lanes::mul(nx, invLen), zero);
+        ny = Lanes::select(valid, Lanes::mul(ny, invLen), zero);
+        nz = Lanes::select(valid, Lanes::mul(nz, invLen), zero);
+
+        // Only bodies that are actually rotating get the new orientation
+        Lanes::store(b.qw + i, Lanes::select(rotating, nw, qw));
+        Lanes::store(b.qx + i, Lanes::select(rotating, nx, qx));
+        Lanes::store(b.qy + i, Lanes::select(rotating, ny, qy));
+        Lanes::store(b.qz + i, Lanes::select(rotating, nz, qz));
+
+        Lanes::store(b.vx + i, vx);
+        Lanes::store(b.vy + i, vy);
+        Lanes::store(b.vz + i, vz);
+        Lanes::store(b.wx + i, wx);
+        Lanes::store(b.wy + i, wy);
+        Lanes::store(b.wz + i, wz);
+
+        // Clear accumulated forces for next frame
+        Lanes::store(b.fx + i, zero);
+        Lanes::store(b.fy + i, zero);
+        Lanes::store(b.fz + i, zero);
+        Lanes::store(b.tx + i, zero);
+        Lanes::store(b.ty + i, zero);
+        Lanes::store(b.tz + i, zero);
+    }
+}
+
+} // namespace
+
+void integrateBodiesSimd(const BodyArrays& bodies, float deltaTime) {
+    size_t simdEnd = bodies.count - (bodies.count % Lanes::WIDTH);
+    integrateLanes(bodies, simdEnd, deltaTime);
+
+    // Handle remaining bodies
+    integrateRangeScalar(bodies, simdEnd, bodies.count, deltaTime);
+}
+
+size_t integratorLaneWidth() {
+    return Lanes::WIDTH;
+}
+
+#else
+
+// Scalar fallback
+void integrateBodiesSimd(const BodyArrays& bodies, float deltaTime) {
+    integrateRangeScalar(bodies, 0, bodies.count, deltaTime);
+}
+
+size_t integratorLaneWidth() {
+    return 1;
+}
+
+#endif
+
+} // namespace aeronav
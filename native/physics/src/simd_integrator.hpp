@@ -0,0 +1,79 @@
+#pragma once
+
+#include "physics_world.hpp"
+#include "integrators.hpp"
+#include <cstddef>
+#include <type_traits>
+
+// Wide SIMD detection (native builds only; WASM SIMD128 and SSE come from vector3.hpp)
+#if !defined(__EMSCRIPTEN__) && defined(__AVX__)
+    #include <immintrin.h>
+    #define USE_AVX 1
+#endif
+
+namespace aeronav {
+
+/**
+ * Batched rigid-body integrators over BodyArrays
+ *
+ * integrateBodiesScalar is the reference path (per-body math identical to
+ * RigidBody::integrate). integrateBodiesSimd processes 4 bodies per lane
+ * group (WASM SIMD128 / SSE) or 8 (AVX) with a polynomial sin/cos for the
+ * quaternion update, and falls back to the scalar path for the tail.
+ * Results match the reference to within float rounding.
+ */
+void integrateBodiesScalar(const BodyArrays& bodies, float deltaTime);
+void integrateBodiesSimd(const BodyArrays& bodies, float deltaTime);
+
+// Per-body loop over any integrators.hpp policy (scalar; forces cleared after the step)
+template <typename Integrator>
+void integrateBodiesWith(const BodyArrays& b, float deltaTime) {
+    for (size_t i = 0; i < b.count; i++) {
+        MotionInputs inputs;
+        const float invMass = b.mass[i] > 0.0f ? 1.0f / b.mass[i] : 0.0f;
+        inputs.linearAcceleration = Vector3(b.fx[i] * invMass, b.fy[i] * invMass, b.fz[i] * invMass);
+        inputs.angularAcceleration = Vector3(b.tx[i], b.ty[i], b.tz[i]);
+        inputs.linearDamping = b.linearDamping[i];
+        inputs.angularDamping = b.angularDamping[i];
+        inputs.maxAngularVelocity = b.maxAngularVelocity[i];
+
+        MotionState s;
+        s.position = Vector3(b.px[i], b.py[i], b.pz[i]);
+        s.velocity = Vector3(b.vx[i], b.vy[i], b.vz[i]);
+        s.rotation = Quaternion(b.qw[i], b.qx[i], b.qy[i], b.qz[i]);
+        s.angularVelocity = Vector3(b.wx[i], b.wy[i], b.wz[i]);
+        Integrator::integrate(s, inputs, deltaTime);
+
+        b.px[i] = s.position.x; b.py[i] = s.position.y; b.pz[i] = s.position.z;
+        b.vx[i] = s.velocity.x; b.vy[i] = s.velocity.y; b.vz[i] = s.velocity.z;
+        b.qw[i] = s.rotation.w; b.qx[i] = s.rotation.x; b.qy[i] = s.rotation.y; b.qz[i] = s.rotation.z;
+        b.wx[i] = s.angularVelocity.x; b.wy[i] = s.angularVelocity.y; b.wz[i] = s.angularVelocity.z;
+
+        b.fx[i] = 0.0f; b.fy[i] = 0.0f; b.fz[i] = 0.0f;
+        b.tx[i] = 0.0f; b.ty[i] = 0.0f; b.tz[i] = 0.0f;
+    }
+}
+
+// Number of bodies processed per SIMD lane group (1 when no SIMD is available)
+size_t integratorLaneWidth();
+
+// Compile-time selected integrator used by PhysicsWorld::stepAll
+inline void integrateBodies(const BodyArrays& bodies, float deltaTime) {
+#if USE_WASM_SIMD || USE_SSE || USE_AVX
+    integrateBodiesSimd(bodies, deltaTime);
+#else
+    integrateBodiesScalar(bodies, deltaTime);
+#endif
+}
+
+// Batched path for a policy: SemiImplicitEuler keeps the SIMD kernel
+template <typename Integrator>
+inline void integrateBodies(const BodyArrays& bodies, float deltaTime) {
+    if constexpr (std::is_same<Integrator, SemiImplicitEuler>::value) {
+        integrateBodies(bodies, deltaTime);
+    } else {
+        integrateBodiesWith<Integrator>(bodies, deltaTime);
+    }
+}
+
+} // namespace aeronav
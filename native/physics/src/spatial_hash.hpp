@@ -0,0 +1,168 @@
+#pragma once
+
+#include "arena.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace aeronav {
+
+/**
+ * Uniform-grid broadphase over N points, stored in a hashed cell table
+ * Each point sits in an intrusive doubly-linked list for its bucket, so
+ * update() only relinks points whose cell changed since the last call
+ * (a full rebuild happens only when the point count or cell size changes).
+ * Neighbour queries visit the cells overlapping the query sphere and filter
+ * by exact cell and distance, so hash collisions never yield duplicates.
+ * Header-only so other modules (RL) can use it without linking physics.
+ */
+class SpatialHash {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    explicit SpatialHash(float cellSize = 1.0f) : cellSize_(cellSize), count_(0) {}
+
+    // Cell edge length; queries are cheapest when radius <= cellSize
+    void setCellSize(float cellSize) {
+        if (cellSize == cellSize_) return;
+        cellSize_ = cellSize;
+        count_ = 0;   // force a rebuild on the next update()
+    }
+    float getCellSize() const { return cellSize_; }
+
+    size_t getCount() const { return count_; }
+
+    // Preallocate every table for up to maxPoints points in `arena`
+    // (arenaBytesFor(maxPoints) bytes), so update() never allocates below that
+    void reserve(size_t maxPoints, const std::shared_ptr<Arena>& arena) {
+        for (ArenaVector<float>* values : {&x_, &y_, &z_}) reserveInArena(*values, arena, maxPoints);
+        for (ArenaVector<int32_t>* values : {&cellX_, &cellY_, &cellZ_}) reserveInArena(*values, arena, maxPoints);
+        for (ArenaVector<uint32_t>* values : {&next_, &prev_}) reserveInArena(*values, arena, maxPoints);
+        reserveInArena(heads_, arena, bucketCountFor(maxPoints));
+    }
+
+    static size_t arenaBytesFor(size_t maxPoints) {
+        return 3 * Arena::bytesFor<float>(maxPoints) + 3 * Arena::bytesFor<int32_t>(maxPoints) +
+               2 * Arena::bytesFor<uint32_t>(maxPoints) + Arena::bytesFor<uint32_t>(bucketCountFor(maxPoints));
+    }
+
+    // Sync with the current positions (SoA, `count` points addressed by index)
+    void update(const float* x, const float* y, const float* z, size_t count) {
+        if (count != count_ || heads_.empty()) {
+            rebuild(x, y, z, count);
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            x_[i] = x[i]; y_[i] = y[i]; z_[i] = z[i];
+            const int32_t cx = cellOf(x[i]), cy = cellOf(y[i]), cz = cellOf(z[i]);
+            if (cx == cellX_[i] && cy == cellY_[i] && cz == cellZ_[i]) continue;
+            unlink(static_cast<uint32_t>(i));
+            cellX_[i] = cx; cellY_[i] = cy; cellZ_[i] = cz;
+            link(static_cast<uint32_t>(i));
+        }
+    }
+
+    // fn(index, distanceSquared) for every point within radius of (x, y, z)
+    template <typename Fn>
+    void forEachNeighbor(float x, float y, float z, float radius, Fn&& fn) const {
+        if (count_ == 0) return;
+        const float radiusSq = radius * radius;
+        const int32_t x0 = cellOf(x - radius), x1 = cellOf(x + radius);
+        const int32_t y0 = cellOf(y - radius), y1 = cellOf(y + radius);
+        const int32_t z0 = cellOf(z - radius), z1 = cellOf(z + radius);
+        for (int32_t cx = x0; cx <= x1; cx++) {
+            for (int32_t cy = y0; cy <= y1; cy++) {
+                for (int32_t cz = z0; cz <= z1; cz++) {
+                    for (uint32_t j = heads_[bucketOf(cx, cy, cz)]; j != NONE; j = next_[j]) {
+                        if (cellX_[j] != cx || cellY_[j] != cy || cellZ_[j] != cz) continue;
+                        const float dx = x_[j] - x, dy = y_[j] - y, dz = z_[j] - z;
+                        const float distSq = dx * dx + dy * dy + dz * dz;
+                        if (distSq <= radiusSq) fn(j, distSq);
+                    }
+                }
+            }
+        }
+    }
+
+    // fn(i, j, distanceSquared) once per pair i < j within radius
+    template <typename Fn>
+    void forEachPair(float radius, Fn&& fn) const {
+        for (uint32_t i = 0; i < count_; i++) {
+            forEachNeighbor(x_[i], y_[i], z_[i], radius, [&](uint32_t j, float distSq) {
+                if (j > i) fn(i, j, distSq);
+            });
+        }
+    }
+
+private:
+    float cellSize_;
+    size_t count_;
+
+    // Cached positions and cell coordinates per point
+    ArenaVector<float> x_, y_, z_;
+    ArenaVector<int32_t> cellX_, cellY_, cellZ_;
+
+    // Bucket lists (heads_ size is a power of two >= 2 * count)
+    ArenaVector<uint32_t> heads_;
+    ArenaVector<uint32_t> next_, prev_;
+
+    // Cells are clamped to +-CELL_LIMIT, so the cast is defined for any float
+    // (a diverged or infinite coordinate lands in an edge cell) and the
+    // neighborhood loops cannot overflow; NaN gets a sentinel cell of its own,
+    // where distance tests against it always fail
+    static constexpr int32_t CELL_LIMIT = 1 << 30;
+    static constexpr int32_t NAN_CELL = CELL_LIMIT + 1;
+
+    int32_t cellOf(float v) const {
+        const float cell = std::floor(v / cellSize_);
+        if (std::isnan(cell)) return NAN_CELL;
+        if (cell >= static_cast<float>(CELL_LIMIT)) return CELL_LIMIT;
+        if (cell <= -static_cast<float>(CELL_LIMIT)) return -CELL_LIMIT;
+        return static_cast<int32_t>(cell);
+    }
+
+    size_t bucketOf(int32_t cx, int32_t cy, int32_t cz) const {
+        const uint32_t h = (static_cast<uint32_t>(cx) * 73856093u) ^
+                           (static_cast<uint32_t>(cy) * 19349663u) ^
+                           (static_cast<uint32_t>(cz) * 83492791u);
+        return h & (heads_.size() - 1);
+    }
+
+    void link(uint32_t i) {
+        uint32_t& head = heads_[bucketOf(cellX_[i], cellY_[i], cellZ_[i])];
+        prev_[i] = NONE;
+        next_[i] = head;
+        if (head != NONE) prev_[head] = i;
+        head = i;
+    }
+
+    void unlink(uint32_t i) {
+        if (prev_[i] != NONE) next_[prev_[i]] = next_[i];
+        else heads_[bucketOf(cellX_[i], cellY_[i], cellZ_[i])] = next_[i];
+        if (next_[i] != NONE) prev_[next_[i]] = prev_[i];
+    }
+
+    static size_t bucketCountFor(size_t count) {
+        size_t buckets = 16;
+        while (buckets < 2 * count) buckets <<= 1;
+        return buckets;
+    }
+
+    void rebuild(const float* x, const float* y, const float* z, size_t count) {
+        heads_.assign(bucketCountFor(count), NONE);
+
+        count_ = count;
+        x_.assign(x, x + count); y_.assign(y, y + count); z_.assign(z, z + count);
+        cellX_.resize(count); cellY_.resize(count); cellZ_.resize(count);
+        next_.resize(count); prev_.resize(count);
+
+        // Link in reverse so each bucket lists its points in ascending index order
+        for (size_t i = count; i-- > 0;) {
+            cellX_[i] = cellOf(x[i]); cellY_[i] = cellOf(y[i]); cellZ_[i] = cellOf(z[i]);
+            link(static_cast<uint32_t>(i));
+        }
+    }
+};
+
+} // namespace aeronav
@@ -0,0 +1,210 @@
+#include "trajectory_rollout.hpp"
+#include "simd_integrator.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace aeronav {
+
+TrajectoryRollout::TrajectoryRollout(size_t threads)
+    : target_(Vector3::zero())
+    , startPosition_(Vector3::zero())
+    , startVelocity_(Vector3::zero())
+    , startRotation_(Quaternion::identity())
+    , startAngularVelocity_(Vector3::zero())
+    , candidates_(0)
+{
+    setThreadCount(threads);
+}
+
+void TrajectoryRollout::setThreadCount(size_t threads) {
+    if (threads == 0) threads = ThreadPool::hardwareThreads();
+    if (threads == getThreadCount()) return;
+    pool_ = threads > 1 ? std::make_unique<ThreadPool>(threads) : nullptr;
+}
+
+void TrajectoryRollout::setStart(const Vector3& position, const Vector3& velocity,
+                                 const Quaternion& rotation, const Vector3& angularVelocity) {
+    startPosition_ = position;
+    startVelocity_ = velocity;
+    startRotation_ = rotation;
+    startAngularVelocity_ = angularVelocity;
+}
+
+void TrajectoryRollout::setStart(const PhysicsState& state) {
+    const Vector3& r = state.rotation;
+    const float w = std::sqrt(std::max(0.0f, 1.0f - (r.x * r.x + r.y * r.y + r.z * r.z)));
+    setStart(state.position, state.velocity, Quaternion(w, r.x, r.y, r.z), state.angularVelocity);
+}
+
+void TrajectoryRollout::setStart(const PhysicsEngine& engine) {
+    setStart(engine.getPosition(), engine.getVelocity(), engine.getRotation(), engine.getAngularVelocity());
+    config_ = engine.getConfig();
+    target_ = engine.getTarget();
+}
+
+void TrajectoryRollout::setStart(const PhysicsWorld& world, uint32_t index) {
+    if (index >= world.getBodyCount()) return;
+    setStart(world.getPosition(index), world.getVelocity(index), world.getRotation(index),
+             world.getAngularVelocity(index));
+    config_ = world.getConfig(index);
+    target_ = world.getTarget(index);
+}
+
+void TrajectoryRollout::reserve(size_t candidates) {
+    if (arrays_[PX].size() >= candidates) return;
+    for (std::vector<float>& array : arrays_) array.resize(candidates);
+    results_.resize(candidates * RolloutLayout::STRIDE);
+}
+
+BodyArrays TrajectoryRollout::slice(size_t begin, size_t end) {
+    BodyArrays b;
+    b.px = arrays_[PX].data() + begin; b.py = arrays_[PY].data() + begin; b.pz = arrays_[PZ].data() + begin;
+    b.vx = arrays_[VX].data() + begin; b.vy = arrays_[VY].data() + begin; b.vz = arrays_[VZ].data() + begin;
+    b.qw = arrays_[QW].data() + begin; b.qx = arrays_[QX].data() + begin;
+    b.qy = arrays_[QY].data() + begin; b.qz = arrays_[QZ].data() + begin;
+    b.wx = arrays_[WX].data() + begin; b.wy = arrays_[WY].data() + begin; b.wz = arrays_[WZ].data() + begin;
+    b.fx = arrays_[FX].data() + begin; b.fy = arrays_[FY].data() + begin; b.fz = arrays_[FZ].data() + begin;
+    b.tx = arrays_[TX].data() + begin; b.ty = arrays_[TY].data() + begin; b.tz = arrays_[TZ].data() + begin;
+    b.mass = arrays_[MASS].data() + begin;
+    b.linearDamping = arrays_[LINEAR_DAMPING].data() + begin;
+    b.angularDamping = arrays_[ANGULAR_DAMPING].data() + begin;
+    b.maxAngularVelocity = arrays_[MAX_ANGULAR_VELOCITY].data() + begin;
+    b.count = end - begin;
+    return b;
+}
+
+void TrajectoryRollout::run(const uint8_t* actions, size_t candidates, size_t horizon,
+                            float deltaTime, float intensity) {
+    AERONAV_PROFILE_SCOPE(PHYSICS_ROLLOUT);
+    AERONAV_PROFILE_COUNT(ITEMS, candidates);
+
+    candidates_ = candidates;
+    if (candidates == 0) return;
+    reserve(candidates);
+
+    // Same clamp as PhysicsWorld::stepAll; a non-positive step leaves every candidate at the start
+    deltaTime = std::min(deltaTime, SemiImplicitEuler::MAX_DELTA_TIME);
+    if (deltaTime <= 0.0f || actions == nullptr) horizon = 0;
+
+    // Each range only touches its own candidates, so no merge step is needed
+    auto rolloutRange = [&](size_t begin, size_t end) {
+        runRange(actions, begin, end, horizon, deltaTime, intensity);
+    };
+
+    if (pool_) {
+        pool_->parallelFor(candidates, ROLLOUT_GRAIN, rolloutRange);
+    } else {
+        rolloutRange(0, candidates);
+    }
+}
+
+// No profile scopes in here: ranges run inside pool tasks
+void TrajectoryRollout::runRange(const uint8_t* actions, size_t begin, size_t end, size_t horizon,
+                                 float deltaTime, float intensity) {
+    const BodyArrays b = slice(begin, end);
+    const size_t count = end - begin;
+    float* energy = results_.data() + begin * RolloutLayout::STRIDE + RolloutLayout::ENERGY;
+    float* minDistance = results_.data() + begin * RolloutLayout::STRIDE + RolloutLayout::MIN_DISTANCE;
+    const float startDistance = (target_ - startPosition_).length();
+
+    for (size_t i = 0; i < count; i++) {
+        b.px[i] = startPosition_.x; b.py[i] = startPosition_.y; b.pz[i] = startPosition_.z;
+        b.vx[i] = startVelocity_.x; b.vy[i] = startVelocity_.y; b.vz[i] = startVelocity_.z;
+        b.qw[i] = startRotation_.w; b.qx[i] = startRotation_.x;
+        b.qy[i] = startRotation_.y; b.qz[i] = startRotation_.z;
+        b.wx[i] = startAngularVelocity_.x; b.wy[i] = startAngularVelocity_.y; b.wz[i] = startAngularVelocity_.z;
+        b.fx[i] = 0.0f; b.fy[i] = 0.0f; b.fz[i] = 0.0f;
+        b.tx[i] = 0.0f; b.ty[i] = 0.0f; b.tz[i] = 0.0f;
+        arrays_[MASS][begin + i] = config_.mass;
+        arrays_[LINEAR_DAMPING][begin + i] = config_.linearDamping;
+        arrays_[ANGULAR_DAMPING][begin + i] = config_.angularDamping;
+        arrays_[MAX_ANGULAR_VELOCITY][begin + i] = config_.maxAngularVelocity;
+        energy[i * RolloutLayout::STRIDE] = 0.0f;
+        minDistance[i * RolloutLayout::STRIDE] = startDistance;
+    }
+
+    for (size_t t = 0; t < horizon; t++) {
+        // Thrust and drag, operation for operation as PhysicsWorld::thrustBody
+        for (size_t i = 0; i < count; i++) {
+            const Vector3 position(b.px[i], b.py[i], b.pz[i]);
+            const Vector3 toTarget = target_ - position;
+            const float distance = toTarget.length();
+            // Position is the previous step's result, so this is also the closest-approach sample
+            float& closest = minDistance[i * RolloutLayout::STRIDE];
+            closest = std::min(closest, distance);
+            if (distance <= 0.1f) continue;
+
+            // Actions differ per candidate, so the THRUST_TRAITS row is read at run time
+            const ThrustAction action = static_cast<ThrustAction>(actions[(begin + i) * horizon + t]);
+            const ThrustTraits& traits = thrustTraits(action);
+            Vector3 force = Vector3::zero();
+            if (traits.thrustScale != 0.0f) {
+                const Vector3 direction = (distance > 1e-6f) ? toTarget / distance : Vector3::zero();
+                force = direction * (config_.maxThrust * intensity * traits.thrustScale);
+            }
+            if (traits.angularDamping != 1.0f) {
+                b.wx[i] *= traits.angularDamping;
+                b.wy[i] *= traits.angularDamping;
+                b.wz[i] *= traits.angularDamping;
+            }
+
+            if (traits.applyDrag) {
+                const Vector3 velocity(b.vx[i], b.vy[i], b.vz[i]);
+                const float speed = velocity.length();
+                if (speed > 1e-6f) {
+                    const Vector3 dragForce = velocity.normalized() * (-(config_.dragCoefficient * speed));
+                    b.fx[i] += dragForce.x; b.fy[i] += dragForce.y; b.fz[i] += dragForce.z;
+                }
+            }
+            if (force.lengthSquared() > 1e-6f) {
+                b.fx[i] += force.x; b.fy[i] += force.y; b.fz[i] += force.z;
+                energy[i * RolloutLayout::STRIDE] += force.length() * deltaTime;
+            }
+        }
+
+        integrateBodies(b, deltaTime);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        float* record = results_.data() + (begin + i) * RolloutLayout::STRIDE;
+        const Vector3 position(b.px[i], b.py[i], b.pz[i]);
+        record[RolloutLayout::END_POSITION + 0] = position.x;
+        record[RolloutLayout::END_POSITION + 1] = position.y;
+        record[RolloutLayout::END_POSITION + 2] = position.z;
+        record[RolloutLayout::DISTANCE] = (target_ - position).length();
+        record[RolloutLayout::MIN_DISTANCE] =
+            std::min(record[RolloutLayout::MIN_DISTANCE], record[RolloutLayout::DISTANCE]);
+    }
+}
+
+size_t TrajectoryRollout::bestCandidate(float energyWeight) const {
+    size_t best = 0;
+    float bestScore = 0.0f;
+    for (size_t c = 0; c < candidates_; c++) {
+        const float* record = results_.data() + c * RolloutLayout::STRIDE;
+        const float score = record[RolloutLayout::DISTANCE] + energyWeight * record[RolloutLayout::ENERGY];
+        if (c == 0 || score < bestScore) {
+            best = c;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+void TrajectoryRollout::sampleActions(RngStream& rng, uint8_t* out, size_t candidates, size_t horizon,
+                                      float switchProbability) {
+    constexpr uint32_t ACTION_COUNT = 4;
+    for (size_t c = 0; c < candidates; c++) {
+        uint8_t* sequence = out + c * horizon;
+        uint8_t action = static_cast<uint8_t>(rng.nextBelow(ACTION_COUNT));
+        for (size_t t = 0; t < horizon; t++) {
+            if (t > 0 && rng.nextFloat() < switchProbability) {
+                action = static_cast<uint8_t>(rng.nextBelow(ACTION_COUNT));
+            }
+            sequence[t] = action;
+        }
+    }
+}
+
+} // namespace aeronav
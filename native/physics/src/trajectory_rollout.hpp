@@ -0,0 +1,108 @@
+#pragma once
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "physics_engine.hpp"
+#include "physics_world.hpp"
+#include "thread_pool.hpp"
+#include "rng.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace aeronav {
+
+// Per-candidate result record layout (floats, one record per candidate)
+struct RolloutLayout {
+    static constexpr size_t END_POSITION = 0;   // x, y, z after the last step
+    static constexpr size_t DISTANCE = 3;       // distance to target after the last step
+    static constexpr size_t MIN_DISTANCE = 4;   // closest approach over the horizon
+    static constexpr size_t ENERGY = 5;         // thrust impulse spent, sum of |thrust| * dt (N*s)
+    static constexpr size_t STRIDE = 6;
+};
+
+/**
+ * Monte Carlo lookahead over candidate thrust sequences
+ * Simulates K action sequences of length H from one start state with the
+ * same thrust, drag and integrator math as PhysicsWorld::stepAll, so a
+ * candidate ends exactly where a world body given those actions would.
+ * Candidates are stored structure-of-arrays and stepped with the SIMD batch
+ * integrator; batches of ROLLOUT_GRAIN candidates run on the thread pool
+ * (serial without AERONAV_ENABLE_THREADS). Buffers grow only when K does.
+ */
+class TrajectoryRollout {
+public:
+    static constexpr size_t ROLLOUT_GRAIN = 64;   // candidates per parallel work item
+
+    // threads = total participants including the caller (0 = hardware threads)
+    explicit TrajectoryRollout(size_t threads = 1);
+
+    void setConfig(const SpaceshipConfig& config) { config_ = config; }
+    const SpaceshipConfig& getConfig() const { return config_; }
+    void setThreadCount(size_t threads);
+    size_t getThreadCount() const { return pool_ ? pool_->getThreadCount() : 1; }
+
+    // Start state. PhysicsState only carries quaternion x, y, z; w is rebuilt
+    // as the non-negative root (the same rotation)
+    void setStart(const Vector3& position, const Vector3& velocity,
+                  const Quaternion& rotation, const Vector3& angularVelocity);
+    void setStart(const PhysicsState& state);
+
+    // Plan from a live ship: its state, config and target
+    void setStart(const PhysicsEngine& engine);
+    void setStart(const PhysicsWorld& world, uint32_t index);
+
+    void setTarget(float x, float y, float z) { target_ = Vector3(x, y, z); }
+    Vector3 getTarget() const { return target_; }
+
+    // actions[c * horizon + t] is candidate c's ThrustAction at step t (values
+    // above STABILIZE act as IDLE). Fills one RolloutLayout record per candidate.
+    void run(const uint8_t* actions, size_t candidates, size_t horizon,
+             float deltaTime, float intensity = 1.0f);
+
+    // Results of the last run()
+    const float* getResults() const { return results_.data(); }
+    size_t getCandidateCount() const { return candidates_; }
+
+    // Lowest final distance + energyWeight * energy (0 when no candidates)
+    size_t bestCandidate(float energyWeight = 0.0f) const;
+
+    /**
+     * Random candidate sequences for Monte Carlo planning
+     * Each candidate starts on a uniform action and switches to a new uniform
+     * action with probability switchProbability per step, so sequences hold
+     * an action for a while like a real pilot.
+     */
+    static void sampleActions(RngStream& rng, uint8_t* out, size_t candidates, size_t horizon,
+                              float switchProbability = 0.2f);
+
+private:
+    SpaceshipConfig config_;
+    Vector3 target_;
+
+    Vector3 startPosition_;
+    Vector3 startVelocity_;
+    Quaternion startRotation_;
+    Vector3 startAngularVelocity_;
+
+    // Candidate bodies (structure-of-arrays, CandidateArray order)
+    enum CandidateArray {
+        PX, PY, PZ, VX, VY, VZ, QW, QX, QY, QZ, WX, WY, WZ,
+        FX, FY, FZ, TX, TY, TZ,
+        MASS, LINEAR_DAMPING, ANGULAR_DAMPING, MAX_ANGULAR_VELOCITY,
+        ARRAY_COUNT
+    };
+    std::vector<float> arrays_[ARRAY_COUNT];
+    std::vector<float> results_;
+    size_t candidates_;
+
+    std::unique_ptr<ThreadPool> pool_;   // null when serial
+
+    void reserve(size_t candidates);
+    BodyArrays slice(size_t begin, size_t end);
+    void runRange(const uint8_t* actions, size_t begin, size_t end, size_t horizon,
+                  float deltaTime, float intensity);
+};
+
+} // namespace aeronav
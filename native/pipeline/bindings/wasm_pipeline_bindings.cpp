@@ -0,0 +1,130 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../src/noise_pipeline.hpp"
+#include "arena.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+
+using namespace emscripten;
+using namespace aeronav;
+
+// Linked with the RL bindings (MultiAgentSystem, profiler, allocation stats
+// come from there); this file only adds the pipeline.
+
+// Wrapper for NoisePipeline over a MultiAgentSystem of this module
+// JS fills the persistent spectrum input with one TypedArray.set() and calls
+// tick(): band analysis, classification and stepAll run in one crossing.
+class NoisePipelineWrapper {
+public:
+    explicit NoisePipelineWrapper(MultiAgentSystem& system) : pipeline_(system) {}
+
+    bool configureBands(unsigned int bandCount, unsigned int binCount, float sampleRate,
+                        float minHz, float maxHz, int scale) {
+        return pipeline_.getBandBank().configure(bandCount, binCount, sampleRate, minHz, maxHz,
+            scale == static_cast<int>(BandScale::MEL) ? BandScale::MEL : BandScale::LOG);
+    }
+    void setNoiseBands(unsigned int begin, unsigned int end) { pipeline_.getBandBank().setNoiseBands(begin, end); }
+    void setNoiseThresholds(float high, float low) { pipeline_.getBandBank().setNoiseThresholds(high, low); }
+    void setSmoothing(float timeConstant) { pipeline_.getBandBank().setSmoothing(timeConstant); }
+
+    // Uint8Array view over the persistent spectrum input (re-acquire after memory growth)
+    val getSpectrumBuffer(unsigned int length) {
+        if (spectrum_.size() < length) spectrum_.resize(length);
+        return val(typed_memory_view(length, spectrum_.data()));
+    }
+
+    // Classify the spectrum input and step every agent; returns the NoiseState (0 / 1)
+    int tick(unsigned int length, bool isTraining) {
+        AERONAV_PROFILE_BOUNDARY();
+        length = std::min<unsigned int>(length, spectrum_.size());
+        return static_cast<int>(pipeline_.tick(spectrum_.data(), length, isTraining));
+    }
+
+    // Offline batches: stage `ticks` spectra of `bins` bytes (or `ticks` state
+    // bytes) in getBatchBuffer(), then run them; per-tick states and mean
+    // rewards land in getStateView() / getRewardView()
+    val getBatchBuffer(unsigned int bytes) {
+        if (batch_.size() < bytes) batch_.resize(bytes);
+        return val(typed_memory_view(bytes, batch_.data()));
+    }
+
+    unsigned int runSpectra(unsigned int ticks, unsigned int bins, bool isTraining) {
+        AERONAV_PROFILE_BOUNDARY();
+        if (bins == 0) return 0;
+        ticks = std::min<unsigned int>(ticks, static_cast<unsigned int>(batch_.size() / bins));
+        reserveOutputs(ticks);
+        return static_cast<unsigned int>(
+            pipeline_.runSpectra(batch_.data(), ticks, bins, isTraining, states_.data(), rewards_.data()));
+    }
+
+    unsigned int runStates(unsigned int ticks, bool isTraining) {
+        AERONAV_PROFILE_BOUNDARY();
+        ticks = std::min<unsigned int>(ticks, static_cast<unsigned int>(batch_.size()));
+        reserveOutputs(ticks);
+        std::transform(batch_.begin(), batch_.begin() + ticks, states_.begin(),
+                       [](uint8_t state) { return static_cast<uint8_t>(state != 0); });
+        return static_cast<unsigned int>(pipeline_.runStates(batch_.data(), ticks, isTraining, rewards_.data()));
+    }
+
+    val getStateView() const { return val(typed_memory_view(outputTicks_, states_.data())); }
+    val getRewardView() const { return val(typed_memory_view(outputTicks_, rewards_.data())); }
+
+    // Bands of the last analyzed spectrum, for display without a second analyzer
+    val getBandView() const {
+        const BandBank& bank = pipeline_.getBandBank();
+        return val(typed_memory_view(bank.getBandCount(), bank.getBands()));
+    }
+    val getDetectorView() const {
+        return val(typed_memory_view(BandDetectorLayout::STRIDE, pipeline_.getBandBank().getDetector()));
+    }
+
+    int getLastState() const { return static_cast<int>(pipeline_.getLastState()); }
+    double getTickCount() const { return static_cast<double>(pipeline_.getTickCount()); }
+    double getHighNoiseTicks() const { return static_cast<double>(pipeline_.getHighNoiseTicks()); }
+    void resetCounters() { pipeline_.resetCounters(); }
+
+private:
+    NoisePipeline pipeline_;
+    ArenaVector<uint8_t> spectrum_;
+    ArenaVector<uint8_t> batch_;
+    ArenaVector<uint8_t> states_;
+    ArenaVector<float> rewards_;
+    size_t outputTicks_ = 0;
+
+    void reserveOutputs(size_t ticks) {
+        if (states_.size() < ticks) states_.resize(ticks);
+        if (rewards_.size() < ticks) rewards_.resize(ticks);
+        outputTicks_ = ticks;
+    }
+};
+
+EMSCRIPTEN_BINDINGS(aeronav_pipeline) {
+    // The system argument is held by reference: keep it alive while the pipeline is used
+    class_<NoisePipelineWrapper>("NoisePipeline")
+        .constructor<MultiAgentSystem&>()
+        .function("configureBands", &NoisePipelineWrapper::configureBands)
+        .function("setNoiseBands", &NoisePipelineWrapper::setNoiseBands)
+        .function("setNoiseThresholds", &NoisePipelineWrapper::setNoiseThresholds)
+        .function("setSmoothing", &NoisePipelineWrapper::setSmoothing)
+        .function("getSpectrumBuffer", &NoisePipelineWrapper::getSpectrumBuffer)
+        .function("tick", &NoisePipelineWrapper::tick)
+        .function("getBatchBuffer", &NoisePipelineWrapper::getBatchBuffer)
+        .function("runSpectra", &NoisePipelineWrapper::runSpectra)
+        .function("runStates", &NoisePipelineWrapper::runStates)
+        .function("getStateView", &NoisePipelineWrapper::getStateView)
+        .function("getRewardView", &NoisePipelineWrapper::getRewardView)
+        .function("getBandView", &NoisePipelineWrapper::getBandView)
+        .function("getDetectorView", &NoisePipelineWrapper::getDetectorView)
+        .function("getLastState", &NoisePipelineWrapper::getLastState)
+        .function("getTickCount", &NoisePipelineWrapper::getTickCount)
+        .function("getHighNoiseTicks", &NoisePipelineWrapper::getHighNoiseTicks)
+        .function("resetCounters", &NoisePipelineWrapper::resetCounters);
+
+    constant("BAND_SCALE_LOG", static_cast<int>(BandScale::LOG));
+    constant("BAND_SCALE_MEL", static_cast<int>(BandScale::MEL));
+    constant("BAND_DETECTOR_STRIDE", static_cast<int>(BandDetectorLayout::STRIDE));
+    constant("BAND_DETECTOR_NOISE_LEVEL", static_cast<int>(BandDetectorLayout::NOISE_LEVEL));
+    constant("BAND_DETECTOR_FLUX", static_cast<int>(BandDetectorLayout::FLUX));
+    constant("BAND_DETECTOR_ONSET", static_cast<int>(BandDetectorLayout::ONSET));
+    constant("BAND_DETECTOR_NOISE_STATE", static_cast<int>(BandDetectorLayout::NOISE_STATE));
+}
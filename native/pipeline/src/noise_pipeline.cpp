@@ -0,0 +1,66 @@
+#include "noise_pipeline.hpp"
+
+namespace aeronav {
+
+NoisePipeline::NoisePipeline(MultiAgentSystem& system)
+    : system_(system)
+    , bank_()
+    , lastState_(NoiseState::LOW_NOISE)
+    , ticks_(0)
+    , highNoiseTicks_(0)
+{
+}
+
+void NoisePipeline::resetCounters() {
+    ticks_ = 0;
+    highNoiseTicks_ = 0;
+}
+
+void NoisePipeline::step(NoiseState state, bool isTraining) {
+    system_.stepAll(state, isTraining);
+    lastState_ = state;
+    ticks_++;
+    if (state == NoiseState::HIGH_NOISE) highNoiseTicks_++;
+}
+
+float NoisePipeline::meanReward() {
+    const AgentArrays arrays = system_.getArrays();
+    if (arrays.count == 0) return 0.0f;
+    float sum = 0.0f;
+    for (size_t i = 0; i < arrays.count; i++) sum += arrays.reward[i];
+    return sum / static_cast<float>(arrays.count);
+}
+
+NoiseState NoisePipeline::tick(const uint8_t* spectrum, size_t length, bool isTraining) {
+    bank_.process(spectrum, length);
+    step(bank_.getNoiseState(), isTraining);
+    return lastState_;
+}
+
+NoiseState NoisePipeline::tickFloat(const float* spectrum, size_t length, bool normalized, bool isTraining) {
+    bank_.processFloat(spectrum, length, normalized);
+    step(bank_.getNoiseState(), isTraining);
+    return lastState_;
+}
+
+size_t NoisePipeline::runSpectra(const uint8_t* spectra, size_t ticks, size_t bins, bool isTraining,
+                                 uint8_t* statesOut, float* meanRewardOut) {
+    if (spectra == nullptr || bins == 0) return 0;
+    for (size_t t = 0; t < ticks; t++) {
+        const NoiseState state = tick(spectra + t * bins, bins, isTraining);
+        if (statesOut) statesOut[t] = static_cast<uint8_t>(state);
+        if (meanRewardOut) meanRewardOut[t] = meanReward();
+    }
+    return ticks;
+}
+
+size_t NoisePipeline::runStates(const uint8_t* states, size_t ticks, bool isTraining, float* meanRewardOut) {
+    if (states == nullptr) return 0;
+    for (size_t t = 0; t < ticks; t++) {
+        step(states[t] != 0 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE, isTraining);
+        if (meanRewardOut) meanRewardOut[t] = meanReward();
+    }
+    return ticks;
+}
+
+} // namespace aeronav
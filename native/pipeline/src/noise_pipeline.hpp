@@ -0,0 +1,59 @@
+#pragma once
+
+#include "band_bank.hpp"
+#include "multi_agent.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace aeronav {
+
+/**
+ * Audio -> RL in one module: each tick classifies a spectrum with a BandBank
+ * and steps every agent of a MultiAgentSystem on the resulting NoiseState,
+ * with no return to the caller in between.
+ *
+ * The batch entry points run many ticks per call for offline training, from
+ * recorded spectra or from a precomputed noise-state stream. Only stepAll()
+ * touches the system, so results match driving it tick by tick.
+ */
+class NoisePipeline {
+public:
+    // The system must outlive the pipeline
+    explicit NoisePipeline(MultiAgentSystem& system);
+
+    BandBank& getBandBank() { return bank_; }
+    const BandBank& getBandBank() const { return bank_; }
+    MultiAgentSystem& getSystem() { return system_; }
+
+    // One tick: classify an AnalyserNode byte spectrum (or a float spectrum), then step
+    NoiseState tick(const uint8_t* spectrum, size_t length, bool isTraining);
+    NoiseState tickFloat(const float* spectrum, size_t length, bool normalized, bool isTraining);
+
+    /**
+     * `ticks` byte spectra of `bins` bins, back to back. statesOut (ticks
+     * bytes, 0 / 1) and meanRewardOut (ticks floats, mean agent reward
+     * after the step) are optional. Returns the ticks run.
+     */
+    size_t runSpectra(const uint8_t* spectra, size_t ticks, size_t bins, bool isTraining,
+                      uint8_t* statesOut = nullptr, float* meanRewardOut = nullptr);
+
+    // `ticks` noise states (0 = LOW_NOISE, anything else HIGH_NOISE), bypassing the bank
+    size_t runStates(const uint8_t* states, size_t ticks, bool isTraining, float* meanRewardOut = nullptr);
+
+    NoiseState getLastState() const { return lastState_; }
+    uint64_t getTickCount() const { return ticks_; }
+    uint64_t getHighNoiseTicks() const { return highNoiseTicks_; }
+    void resetCounters();
+
+private:
+    MultiAgentSystem& system_;
+    BandBank bank_;
+    NoiseState lastState_;
+    uint64_t ticks_;
+    uint64_t highNoiseTicks_;
+
+    void step(NoiseState state, bool isTraining);
+    float meanReward();
+};
+
+} // namespace aeronav
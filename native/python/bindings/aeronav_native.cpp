@@ -0,0 +1,636 @@
+// Python extension for the Aeronav native cores (physics, RL, audio, vec-env)
+// Batched state crosses as NumPy arrays: outputs over fixed-size native
+// buffers are views (kept alive by the owning object), outputs over storage
+// that can reallocate (world bodies, agents, band layout) are copies. Inputs
+// are read through the buffer protocol without per-element conversion.
+// Batched steps release the GIL.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include "physics_engine.hpp"
+#include "physics_world.hpp"
+#include "multi_agent.hpp"
+#include "audio_fft.hpp"
+#include "band_bank.hpp"
+#include "noise_pipeline.hpp"
+#include "vec_env.hpp"
+#include "trajectory_recorder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+using namespace aeronav;
+
+namespace {
+
+// C-contiguous input arrays (converted once if the caller passes another dtype/layout)
+template <typename T>
+using InputArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// Read-only NumPy view over memory owned by `owner`. Only for buffers that
+// never move for the owner's lifetime: a view over growable storage would
+// dangle after the next reallocation.
+template <typename T>
+py::array_t<T> readOnlyView(const T* data, std::vector<py::ssize_t> shape, py::handle owner) {
+    py::array_t<T> array(shape, data, owner);
+    py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return array;
+}
+
+// Owned NumPy copy of native storage that can reallocate
+template <typename T>
+py::array_t<T> copyOf(const T* data, std::vector<py::ssize_t> shape) {
+    return py::array_t<T>(shape, data);
+}
+
+void requireLength(const py::array& array, size_t length, const char* name) {
+    if (static_cast<size_t>(array.size()) < length) {
+        throw std::invalid_argument(std::string(name) + " has fewer elements than required");
+    }
+}
+
+// Any bytes-like object (bytes, bytearray, memoryview, uint8 ndarray) without copying
+template <typename Restore>
+bool restoreFromBuffer(const py::buffer& data, Restore&& restore) {
+    py::buffer_info info = data.request();
+    const size_t size = static_cast<size_t>(info.size * info.itemsize);
+    const uint8_t* bytes = static_cast<const uint8_t*>(info.ptr);
+    py::gil_scoped_release release;
+    return restore(bytes, size);
+}
+
+py::tuple analysisTuple(const AudioAnalysisResult& result) {
+    return py::make_tuple(result.bass, result.mid, result.treble, result.volume);
+}
+
+// (rows, bins) spectra -> (rows, 4) [bass, mid, treble, volume]
+template <typename T, int Flags, typename Analyze>
+py::array_t<float> analyzeRows(const py::array_t<T, Flags>& spectra, Analyze&& analyze) {
+    if (spectra.ndim() != 2) throw std::invalid_argument("spectra must be 2-D (rows, bins)");
+    const size_t rows = static_cast<size_t>(spectra.shape(0));
+    const size_t bins = static_cast<size_t>(spectra.shape(1));
+
+    py::array_t<float> out({static_cast<py::ssize_t>(rows), static_cast<py::ssize_t>(4)});
+    const T* in = spectra.data();
+    float* results = out.mutable_data();
+    {
+        py::gil_scoped_release release;
+        for (size_t row = 0; row < rows; row++) {
+            const AudioAnalysisResult r = analyze(in + row * bins, bins);
+            float* record = results + row * 4;
+            record[0] = r.bass; record[1] = r.mid; record[2] = r.treble; record[3] = r.volume;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+PYBIND11_MODULE(aeronav_native, m) {
+    m.doc() = "Aeronav native physics, multi-agent RL, audio analysis and vectorized env";
+
+    py::enum_<ThrustAction>(m, "ThrustAction")
+        .value("IDLE", ThrustAction::IDLE)
+        .value("GLIDE", ThrustAction::GLIDE)
+        .value("BOOST", ThrustAction::BOOST)
+        .value("STABILIZE", ThrustAction::STABILIZE);
+
+    py::enum_<IntegratorType>(m, "IntegratorType")
+        .value("SEMI_IMPLICIT_EULER", IntegratorType::SEMI_IMPLICIT_EULER)
+        .value("VELOCITY_VERLET", IntegratorType::VELOCITY_VERLET)
+        .value("RUNGE_KUTTA_4", IntegratorType::RUNGE_KUTTA_4)
+        .value("EXACT_DAMPING", IntegratorType::EXACT_DAMPING);
+
+    py::enum_<NoiseState>(m, "NoiseState")
+        .value("LOW_NOISE", NoiseState::LOW_NOISE)
+        .value("HIGH_NOISE", NoiseState::HIGH_NOISE);
+
+    py::enum_<AgentPolicy>(m, "AgentPolicy")
+        .value("BALANCED", AgentPolicy::BALANCED)
+        .value("CONSERVATIVE", AgentPolicy::CONSERVATIVE)
+        .value("AGGRESSIVE", AgentPolicy::AGGRESSIVE)
+        .value("EXPLORATORY", AgentPolicy::EXPLORATORY)
+        .value("EXPLOITATIVE", AgentPolicy::EXPLOITATIVE);
+
+    // State record layout (float offsets within one StateLayout record)
+    m.attr("STATE_POSITION") = StateLayout::POSITION;
+    m.attr("STATE_VELOCITY") = StateLayout::VELOCITY;
+    m.attr("STATE_ROTATION") = StateLayout::ROTATION;
+    m.attr("STATE_ANGULAR_VELOCITY") = StateLayout::ANGULAR_VELOCITY;
+    m.attr("STATE_ROTATION_W") = StateLayout::ROTATION_W;
+    m.attr("STATE_ROLL") = StateLayout::ROLL;
+    m.attr("STATE_YAW") = StateLayout::YAW;
+    m.attr("STATE_SPEED") = StateLayout::SPEED;
+    m.attr("STATE_STRIDE") = StateLayout::STRIDE;
+
+    // Container heap traffic of the extension (arena.hpp)
+    py::class_<AllocationStats>(m, "AllocationStats")
+        .def_readonly("heap_allocations", &AllocationStats::heapAllocations)
+        .def_readonly("heap_frees", &AllocationStats::heapFrees)
+        .def_readonly("heap_bytes_in_use", &AllocationStats::heapBytesInUse)
+        .def_readonly("arena_allocations", &AllocationStats::arenaAllocations);
+    m.def("allocation_stats", &getAllocationStats);
+
+    // ---- Physics ----
+
+    py::class_<SpaceshipConfig>(m, "SpaceshipConfig")
+        .def(py::init<>())
+        .def_readwrite("mass", &SpaceshipConfig::mass)
+        .def_readwrite("max_thrust", &SpaceshipConfig::maxThrust)
+        .def_readwrite("max_angular_velocity", &SpaceshipConfig::maxAngularVelocity)
+        .def_readwrite("linear_damping", &SpaceshipConfig::linearDamping)
+        .def_readwrite("angular_damping", &SpaceshipConfig::angularDamping)
+        .def_readwrite("drag_coefficient", &SpaceshipConfig::dragCoefficient);
+
+    py::class_<PhysicsEngine>(m, "PhysicsEngine")
+        .def(py::init<>())
+        .def(py::init<const SpaceshipConfig&>(), py::arg("config"))
+        .def("step", [](PhysicsEngine& engine, float deltaTime, IntegratorType integrator) {
+            withIntegrator(integrator, [&](auto policy) { engine.stepWith<decltype(policy)>(deltaTime); });
+        }, py::arg("delta_time"), py::arg("integrator") = IntegratorType::SEMI_IMPLICIT_EULER)
+        .def("reset", &PhysicsEngine::reset, py::arg("x") = 0.0f, py::arg("y") = 0.0f, py::arg("z") = 0.0f)
+        .def("set_target", &PhysicsEngine::setTarget, py::arg("x"), py::arg("y"), py::arg("z"))
+        .def("apply_thrust", [](PhysicsEngine& engine, int action, float intensity) {
+            engine.applyThrust(toThrustAction(action), intensity);
+        }, py::arg("action"), py::arg("intensity") = 1.0f)
+        .def("apply_banking", &PhysicsEngine::applyBanking, py::arg("desired_roll"), py::arg("roll_factor") = 0.1f)
+        // (STATE_STRIDE,) view, refreshed in place by step()/reset()
+        .def_property_readonly("state", [](py::object self) {
+            const PhysicsEngine& engine = self.cast<const PhysicsEngine&>();
+            return readOnlyView(engine.getStateBuffer(), {static_cast<py::ssize_t>(StateLayout::STRIDE)}, self);
+        })
+        .def("set_fixed_timestep", &PhysicsEngine::setFixedTimestep,
+             py::arg("rate_hz"), py::arg("max_sub_steps") = 4)
+        .def_property_readonly("is_fixed_timestep", &PhysicsEngine::isFixedTimestep)
+        .def_property_readonly("interpolation_alpha", &PhysicsEngine::getInterpolationAlpha)
+        .def_property_readonly("last_sub_step_count", &PhysicsEngine::getLastSubStepCount)
+        // (STATE_STRIDE,) interpolated render record
+        .def_property_readonly("render_state", [](py::object self) {
+            const PhysicsEngine& engine = self.cast<const PhysicsEngine&>();
+            return readOnlyView(engine.getRenderStateBuffer(), {static_cast<py::ssize_t>(StateLayout::STRIDE)}, self);
+        })
+        // -> bytes (one PhysicsEngineSnapshot record)
+        .def("save_snapshot", [](const PhysicsEngine& engine) {
+            PhysicsEngineSnapshot snapshot;
+            engine.saveSnapshot(snapshot);
+            return py::bytes(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+        })
+        .def("restore_snapshot", [](PhysicsEngine& engine, const py::buffer& data) {
+            return restoreFromBuffer(data, [&](const uint8_t* bytes, size_t size) {
+                if (size != sizeof(PhysicsEngineSnapshot)) return false;
+                PhysicsEngineSnapshot snapshot;
+                std::memcpy(&snapshot, bytes, sizeof(snapshot));
+                return engine.restoreSnapshot(snapshot);
+            });
+        }, py::arg("data"))
+        .def_property_readonly("roll", &PhysicsEngine::getRoll)
+        .def_property_readonly("pitch", &PhysicsEngine::getPitch)
+        .def_property_readonly("yaw", &PhysicsEngine::getYaw)
+        .def_property_readonly("speed", &PhysicsEngine::getSpeed)
+        // Fill STATE_ROLL/YAW/SPEED of `state` on every refresh
+        .def_property("derived_state_export", &PhysicsEngine::isDerivedStateExport,
+                      &PhysicsEngine::setDerivedStateExport)
+        .def_property("config", &PhysicsEngine::getConfig, &PhysicsEngine::setConfig);
+
+    py::class_<PhysicsWorld>(m, "PhysicsWorld")
+        .def(py::init<>())
+        .def(py::init<size_t>(), py::arg("max_bodies"))
+        .def("create_body", &PhysicsWorld::createBody, py::arg("config") = SpaceshipConfig())
+        .def_property_readonly("body_count", &PhysicsWorld::getBodyCount)
+        .def("clear", &PhysicsWorld::clear)
+        .def("step_all", [](PhysicsWorld& world, float deltaTime, IntegratorType integrator) {
+            withIntegrator(integrator, [&](auto policy) { world.stepAllWith<decltype(policy)>(deltaTime); });
+        }, py::arg("delta_time"), py::arg("integrator") = IntegratorType::SEMI_IMPLICIT_EULER,
+           py::call_guard<py::gil_scoped_release>())
+        .def("reset_body", &PhysicsWorld::resetBody,
+             py::arg("index"), py::arg("x") = 0.0f, py::arg("y") = 0.0f, py::arg("z") = 0.0f)
+        .def("set_target", &PhysicsWorld::setTarget, py::arg("index"), py::arg("x"), py::arg("y"), py::arg("z"))
+        // targets: (body_count, 3)
+        .def("set_targets", [](PhysicsWorld& world, const InputArray<float>& targets) {
+            const size_t count = world.getBodyCount();
+            requireLength(targets, count * 3, "targets");
+            const float* t = targets.data();
+            py::gil_scoped_release release;
+            for (size_t i = 0; i < count; i++) {
+                world.setTarget(static_cast<uint32_t>(i), t[i * 3], t[i * 3 + 1], t[i * 3 + 2]);
+            }
+        }, py::arg("targets"))
+        .def("apply_thrust", [](PhysicsWorld& world, uint32_t index, int action, float intensity) {
+            world.applyThrust(index, toThrustAction(action), intensity);
+        }, py::arg("index"), py::arg("action"), py::arg("intensity") = 1.0f)
+        // actions: (body_count,) ThrustAction values
+        .def("apply_thrusts", [](PhysicsWorld& world, const InputArray<int32_t>& actions, float intensity) {
+            const size_t count = world.getBodyCount();
+            requireLength(actions, count, "actions");
+            const int32_t* a = actions.data();
+            py::gil_scoped_release release;
+            for (size_t i = 0; i < count; i++) {
+                world.applyThrust(static_cast<uint32_t>(i), toThrustAction(a[i]), intensity);
+            }
+        }, py::arg("actions"), py::arg("intensity") = 1.0f)
+        // (body_count, STATE_STRIDE) copy (the body arrays reallocate on create_body())
+        .def_property_readonly("state", [](const PhysicsWorld& world) {
+            return copyOf(world.getStateBuffer(),
+                          {static_cast<py::ssize_t>(world.getBodyCount()),
+                           static_cast<py::ssize_t>(StateLayout::STRIDE)});
+        })
+        .def("save_snapshot", [](const PhysicsWorld& world) {
+            std::string blob(world.getSnapshotSize(), '\0');
+            world.saveSnapshot(reinterpret_cast<uint8_t*>(&blob[0]), blob.size());
+            return py::bytes(blob);
+        })
+        .def("restore_snapshot", [](PhysicsWorld& world, const py::buffer& data) {
+            return restoreFromBuffer(data, [&](const uint8_t* bytes, size_t size) {
+                return world.restoreSnapshot(bytes, size);
+            });
+        }, py::arg("data"))
+        .def_property("derived_state_export", &PhysicsWorld::isDerivedStateExport,
+                      &PhysicsWorld::setDerivedStateExport)
+        .def_property("proximity_radius", &PhysicsWorld::getProximityRadius, &PhysicsWorld::setProximityRadius)
+        // (pairs, 2) copy of the body index pairs within the proximity radius
+        .def("find_proximity_pairs", [](PhysicsWorld& world) {
+            size_t pairs;
+            {
+                py::gil_scoped_release release;
+                pairs = world.findProximityPairs();
+            }
+            py::array_t<uint32_t> out({static_cast<py::ssize_t>(pairs), static_cast<py::ssize_t>(2)});
+            std::copy(world.getProximityPairs(), world.getProximityPairs() + pairs * 2, out.mutable_data());
+            return out;
+        });
+
+    // ---- Multi-agent RL ----
+
+    py::class_<EnergyConfig>(m, "EnergyConfig")
+        .def(py::init<>())
+        .def_readwrite("max", &EnergyConfig::max)
+        .def_readwrite("regen", &EnergyConfig::regen)
+        .def_readwrite("cost_glide", &EnergyConfig::costGlide)
+        .def_readwrite("cost_boost", &EnergyConfig::costBoost)
+        .def_readwrite("cost_stabilize", &EnergyConfig::costStabilize);
+
+    py::class_<AgentConfig>(m, "AgentConfig")
+        .def(py::init<>())
+        .def_readwrite("policy", &AgentConfig::policy)
+        .def_readwrite("epsilon_normal", &AgentConfig::epsilonNormal)
+        .def_readwrite("epsilon_training", &AgentConfig::epsilonTraining)
+        .def_readwrite("learning_rate", &AgentConfig::learningRate)
+        .def_readwrite("energy", &AgentConfig::energy);
+
+    m.attr("COORDINATION_EVENT_STRIDE") = CoordinationEventRecord::STRIDE;
+
+    py::class_<MultiAgentSystem>(m, "MultiAgentSystem")
+        .def(py::init<>())
+        .def(py::init<uint64_t>(), py::arg("seed"))
+        .def(py::init<uint64_t, size_t>(), py::arg("seed"), py::arg("max_agents"))
+        .def_property_readonly("agent_capacity", &MultiAgentSystem::getAgentCapacity)
+        .def_property("seed", &MultiAgentSystem::getSeed, &MultiAgentSystem::setSeed)
+        .def("create_agent", &MultiAgentSystem::createAgent, py::arg("config") = AgentConfig())
+        .def("remove_agent", &MultiAgentSystem::removeAgent, py::arg("agent_id"))
+        .def("has_agent", &MultiAgentSystem::hasAgent, py::arg("agent_id"))
+        .def_property_readonly("agent_count", &MultiAgentSystem::getAgentCount)
+        .def_property("thread_count", &MultiAgentSystem::getThreadCount, &MultiAgentSystem::setThreadCount)
+        .def("step_all", &MultiAgentSystem::stepAll, py::arg("noise_state"), py::arg("is_training"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("select_action", &MultiAgentSystem::selectAction,
+             py::arg("agent_id"), py::arg("noise_state"), py::arg("is_training"))
+        .def("calculate_reward", &MultiAgentSystem::calculateReward,
+             py::arg("agent_id"), py::arg("noise_state"), py::arg("action"), py::arg("energy_level"))
+        .def("update_q_table", &MultiAgentSystem::updateQTable,
+             py::arg("agent_id"), py::arg("noise_state"), py::arg("action"), py::arg("reward"))
+        .def("regen_energy", &MultiAgentSystem::regenEnergy, py::arg("agent_id"), py::arg("delta_time"))
+        .def("reset_energy", &MultiAgentSystem::resetEnergy, py::arg("agent_id"))
+        // Per-agent (agent_count,) copies in dense order (the agent arrays reallocate on create)
+        .def_property_readonly("energy", [](MultiAgentSystem& system) {
+            AgentArrays a = system.getArrays();
+            return copyOf<float>(a.energy, {static_cast<py::ssize_t>(a.count)});
+        })
+        .def_property_readonly("reward", [](MultiAgentSystem& system) {
+            AgentArrays a = system.getArrays();
+            return copyOf<float>(a.reward, {static_cast<py::ssize_t>(a.count)});
+        })
+        .def_property_readonly("confidence", [](MultiAgentSystem& system) {
+            AgentArrays a = system.getArrays();
+            return copyOf<float>(a.confidence, {static_cast<py::ssize_t>(a.count)});
+        })
+        // ThrustAction values as float32, as written by step_all()
+        .def_property_readonly("action", [](MultiAgentSystem& system) {
+            AgentArrays a = system.getArrays();
+            return copyOf<float>(a.action, {static_cast<py::ssize_t>(a.count)});
+        })
+        // (2, 3, agent_count) copy indexed [noise_state][action - 1]
+        .def_property_readonly("q_values", [](MultiAgentSystem& system) {
+            AgentArrays a = system.getArrays();
+            const py::ssize_t count = static_cast<py::ssize_t>(a.count);
+            py::array_t<float> out({static_cast<py::ssize_t>(NOISE_STATE_COUNT),
+                                    static_cast<py::ssize_t>(Q_ACTION_COUNT), count});
+            float* q = out.mutable_data();
+            for (size_t noise = 0; noise < NOISE_STATE_COUNT; noise++) {
+                for (size_t action = 0; action < Q_ACTION_COUNT; action++, q += a.count) {
+                    std::copy(a.q[noise][action], a.q[noise][action] + a.count, q);
+                }
+            }
+            return out;
+        })
+        // (agent_count, AGENT_RECORD_STRIDE) copy, one AgentRecordLayout record per agent;
+        // the ID and TOTAL_STEPS columns are uint32 words (records.view(numpy.uint32))
+        .def_property_readonly("agent_records", [](const MultiAgentSystem& system) {
+            py::array_t<float> out({static_cast<py::ssize_t>(system.getAgentCount()),
+                                    static_cast<py::ssize_t>(AgentRecordLayout::STRIDE)});
+            system.writeAgentRecords(out.mutable_data());
+            return out;
+        })
+        // positions: (agent_count, stride >= 3), e.g. PhysicsWorld.state
+        .def("set_agent_positions", [](MultiAgentSystem& system, const InputArray<float>& positions) {
+            if (positions.ndim() != 2 || positions.shape(1) < 3) {
+                throw std::invalid_argument("positions must be (agents, stride >= 3)");
+            }
+            system.setAgentPositions(positions.data(), static_cast<size_t>(positions.shape(1)),
+                                     static_cast<size_t>(positions.shape(0)));
+        }, py::arg("positions"))
+        .def("detect_coordination", &MultiAgentSystem::detectCoordination, py::arg("timestamp"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("detect_coordination_in_radius", &MultiAgentSystem::detectCoordinationInRadius,
+             py::arg("timestamp"), py::arg("radius"), py::call_guard<py::gil_scoped_release>())
+        .def("coordination_score", &MultiAgentSystem::calculateCoordinationScore, py::arg("agent_id"))
+        .def("save_snapshot", [](const MultiAgentSystem& system) {
+            std::string blob(system.getSnapshotSize(), '\0');
+            system.saveSnapshot(reinterpret_cast<uint8_t*>(&blob[0]), blob.size());
+            return py::bytes(blob);
+        })
+        .def("restore_snapshot", [](MultiAgentSystem& system, const py::buffer& data) {
+            return restoreFromBuffer(data, [&](const uint8_t* bytes, size_t size) {
+                return system.restoreSnapshot(bytes, size);
+            });
+        }, py::arg("data"))
+        .def("clear_coordination_events", &MultiAgentSystem::clearCoordinationEvents)
+        .def_property("coordination_event_capacity", &MultiAgentSystem::getCoordinationEventCapacity,
+                      &MultiAgentSystem::setCoordinationEventCapacity)
+        .def_property_readonly("coordination_sequence", &MultiAgentSystem::getCoordinationSequence)
+        // -> (events (n, COORDINATION_EVENT_STRIDE) uint32, next_sequence)
+        .def("coordination_events_since", [](const MultiAgentSystem& system, uint64_t sequence) {
+            const size_t capacity = system.getCoordinationEventCapacity();
+            std::vector<CoordinationEventRecord> records(capacity);
+            const size_t count = system.copyCoordinationEventsSince(sequence, records.data(), capacity);
+            py::array_t<uint32_t> out({static_cast<py::ssize_t>(count),
+                                       static_cast<py::ssize_t>(CoordinationEventRecord::STRIDE)});
+            if (count > 0) {
+                std::copy(records[0].words, records[0].words + count * CoordinationEventRecord::STRIDE,
+                          out.mutable_data());
+            }
+            return py::make_tuple(out, system.getCoordinationSequence());
+        }, py::arg("sequence") = 0);
+
+    m.attr("AGENT_RECORD_ID") = AgentRecordLayout::ID;
+    m.attr("AGENT_RECORD_ACTION") = AgentRecordLayout::ACTION;
+    m.attr("AGENT_RECORD_REWARD") = AgentRecordLayout::REWARD;
+    m.attr("AGENT_RECORD_ENERGY") = AgentRecordLayout::ENERGY;
+    m.attr("AGENT_RECORD_CONFIDENCE") = AgentRecordLayout::CONFIDENCE;
+    m.attr("AGENT_RECORD_Q_LOW_NOISE") = AgentRecordLayout::Q_LOW_NOISE;
+    m.attr("AGENT_RECORD_Q_HIGH_NOISE") = AgentRecordLayout::Q_HIGH_NOISE;
+    m.attr("AGENT_RECORD_TOTAL_STEPS") = AgentRecordLayout::TOTAL_STEPS;
+    m.attr("AGENT_RECORD_STRIDE") = AgentRecordLayout::STRIDE;
+
+    // ---- Trajectory recording ----
+
+    // Appends fixed-size records to a memory-mapped file; usable as a context manager
+    py::class_<TrajectoryRecorder>(m, "TrajectoryRecorder")
+        .def(py::init([](const std::string& path, uint32_t recordWords, uint32_t chunkRecords, bool delta) {
+            auto recorder = std::make_unique<TrajectoryRecorder>(recordWords, chunkRecords, delta);
+            if (!recorder->isValid()) throw std::invalid_argument("chunk payload exceeds 32 bits, use fewer chunk_records");
+            if (!recorder->open(path.c_str())) throw std::runtime_error("cannot create recording " + path);
+            return recorder;
+        }), py::arg("path"), py::arg("record_words"),
+            py::arg("chunk_records") = TrajectoryRecorder::DEFAULT_CHUNK_RECORDS, py::arg("delta") = true)
+        // record: any C-contiguous array of >= record_words 4-byte values (float32, int32, uint32)
+        .def("append", [](TrajectoryRecorder& recorder, const py::array& record) {
+            if (record.itemsize() != 4 || !(record.flags() & py::array::c_style)) {
+                throw std::invalid_argument("record must be a C-contiguous array of 4-byte values");
+            }
+            requireLength(record, recorder.getRecordWords(), "record");
+            recorder.append(record.data());
+        }, py::arg("record"))
+        .def("finish", &TrajectoryRecorder::finish)
+        .def("__enter__", [](py::object self) { return self; })
+        .def("__exit__", [](TrajectoryRecorder& recorder, py::args) { recorder.finish(); })
+        .def_property_readonly("record_words", &TrajectoryRecorder::getRecordWords)
+        .def_property_readonly("record_count", &TrajectoryRecorder::getRecordCount)
+        .def_property_readonly("bytes_written", &TrajectoryRecorder::getBytesWritten)
+        .def_property_readonly("is_finished", &TrajectoryRecorder::isFinished)
+        .def_property_readonly("has_write_error", &TrajectoryRecorder::hasWriteError);
+
+    // Random access over a recording (finished or not); records come back as
+    // float32 (use .view(numpy.uint32) for integer words)
+    py::class_<TrajectoryReader>(m, "TrajectoryReader")
+        .def(py::init([](const std::string& path) {
+            auto reader = std::make_unique<TrajectoryReader>();
+            if (!reader->open(path.c_str())) throw std::runtime_error("cannot open recording " + path);
+            return reader;
+        }), py::arg("path"))
+        .def("__len__", &TrajectoryReader::getRecordCount)
+        .def_property_readonly("record_words", &TrajectoryReader::getRecordWords)
+        .def_property_readonly("chunk_records", &TrajectoryReader::getChunkRecords)
+        .def_property_readonly("is_finished", &TrajectoryReader::isFinished)
+        .def("read", [](TrajectoryReader& reader, uint64_t step) {
+            py::array_t<float> out(static_cast<py::ssize_t>(reader.getRecordWords()));
+            if (!reader.read(step, out.mutable_data())) throw py::index_error("step out of range");
+            return out;
+        }, py::arg("step"))
+        // -> (n, record_words), n = records actually in [first, first + count)
+        .def("read_range", [](TrajectoryReader& reader, uint64_t first, size_t count) {
+            const uint64_t available = reader.getRecordCount() > first ? reader.getRecordCount() - first : 0;
+            count = static_cast<size_t>(std::min<uint64_t>(count, available));
+            py::array_t<float> out({static_cast<py::ssize_t>(count),
+                                    static_cast<py::ssize_t>(reader.getRecordWords())});
+            float* records = out.mutable_data();
+            size_t copied;
+            {
+                py::gil_scoped_release release;
+                copied = reader.readRange(first, count, records);
+            }
+            if (copied != count) throw std::runtime_error("recording is corrupt");
+            return out;
+        }, py::arg("first"), py::arg("count"));
+
+    // ---- Audio ----
+
+    py::class_<AudioFFTAnalyzer>(m, "AudioFFTAnalyzer")
+        .def(py::init<>())
+        .def("set_bass_range", &AudioFFTAnalyzer::setBassRange, py::arg("end_percent"))
+        .def("set_mid_range", &AudioFFTAnalyzer::setMidRange, py::arg("end_percent"))
+        // One spectrum -> (bass, mid, treble, volume); uint8 (0-255) or float input
+        .def("analyze", [](AudioFFTAnalyzer& analyzer, const py::array_t<uint8_t, py::array::c_style>& data) {
+            return analysisTuple(analyzer.analyzeFrequencies(data.data(), static_cast<size_t>(data.size())));
+        }, py::arg("data"))
+        .def("analyze", [](AudioFFTAnalyzer& analyzer, const InputArray<float>& data, bool normalized) {
+            return analysisTuple(analyzer.analyzeFrequenciesFloat(data.data(), static_cast<size_t>(data.size()),
+                                                                  normalized));
+        }, py::arg("data"), py::arg("normalized") = true)
+        // (rows, bins) spectra -> (rows, 4) float32 [bass, mid, treble, volume]
+        .def("analyze_batch", [](AudioFFTAnalyzer& analyzer, const py::array_t<uint8_t, py::array::c_style>& spectra) {
+            return analyzeRows(spectra, [&](const uint8_t* row, size_t bins) {
+                return analyzer.analyzeFrequencies(row, bins);
+            });
+        }, py::arg("spectra"))
+        .def("analyze_batch", [](AudioFFTAnalyzer& analyzer, const InputArray<float>& spectra, bool normalized) {
+            return analyzeRows(spectra, [&](const float* row, size_t bins) {
+                return analyzer.analyzeFrequenciesFloat(row, bins, normalized);
+            });
+        }, py::arg("spectra"), py::arg("normalized") = true);
+
+    py::enum_<BandScale>(m, "BandScale")
+        .value("LOG", BandScale::LOG)
+        .value("MEL", BandScale::MEL);
+
+    // N-band bank; bands/peaks/edges/centers are copies (configure() reallocates the layout)
+    py::class_<BandBank>(m, "BandBank")
+        .def(py::init([](size_t bandCount, size_t binCount, float sampleRate, float minHz, float maxHz,
+                         BandScale scale) {
+            auto bank = std::make_unique<BandBank>();
+            if (!bank->configure(bandCount, binCount, sampleRate, minHz, maxHz, scale)) {
+                throw std::invalid_argument("bands do not fit the bin range");
+            }
+            return bank;
+        }), py::arg("band_count") = 24, py::arg("bin_count") = 1024, py::arg("sample_rate") = 44100.0f,
+            py::arg("min_hz") = 40.0f, py::arg("max_hz") = 16000.0f, py::arg("scale") = BandScale::LOG)
+        .def("configure", &BandBank::configure, py::arg("band_count"), py::arg("bin_count"),
+             py::arg("sample_rate"), py::arg("min_hz"), py::arg("max_hz"), py::arg("scale") = BandScale::LOG)
+        .def("set_smoothing", &BandBank::setSmoothing, py::arg("time_constant"))
+        .def("set_peak_decay", &BandBank::setPeakDecay, py::arg("decay"))
+        .def("set_onset_threshold", &BandBank::setOnsetThreshold, py::arg("ratio"), py::arg("min_flux"))
+        .def("set_noise_bands", &BandBank::setNoiseBands, py::arg("begin"), py::arg("end"))
+        .def("set_noise_thresholds", &BandBank::setNoiseThresholds, py::arg("high"), py::arg("low"))
+        .def("reset", &BandBank::reset)
+        // One spectrum -> NoiseState; uint8 (0-255) or float input
+        .def("process", [](BandBank& bank, const py::array_t<uint8_t, py::array::c_style>& data) {
+            bank.process(data.data(), static_cast<size_t>(data.size()));
+            return bank.getNoiseState();
+        }, py::arg("data"))
+        .def("process", [](BandBank& bank, const InputArray<float>& data, bool normalized) {
+            bank.processFloat(data.data(), static_cast<size_t>(data.size()), normalized);
+            return bank.getNoiseState();
+        }, py::arg("data"), py::arg("normalized") = true)
+        .def_property_readonly("band_count", &BandBank::getBandCount)
+        .def_property_readonly("bands", [](const BandBank& bank) {
+            return copyOf(bank.getBands(), {static_cast<py::ssize_t>(bank.getBandCount())});
+        })
+        .def_property_readonly("peaks", [](const BandBank& bank) {
+            return copyOf(bank.getPeaks(), {static_cast<py::ssize_t>(bank.getBandCount())});
+        })
+        .def_property_readonly("edges", [](const BandBank& bank) {
+            return copyOf(bank.getBandEdges(), {static_cast<py::ssize_t>(bank.getBandCount() + 1)});
+        })
+        .def_property_readonly("centers", [](const BandBank& bank) {
+            return copyOf(bank.getBandCenters(), {static_cast<py::ssize_t>(bank.getBandCount())});
+        })
+        .def_property_readonly("noise_level", &BandBank::getNoiseLevel)
+        .def_property_readonly("flux", &BandBank::getFlux)
+        .def_property_readonly("onset", &BandBank::isOnset)
+        .def_property_readonly("noise_state", &BandBank::getNoiseState);
+
+    // ---- Audio -> RL pipeline ----
+
+    // Holds the system by reference (kept alive by the pipeline)
+    py::class_<NoisePipeline>(m, "NoisePipeline")
+        .def(py::init<MultiAgentSystem&>(), py::arg("system"), py::keep_alive<1, 2>())
+        .def_property_readonly("band_bank", py::overload_cast<>(&NoisePipeline::getBandBank),
+                               py::return_value_policy::reference_internal)
+        // One spectrum -> NoiseState, with every agent stepped on it
+        .def("tick", [](NoisePipeline& pipeline, const py::array_t<uint8_t, py::array::c_style>& spectrum,
+                        bool isTraining) {
+            return pipeline.tick(spectrum.data(), static_cast<size_t>(spectrum.size()), isTraining);
+        }, py::arg("spectrum"), py::arg("is_training") = false)
+        // (ticks, bins) spectra -> (states uint8 (ticks,), mean rewards float32 (ticks,))
+        .def("run_spectra", [](NoisePipeline& pipeline, const py::array_t<uint8_t, py::array::c_style>& spectra,
+                               bool isTraining) {
+            if (spectra.ndim() != 2) throw std::invalid_argument("spectra must be 2-D (ticks, bins)");
+            const size_t ticks = static_cast<size_t>(spectra.shape(0));
+            const size_t bins = static_cast<size_t>(spectra.shape(1));
+            py::array_t<uint8_t> states(static_cast<py::ssize_t>(ticks));
+            py::array_t<float> rewards(static_cast<py::ssize_t>(ticks));
+            const uint8_t* in = spectra.data();
+            uint8_t* statesOut = states.mutable_data();
+            float* rewardsOut = rewards.mutable_data();
+            {
+                py::gil_scoped_release release;
+                pipeline.runSpectra(in, ticks, bins, isTraining, statesOut, rewardsOut);
+            }
+            return py::make_tuple(states, rewards);
+        }, py::arg("spectra"), py::arg("is_training") = true)
+        // (ticks,) noise states (0 / 1) -> mean rewards float32 (ticks,)
+        .def("run_states", [](NoisePipeline& pipeline, const InputArray<uint8_t>& states, bool isTraining) {
+            const size_t ticks = static_cast<size_t>(states.size());
+            py::array_t<float> rewards(static_cast<py::ssize_t>(ticks));
+            const uint8_t* in = states.data();
+            float* rewardsOut = rewards.mutable_data();
+            {
+                py::gil_scoped_release release;
+                pipeline.runStates(in, ticks, isTraining, rewardsOut);
+            }
+            return rewards;
+        }, py::arg("states"), py::arg("is_training") = true)
+        .def_property_readonly("last_state", &NoisePipeline::getLastState)
+        .def_property_readonly("tick_count", &NoisePipeline::getTickCount)
+        .def_property_readonly("high_noise_ticks", &NoisePipeline::getHighNoiseTicks)
+        .def("reset_counters", &NoisePipeline::resetCounters);
+
+    // ---- Vectorized env ----
+
+    m.attr("OBS_STRIDE") = ObservationLayout::STRIDE;
+
+    py::class_<VecEnvConfig>(m, "VecEnvConfig")
+        .def(py::init<>())
+        .def_readwrite("env_count", &VecEnvConfig::envCount)
+        .def_readwrite("delta_time", &VecEnvConfig::deltaTime)
+        .def_readwrite("max_steps", &VecEnvConfig::maxSteps)
+        .def_readwrite("spawn_radius", &VecEnvConfig::spawnRadius)
+        .def_readwrite("arena_radius", &VecEnvConfig::arenaRadius)
+        .def_readwrite("target_radius", &VecEnvConfig::targetRadius)
+        .def_readwrite("reach_bonus", &VecEnvConfig::reachBonus)
+        .def_readwrite("seed", &VecEnvConfig::seed)
+        .def_readwrite("integrator", &VecEnvConfig::integrator)
+        .def_readwrite("ship", &VecEnvConfig::ship)
+        .def_readwrite("agent", &VecEnvConfig::agent);
+
+    py::class_<VecEnv>(m, "VecEnv")
+        .def(py::init<const VecEnvConfig&>(), py::arg("config") = VecEnvConfig())
+        .def_property_readonly("env_count", &VecEnv::getEnvCount)
+        .def("reset", [](VecEnv& env, const InputArray<uint32_t>& ids) {
+            const uint32_t* data = ids.data();
+            const size_t count = static_cast<size_t>(ids.size());
+            py::gil_scoped_release release;
+            env.reset(data, count);
+        }, py::arg("ids"))
+        .def("reset_all", &VecEnv::resetAll, py::call_guard<py::gil_scoped_release>())
+        .def("set_noise_state", &VecEnv::setNoiseState, py::arg("env"), py::arg("noise_state"))
+        .def("set_noise_state_all", &VecEnv::setNoiseStateAll, py::arg("noise_state"))
+        // actions: (env_count,) ThrustAction values -> (obs, reward, done) views
+        .def("step", [](py::object self, const InputArray<int32_t>& actions) {
+            VecEnv& env = self.cast<VecEnv&>();
+            requireLength(actions, env.getEnvCount(), "actions");
+            const int32_t* data = actions.data();
+            {
+                py::gil_scoped_release release;
+                env.step(data);
+            }
+            return py::make_tuple(self.attr("observations"), self.attr("rewards"), self.attr("dones"));
+        }, py::arg("actions"))
+        .def_property_readonly("observations", [](py::object self) {
+            const VecEnv& env = self.cast<const VecEnv&>();
+            return readOnlyView(env.getObservations(),
+                                {static_cast<py::ssize_t>(env.getEnvCount()),
+                                 static_cast<py::ssize_t>(ObservationLayout::STRIDE)}, self);
+        })
+        .def_property_readonly("rewards", [](py::object self) {
+            const VecEnv& env = self.cast<const VecEnv&>();
+            return readOnlyView(env.getRewards(), {static_cast<py::ssize_t>(env.getEnvCount())}, self);
+        })
+        .def_property_readonly("dones", [](py::object self) {
+            const VecEnv& env = self.cast<const VecEnv&>();
+            return readOnlyView(env.getDones(), {static_cast<py::ssize_t>(env.getEnvCount())}, self);
+        });
+}
@@ -0,0 +1,91 @@
+"""Smoke test for the aeronav_native extension (run by ctest, needs numpy).
+
+Exercises each binding once and checks that arrays read back from
+growable native storage stay valid after that storage reallocates.
+"""
+
+import sys
+
+import numpy as np
+
+import aeronav_native as an
+
+
+def check(condition, message):
+    if not condition:
+        raise AssertionError(message)
+
+
+def test_physics_world():
+    world = an.PhysicsWorld()
+    world.create_body()
+    world.step_all(1.0 / 60.0)
+    state = world.state
+    check(state.shape == (1, an.STATE_STRIDE), "world state shape")
+    before = state.copy()
+    # Grow well past the initial capacity: the old array must be unaffected
+    for _ in range(4096):
+        world.create_body()
+    check(np.array_equal(state, before), "world state changed after create_body")
+    check(world.state.shape == (4097, an.STATE_STRIDE), "world state shape after growth")
+    blob = world.save_snapshot()
+    check(world.restore_snapshot(blob), "world snapshot round trip")
+
+
+def test_multi_agent():
+    system = an.MultiAgentSystem(7)
+    system.create_agent()
+    system.step_all(an.NoiseState.HIGH_NOISE, True)
+    energy = system.energy
+    before = energy.copy()
+    for _ in range(4096):
+        system.create_agent()
+    check(np.array_equal(energy, before), "agent energy changed after create_agent")
+    check(system.energy.shape == (4097,), "agent energy shape after growth")
+    records = system.agent_records
+    check(records.shape[0] == 4097, "agent record rows")
+    ids = records.view(np.uint32)[:, an.AGENT_RECORD_ID]
+    check(len(np.unique(ids)) == 4097, "agent record ids not distinct")
+    blob = system.save_snapshot()
+    check(system.restore_snapshot(blob), "agent snapshot round trip")
+    check(not system.restore_snapshot(b"\x00" * 16), "truncated agent snapshot accepted")
+
+
+def test_band_bank_and_pipeline():
+    bank = an.BandBank(8, 1024)
+    bank.process(np.full(1024, 200, dtype=np.uint8))
+    bands = bank.bands
+    before = bands.copy()
+    check(bank.configure(64, 2048, 48000.0, 30.0, 20000.0, an.BandScale.MEL), "reconfigure")
+    check(np.array_equal(bands, before), "bands changed after configure")
+    check(bank.bands.shape == (64,) and bank.edges.shape == (65,), "band shapes after configure")
+
+    system = an.MultiAgentSystem(3)
+    for _ in range(4):
+        system.create_agent()
+    pipeline = an.NoisePipeline(system)
+    spectra = np.zeros((10, 1024), dtype=np.uint8)
+    spectra[::2] = 255
+    states, rewards = pipeline.run_spectra(spectra)
+    check(states.shape == (10,) and rewards.shape == (10,), "pipeline batch shapes")
+    check(pipeline.tick_count == 10, "pipeline tick count")
+
+
+def test_vec_env():
+    config = an.VecEnvConfig()
+    config.env_count = 8
+    env = an.VecEnv(config)
+    obs, reward, done = env.step(np.full(8, int(an.ThrustAction.BOOST), dtype=np.int32))
+    check(obs.shape == (8, an.OBS_STRIDE), "vec env observation shape")
+    check(np.all(np.isfinite(obs)), "vec env observations finite")
+
+
+def main():
+    for test in (test_physics_world, test_multi_agent, test_band_bank_and_pipeline, test_vec_env):
+        test()
+        print(f"ok {test.__name__}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,9 +1,96 @@
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 #include "../src/multi_agent.hpp"
+#include "profile_bindings.hpp"
+#include <vector>
 
 using namespace emscripten;
 using namespace aeronav;
 
+// 64-bit seeds are passed from JS as two 32-bit halves
+void setSystemSeed(MultiAgentSystem& system, unsigned int seedLow, unsigned int seedHigh) {
+    system.setSeed((static_cast<uint64_t>(seedHigh) << 32) | seedLow);
+}
+
+// Arena-backed system for up to maxAgents agents (see MultiAgentSystem(seed, maxAgents))
+MultiAgentSystem* createMultiAgentSystem(unsigned int seedLow, unsigned int seedHigh, unsigned int maxAgents) {
+    return new MultiAgentSystem((static_cast<uint64_t>(seedHigh) << 32) | seedLow, maxAgents);
+}
+
+// Sequences are 64-bit; doubles keep them exact on the JS side up to 2^53
+double getCoordinationSequence(const MultiAgentSystem& system) {
+    return static_cast<double>(system.getCoordinationSequence());
+}
+
+double getFirstCoordinationSequence(const MultiAgentSystem& system) {
+    return static_cast<double>(system.getFirstCoordinationSequence());
+}
+
+// Zero-copy Uint32Array over the event ring (COORDINATION_EVENT_STRIDE words per
+// record, sequence s at record s % capacity). Re-acquire after memory growth.
+val getCoordinationEventView(const MultiAgentSystem& system) {
+    const size_t words = system.getCoordinationEventCapacity() * CoordinationEventRecord::STRIDE;
+    return val(typed_memory_view(words, system.getCoordinationEventRecords()->words));
+}
+
+// Step records (AGENT_RECORD_STRIDE floats per agent, dense order) in a module-owned
+// buffer; the view is overwritten by the next call (e.g. copy it into a recorder view).
+// ID and TOTAL_STEPS are uint32 words: read them through a Uint32Array on the same buffer
+val getAgentRecordView(const MultiAgentSystem& system) {
+    static ArenaVector<float> records;
+    records.resize(system.getAgentCount() * AgentRecordLayout::STRIDE);
+    system.writeAgentRecords(records.data());
+    return val(typed_memory_view(records.size(), records.data()));
+}
+
+// Positions from a Float32Array of xyz triples `stride` floats apart (e.g. the
+// physics getStateView() records with STATE_STRIDE), one per agent in dense order
+// The floats are staged in a module-owned buffer (one TypedArray.set(), no per-call allocation)
+void setAgentPositions(MultiAgentSystem& system, const val& positions, unsigned int stride) {
+    AERONAV_PROFILE_BOUNDARY();
+    static ArenaVector<float> staging;
+    const unsigned int length = positions["length"].as<unsigned int>();
+    if (staging.size() < length) staging.resize(length);
+    val(typed_memory_view(length, staging.data())).call<void>("set", positions);
+    if (stride < 3) stride = 3;
+    const size_t count = length < 3 ? 0 : (length - 3) / stride + 1;
+    system.setAgentPositions(staging.data(), stride, count);
+}
+
+// Snapshot into a module-owned buffer; returns a Uint8Array view over it that is
+// overwritten by the next saveSnapshot() (copy with slice() to keep it)
+val saveSnapshot(const MultiAgentSystem& system) {
+    static std::vector<uint8_t> buffer;
+    buffer.resize(system.getSnapshotSize());
+    system.saveSnapshot(buffer.data(), buffer.size());
+    return val(typed_memory_view(buffer.size(), buffer.data()));
+}
+
+// The blob is staged like setAgentPositions(): one TypedArray.set() into a
+// module-owned buffer, which only allocates while growing to the largest blob
+bool restoreSnapshot(MultiAgentSystem& system, const val& bytes) {
+    AERONAV_PROFILE_BOUNDARY();
+    static ArenaVector<uint8_t> staging;
+    const unsigned int length = bytes["length"].as<unsigned int>();
+    staging.resize(length);
+    val(typed_memory_view(length, staging.data())).call<void>("set", bytes);
+    return system.restoreSnapshot(staging.data(), length);
+}
+
+// Container heap traffic of this module (arena.hpp); doubles keep the counts exact
+struct AllocationStatsJS {
+    double heapAllocations;
+    double heapFrees;
+    double heapBytesInUse;
+    double arenaAllocations;
+};
+
+AllocationStatsJS getAllocationStatsJS() {
+    const AllocationStats stats = getAllocationStats();
+    return { static_cast<double>(stats.heapAllocations), static_cast<double>(stats.heapFrees),
+             static_cast<double>(stats.heapBytesInUse), static_cast<double>(stats.arenaAllocations) };
+}
+
 EMSCRIPTEN_BINDINGS(aeronav_rl) {
     enum_<AgentPolicy>("AgentPolicy")
         .value("BALANCED", AgentPolicy::BALANCED)
@@ -67,20 +154,65 @@ EMSCRIPTEN_BINDINGS(aeronav_rl) {
         .field("agent2Id", &CoordinationEvent::agent2Id)
         .field("type", &CoordinationEvent::type);
 
+    // Per-frame methods go through ProfiledCall (one boundary scope per call in profiled builds)
     class_<MultiAgentSystem>("MultiAgentSystem")
         .constructor<>()
+        .constructor(&createMultiAgentSystem)
+        .function("getAgentCapacity", &MultiAgentSystem::getAgentCapacity)
+        .function("setSeed", &setSystemSeed)
         .function("createAgent", &MultiAgentSystem::createAgent)
         .function("removeAgent", &MultiAgentSystem::removeAgent)
         .function("getAgentCount", &MultiAgentSystem::getAgentCount)
-        .function("selectAction", &MultiAgentSystem::selectAction)
-        .function("calculateReward", &MultiAgentSystem::calculateReward)
-        .function("updateQTable", &MultiAgentSystem::updateQTable)
-        .function("stepAll", &MultiAgentSystem::stepAll)
-        .function("detectCoordination", &MultiAgentSystem::detectCoordination)
+        .function("getAgentAt", &ProfiledCall<&MultiAgentSystem::getAgentAt>::call)
+        .function("selectAction", &ProfiledCall<&MultiAgentSystem::selectAction>::call)
+        .function("calculateReward", &ProfiledCall<&MultiAgentSystem::calculateReward>::call)
+        .function("updateQTable", &ProfiledCall<&MultiAgentSystem::updateQTable>::call)
+        .function("stepAll", &ProfiledCall<&MultiAgentSystem::stepAll>::call)
+        .function("setThreadCount", &MultiAgentSystem::setThreadCount)
+        .function("getThreadCount", &MultiAgentSystem::getThreadCount)
+        .function("detectCoordination", &ProfiledCall<&MultiAgentSystem::detectCoordination>::call)
         .function("calculateCoordinationScore", &MultiAgentSystem::calculateCoordinationScore)
+        .function("detectCoordinationInRadius", &ProfiledCall<&MultiAgentSystem::detectCoordinationInRadius>::call)
+        .function("setAgentPosition", &ProfiledCall<&MultiAgentSystem::setAgentPosition>::call)
+        .function("setAgentPositions", &setAgentPositions)
         .function("getCoordinationEventCount", &MultiAgentSystem::getCoordinationEventCount)
         .function("getCoordinationEvent", &MultiAgentSystem::getCoordinationEvent)
         .function("clearCoordinationEvents", &MultiAgentSystem::clearCoordinationEvents)
-        .function("regenEnergy", &MultiAgentSystem::regenEnergy)
-        .function("consumeEnergy", &MultiAgentSystem::consumeEnergy);
+        .function("setCoordinationEventCapacity", &MultiAgentSystem::setCoordinationEventCapacity)
+        .function("getCoordinationEventCapacity", &MultiAgentSystem::getCoordinationEventCapacity)
+        .function("getCoordinationSequence", &getCoordinationSequence)
+        .function("getFirstCoordinationSequence", &getFirstCoordinationSequence)
+        .function("getCoordinationEventView", &getCoordinationEventView)
+        .function("getAgentRecordView", &getAgentRecordView)
+        .function("regenEnergy", &ProfiledCall<&MultiAgentSystem::regenEnergy>::call)
+        .function("consumeEnergy", &ProfiledCall<&MultiAgentSystem::consumeEnergy>::call)
+        .function("resetEnergy", &MultiAgentSystem::resetEnergy)
+        .function("saveSnapshot", &saveSnapshot)
+        .function("restoreSnapshot", &restoreSnapshot);
+
+    value_object<AllocationStatsJS>("AllocationStats")
+        .field("heapAllocations", &AllocationStatsJS::heapAllocations)
+        .field("heapFrees", &AllocationStatsJS::heapFrees)
+        .field("heapBytesInUse", &AllocationStatsJS::heapBytesInUse)
+        .field("arenaAllocations", &AllocationStatsJS::arenaAllocations);
+    function("getAllocationStats", &getAllocationStatsJS);
+
+    // Stage timers and counters (profiler.hpp; all zero unless built with profiling)
+    bindProfiler();
+
+    constant("COORDINATION_EVENT_TIMESTAMP", static_cast<int>(CoordinationEventRecord::TIMESTAMP));
+    constant("COORDINATION_EVENT_AGENT1_ID", static_cast<int>(CoordinationEventRecord::AGENT1_ID));
+    constant("COORDINATION_EVENT_AGENT2_ID", static_cast<int>(CoordinationEventRecord::AGENT2_ID));
+    constant("COORDINATION_EVENT_TYPE", static_cast<int>(CoordinationEventRecord::TYPE));
+    constant("COORDINATION_EVENT_STRIDE", static_cast<int>(CoordinationEventRecord::STRIDE));
+
+    constant("AGENT_RECORD_ID", static_cast<int>(AgentRecordLayout::ID));
+    constant("AGENT_RECORD_ACTION", static_cast<int>(AgentRecordLayout::ACTION));
+    constant("AGENT_RECORD_REWARD", static_cast<int>(AgentRecordLayout::REWARD));
+    constant("AGENT_RECORD_ENERGY", static_cast<int>(AgentRecordLayout::ENERGY));
+    constant("AGENT_RECORD_CONFIDENCE", static_cast<int>(AgentRecordLayout::CONFIDENCE));
+    constant("AGENT_RECORD_Q_LOW_NOISE", static_cast<int>(AgentRecordLayout::Q_LOW_NOISE));
+    constant("AGENT_RECORD_Q_HIGH_NOISE", static_cast<int>(AgentRecordLayout::Q_HIGH_NOISE));
+    constant("AGENT_RECORD_TOTAL_STEPS", static_cast<int>(AgentRecordLayout::TOTAL_STEPS));
+    constant("AGENT_RECORD_STRIDE", static_cast<int>(AgentRecordLayout::STRIDE));
 }
@@ -0,0 +1,208 @@
+#include "agent_step.hpp"
+
+namespace aeronav {
+
+namespace {
+
+// Thin lane wrappers so the kernel below is written once for every ISA.
+// Masks are full-width compare results (bool for the scalar tail).
+struct ScalarLanes {
+    using V = float;
+    using M = bool;
+    static constexpr size_t WIDTH = 1;
+    static V load(const float* p) { return *p; }
+    static void store(float* p, V v) { *p = v; }
+    static V splat(float s) { return s; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static M lt(V a, V b) { return a < b; }
+    static M gt(V a, V b) { return a > b; }
+    static M ge(V a, V b) { return a >= b; }
+    static M eq(V a, V b) { return a == b; }
+    static M maskAnd(M a, M b) { return a && b; }
+    static V select(M mask, V a, V b) { return mask ? a : b; }
+};
+
+#if USE_WASM_SIMD
+struct Lanes {
+    using V = v128_t;
+    using M = v128_t;
+    static constexpr size_t WIDTH = 4;
+    static V load(const float* p) { return wasm_v128_load(p); }
+    static void store(float* p, V v) { wasm_v128_store(p, v); }
+    static V splat(float s) { return wasm_f32x4_splat(s); }
+    static V add(V a, V b) { return wasm_f32x4_add(a, b); }
+    static V sub(V a, V b) { return wasm_f32x4_sub(a, b); }
+    static V mul(V a, V b) { return wasm_f32x4_mul(a, b); }
+    static M lt(V a, V b) { return wasm_f32x4_lt(a, b); }
+    static M gt(V a, V b) { return wasm_f32x4_gt(a, b); }
+    static M ge(V a, V b) { return wasm_f32x4_ge(a, b); }
+    static M eq(V a, V b) { return wasm_f32x4_eq(a, b); }
+    static M maskAnd(M a, M b) { return wasm_v128_and(a, b); }
+    static V select(M mask, V a, V b) { return wasm_v128_bitselect(a, b, mask); }
+};
+#elif USE_SSE
+struct Lanes {
+    using V = __m128;
+    using M = __m128;
+    static constexpr size_t WIDTH = 4;
+    static V load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+    static V splat(float s) { return _mm_set1_ps(s); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static M lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static M gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static M ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static M eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+    static M maskAnd(M a, M b) { return _mm_and_ps(a, b); }
+    static V select(M mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+};
+#endif
+
+// std::min / std::max semantics (argument order matters for bit-identity)
+template <typename L>
+typename L::V stdMin(typename L::V a, typename L::V b) { return L::select(L::lt(b, a), b, a); }
+
+template <typename L>
+typename L::V stdMax(typename L::V a, typename L::V b) { return L::select(L::lt(a, b), b, a); }
+
+// Q-update of one slot, kept only where `taken` is set
+template <typename L>
+typename L::V updateQ(typename L::M taken, typename L::V q, typename L::V lr, typename L::V reward) {
+    using V = typename L::V;
+    const V newQ = L::add(q, L::mul(lr, L::sub(reward, q)));
+    return L::select(taken, stdMax<L>(L::splat(0.0f), stdMin<L>(L::splat(1.0f), newQ)), q);
+}
+
+// Policy reward adjustments read per agent (ranges that mix policies)
+struct PerAgentPolicy {
+    template <typename L>
+    static typename L::V adjust(const AgentArrays& a, size_t i, typename L::V reward,
+                                typename L::M isBoost, typename L::M highEnergy, typename L::M lowEnergy) {
+        const typename L::V zero = L::splat(0.0f);
+        reward = L::add(reward, L::select(isBoost, L::load(a.boostRewardAdj + i), zero));
+        reward = L::add(reward, L::select(highEnergy, L::load(a.highEnergyAdj + i), zero));
+        reward = L::add(reward, L::select(lowEnergy, L::load(a.lowEnergyAdj + i), zero));
+        return reward;
+    }
+};
+
+// One policy's adjustments as constants (Traits = AgentPolicyTraits<P>). Rewards
+// here are never -0, so skipping a +0 adjustment keeps results bit-identical.
+template <typename Traits>
+struct UniformPolicy {
+    template <typename L>
+    static typename L::V adjust(const AgentArrays&, size_t, typename L::V reward,
+                                typename L::M isBoost, typename L::M highEnergy, typename L::M lowEnergy) {
+        const typename L::V zero = L::splat(0.0f);
+        if constexpr (Traits::BOOST_REWARD_ADJ != 0.0f) {
+            reward = L::add(reward, L::select(isBoost, L::splat(Traits::BOOST_REWARD_ADJ), zero));
+        }
+        if constexpr (Traits::HIGH_ENERGY_ADJ != 0.0f) {
+            reward = L::add(reward, L::select(highEnergy, L::splat(Traits::HIGH_ENERGY_ADJ), zero));
+        }
+        if constexpr (Traits::LOW_ENERGY_ADJ != 0.0f) {
+            reward = L::add(reward, L::select(lowEnergy, L::splat(Traits::LOW_ENERGY_ADJ), zero));
+        }
+        return reward;
+    }
+};
+
+// One lane group of agents starting at i (same operation order as the member functions)
+template <typename L, typename Policy>
+void stepLanes(const AgentArrays& a, const AgentStepParams& p, size_t i) {
+    using V = typename L::V;
+    using M = typename L::M;
+
+    const V zero = L::splat(0.0f);
+    const V glide = L::splat(1.0f);
+    const V boost = L::splat(2.0f);
+    const V stabilize = L::splat(3.0f);
+
+    float* const* q = a.q[p.noiseState];
+    V qGlide = L::load(q[0] + i);
+    V qBoost = L::load(q[1] + i);
+    V qStabilize = L::load(q[2] + i);
+
+    // Epsilon-greedy selection
+    const V epsilon = L::load((p.isTraining ? a.epsilonTraining : a.epsilonNormal) + i);
+    const M explore = L::lt(L::load(a.exploreDraw + i), epsilon);
+    const M greedyGlide = L::maskAnd(L::ge(qGlide, qBoost), L::ge(qGlide, qStabilize));
+    const M greedyBoost = L::ge(qBoost, qStabilize);
+    const V greedy = L::select(greedyGlide, glide, L::select(greedyBoost, boost, stabilize));
+    const V action = L::select(explore, L::load(a.exploreAction + i), greedy);
+
+    const M isGlide = L::eq(action, glide);
+    const M isBoost = L::eq(action, boost);
+    const M isStabilize = L::eq(action, stabilize);
+
+    // Reward: base, policy adjustments, energy penalty/bonus, clamp
+    const V energy = L::load(a.energy + i);
+    const M lowEnergy = L::lt(energy, L::splat(20.0f));
+    V reward = L::select(isBoost, L::splat(p.baseReward[1]),
+                         L::select(isGlide, L::splat(p.baseReward[0]), L::splat(p.baseReward[2])));
+    reward = Policy::template adjust<L>(a, i, reward, isBoost, L::gt(energy, L::splat(70.0f)), lowEnergy);
+    reward = L::add(reward, L::select(lowEnergy, L::splat(-0.5f), zero));
+    reward = L::add(reward, L::select(L::gt(energy, L::splat(80.0f)), L::splat(0.1f), zero));
+    reward = stdMax<L>(L::splat(-1.0f), stdMin<L>(L::splat(1.0f), reward));
+
+    // Q-update of the taken action
+    const V lr = L::load(a.learningRate + i);
+    L::store(q[0] + i, updateQ<L>(isGlide, qGlide, lr, reward));
+    L::store(q[1] + i, updateQ<L>(isBoost, qBoost, lr, reward));
+    L::store(q[2] + i, updateQ<L>(isStabilize, qStabilize, lr, reward));
+
+    // Energy consumption (uses the pre-step energy for the reward above)
+    const V cost = L::select(isBoost, L::load(a.cost[1] + i),
+                             L::select(isGlide, L::load(a.cost[0] + i), L::load(a.cost[2] + i)));
+    L::store(a.energy + i, stdMax<L>(zero, L::sub(energy, cost)));
+
+    // Confidence from the (possibly just updated) low-noise Q-values
+    const V lowGlide = L::load(a.q[0][0] + i);
+    const V lowBoost = L::load(a.q[0][1] + i);
+    const V lowStabilize = L::load(a.q[0][2] + i);
+    L::store(a.confidence + i, stdMax<L>(lowGlide, stdMax<L>(lowBoost, lowStabilize)));
+
+    L::store(a.reward + i, reward);
+    L::store(a.action + i, action);
+}
+
+template <typename Policy>
+void stepRange(const AgentArrays& agents, const AgentStepParams& params, size_t begin, size_t end) {
+    if (end > agents.count) end = agents.count;
+    size_t i = begin;
+#if USE_WASM_SIMD || USE_SSE
+    for (; i + Lanes::WIDTH <= end; i += Lanes::WIDTH) {
+        stepLanes<Lanes, Policy>(agents, params, i);
+    }
+#endif
+    for (; i < end; i++) {
+        stepLanes<ScalarLanes, Policy>(agents, params, i);
+    }
+}
+
+} // namespace
+
+void stepAgents(const AgentArrays& agents, const AgentStepParams& params, size_t begin, size_t end) {
+    stepRange<PerAgentPolicy>(agents, params, begin, end);
+}
+
+void stepAgentsUniform(AgentPolicy policy, const AgentArrays& agents, const AgentStepParams& params,
+                       size_t begin, size_t end) {
+    withAgentPolicy(policy, [&](auto traits) {
+        stepRange<UniformPolicy<decltype(traits)>>(agents, params, begin, end);
+    });
+}
+
+size_t agentLaneWidth() {
+#if USE_WASM_SIMD || USE_SSE
+    return Lanes::WIDTH;
+#else
+    return 1;
+#endif
+}
+
+} // namespace aeronav
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "policy_traits.hpp"
+
+// SIMD detection
+#if defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define USE_WASM_SIMD 1
+#elif defined(__SSE__)
+    #include <xmmintrin.h>
+    #define USE_SSE 1
+#endif
+
+namespace aeronav {
+
+constexpr size_t NOISE_STATE_COUNT = 2;
+constexpr size_t Q_ACTION_COUNT = 3;   // GLIDE, BOOST, STABILIZE (ThrustAction - 1)
+
+// Raw structure-of-arrays view over N agents (consumed by the fused step kernel)
+struct AgentArrays {
+    // Q-values indexed [noiseState][action - 1]
+    float* q[NOISE_STATE_COUNT][Q_ACTION_COUNT];
+
+    // Per-step state
+    float* energy;
+    float* reward;
+    float* confidence;
+    float* action;   // ThrustAction as float, written by the kernel
+
+    // Per-agent parameters (expanded from AgentConfig and the policy table)
+    const float* epsilonNormal;
+    const float* epsilonTraining;
+    const float* learningRate;
+    const float* cost[Q_ACTION_COUNT];
+    const float* boostRewardAdj;    // added when boosting
+    const float* highEnergyAdj;     // added when energy > 70
+    const float* lowEnergyAdj;      // added when energy < 20
+
+    // Random draws for this step (one Philox block per agent, drawn up front)
+    const float* exploreDraw;       // uniform [0, 1), compared against epsilon
+    const float* exploreAction;     // action taken when exploring
+
+    size_t count;
+};
+
+// Per-step inputs shared by every agent
+struct AgentStepParams {
+    size_t noiseState;   // NoiseState as index
+    bool isTraining;
+    float baseReward[Q_ACTION_COUNT];
+};
+
+/**
+ * Fused epsilon-greedy selection, reward, Q-update and energy consumption
+ * Branch-free over 4 agents per lane group (WASM SIMD128 / SSE) with a
+ * scalar tail, over agents [begin, end). Float operations are issued in the
+ * same order as the MultiAgentSystem member functions, so results are
+ * bit-identical to stepAllReference() for the same random draws (build with
+ * FP contraction off); the tail matches the lanes exactly, so any
+ * partitioning of the agents gives the same results.
+ */
+void stepAgents(const AgentArrays& agents, const AgentStepParams& params, size_t begin, size_t end);
+
+// Same kernel with one policy's reward adjustments compiled in as constants
+// (zero adjustments drop out); every agent in [begin, end) must have that
+// policy. Results are bit-identical to stepAgents().
+void stepAgentsUniform(AgentPolicy policy, const AgentArrays& agents, const AgentStepParams& params,
+                       size_t begin, size_t end);
+
+// Number of agents processed per SIMD lane group (1 when no SIMD is available)
+size_t agentLaneWidth();
+
+} // namespace aeronav
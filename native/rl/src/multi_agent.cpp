@@ -1,117 +1,357 @@
 #include "multi_agent.hpp"
+#include "profiler.hpp"
 #include <algorithm>
+#include <cstring>
 #include <ctime>
+#include <type_traits>
 
 namespace aeronav {
 
-MultiAgentSystem::MultiAgentSystem() : nextAgentId_(0) {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+namespace {
+
+size_t policyIndex(AgentPolicy policy) {
+    const size_t index = static_cast<size_t>(policy);
+    return index < AGENT_POLICY_COUNT ? index : 0;
+}
+
+// Base reward per [noiseState][action - 1]
+constexpr float BASE_REWARD[NOISE_STATE_COUNT][Q_ACTION_COUNT] = {
+    {0.7f, 0.8f, 0.2f},   // LOW_NOISE: glide, boost, stabilize
+    {0.1f, 0.3f, 0.9f}    // HIGH_NOISE
+};
+
+size_t noiseIndex(NoiseState noiseState) {
+    return noiseState == NoiseState::LOW_NOISE ? 0 : 1;
+}
+
+// Swap-and-pop of one element
+template <typename T>
+void removeSwap(ArenaVector<T>& values, size_t idx) {
+    if (idx + 1 != values.size()) values[idx] = values.back();
+    values.pop_back();
+}
+
+// Coordination rules; the bins below count the partners each rule admits
+constexpr float COORDINATION_CONFIDENCE = 0.7f;
+
+bool classifyPair(ThrustAction action1, bool confident1, ThrustAction action2, bool confident2,
+                  CoordinationType& type) {
+    // Conflict: opposite actions
+    if ((action1 == ThrustAction::BOOST && action2 == ThrustAction::STABILIZE) ||
+        (action1 == ThrustAction::STABILIZE && action2 == ThrustAction::BOOST)) {
+        type = CoordinationType::CONFLICT;
+        return true;
+    }
+    // Cooperation: same high-confidence action
+    if (action1 == action2 && action1 != ThrustAction::IDLE && confident1 && confident2) {
+        type = CoordinationType::COOPERATION;
+        return true;
+    }
+    // Independence: different compatible actions
+    if (action1 != action2 && action1 != ThrustAction::IDLE && action2 != ThrustAction::IDLE) {
+        type = CoordinationType::INDEPENDENCE;
+        return true;
+    }
+    return false;
+}
+
+// Agent counts per (action, confidence > COORDINATION_CONFIDENCE)
+struct ActionHistogram {
+    uint32_t bins[4][2] = {};
+
+    void add(ThrustAction action, bool confident) {
+        bins[static_cast<size_t>(action) & 3][confident ? 1 : 0]++;
+    }
+    uint32_t total(ThrustAction action) const {
+        const size_t a = static_cast<size_t>(action) & 3;
+        return bins[a][0] + bins[a][1];
+    }
+    uint32_t confident(ThrustAction action) const {
+        return bins[static_cast<size_t>(action) & 3][1];
+    }
+};
+
+uint32_t conflictPartners(const ActionHistogram& bins, ThrustAction action) {
+    if (action == ThrustAction::BOOST) return bins.total(ThrustAction::STABILIZE);
+    if (action == ThrustAction::STABILIZE) return bins.total(ThrustAction::BOOST);
+    return 0;
 }
 
-float MultiAgentSystem::randomFloat() {
-    return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+uint32_t cooperationPartners(const ActionHistogram& bins, ThrustAction action, bool confident) {
+    return action != ThrustAction::IDLE && confident ? bins.confident(action) : 0;
+}
+
+uint32_t independencePartners(const ActionHistogram& bins, ThrustAction action) {
+    if (action == ThrustAction::GLIDE) {
+        return bins.total(ThrustAction::BOOST) + bins.total(ThrustAction::STABILIZE);
+    }
+    if (action == ThrustAction::BOOST || action == ThrustAction::STABILIZE) {
+        return bins.total(ThrustAction::GLIDE);
+    }
+    return 0;
+}
+
+float coordinationScoreFrom(uint32_t cooperation, uint32_t conflict) {
+    const uint32_t total = cooperation + conflict;
+    if (total == 0) return 0.5f;
+    return static_cast<float>(cooperation) / static_cast<float>(total);
+}
+
+} // namespace
+
+MultiAgentSystem::MultiAgentSystem()
+    : policyCounts_()
+    , events_(DEFAULT_COORDINATION_EVENT_CAPACITY)
+    , coordinationRows_(DEFAULT_COORDINATION_EVENT_CAPACITY)
+    , nextAgentId_(0), seed_(static_cast<uint64_t>(std::time(nullptr))), agentCapacity_(0) {}
+
+MultiAgentSystem::MultiAgentSystem(uint64_t seed)
+    : policyCounts_()
+    , events_(DEFAULT_COORDINATION_EVENT_CAPACITY)
+    , coordinationRows_(DEFAULT_COORDINATION_EVENT_CAPACITY)
+    , nextAgentId_(0), seed_(seed), agentCapacity_(0) {}
+
+MultiAgentSystem::MultiAgentSystem(uint64_t seed, size_t maxAgents)
+    : MultiAgentSystem(seed) {
+    reserveAgents(maxAgents);
+}
+
+void MultiAgentSystem::reserveAgents(size_t maxAgents) {
+    size_t bytes = 0;
+    forEachArray([&bytes, maxAgents](const auto& values) {
+        bytes += Arena::bytesFor<typename std::decay_t<decltype(values)>::value_type>(maxAgents);
+    });
+    bytes += Arena::bytesFor<uint32_t>(maxAgents) * 2;   // sparse_, neighborScratch_
+    bytes += Arena::bytesFor<CoordinationEventRecord>(events_.capacity());
+    bytes += Arena::bytesFor<size_t>(coordinationRows_.size());
+    bytes += SpatialHash::arenaBytesFor(maxAgents);
+    auto arena = std::make_shared<Arena>(bytes);
+
+    forEachArray([&arena, maxAgents](auto& values) { reserveInArena(values, arena, maxAgents); });
+    reserveInArena(sparse_, arena, maxAgents);
+    reserveInArena(neighborScratch_, arena, maxAgents);
+    events_.reserveIn(arena);
+    reserveInArena(coordinationRows_, arena, coordinationRows_.size());
+    coordinationGrid_.reserve(maxAgents, arena);
+    agentCapacity_ = maxAgents;
+}
+
+void MultiAgentSystem::setSeed(uint64_t seed) {
+    seed_ = seed;
+    for (size_t i = 0; i < ids_.size(); i++) {
+        rngs_[i].reseed(seed_, ids_[i]);
+    }
 }
 
-int MultiAgentSystem::randomInt(int max) {
-    return std::rand() % max;
+template <typename Self, typename Fn>
+void MultiAgentSystem::forEachArrayOf(Self& self, Fn& fn) {
+    fn(self.ids_); fn(self.configs_); fn(self.action_); fn(self.totalSteps_); fn(self.coordinationScore_);
+    fn(self.cooperationCount_); fn(self.conflictCount_);
+    fn(self.px_); fn(self.py_); fn(self.pz_); fn(self.rngs_);
+    for (auto& noise : self.q_) {
+        for (auto& values : noise) fn(values);
+    }
+    fn(self.energy_); fn(self.reward_); fn(self.confidence_);
+    fn(self.epsilonNormal_); fn(self.epsilonTraining_); fn(self.learningRate_);
+    for (auto& values : self.cost_) fn(values);
+    fn(self.boostRewardAdj_); fn(self.highEnergyAdj_); fn(self.lowEnergyAdj_);
+    fn(self.exploreDraw_); fn(self.exploreAction_); fn(self.stepAction_);
 }
 
 uint32_t MultiAgentSystem::createAgent(const AgentConfig& config) {
-    AgentMetrics agent;
-    agent.id = nextAgentId_++;
-    agent.policy = config.policy;
-    agent.action = ThrustAction::IDLE;
-    agent.confidence = 0.0f;
-    agent.reward = 0.0f;
-    agent.energy = config.energy.max;
-    agent.qTable = initializeQTable(config.policy);
-    agent.totalSteps = 0;
-    agent.coordinationScore = 0.5f;
-
-    agents_.push_back(agent);
+    const uint32_t id = nextAgentId_++;
+    const PolicyTraits& params = policyTraits(config.policy);
+    policyCounts_[policyIndex(config.policy)]++;
+
+    sparse_.push_back(static_cast<uint32_t>(ids_.size()));
+    ids_.push_back(id);
     configs_.push_back(config);
-    return agent.id;
+    action_.push_back(ThrustAction::IDLE);
+    totalSteps_.push_back(0);
+    coordinationScore_.push_back(0.5f);
+    cooperationCount_.push_back(0);
+    conflictCount_.push_back(0);
+    px_.push_back(0.0f);
+    py_.push_back(0.0f);
+    pz_.push_back(0.0f);
+    rngs_.emplace_back(seed_, id);
+
+    for (auto& noise : q_) {
+        for (auto& values : noise) values.push_back(0.0f);
+    }
+    setQTableAt(ids_.size() - 1, initializeQTable(config.policy));
+    energy_.push_back(config.energy.max);
+    reward_.push_back(0.0f);
+    confidence_.push_back(0.0f);
+
+    epsilonNormal_.push_back(config.epsilonNormal);
+    epsilonTraining_.push_back(config.epsilonTraining);
+    learningRate_.push_back(config.learningRate);
+    cost_[0].push_back(config.energy.costGlide);
+    cost_[1].push_back(config.energy.costBoost);
+    cost_[2].push_back(config.energy.costStabilize);
+    boostRewardAdj_.push_back(params.boostRewardAdj);
+    highEnergyAdj_.push_back(params.highEnergyAdj);
+    lowEnergyAdj_.push_back(params.lowEnergyAdj);
+
+    exploreDraw_.push_back(0.0f);
+    exploreAction_.push_back(0.0f);
+    stepAction_.push_back(0.0f);
+    return id;
 }
 
 void MultiAgentSystem::removeAgent(uint32_t id) {
-    for (size_t i = 0; i < agents_.size(); i++) {
-        if (agents_[i].id == id) {
-            agents_.erase(agents_.begin() + i);
-            configs_.erase(configs_.begin() + i);
-            return;
+    const uint32_t idx = indexOf(id);
+    if (idx == INVALID_INDEX) return;
+
+    policyCounts_[policyIndex(configs_[idx].policy)]--;
+
+    // Swap-and-pop: move the last agent into the freed slot
+    forEachArray([idx](auto& values) { removeSwap(values, idx); });
+    if (idx < ids_.size()) sparse_[ids_[idx]] = idx;
+    sparse_[id] = INVALID_INDEX;
+}
+
+AgentMetrics MultiAgentSystem::getAgentAt(size_t index) const {
+    AgentMetrics agent;
+    agent.id = ids_[index];
+    agent.policy = configs_[index].policy;
+    agent.action = action_[index];
+    agent.confidence = confidence_[index];
+    agent.reward = reward_[index];
+    agent.energy = energy_[index];
+    agent.qTable.lowNoise = QValues(q_[0][0][index], q_[0][1][index], q_[0][2][index]);
+    agent.qTable.highNoise = QValues(q_[1][0][index], q_[1][1][index], q_[1][2][index]);
+    agent.totalSteps = totalSteps_[index];
+    agent.coordinationScore = coordinationScore_[index];
+    return agent;
+}
+
+bool MultiAgentSystem::getAgent(uint32_t id, AgentMetrics& out) const {
+    const uint32_t idx = indexOf(id);
+    if (idx == INVALID_INDEX) return false;
+    out = getAgentAt(idx);
+    return true;
+}
+
+std::vector<AgentMetrics> MultiAgentSystem::getAgents() const {
+    std::vector<AgentMetrics> agents;
+    agents.reserve(ids_.size());
+    for (size_t i = 0; i < ids_.size(); i++) agents.push_back(getAgentAt(i));
+    return agents;
+}
+
+void MultiAgentSystem::writeAgentRecords(float* out) const {
+    for (size_t i = 0; i < ids_.size(); i++, out += AgentRecordLayout::STRIDE) {
+        std::memcpy(out + AgentRecordLayout::ID, &ids_[i], sizeof(uint32_t));
+        out[AgentRecordLayout::ACTION] = static_cast<float>(action_[i]);
+        out[AgentRecordLayout::REWARD] = reward_[i];
+        out[AgentRecordLayout::ENERGY] = energy_[i];
+        out[AgentRecordLayout::CONFIDENCE] = confidence_[i];
+        for (size_t a = 0; a < Q_ACTION_COUNT; a++) {
+            out[AgentRecordLayout::Q_LOW_NOISE + a] = q_[0][a][i];
+            out[AgentRecordLayout::Q_HIGH_NOISE + a] = q_[1][a][i];
         }
+        std::memcpy(out + AgentRecordLayout::TOTAL_STEPS, &totalSteps_[i], sizeof(uint32_t));
     }
 }
 
-AgentMetrics* MultiAgentSystem::getAgent(uint32_t id) {
-    for (auto& agent : agents_) {
-        if (agent.id == id) return &agent;
+AgentArrays MultiAgentSystem::getArrays() {
+    AgentArrays arrays;
+    for (size_t n = 0; n < NOISE_STATE_COUNT; n++) {
+        for (size_t a = 0; a < Q_ACTION_COUNT; a++) arrays.q[n][a] = q_[n][a].data();
     }
-    return nullptr;
+    arrays.energy = energy_.data();
+    arrays.reward = reward_.data();
+    arrays.confidence = confidence_.data();
+    arrays.action = stepAction_.data();
+    arrays.epsilonNormal = epsilonNormal_.data();
+    arrays.epsilonTraining = epsilonTraining_.data();
+    arrays.learningRate = learningRate_.data();
+    for (size_t a = 0; a < Q_ACTION_COUNT; a++) arrays.cost[a] = cost_[a].data();
+    arrays.boostRewardAdj = boostRewardAdj_.data();
+    arrays.highEnergyAdj = highEnergyAdj_.data();
+    arrays.lowEnergyAdj = lowEnergyAdj_.data();
+    arrays.exploreDraw = exploreDraw_.data();
+    arrays.exploreAction = exploreAction_.data();
+    arrays.count = ids_.size();
+    return arrays;
+}
+
+void MultiAgentSystem::setQTableAt(size_t idx, const QTable& table) {
+    q_[0][0][idx] = table.lowNoise.glide;
+    q_[0][1][idx] = table.lowNoise.boost;
+    q_[0][2][idx] = table.lowNoise.stabilize;
+    q_[1][0][idx] = table.highNoise.glide;
+    q_[1][1][idx] = table.highNoise.boost;
+    q_[1][2][idx] = table.highNoise.stabilize;
+}
+
+void MultiAgentSystem::drawExploration(size_t idx, const PolicyTraits& traits, float& draw,
+                                       ThrustAction& exploreAction) {
+    // Same block layout as selectActionAt(): word 0 explore test, words 1-3 choice
+    uint32_t words[4];
+    rngs_[idx].nextBlock(words);
+    draw = Philox4x32::toFloat(words[0]);
+    exploreAction = traits.exploreActions[RngStream::belowFromWords(words + 1, 3, traits.exploreCount)];
 }
 
 QTable MultiAgentSystem::initializeQTable(AgentPolicy policy) {
-    QTable qt;
-    switch (policy) {
-        case AgentPolicy::CONSERVATIVE:
-            qt.lowNoise = QValues(0.9f, 0.3f, 0.7f);
-            qt.highNoise = QValues(0.5f, 0.2f, 0.95f);
-            break;
-        case AgentPolicy::AGGRESSIVE:
-            qt.lowNoise = QValues(0.6f, 0.9f, 0.4f);
-            qt.highNoise = QValues(0.3f, 0.7f, 0.8f);
-            break;
-        case AgentPolicy::EXPLORATORY:
-            qt.lowNoise = QValues(0.7f, 0.6f, 0.5f);
-            qt.highNoise = QValues(0.4f, 0.5f, 0.7f);
-            break;
-        case AgentPolicy::EXPLOITATIVE:
-            qt.lowNoise = QValues(0.95f, 0.4f, 0.6f);
-            qt.highNoise = QValues(0.3f, 0.2f, 0.98f);
-            break;
-        default: // BALANCED
-            qt.lowNoise = QValues(0.8f, 0.6f, 0.2f);
-            qt.highNoise = QValues(0.1f, 0.3f, 0.9f);
-            break;
+    return getDefaultQTable(policy);
+}
+
+bool MultiAgentSystem::uniformPolicy(AgentPolicy& policy) const {
+    for (size_t p = 0; p < AGENT_POLICY_COUNT; p++) {
+        if (policyCounts_[p] != 0 && policyCounts_[p] == ids_.size()) {
+            policy = static_cast<AgentPolicy>(p);
+            return true;
+        }
     }
-    return qt;
+    return false;
+}
+
+void MultiAgentSystem::countPolicies() {
+    std::fill(std::begin(policyCounts_), std::end(policyCounts_), 0u);
+    for (const AgentConfig& config : configs_) policyCounts_[policyIndex(config.policy)]++;
 }
 
 ThrustAction MultiAgentSystem::selectAction(uint32_t agentId, NoiseState noiseState, bool isTraining) {
-    size_t idx = 0;
-    for (; idx < agents_.size(); idx++) {
-        if (agents_[idx].id == agentId) break;
-    }
-    if (idx >= agents_.size()) return ThrustAction::IDLE;
+    AERONAV_PROFILE_SCOPE(RL_SELECT);
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return ThrustAction::IDLE;
+    return selectActionAt(idx, noiseState, isTraining);
+}
 
-    AgentMetrics& agent = agents_[idx];
+ThrustAction MultiAgentSystem::selectActionAt(size_t idx, NoiseState noiseState, bool isTraining) {
     const AgentConfig& config = configs_[idx];
     float epsilon = isTraining ? config.epsilonTraining : config.epsilonNormal;
-    const QValues& qv = (noiseState == NoiseState::LOW_NOISE) ? agent.qTable.lowNoise : agent.qTable.highNoise;
-
-    // Epsilon-greedy exploration
-    if (randomFloat() < epsilon) {
-        if (config.policy == AgentPolicy::CONSERVATIVE) {
-            return (randomInt(2) == 0) ? ThrustAction::GLIDE : ThrustAction::STABILIZE;
-        } else if (config.policy == AgentPolicy::AGGRESSIVE) {
-            return (randomInt(2) == 0) ? ThrustAction::BOOST : ThrustAction::STABILIZE;
-        }
-        return static_cast<ThrustAction>(randomInt(3) + 1); // GLIDE, BOOST, or STABILIZE
+    const auto& q = q_[noiseIndex(noiseState)];
+    const float glide = q[0][idx], boost = q[1][idx], stabilize = q[2][idx];
+
+    // One block per decision: word 0 is the explore test, words 1-3 pick the action
+    uint32_t words[4];
+    rngs_[idx].nextBlock(words);
+
+    // Epsilon-greedy exploration over the policy's action set
+    if (Philox4x32::toFloat(words[0]) < epsilon) {
+        const PolicyTraits& traits = policyTraits(config.policy);
+        return traits.exploreActions[RngStream::belowFromWords(words + 1, 3, traits.exploreCount)];
     }
 
     // Exploitation: pick best Q-value
-    if (qv.glide >= qv.boost && qv.glide >= qv.stabilize) return ThrustAction::GLIDE;
-    if (qv.boost >= qv.stabilize) return ThrustAction::BOOST;
+    if (glide >= boost && glide >= stabilize) return ThrustAction::GLIDE;
+    if (boost >= stabilize) return ThrustAction::BOOST;
     return ThrustAction::STABILIZE;
 }
 
 float MultiAgentSystem::calculateReward(uint32_t agentId, NoiseState noiseState, ThrustAction action, float energyLevel) {
-    size_t idx = 0;
-    for (; idx < agents_.size(); idx++) {
-        if (agents_[idx].id == agentId) break;
-    }
-    if (idx >= agents_.size()) return 0.0f;
+    AERONAV_PROFILE_SCOPE(RL_REWARD);
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return 0.0f;
+    return calculateRewardAt(idx, noiseState, action, energyLevel);
+}
 
+float MultiAgentSystem::calculateRewardAt(size_t idx, NoiseState noiseState, ThrustAction action, float energyLevel) const {
     const AgentConfig& config = configs_[idx];
     float reward = 0.0f;
 
@@ -126,14 +366,11 @@ float MultiAgentSystem::calculateReward(uint32_t agentId, NoiseState noiseState,
         else reward = 0.2f;
     }
 
-    // Policy adjustments
-    if (config.policy == AgentPolicy::CONSERVATIVE) {
-        if (action == ThrustAction::BOOST) reward -= 0.2f;
-        if (energyLevel > 70.0f) reward += 0.1f;
-    } else if (config.policy == AgentPolicy::AGGRESSIVE) {
-        if (action == ThrustAction::BOOST) reward += 0.1f;
-        if (energyLevel < 20.0f) reward -= 0.2f;
-    }
+    // Policy adjustments (same order as the fused kernel)
+    const PolicyTraits& traits = policyTraits(config.policy);
+    if (action == ThrustAction::BOOST) reward += traits.boostRewardAdj;
+    if (energyLevel > 70.0f) reward += traits.highEnergyAdj;
+    if (energyLevel < 20.0f) reward += traits.lowEnergyAdj;
 
     // Energy penalty
     if (energyLevel < 20.0f) reward -= 0.5f;
@@ -143,121 +380,386 @@ float MultiAgentSystem::calculateReward(uint32_t agentId, NoiseState noiseState,
 }
 
 void MultiAgentSystem::updateQTable(uint32_t agentId, NoiseState noiseState, ThrustAction action, float reward) {
-    size_t idx = 0;
-    for (; idx < agents_.size(); idx++) {
-        if (agents_[idx].id == agentId) break;
-    }
-    if (idx >= agents_.size()) return;
+    AERONAV_PROFILE_SCOPE(RL_Q_UPDATE);
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return;
+    updateQTableAt(idx, noiseState, action, reward);
+}
 
-    AgentMetrics& agent = agents_[idx];
+void MultiAgentSystem::updateQTableAt(size_t idx, NoiseState noiseState, ThrustAction action, float reward) {
     const AgentConfig& config = configs_[idx];
-    QValues& qv = (noiseState == NoiseState::LOW_NOISE) ? agent.qTable.lowNoise : agent.qTable.highNoise;
+    auto& q = q_[noiseIndex(noiseState)];
 
     float* qPtr = nullptr;
     switch (action) {
-        case ThrustAction::GLIDE: qPtr = &qv.glide; break;
-        case ThrustAction::BOOST: qPtr = &qv.boost; break;
-        case ThrustAction::STABILIZE: qPtr = &qv.stabilize; break;
+        case ThrustAction::GLIDE: qPtr = &q[0][idx]; break;
+        case ThrustAction::BOOST: qPtr = &q[1][idx]; break;
+        case ThrustAction::STABILIZE: qPtr = &q[2][idx]; break;
         default: return;
     }
 
     float currentQ = *qPtr;
     float newQ = currentQ + config.learningRate * (reward - currentQ);
     *qPtr = std::max(0.0f, std::min(1.0f, newQ));
-    agent.totalSteps++;
+    totalSteps_[idx]++;
 }
 
 void MultiAgentSystem::regenEnergy(uint32_t agentId, float deltaTime) {
-    size_t idx = 0;
-    for (; idx < agents_.size(); idx++) {
-        if (agents_[idx].id == agentId) break;
-    }
-    if (idx >= agents_.size()) return;
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return;
 
-    AgentMetrics& agent = agents_[idx];
     const AgentConfig& config = configs_[idx];
-    agent.energy = std::min(config.energy.max, agent.energy + config.energy.regen * deltaTime);
+    energy_[idx] = std::min(config.energy.max, energy_[idx] + config.energy.regen * deltaTime);
 }
 
 void MultiAgentSystem::consumeEnergy(uint32_t agentId, ThrustAction action) {
-    size_t idx = 0;
-    for (; idx < agents_.size(); idx++) {
-        if (agents_[idx].id == agentId) break;
-    }
-    if (idx >= agents_.size()) return;
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return;
+    consumeEnergyAt(idx, action);
+}
 
-    AgentMetrics& agent = agents_[idx];
-    const EnergyConfig& ec = configs_[idx].energy;
+void MultiAgentSystem::resetEnergy(uint32_t agentId) {
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return;
+    energy_[idx] = configs_[idx].energy.max;
+}
 
-    float cost = 0.0f;
-    switch (action) {
-        case ThrustAction::GLIDE: cost = ec.costGlide; break;
-        case ThrustAction::BOOST: cost = ec.costBoost; break;
-        case ThrustAction::STABILIZE: cost = ec.costStabilize; break;
-        default: break;
-    }
-    agent.energy = std::max(0.0f, agent.energy - cost);
+void MultiAgentSystem::consumeEnergyAt(size_t idx, ThrustAction action) {
+    energy_[idx] = std::max(0.0f, energy_[idx] - getEnergyCost(action, configs_[idx].energy));
+}
+
+CoordinationEventRecord CoordinationEventRecord::pack(const CoordinationEvent& event) {
+    CoordinationEventRecord record;
+    record.words[TIMESTAMP] = event.timestamp;
+    record.words[AGENT1_ID] = event.agent1Id;
+    record.words[AGENT2_ID] = event.agent2Id;
+    record.words[TYPE] = static_cast<uint32_t>(event.type);
+    return record;
+}
+
+CoordinationEvent CoordinationEventRecord::unpack() const {
+    return {words[TIMESTAMP], words[AGENT1_ID], words[AGENT2_ID], static_cast<CoordinationType>(words[TYPE])};
 }
 
 void MultiAgentSystem::detectCoordination(uint32_t timestamp) {
-    for (size_t i = 0; i < agents_.size(); i++) {
-        for (size_t j = i + 1; j < agents_.size(); j++) {
-            const AgentMetrics& a1 = agents_[i];
-            const AgentMetrics& a2 = agents_[j];
-
-            // Conflict: opposite actions
-            if ((a1.action == ThrustAction::BOOST && a2.action == ThrustAction::STABILIZE) ||
-                (a1.action == ThrustAction::STABILIZE && a2.action == ThrustAction::BOOST)) {
-                recentEvents_.push_back({timestamp, a1.id, a2.id, CoordinationType::CONFLICT});
-            }
-            // Cooperation: same high-confidence action
-            else if (a1.action == a2.action && a1.action != ThrustAction::IDLE &&
-                     a1.confidence > 0.7f && a2.confidence > 0.7f) {
-                recentEvents_.push_back({timestamp, a1.id, a2.id, CoordinationType::COOPERATION});
-            }
-            // Independence: different compatible actions
-            else if (a1.action != a2.action && a1.action != ThrustAction::IDLE && a2.action != ThrustAction::IDLE) {
-                recentEvents_.push_back({timestamp, a1.id, a2.id, CoordinationType::INDEPENDENCE});
+    const size_t n = ids_.size();
+    if (n < 2) return;
+
+    AERONAV_PROFILE_SCOPE(RL_COORDINATION);
+
+    // Per-agent counts against every other agent, straight from the bins
+    ActionHistogram all;
+    for (size_t i = 0; i < n; i++) {
+        all.add(action_[i], confidence_[i] > COORDINATION_CONFIDENCE);
+    }
+    for (size_t i = 0; i < n; i++) {
+        const bool confident = confidence_[i] > COORDINATION_CONFIDENCE;
+        uint32_t cooperation = cooperationPartners(all, action_[i], confident);
+        if (cooperation > 0) cooperation--;   // the agent's own bin entry
+        cooperationCount_[i] += cooperation;
+        conflictCount_[i] += conflictPartners(all, action_[i]);
+        coordinationScore_[i] = coordinationScoreFrom(cooperationCount_[i], conflictCount_[i]);
+    }
+
+    // Only the last capacity pair events (in (i, j) scan order) survive the
+    // ring. Walk back from the last row, counting each row's events against the
+    // bins of the agents after it, until that many are covered.
+    const size_t capacity = events_.capacity();
+    size_t* rows = coordinationRows_.data();
+    size_t rowCount = 0;
+    size_t covered = 0;
+    ActionHistogram after;
+    for (size_t i = n; i-- > 0 && covered < capacity;) {
+        const ThrustAction action = action_[i];
+        const bool confident = confidence_[i] > COORDINATION_CONFIDENCE;
+        const uint32_t events = conflictPartners(after, action) +
+                                cooperationPartners(after, action, confident) +
+                                independencePartners(after, action);
+        if (events > 0) {
+            rows[rowCount++] = i;
+            covered += events;
+        }
+        after.add(action, confident);
+    }
+
+    // Emit those rows in scan order, skipping the excess of the first one
+    size_t skip = covered > capacity ? covered - capacity : 0;
+    while (rowCount > 0) {
+        const size_t i = rows[--rowCount];
+        const bool confident1 = confidence_[i] > COORDINATION_CONFIDENCE;
+        for (size_t j = i + 1; j < n; j++) {
+            CoordinationType type;
+            if (!classifyPair(action_[i], confident1, action_[j],
+                              confidence_[j] > COORDINATION_CONFIDENCE, type)) continue;
+            if (skip > 0) {
+                skip--;
+                continue;
             }
+            events_.push(CoordinationEventRecord::pack({timestamp, ids_[i], ids_[j], type}));
+            AERONAV_PROFILE_COUNT(EVENTS, 1);
         }
     }
-    // Keep only last 100 events
-    if (recentEvents_.size() > 100) {
-        recentEvents_.erase(recentEvents_.begin(), recentEvents_.begin() + (recentEvents_.size() - 100));
+}
+
+void MultiAgentSystem::recordCoordination(uint32_t timestamp, size_t i, size_t j) {
+    CoordinationType type;
+    if (!classifyPair(action_[i], confidence_[i] > COORDINATION_CONFIDENCE,
+                      action_[j], confidence_[j] > COORDINATION_CONFIDENCE, type)) return;
+
+    if (type == CoordinationType::COOPERATION) {
+        cooperationCount_[i]++;
+        cooperationCount_[j]++;
+    } else if (type == CoordinationType::CONFLICT) {
+        conflictCount_[i]++;
+        conflictCount_[j]++;
     }
+    events_.push(CoordinationEventRecord::pack({timestamp, ids_[i], ids_[j], type}));
+    AERONAV_PROFILE_COUNT(EVENTS, 1);
 }
 
-float MultiAgentSystem::calculateCoordinationScore(uint32_t agentId) {
-    int cooperation = 0, conflict = 0;
-    for (const auto& e : recentEvents_) {
-        if (e.agent1Id == agentId || e.agent2Id == agentId) {
-            if (e.type == CoordinationType::COOPERATION) cooperation++;
-            else if (e.type == CoordinationType::CONFLICT) conflict++;
-        }
+void MultiAgentSystem::detectCoordinationInRadius(uint32_t timestamp, float radius) {
+    const size_t n = ids_.size();
+    if (n < 2 || radius <= 0.0f) return;
+
+    AERONAV_PROFILE_SCOPE(RL_COORDINATION);
+
+    coordinationGrid_.setCellSize(radius);
+    coordinationGrid_.update(px_.data(), py_.data(), pz_.data(), n);
+
+    // Pairs in (i, j) order, like detectCoordination()
+    for (size_t i = 0; i < n; i++) {
+        neighborScratch_.clear();
+        coordinationGrid_.forEachNeighbor(px_[i], py_[i], pz_[i], radius, [&](uint32_t j, float) {
+            if (j > i) neighborScratch_.push_back(j);
+        });
+        std::sort(neighborScratch_.begin(), neighborScratch_.end());
+        for (uint32_t j : neighborScratch_) recordCoordination(timestamp, i, j);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        coordinationScore_[i] = coordinationScoreFrom(cooperationCount_[i], conflictCount_[i]);
     }
-    int total = cooperation + conflict;
-    if (total == 0) return 0.5f;
-    return static_cast<float>(cooperation) / static_cast<float>(total);
+}
+
+void MultiAgentSystem::setAgentPosition(uint32_t agentId, float x, float y, float z) {
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return;
+    px_[idx] = x;
+    py_[idx] = y;
+    pz_[idx] = z;
+}
+
+void MultiAgentSystem::setAgentPositions(const float* positions, size_t stride, size_t count) {
+    count = std::min(count, ids_.size());
+    for (size_t i = 0; i < count; i++, positions += stride) {
+        px_[i] = positions[0];
+        py_[i] = positions[1];
+        pz_[i] = positions[2];
+    }
+}
+
+float MultiAgentSystem::calculateCoordinationScore(uint32_t agentId) {
+    const uint32_t idx = indexOf(agentId);
+    if (idx == INVALID_INDEX) return 0.5f;
+    return coordinationScore_[idx];
 }
 
 CoordinationEvent MultiAgentSystem::getCoordinationEvent(size_t index) const {
-    if (index < recentEvents_.size()) return recentEvents_[index];
+    if (index < events_.size()) return events_.at(index).unpack();
     return {0, 0, 0, CoordinationType::INDEPENDENCE};
 }
 
 void MultiAgentSystem::clearCoordinationEvents() {
-    recentEvents_.clear();
+    events_.clear();
+    std::fill(cooperationCount_.begin(), cooperationCount_.end(), 0u);
+    std::fill(conflictCount_.begin(), conflictCount_.end(), 0u);
+    std::fill(coordinationScore_.begin(), coordinationScore_.end(), 0.5f);
+}
+
+void MultiAgentSystem::setCoordinationEventCapacity(size_t capacity) {
+    events_.setCapacity(capacity);
+    coordinationRows_.resize(events_.capacity());
+}
+
+size_t MultiAgentSystem::snapshotSizeFor(const SnapshotCounts& counts) const {
+    size_t perAgent = 0;
+    forEachArray([&perAgent](const auto& values) {
+        perAgent += sizeof(typename std::decay_t<decltype(values)>::value_type);
+    });
+    return sizeof(SnapshotHeader) + sizeof(SnapshotCounts)
+        + counts.sparseCount * sizeof(uint32_t)
+        + counts.agentCount * perAgent
+        + counts.eventCapacity * sizeof(CoordinationEventRecord);
+}
+
+size_t MultiAgentSystem::getSnapshotSize() const {
+    SnapshotCounts counts = {};
+    counts.agentCount = ids_.size();
+    counts.sparseCount = sparse_.size();
+    counts.eventCapacity = events_.capacity();
+    return snapshotSizeFor(counts);
+}
+
+size_t MultiAgentSystem::saveSnapshot(uint8_t* out, size_t capacity) const {
+    SnapshotCounts counts = {};
+    counts.agentCount = ids_.size();
+    counts.sparseCount = sparse_.size();
+    counts.seed = seed_;
+    counts.eventSequence = events_.getSequence();
+    counts.eventCapacity = events_.capacity();
+    counts.eventCount = events_.size();
+    counts.nextAgentId = nextAgentId_;
+
+    const size_t size = snapshotSizeFor(counts);
+    if (out == nullptr || capacity < size) return 0;
+
+    SnapshotWriter writer(out);
+    writer.write(makeSnapshotHeader(SnapshotKind::MULTI_AGENT, SNAPSHOT_VERSION, size));
+    writer.write(counts);
+    writer.writeArray(sparse_.data(), sparse_.size());
+    forEachArray([&writer](const auto& values) { writer.writeArray(values.data(), values.size()); });
+    writer.writeArray(events_.data(), events_.capacity());
+    return writer.size();
+}
+
+bool MultiAgentSystem::restoreSnapshot(const uint8_t* data, size_t size) {
+    SnapshotHeader header;
+    if (!checkSnapshotHeader(data, size, SnapshotKind::MULTI_AGENT, SNAPSHOT_VERSION, header)) return false;
+    if (size < sizeof(SnapshotHeader) + sizeof(SnapshotCounts)) return false;
+
+    SnapshotReader reader(data);
+    reader.read(header);
+    SnapshotCounts counts;
+    reader.read(counts);
+
+    // Every count is bounded by the blob size before any size arithmetic
+    if (counts.agentCount > size || counts.sparseCount > size || counts.eventCapacity > size) return false;
+    if (counts.agentCount > counts.sparseCount || counts.sparseCount != counts.nextAgentId) return false;
+    if (counts.eventCapacity < 1 || counts.eventCount > counts.eventCapacity) return false;
+    if (snapshotSizeFor(counts) != size) return false;
+
+    const size_t agentCount = static_cast<size_t>(counts.agentCount);
+    if (!consistentIdMaps(data + reader.offset(), static_cast<size_t>(counts.sparseCount), agentCount)) {
+        return false;
+    }
+
+    sparse_.resize(static_cast<size_t>(counts.sparseCount));
+    reader.readArray(sparse_.data(), sparse_.size());
+    forEachArray([&reader, agentCount](auto& values) {
+        values.resize(agentCount);
+        reader.readArray(values.data(), agentCount);
+    });
+
+    events_.restore(static_cast<size_t>(counts.eventCapacity), counts.eventSequence,
+                    static_cast<size_t>(counts.eventCount));
+    reader.readArray(events_.slots(), events_.capacity());
+    coordinationRows_.resize(events_.capacity());
+
+    seed_ = counts.seed;
+    nextAgentId_ = counts.nextAgentId;
+    countPolicies();
+    return true;
+}
+
+// `blob` points at the sparse map, immediately followed by ids_ (first of
+// forEachArray). Every live sparse entry must name a dense slot holding that
+// id, and every slot must be named once: otherwise indexOf() would hand out
+// out-of-range or aliased indices. Checked in place, before anything is restored.
+bool MultiAgentSystem::consistentIdMaps(const uint8_t* blob, size_t sparseCount, size_t agentCount) {
+    const uint8_t* ids = blob + sparseCount * sizeof(uint32_t);
+    size_t live = 0;
+    for (size_t id = 0; id < sparseCount; id++) {
+        uint32_t idx;
+        std::memcpy(&idx, blob + id * sizeof(uint32_t), sizeof(idx));
+        if (idx == INVALID_INDEX) continue;
+        if (idx >= agentCount) return false;
+        uint32_t owner;
+        std::memcpy(&owner, ids + idx * sizeof(uint32_t), sizeof(owner));
+        if (owner != id) return false;
+        live++;
+    }
+    return live == agentCount;
+}
+
+void MultiAgentSystem::setThreadCount(size_t threads) {
+    if (threads == 0) threads = ThreadPool::hardwareThreads();
+    if (threads == getThreadCount()) return;
+    pool_ = threads > 1 ? std::make_unique<ThreadPool>(threads) : nullptr;
 }
 
 void MultiAgentSystem::stepAll(NoiseState noiseState, bool isTraining) {
-    for (auto& agent : agents_) {
-        ThrustAction action = selectAction(agent.id, noiseState, isTraining);
-        float reward = calculateReward(agent.id, noiseState, action, agent.energy);
-        updateQTable(agent.id, noiseState, action, reward);
-        consumeEnergy(agent.id, action);
-        agent.action = action;
-        agent.reward = reward;
-        agent.confidence = std::max(agent.qTable.lowNoise.glide, std::max(agent.qTable.lowNoise.boost, agent.qTable.lowNoise.stabilize));
+    AERONAV_PROFILE_SCOPE(RL_STEP);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, ids_.size());
+
+    AgentStepParams params;
+    params.noiseState = noiseIndex(noiseState);
+    params.isTraining = isTraining;
+    for (size_t a = 0; a < Q_ACTION_COUNT; a++) params.baseReward[a] = BASE_REWARD[params.noiseState][a];
+
+    const AgentArrays arrays = getArrays();
+    AgentPolicy policy = AgentPolicy::BALANCED;
+    const bool uniform = uniformPolicy(policy);
+    const PolicyTraits& uniformTraits = policyTraits(policy);
+
+    // Each partition only touches its own agents' slots, so no merge step is needed
+    auto stepRange = [&](size_t begin, size_t end) {
+        // RNG pre-pass: the same single block per agent that selectAction() draws
+        for (size_t idx = begin; idx < end; idx++) {
+            ThrustAction exploreAction;
+            const PolicyTraits& traits = uniform ? uniformTraits : policyTraits(configs_[idx].policy);
+            drawExploration(idx, traits, exploreDraw_[idx], exploreAction);
+            exploreAction_[idx] = static_cast<float>(exploreAction);
+        }
+
+        if (uniform) {
+            stepAgentsUniform(policy, arrays, params, begin, end);
+        } else {
+            stepAgents(arrays, params, begin, end);
+        }
+
+        for (size_t idx = begin; idx < end; idx++) {
+            action_[idx] = static_cast<ThrustAction>(static_cast<uint8_t>(stepAction_[idx]));
+            totalSteps_[idx]++;
+        }
+    };
+
+    if (pool_) {
+        pool_->parallelFor(ids_.size(), STEP_GRAIN, stepRange);
+    } else {
+        stepRange(0, ids_.size());
+    }
+}
+
+void MultiAgentSystem::stepAllReference(NoiseState noiseState, bool isTraining) {
+    AERONAV_PROFILE_SCOPE(RL_STEP);
+    AERONAV_PROFILE_COUNT(STEPS, 1);
+    AERONAV_PROFILE_COUNT(ITEMS, ids_.size());
+    for (size_t idx = 0; idx < ids_.size(); idx++) {
+        ThrustAction action = selectActionAt(idx, noiseState, isTraining);
+        float reward = calculateRewardAt(idx, noiseState, action, energy_[idx]);
+        updateQTableAt(idx, noiseState, action, reward);
+        consumeEnergyAt(idx, action);
+        action_[idx] = action;
+        reward_[idx] = reward;
+        confidence_[idx] = std::max(q_[0][0][idx], std::max(q_[0][1][idx], q_[0][2][idx]));
+    }
+}
+
+QTable getDefaultQTable(AgentPolicy policy) {
+    const PolicyTraits& traits = policyTraits(policy);
+    QTable qt;
+    qt.lowNoise = QValues(traits.lowNoiseQ[0], traits.lowNoiseQ[1], traits.lowNoiseQ[2]);
+    qt.highNoise = QValues(traits.highNoiseQ[0], traits.highNoiseQ[1], traits.highNoiseQ[2]);
+    return qt;
+}
+
+float getEnergyCost(ThrustAction action, const EnergyConfig& config) {
+    switch (action) {
+        case ThrustAction::GLIDE: return config.costGlide;
+        case ThrustAction::BOOST: return config.costBoost;
+        case ThrustAction::STABILIZE: return config.costStabilize;
+        default: return 0.0f;
     }
 }
 
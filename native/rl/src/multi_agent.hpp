@@ -3,35 +3,22 @@
 #include <cstdint>
 #include <cstddef>
 #include <cmath>
-#include <cstdlib>
 #include <vector>
 #include <string>
+#include "rng.hpp"
+#include "thrust_action.hpp"
+#include "noise_state.hpp"
+#include "policy_traits.hpp"
+#include "agent_step.hpp"
+#include "thread_pool.hpp"
+#include "event_ring.hpp"
+#include "spatial_hash.hpp"
+#include "snapshot.hpp"
+#include "arena.hpp"
+#include <memory>
 
 namespace aeronav {
 
-// Agent policy types
-enum class AgentPolicy : uint8_t {
-    BALANCED = 0,
-    CONSERVATIVE = 1,
-    AGGRESSIVE = 2,
-    EXPLORATORY = 3,
-    EXPLOITATIVE = 4
-};
-
-// Thrust actions
-enum class ThrustAction : uint8_t {
-    IDLE = 0,
-    GLIDE = 1,
-    BOOST = 2,
-    STABILIZE = 3
-};
-
-// Noise state
-enum class NoiseState : uint8_t {
-    LOW_NOISE = 0,
-    HIGH_NOISE = 1
-};
-
 // Coordination event types
 enum class CoordinationType : uint8_t {
     COOPERATION = 0,
@@ -84,7 +71,7 @@ struct AgentConfig {
         , energy() {}
 };
 
-// Agent metrics/state
+// Agent metrics/state (snapshot assembled from the system's per-agent arrays)
 struct AgentMetrics {
     uint32_t id;
     AgentPolicy policy;
@@ -105,53 +92,243 @@ struct CoordinationEvent {
     CoordinationType type;
 };
 
+// Packed event record as stored in the event ring and exported to JS (uint32 words)
+struct CoordinationEventRecord {
+    static constexpr size_t TIMESTAMP = 0;
+    static constexpr size_t AGENT1_ID = 1;
+    static constexpr size_t AGENT2_ID = 2;
+    static constexpr size_t TYPE = 3;
+    static constexpr size_t STRIDE = 4;
+
+    uint32_t words[STRIDE];
+
+    static CoordinationEventRecord pack(const CoordinationEvent& event);
+    CoordinationEvent unpack() const;
+};
+
+static_assert(sizeof(CoordinationEventRecord) == CoordinationEventRecord::STRIDE * sizeof(uint32_t),
+              "event records must be tightly packed for the typed-array view");
+
+// Flat per-agent step record (floats), e.g. for trajectory_recorder.hpp
+// ID and TOTAL_STEPS hold uint32 words bit-cast into their float slots (exact
+// past 2^24); read them through a uint32 view of the same buffer
+struct AgentRecordLayout {
+    static constexpr size_t ID = 0;            // uint32 word
+    static constexpr size_t ACTION = 1;        // ThrustAction
+    static constexpr size_t REWARD = 2;
+    static constexpr size_t ENERGY = 3;
+    static constexpr size_t CONFIDENCE = 4;
+    static constexpr size_t Q_LOW_NOISE = 5;   // glide, boost, stabilize
+    static constexpr size_t Q_HIGH_NOISE = 8;  // glide, boost, stabilize
+    static constexpr size_t TOTAL_STEPS = 11;  // uint32 word
+    static constexpr size_t STRIDE = 12;
+};
+
 /**
  * Multi-agent reinforcement learning system
+ * Agents are stored as structure-of-arrays (Q-values per [noiseState][action],
+ * energy, and per-agent parameters expanded from the policy table), and
+ * stepAll() runs the fused SIMD kernel in agent_step.hpp over them.
  */
 class MultiAgentSystem {
 public:
     MultiAgentSystem();
+    explicit MultiAgentSystem(uint64_t seed);
+    // Every per-agent array, the id map, the event ring and the coordination
+    // scratch in one arena sized for maxAgents, so creating up to maxAgents
+    // agents and stepping them never allocates (past that, or once ids pass
+    // maxAgents through churn, growth falls back to the heap)
+    MultiAgentSystem(uint64_t seed, size_t maxAgents);
+    size_t getAgentCapacity() const { return agentCapacity_; }
+
+    // Reseed every agent stream (agent i draws from stream agentId under this seed)
+    void setSeed(uint64_t seed);
+    uint64_t getSeed() const { return seed_; }
 
     // Agent management
+    // Ids are never reused; id -> dense index is an O(1) sparse-set lookup and
+    // removal is swap-and-pop (so getAgents() order changes on removal)
     uint32_t createAgent(const AgentConfig& config);
     void removeAgent(uint32_t id);
-    AgentMetrics* getAgent(uint32_t id);
-    size_t getAgentCount() const { return agents_.size(); }
+    bool getAgent(uint32_t id, AgentMetrics& out) const;
+    AgentMetrics getAgentAt(size_t index) const;
+    size_t getAgentCount() const { return ids_.size(); }
+    bool hasAgent(uint32_t id) const { return indexOf(id) != INVALID_INDEX; }
 
     // Core RL operations
     ThrustAction selectAction(uint32_t agentId, NoiseState noiseState, bool isTraining);
     float calculateReward(uint32_t agentId, NoiseState noiseState, ThrustAction action, float energyLevel);
     void updateQTable(uint32_t agentId, NoiseState noiseState, ThrustAction action, float reward);
 
-    // Step all agents
+    // Step all agents (fused kernel, partitioned across the thread pool). When
+    // every agent shares one policy the kernel specialized on it runs instead.
     void stepAll(NoiseState noiseState, bool isTraining);
 
+    // Threads used by stepAll (caller included; 0 = all hardware threads, 1 = serial).
+    // Every agent draws from its own stream, so results never depend on this.
+    void setThreadCount(size_t threads);
+    size_t getThreadCount() const { return pool_ ? pool_->getThreadCount() : 1; }
+
+    // Step all agents through the per-agent member functions (reference for stepAll)
+    void stepAllReference(NoiseState noiseState, bool isTraining);
+
     // Coordination
+    // Agents are binned by (action, confidence > 0.7) and each agent's
+    // cooperation/conflict counts come from the bin totals in O(N). Counts
+    // accumulate across calls until clearCoordinationEvents(); only the last
+    // getCoordinationEventCapacity() pair events are kept, in the event ring.
+    static constexpr size_t DEFAULT_COORDINATION_EVENT_CAPACITY = 100;
+
     void detectCoordination(uint32_t timestamp);
     float calculateCoordinationScore(uint32_t agentId);
-    size_t getCoordinationEventCount() const { return recentEvents_.size(); }
-    CoordinationEvent getCoordinationEvent(size_t index) const;
-    void clearCoordinationEvents();
+
+    // Distance-based variant: only pairs within radius of each other are
+    // classified, found through a spatial hash in O(N*k) (k = neighbours)
+    void detectCoordinationInRadius(uint32_t timestamp, float radius);
+
+    // Agent positions (origin until set), e.g. copied from the physics bodies
+    void setAgentPosition(uint32_t agentId, float x, float y, float z);
+    // Positions for the first `count` agents in dense order, read from xyz
+    // triples `stride` floats apart (StateLayout records: stride 16)
+    void setAgentPositions(const float* positions, size_t stride, size_t count);
+    size_t getCoordinationEventCount() const { return events_.size(); }
+    CoordinationEvent getCoordinationEvent(size_t index) const;   // 0 = oldest retained
+    void clearCoordinationEvents();   // the event sequence keeps counting
+
+    // Event log: every event gets the next sequence number; event s sits in
+    // record s % capacity of getCoordinationEventRecords() until overwritten
+    void setCoordinationEventCapacity(size_t capacity);   // drops retained events
+    size_t getCoordinationEventCapacity() const { return events_.capacity(); }
+    uint64_t getCoordinationSequence() const { return events_.getSequence(); }
+    uint64_t getFirstCoordinationSequence() const { return events_.getFirstSequence(); }
+    const CoordinationEventRecord* getCoordinationEventRecords() const { return events_.data(); }
+    size_t copyCoordinationEventsSince(uint64_t sequence, CoordinationEventRecord* out, size_t maxCount) const {
+        return events_.copySince(sequence, out, maxCount);
+    }
 
     // Energy management
     void regenEnergy(uint32_t agentId, float deltaTime);
     void consumeEnergy(uint32_t agentId, ThrustAction action);
+    void resetEnergy(uint32_t agentId);   // back to the configured maximum
 
-    // Getters for all agents (for WASM binding)
-    std::vector<AgentMetrics>& getAgents() { return agents_; }
+    // Snapshot of all agents in dense order
+    std::vector<AgentMetrics> getAgents() const;
+
+    // Raw SoA access for batched consumers
+    AgentArrays getArrays();
+
+    // One AgentRecordLayout record per agent in dense order into out
+    // (getAgentCount() * AgentRecordLayout::STRIDE floats)
+    void writeAgentRecords(float* out) const;
+
+    // Snapshot / restore of every agent, the id map, seed, next id and the
+    // coordination event ring (see snapshot.hpp). Thread count and scratch
+    // grids are not state. restoreSnapshot() validates the blob before touching
+    // the system and allocates only when it has never held that many agents.
+    static constexpr uint16_t SNAPSHOT_VERSION = 1;
+    size_t getSnapshotSize() const;
+    size_t saveSnapshot(uint8_t* out, size_t capacity) const;   // bytes written, 0 if capacity is too small
+    bool restoreSnapshot(const uint8_t* data, size_t size);
 
 private:
-    std::vector<AgentMetrics> agents_;
-    std::vector<AgentConfig> configs_;
-    std::vector<CoordinationEvent> recentEvents_;
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+    static constexpr size_t STEP_GRAIN = 256;   // agents per parallel work item
+
+    // Cold per-agent data
+    ArenaVector<uint32_t> ids_;
+    ArenaVector<AgentConfig> configs_;
+    ArenaVector<ThrustAction> action_;
+    ArenaVector<uint32_t> totalSteps_;
+    ArenaVector<float> coordinationScore_;
+    ArenaVector<uint32_t> cooperationCount_;
+    ArenaVector<uint32_t> conflictCount_;
+    ArenaVector<float> px_, py_, pz_;
+    ArenaVector<RngStream> rngs_;   // per-agent streams
+    ArenaVector<uint32_t> sparse_;  // agent id -> dense index (INVALID_INDEX if removed)
+
+    // Hot per-agent state
+    ArenaVector<float> q_[NOISE_STATE_COUNT][Q_ACTION_COUNT];
+    ArenaVector<float> energy_;
+    ArenaVector<float> reward_;
+    ArenaVector<float> confidence_;
+
+    // Per-agent parameters
+    ArenaVector<float> epsilonNormal_;
+    ArenaVector<float> epsilonTraining_;
+    ArenaVector<float> learningRate_;
+    ArenaVector<float> cost_[Q_ACTION_COUNT];
+    ArenaVector<float> boostRewardAdj_;
+    ArenaVector<float> highEnergyAdj_;
+    ArenaVector<float> lowEnergyAdj_;
+
+    // Per-step scratch for the fused kernel
+    ArenaVector<float> exploreDraw_;
+    ArenaVector<float> exploreAction_;
+    ArenaVector<float> stepAction_;
+
+    std::unique_ptr<ThreadPool> pool_;   // null when serial
+
+    // Agents per policy (policyTraits() index), for the uniform-policy kernel
+    uint32_t policyCounts_[AGENT_POLICY_COUNT];
+
+    EventRing<CoordinationEventRecord> events_;
+    ArenaVector<size_t> coordinationRows_;   // detectCoordination scratch (<= capacity rows)
+    SpatialHash coordinationGrid_;
+    ArenaVector<uint32_t> neighborScratch_;
+
     uint32_t nextAgentId_;
+    uint64_t seed_;
+    size_t agentCapacity_;   // arena-backed agents (0 = heap only)
+
+    void reserveAgents(size_t maxAgents);
 
     // Initialize Q-table based on policy
     QTable initializeQTable(AgentPolicy policy);
 
-    // Random number generation
-    float randomFloat();
-    int randomInt(int max);
+    void setQTableAt(size_t idx, const QTable& table);
+
+    // The policy every agent has, if there is one (false when mixed or empty)
+    bool uniformPolicy(AgentPolicy& policy) const;
+    void countPolicies();
+
+    // Per-agent random draw for one selection (exactly one block), exploring
+    // over `traits` (the agent's own policy)
+    void drawExploration(size_t idx, const PolicyTraits& traits, float& draw, ThrustAction& exploreAction);
+
+    uint32_t indexOf(uint32_t id) const {
+        return id < sparse_.size() ? sparse_[id] : INVALID_INDEX;
+    }
+
+    // Dense-index implementations behind the id-based API
+    ThrustAction selectActionAt(size_t idx, NoiseState noiseState, bool isTraining);
+    float calculateRewardAt(size_t idx, NoiseState noiseState, ThrustAction action, float energyLevel) const;
+    void updateQTableAt(size_t idx, NoiseState noiseState, ThrustAction action, float reward);
+    void consumeEnergyAt(size_t idx, ThrustAction action);
+
+    void recordCoordination(uint32_t timestamp, size_t i, size_t j);
+
+    // Apply fn to every per-agent array (keeps them in lockstep on create/remove;
+    // fixed order, snapshots depend on it)
+    template <typename Fn>
+    void forEachArray(Fn&& fn) { forEachArrayOf(*this, fn); }
+    template <typename Fn>
+    void forEachArray(Fn&& fn) const { forEachArrayOf(*this, fn); }
+    template <typename Self, typename Fn>
+    static void forEachArrayOf(Self& self, Fn& fn);
+
+    // Fixed-size part of a snapshot, after the header
+    struct SnapshotCounts {
+        uint64_t agentCount;
+        uint64_t sparseCount;
+        uint64_t seed;
+        uint64_t eventSequence;
+        uint64_t eventCapacity;
+        uint64_t eventCount;
+        uint32_t nextAgentId;
+        uint32_t reserved;
+    };
+    size_t snapshotSizeFor(const SnapshotCounts& counts) const;
+    static bool consistentIdMaps(const uint8_t* blob, size_t sparseCount, size_t agentCount);
 };
 
 // Standalone utility functions
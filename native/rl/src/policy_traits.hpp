@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "thrust_action.hpp"
+
+namespace aeronav {
+
+// Agent policy types
+enum class AgentPolicy : uint8_t {
+    BALANCED = 0,
+    CONSERVATIVE = 1,
+    AGGRESSIVE = 2,
+    EXPLORATORY = 3,
+    EXPLOITATIVE = 4
+};
+
+constexpr size_t AGENT_POLICY_COUNT = 5;
+
+// Everything a policy changes, in one table read by the member functions
+// and the fused kernel alike
+struct PolicyTraits {
+    float lowNoiseQ[3];      // initial Q-values: glide, boost, stabilize
+    float highNoiseQ[3];
+    float boostRewardAdj;    // added when boosting
+    float highEnergyAdj;     // added when energy > 70
+    float lowEnergyAdj;      // added when energy < 20
+    uint32_t exploreCount;   // exploration picks uniformly from the first exploreCount actions
+    ThrustAction exploreActions[3];
+};
+
+constexpr PolicyTraits POLICY_TRAITS[AGENT_POLICY_COUNT] = {
+    // BALANCED
+    {{0.8f, 0.6f, 0.2f}, {0.1f, 0.3f, 0.9f}, 0.0f, 0.0f, 0.0f,
+     3, {ThrustAction::GLIDE, ThrustAction::BOOST, ThrustAction::STABILIZE}},
+    // CONSERVATIVE
+    {{0.9f, 0.3f, 0.7f}, {0.5f, 0.2f, 0.95f}, -0.2f, 0.1f, 0.0f,
+     2, {ThrustAction::GLIDE, ThrustAction::STABILIZE, ThrustAction::IDLE}},
+    // AGGRESSIVE
+    {{0.6f, 0.9f, 0.4f}, {0.3f, 0.7f, 0.8f}, 0.1f, 0.0f, -0.2f,
+     2, {ThrustAction::BOOST, ThrustAction::STABILIZE, ThrustAction::IDLE}},
+    // EXPLORATORY
+    {{0.7f, 0.6f, 0.5f}, {0.4f, 0.5f, 0.7f}, 0.0f, 0.0f, 0.0f,
+     3, {ThrustAction::GLIDE, ThrustAction::BOOST, ThrustAction::STABILIZE}},
+    // EXPLOITATIVE
+    {{0.95f, 0.4f, 0.6f}, {0.3f, 0.2f, 0.98f}, 0.0f, 0.0f, 0.0f,
+     3, {ThrustAction::GLIDE, ThrustAction::BOOST, ThrustAction::STABILIZE}},
+};
+
+// Unknown policies behave as BALANCED
+constexpr const PolicyTraits& policyTraits(AgentPolicy policy) {
+    return POLICY_TRAITS[static_cast<size_t>(policy) < AGENT_POLICY_COUNT ? static_cast<size_t>(policy) : 0];
+}
+
+// Compile-time view of one policy, for kernels specialized on it
+template <AgentPolicy Policy>
+struct AgentPolicyTraits {
+    static constexpr AgentPolicy POLICY = Policy;
+    static constexpr float BOOST_REWARD_ADJ = policyTraits(Policy).boostRewardAdj;
+    static constexpr float HIGH_ENERGY_ADJ = policyTraits(Policy).highEnergyAdj;
+    static constexpr float LOW_ENERGY_ADJ = policyTraits(Policy).lowEnergyAdj;
+};
+
+// Run fn(AgentPolicyTraits<P>{}) for a runtime policy (one switch per batch)
+template <typename Fn>
+void withAgentPolicy(AgentPolicy policy, Fn&& fn) {
+    switch (policy) {
+        case AgentPolicy::CONSERVATIVE: fn(AgentPolicyTraits<AgentPolicy::CONSERVATIVE>{}); break;
+        case AgentPolicy::AGGRESSIVE: fn(AgentPolicyTraits<AgentPolicy::AGGRESSIVE>{}); break;
+        case AgentPolicy::EXPLORATORY: fn(AgentPolicyTraits<AgentPolicy::EXPLORATORY>{}); break;
+        case AgentPolicy::EXPLOITATIVE: fn(AgentPolicyTraits<AgentPolicy::EXPLOITATIVE>{}); break;
+        case AgentPolicy::BALANCED:
+        default: fn(AgentPolicyTraits<AgentPolicy::BALANCED>{}); break;
+    }
+}
+
+} // namespace aeronav
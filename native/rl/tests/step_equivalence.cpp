@@ -0,0 +1,102 @@
+// stepAll vs stepAllReference equivalence
+// The fused kernel (agent_step.hpp) must reproduce the per-agent member
+// functions bit for bit: same Q-tables, energy, rewards, actions, confidence
+// and step counts, and the same per-agent RNG streams afterwards, serial and
+// threaded, for mixed and uniform policy populations. Exits nonzero if any
+// configuration mismatches.
+
+#include "multi_agent.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace aeronav;
+
+namespace {
+
+constexpr size_t AGENT_COUNT = 1003;   // not a multiple of any SIMD width
+constexpr int STEP_COUNT = 300;
+constexpr int FOLLOW_UP_STEPS = 20;    // reference steps on both systems after the comparison
+constexpr uint32_t SEED = 5;
+
+// policy < 0: mixed population (agent i gets policy i % AGENT_POLICY_COUNT)
+void populate(MultiAgentSystem& system, int policy) {
+    AgentConfig config;
+    for (size_t i = 0; i < AGENT_COUNT; i++) {
+        config.policy = static_cast<AgentPolicy>(policy < 0 ? i % AGENT_POLICY_COUNT : static_cast<size_t>(policy));
+        system.createAgent(config);
+    }
+}
+
+// Agents whose AgentRecordLayout record differs in any bit
+size_t mismatchingAgents(const MultiAgentSystem& expected, const MultiAgentSystem& actual) {
+    if (expected.getAgentCount() != actual.getAgentCount()) return AGENT_COUNT;
+    std::vector<float> expectedRecords(expected.getAgentCount() * AgentRecordLayout::STRIDE);
+    std::vector<float> actualRecords(actual.getAgentCount() * AgentRecordLayout::STRIDE);
+    expected.writeAgentRecords(expectedRecords.data());
+    actual.writeAgentRecords(actualRecords.data());
+
+    size_t mismatches = 0;
+    for (size_t offset = 0; offset < expectedRecords.size(); offset += AgentRecordLayout::STRIDE) {
+        if (std::memcmp(&expectedRecords[offset], &actualRecords[offset],
+                        AgentRecordLayout::STRIDE * sizeof(float)) != 0) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+bool runCase(int policy, size_t threads) {
+    MultiAgentSystem reference(SEED);
+    MultiAgentSystem fused(SEED);
+    populate(reference, policy);
+    populate(fused, policy);
+    fused.setThreadCount(threads);
+
+    for (int step = 0; step < STEP_COUNT; step++) {
+        const NoiseState noise = step % 3 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE;
+        const bool isTraining = step % 50 != 49;
+        reference.stepAllReference(noise, isTraining);
+        fused.stepAll(noise, isTraining);
+
+        // Partial regen mid-run so the agents' energies diverge from each other
+        if (step == 100) {
+            for (uint32_t id = 0; id < AGENT_COUNT; id += 7) {
+                reference.regenEnergy(id, 3.0f);
+                fused.regenEnergy(id, 3.0f);
+            }
+        }
+    }
+
+    const size_t mismatches = mismatchingAgents(reference, fused);
+
+    // The records do not hold the RNG state: step both the same way and compare
+    // again, so a stream the fused kernel advanced differently shows up
+    for (int step = 0; step < FOLLOW_UP_STEPS; step++) {
+        reference.stepAllReference(NoiseState::HIGH_NOISE, true);
+        fused.stepAllReference(NoiseState::HIGH_NOISE, true);
+    }
+    const size_t followUpMismatches = mismatchingAgents(reference, fused);
+
+    std::printf("policy %2d threads %zu: %zu mismatching agents, %zu after follow-up steps\n",
+                policy, threads, mismatches, followUpMismatches);
+    return mismatches == 0 && followUpMismatches == 0;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<size_t> threadCounts = {1};
+#ifdef AERONAV_ENABLE_THREADS
+    threadCounts.push_back(4);
+#endif
+
+    bool ok = true;
+    for (size_t threads : threadCounts) {
+        for (int policy = -1; policy < static_cast<int>(AGENT_POLICY_COUNT); policy++) {
+            ok = runCase(policy, threads) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../src/vec_env.hpp"
+
+using namespace emscripten;
+using namespace aeronav;
+
+// Flat, JS-friendly subset of VecEnvConfig (64-bit seed as two halves)
+struct VecEnvConfigJS {
+    unsigned int envCount;
+    float deltaTime;
+    unsigned int maxSteps;
+    float spawnRadius;
+    float arenaRadius;
+    float targetRadius;
+    float reachBonus;
+    unsigned int seedLow;
+    unsigned int seedHigh;
+    int integrator;   // INTEGRATOR_* value from the physics module
+
+    VecEnvConfig toConfig() const {
+        VecEnvConfig config;
+        config.envCount = envCount;
+        config.deltaTime = deltaTime;
+        config.maxSteps = maxSteps;
+        config.spawnRadius = spawnRadius;
+        config.arenaRadius = arenaRadius;
+        config.targetRadius = targetRadius;
+        config.reachBonus = reachBonus;
+        config.seed = (static_cast<uint64_t>(seedHigh) << 32) | seedLow;
+        if (integrator >= 0 && integrator <= 3) config.integrator = static_cast<IntegratorType>(integrator);
+        return config;
+    }
+};
+
+VecEnvConfigJS defaultVecEnvConfig() {
+    const VecEnvConfig defaults;
+    return {
+        static_cast<unsigned int>(defaults.envCount), defaults.deltaTime, defaults.maxSteps,
+        defaults.spawnRadius, defaults.arenaRadius, defaults.targetRadius, defaults.reachBonus,
+        static_cast<unsigned int>(defaults.seed), static_cast<unsigned int>(defaults.seed >> 32),
+        static_cast<int>(defaults.integrator)
+    };
+}
+
+/**
+ * VecEnv with an env-owned action buffer, so a step crosses the boundary once:
+ * write actions into getActionView(), call step(), read the output views.
+ * All views are invalidated by WASM memory growth (re-acquire when length is 0).
+ */
+class VecEnvWrapper {
+public:
+    VecEnvWrapper() : VecEnvWrapper(defaultVecEnvConfig()) {}
+
+    explicit VecEnvWrapper(const VecEnvConfigJS& config)
+        : env_(config.toConfig())
+        , actions_(env_.getEnvCount(), 0)
+        , resetIds_(env_.getEnvCount(), 0)
+    {
+    }
+
+    unsigned int getEnvCount() const { return static_cast<unsigned int>(env_.getEnvCount()); }
+
+    void step() { env_.step(actions_.data()); }
+    void resetAll() { env_.resetAll(); }
+
+    // Reset the first `count` env ids written into getResetView()
+    void reset(unsigned int count) {
+        env_.reset(resetIds_.data(), count < resetIds_.size() ? count : resetIds_.size());
+    }
+
+    // noiseState: 0 = LOW_NOISE, 1 = HIGH_NOISE
+    void setNoiseState(unsigned int env, int noiseState) {
+        env_.setNoiseState(env, noiseState == 1 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE);
+    }
+
+    void setNoiseStateAll(int noiseState) {
+        env_.setNoiseStateAll(noiseState == 1 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE);
+    }
+
+    unsigned int getStepCount(unsigned int env) const { return env_.getStepCount(env); }
+
+    // Zero-copy views: Int32Array actions / Uint32Array reset ids (inputs),
+    // Float32Array observations (OBS_* layout) and rewards, Uint8Array dones
+    val getActionView() { return val(typed_memory_view(actions_.size(), actions_.data())); }
+    val getResetView() { return val(typed_memory_view(resetIds_.size(), resetIds_.data())); }
+    val getObservationView() const {
+        return val(typed_memory_view(env_.getEnvCount() * ObservationLayout::STRIDE, env_.getObservations()));
+    }
+    val getRewardView() const { return val(typed_memory_view(env_.getEnvCount(), env_.getRewards())); }
+    val getDoneView() const { return val(typed_memory_view(env_.getEnvCount(), env_.getDones())); }
+
+private:
+    VecEnv env_;
+    std::vector<int32_t> actions_;
+    std::vector<uint32_t> resetIds_;
+};
+
+EMSCRIPTEN_BINDINGS(aeronav_vecenv) {
+    value_object<VecEnvConfigJS>("VecEnvConfig")
+        .field("envCount", &VecEnvConfigJS::envCount)
+        .field("deltaTime", &VecEnvConfigJS::deltaTime)
+        .field("maxSteps", &VecEnvConfigJS::maxSteps)
+        .field("spawnRadius", &VecEnvConfigJS::spawnRadius)
+        .field("arenaRadius", &VecEnvConfigJS::arenaRadius)
+        .field("targetRadius", &VecEnvConfigJS::targetRadius)
+        .field("reachBonus", &VecEnvConfigJS::reachBonus)
+        .field("seedLow", &VecEnvConfigJS::seedLow)
+        .field("seedHigh", &VecEnvConfigJS::seedHigh)
+        .field("integrator", &VecEnvConfigJS::integrator);
+
+    function("defaultVecEnvConfig", &defaultVecEnvConfig);
+
+    class_<VecEnvWrapper>("VecEnv")
+        .constructor<>()
+        .constructor<const VecEnvConfigJS&>()
+        .function("getEnvCount", &VecEnvWrapper::getEnvCount)
+        .function("step", &VecEnvWrapper::step)
+        .function("reset", &VecEnvWrapper::reset)
+        .function("resetAll", &VecEnvWrapper::resetAll)
+        .function("setNoiseState", &VecEnvWrapper::setNoiseState)
+        .function("setNoiseStateAll", &VecEnvWrapper::setNoiseStateAll)
+        .function("getStepCount", &VecEnvWrapper::getStepCount)
+        .function("getActionView", &VecEnvWrapper::getActionView)
+        .function("getResetView", &VecEnvWrapper::getResetView)
+        .function("getObservationView", &VecEnvWrapper::getObservationView)
+        .function("getRewardView", &VecEnvWrapper::getRewardView)
+        .function("getDoneView", &VecEnvWrapper::getDoneView);
+
+    // Observation record layout (float offsets within one env record)
+    constant("OBS_POSITION", static_cast<int>(ObservationLayout::POSITION));
+    constant("OBS_VELOCITY", static_cast<int>(ObservationLayout::VELOCITY));
+    constant("OBS_ANGULAR_VELOCITY", static_cast<int>(ObservationLayout::ANGULAR_VELOCITY));
+    constant("OBS_TARGET_DELTA", static_cast<int>(ObservationLayout::TARGET_DELTA));
+    constant("OBS_ROLL", static_cast<int>(ObservationLayout::ROLL));
+    constant("OBS_ENERGY", static_cast<int>(ObservationLayout::ENERGY));
+    constant("OBS_NOISE", static_cast<int>(ObservationLayout::NOISE));
+    constant("OBS_PROGRESS", static_cast<int>(ObservationLayout::PROGRESS));
+    constant("OBS_STRIDE", static_cast<int>(ObservationLayout::STRIDE));
+}
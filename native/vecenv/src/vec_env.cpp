@@ -0,0 +1,139 @@
+#include "vec_env.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace aeronav {
+
+namespace {
+
+// Uniform in [-radius, radius]
+float spawnCoordinate(RngStream& rng, float radius) {
+    return (rng.nextFloat() * 2.0f - 1.0f) * radius;
+}
+
+} // namespace
+
+VecEnv::VecEnv(const VecEnvConfig& config)
+    : config_(config)
+    , world_(config.envCount)
+    , agents_(config.seed, config.envCount)
+{
+    const size_t count = config_.envCount;
+    for (size_t env = 0; env < count; env++) {
+        world_.createBody(config_.ship);
+        agents_.createAgent(config_.agent);
+        // Split off the agent's stream id so spawns never share draws with it
+        spawnRngs_.push_back(RngStream(config_.seed, env).split(0));
+    }
+
+    noise_.assign(count, NoiseState::LOW_NOISE);
+    steps_.assign(count, 0);
+    observations_.assign(count * ObservationLayout::STRIDE, 0.0f);
+    rewards_.assign(count, 0.0f);
+    dones_.assign(count, 0);
+
+    resetAll();
+}
+
+void VecEnv::reset(const uint32_t* ids, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (ids[i] < config_.envCount) resetEnv(ids[i]);
+    }
+}
+
+void VecEnv::resetAll() {
+    for (size_t env = 0; env < config_.envCount; env++) {
+        resetEnv(static_cast<uint32_t>(env));
+    }
+}
+
+void VecEnv::resetEnv(uint32_t env) {
+    RngStream& rng = spawnRngs_[env];
+    const float r = config_.spawnRadius;
+    const float x = spawnCoordinate(rng, r), y = spawnCoordinate(rng, r), z = spawnCoordinate(rng, r);
+    const float tx = spawnCoordinate(rng, r), ty = spawnCoordinate(rng, r), tz = spawnCoordinate(rng, r);
+
+    world_.resetBody(env, x, y, z);
+    world_.setTarget(env, tx, ty, tz);
+    agents_.resetEnergy(env);
+
+    steps_[env] = 0;
+    rewards_[env] = 0.0f;
+    dones_[env] = 0;
+    writeObservation(env);
+}
+
+void VecEnv::step(const int32_t* actions) {
+    const size_t count = config_.envCount;
+    const float* energy = agents_.getArrays().energy;
+
+    // Reward and energy use the pre-step energy; ships with none left idle
+    for (uint32_t env = 0; env < count; env++) {
+        ThrustAction action = toThrustAction(actions[env]);
+        if (energy[env] <= 0.0f) action = ThrustAction::IDLE;
+
+        rewards_[env] = agents_.calculateReward(env, noise_[env], action, energy[env]);
+        agents_.consumeEnergy(env, action);
+        agents_.regenEnergy(env, config_.deltaTime);
+        world_.applyThrust(env, action);
+    }
+
+    withIntegrator(config_.integrator, [&](auto policy) {
+        world_.stepAllWith<decltype(policy)>(config_.deltaTime);
+    });
+
+    for (uint32_t env = 0; env < count; env++) {
+        steps_[env]++;
+
+        const bool reached = distanceToTarget(env) <= config_.targetRadius;
+        if (reached) rewards_[env] += config_.reachBonus;
+
+        const bool escaped = world_.getPosition(env).length() > config_.arenaRadius;
+        const bool exhausted = energy[env] <= 0.0f;
+        const bool timedOut = steps_[env] >= config_.maxSteps;
+        if (reached || escaped || exhausted || timedOut) dones_[env] = 1;
+
+        writeObservation(env);
+    }
+}
+
+void VecEnv::setNoiseState(uint32_t env, NoiseState state) {
+    if (env >= config_.envCount) return;
+    noise_[env] = state;
+    observations_[env * ObservationLayout::STRIDE + ObservationLayout::NOISE] =
+        state == NoiseState::HIGH_NOISE ? 1.0f : 0.0f;
+}
+
+void VecEnv::setNoiseStateAll(NoiseState state) {
+    for (size_t env = 0; env < config_.envCount; env++) {
+        setNoiseState(static_cast<uint32_t>(env), state);
+    }
+}
+
+float VecEnv::distanceToTarget(uint32_t env) const {
+    return (world_.getTarget(env) - world_.getPosition(env)).length();
+}
+
+void VecEnv::writeObservation(uint32_t env) {
+    const float* state = world_.getStateBuffer() + env * StateLayout::STRIDE;
+    float* obs = observations_.data() + env * ObservationLayout::STRIDE;
+
+    const Vector3 target = world_.getTarget(env);
+    for (size_t k = 0; k < 3; k++) {
+        obs[ObservationLayout::POSITION + k] = state[StateLayout::POSITION + k];
+        obs[ObservationLayout::VELOCITY + k] = state[StateLayout::VELOCITY + k];
+        obs[ObservationLayout::ANGULAR_VELOCITY + k] = state[StateLayout::ANGULAR_VELOCITY + k];
+    }
+    obs[ObservationLayout::TARGET_DELTA + 0] = target.x - state[StateLayout::POSITION + 0];
+    obs[ObservationLayout::TARGET_DELTA + 1] = target.y - state[StateLayout::POSITION + 1];
+    obs[ObservationLayout::TARGET_DELTA + 2] = target.z - state[StateLayout::POSITION + 2];
+    obs[ObservationLayout::ROLL] = world_.getRoll(env);
+
+    const float maxEnergy = config_.agent.energy.max;
+    obs[ObservationLayout::ENERGY] = maxEnergy > 0.0f ? agents_.getArrays().energy[env] / maxEnergy : 0.0f;
+    obs[ObservationLayout::NOISE] = noise_[env] == NoiseState::HIGH_NOISE ? 1.0f : 0.0f;
+    obs[ObservationLayout::PROGRESS] = config_.maxSteps > 0
+        ? static_cast<float>(steps_[env]) / static_cast<float>(config_.maxSteps) : 0.0f;
+}
+
+} // namespace aeronav
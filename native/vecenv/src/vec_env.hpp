@@ -0,0 +1,93 @@
+#pragma once
+
+#include "physics_world.hpp"
+#include "multi_agent.hpp"
+#include "rng.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aeronav {
+
+// Observation record layout (floats per environment)
+struct ObservationLayout {
+    static constexpr size_t POSITION = 0;           // x, y, z
+    static constexpr size_t VELOCITY = 3;           // x, y, z
+    static constexpr size_t ANGULAR_VELOCITY = 6;   // x, y, z
+    static constexpr size_t TARGET_DELTA = 9;       // target - position
+    static constexpr size_t ROLL = 12;
+    static constexpr size_t ENERGY = 13;            // fraction of the agent's max energy
+    static constexpr size_t NOISE = 14;             // 0 = LOW_NOISE, 1 = HIGH_NOISE
+    static constexpr size_t PROGRESS = 15;          // steps / maxSteps
+    static constexpr size_t STRIDE = 16;
+};
+
+// Configuration shared by every environment
+struct VecEnvConfig {
+    size_t envCount = 1;
+    float deltaTime = 0.016f;       // seconds per step
+    uint32_t maxSteps = 1000;       // done after this many steps
+    float spawnRadius = 20.0f;      // ships and targets spawn in [-r, r] per axis
+    float arenaRadius = 100.0f;     // done when a ship gets this far from the origin
+    float targetRadius = 1.0f;      // done (plus reachBonus) when this close to the target
+    float reachBonus = 1.0f;
+    uint64_t seed = 0;              // spawn and agent streams
+    IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER;
+    SpaceshipConfig ship;
+    AgentConfig agent;
+};
+
+/**
+ * Headless vectorized training environment
+ * Owns M environments, each one ship in a batched PhysicsWorld plus one agent
+ * in a MultiAgentSystem (env i = body i = agent i). step() takes one
+ * ThrustAction per env and advances every ship with a single stepAll();
+ * observations, rewards and done flags land in contiguous buffers owned by
+ * the env. Done envs keep their flag until they are reset().
+ */
+class VecEnv {
+public:
+    explicit VecEnv(const VecEnvConfig& config = VecEnvConfig());
+
+    size_t getEnvCount() const { return config_.envCount; }
+    const VecEnvConfig& getConfig() const { return config_; }
+
+    // Respawn ship and target, refill energy, clear the step count and done flag
+    void reset(const uint32_t* ids, size_t count);
+    void resetAll();
+
+    // One action per env (ThrustAction values; anything else is IDLE)
+    void step(const int32_t* actions);
+
+    // Noise condition seen by each env's reward model and observation
+    void setNoiseState(uint32_t env, NoiseState state);
+    void setNoiseStateAll(NoiseState state);
+
+    // envCount * ObservationLayout::STRIDE floats, envCount rewards / done flags
+    const float* getObservations() const { return observations_.data(); }
+    const float* getRewards() const { return rewards_.data(); }
+    const uint8_t* getDones() const { return dones_.data(); }
+    uint32_t getStepCount(uint32_t env) const { return env < steps_.size() ? steps_[env] : 0; }
+
+    PhysicsWorld& world() { return world_; }
+    MultiAgentSystem& agents() { return agents_; }
+
+private:
+    VecEnvConfig config_;
+    PhysicsWorld world_;
+    MultiAgentSystem agents_;
+
+    std::vector<RngStream> spawnRngs_;   // per-env respawn streams
+    std::vector<NoiseState> noise_;
+    std::vector<uint32_t> steps_;
+
+    std::vector<float> observations_;
+    std::vector<float> rewards_;
+    std::vector<uint8_t> dones_;
+
+    void resetEnv(uint32_t env);
+    void writeObservation(uint32_t env);
+    float distanceToTarget(uint32_t env) const;
+};
+
+} // namespace aeronav
@@ -0,0 +1,87 @@
+#include "vec_env_capi.h"
+#include "vec_env.hpp"
+
+using aeronav::NoiseState;
+using aeronav::VecEnv;
+using aeronav::VecEnvConfig;
+
+struct AeronavVecEnv {
+    explicit AeronavVecEnv(const VecEnvConfig& config) : env(config) {}
+    VecEnv env;
+};
+
+void aeronav_vecenv_default_config(AeronavVecEnvConfig* config) {
+    if (!config) return;
+    const VecEnvConfig defaults;
+    config->env_count = static_cast<uint32_t>(defaults.envCount);
+    config->delta_time = defaults.deltaTime;
+    config->max_steps = defaults.maxSteps;
+    config->spawn_radius = defaults.spawnRadius;
+    config->arena_radius = defaults.arenaRadius;
+    config->target_radius = defaults.targetRadius;
+    config->reach_bonus = defaults.reachBonus;
+    config->seed = defaults.seed;
+}
+
+AeronavVecEnv* aeronav_vecenv_create(const AeronavVecEnvConfig* config) {
+    VecEnvConfig cfg;
+    if (config) {
+        cfg.envCount = config->env_count;
+        cfg.deltaTime = config->delta_time;
+        cfg.maxSteps = config->max_steps;
+        cfg.spawnRadius = config->spawn_radius;
+        cfg.arenaRadius = config->arena_radius;
+        cfg.targetRadius = config->target_radius;
+        cfg.reachBonus = config->reach_bonus;
+        cfg.seed = config->seed;
+    }
+    // Nothing may unwind across the C boundary
+    try {
+        return new AeronavVecEnv(cfg);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void aeronav_vecenv_destroy(AeronavVecEnv* env) {
+    delete env;
+}
+
+uint32_t aeronav_vecenv_env_count(const AeronavVecEnv* env) {
+    return env ? static_cast<uint32_t>(env->env.getEnvCount()) : 0;
+}
+
+uint32_t aeronav_vecenv_observation_stride(void) {
+    return static_cast<uint32_t>(aeronav::ObservationLayout::STRIDE);
+}
+
+void aeronav_vecenv_reset(AeronavVecEnv* env, const uint32_t* ids, uint32_t count) {
+    if (env && ids) env->env.reset(ids, count);
+}
+
+void aeronav_vecenv_reset_all(AeronavVecEnv* env) {
+    if (env) env->env.resetAll();
+}
+
+void aeronav_vecenv_step(AeronavVecEnv* env, const int32_t* actions) {
+    if (env && actions) env->env.step(actions);
+}
+
+void aeronav_vecenv_set_noise_state(AeronavVecEnv* env, int32_t env_index, int32_t noise_state) {
+    if (!env) return;
+    const NoiseState state = noise_state == 1 ? NoiseState::HIGH_NOISE : NoiseState::LOW_NOISE;
+    if (env_index < 0) env->env.setNoiseStateAll(state);
+    else env->env.setNoiseState(static_cast<uint32_t>(env_index), state);
+}
+
+const float* aeronav_vecenv_observations(const AeronavVecEnv* env) {
+    return env ? env->env.getObservations() : nullptr;
+}
+
+const float* aeronav_vecenv_rewards(const AeronavVecEnv* env) {
+    return env ? env->env.getRewards() : nullptr;
+}
+
+const uint8_t* aeronav_vecenv_dones(const AeronavVecEnv* env) {
+    return env ? env->env.getDones() : nullptr;
+}
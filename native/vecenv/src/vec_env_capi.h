@@ -0,0 +1,63 @@
+/*
+ * C ABI for the native vec-env shared library (libvec_env)
+ * Loadable from Python with ctypes/cffi; the buffer accessors return pointers
+ * into env-owned memory that stay valid until aeronav_vecenv_destroy(), so they
+ * can be wrapped as NumPy arrays once (np.ctypeslib.as_array) and reused.
+ */
+#ifndef AERONAV_VEC_ENV_CAPI_H
+#define AERONAV_VEC_ENV_CAPI_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #define AERONAV_VECENV_API __declspec(dllexport)
+#else
+    #define AERONAV_VECENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct AeronavVecEnv AeronavVecEnv;
+
+/* Scalar subset of aeronav::VecEnvConfig (ship and agent use their defaults) */
+typedef struct AeronavVecEnvConfig {
+    uint32_t env_count;
+    float delta_time;
+    uint32_t max_steps;
+    float spawn_radius;
+    float arena_radius;
+    float target_radius;
+    float reach_bonus;
+    uint64_t seed;
+} AeronavVecEnvConfig;
+
+AERONAV_VECENV_API void aeronav_vecenv_default_config(AeronavVecEnvConfig* config);
+
+/* Returns NULL on failure (e.g. allocation) */
+AERONAV_VECENV_API AeronavVecEnv* aeronav_vecenv_create(const AeronavVecEnvConfig* config);
+AERONAV_VECENV_API void aeronav_vecenv_destroy(AeronavVecEnv* env);
+
+AERONAV_VECENV_API uint32_t aeronav_vecenv_env_count(const AeronavVecEnv* env);
+AERONAV_VECENV_API uint32_t aeronav_vecenv_observation_stride(void);
+
+AERONAV_VECENV_API void aeronav_vecenv_reset(AeronavVecEnv* env, const uint32_t* ids, uint32_t count);
+AERONAV_VECENV_API void aeronav_vecenv_reset_all(AeronavVecEnv* env);
+
+/* actions: env_count ThrustAction values (0=IDLE, 1=GLIDE, 2=BOOST, 3=STABILIZE) */
+AERONAV_VECENV_API void aeronav_vecenv_step(AeronavVecEnv* env, const int32_t* actions);
+
+/* noise_state: 0 = LOW_NOISE, 1 = HIGH_NOISE; env_index < 0 sets every env */
+AERONAV_VECENV_API void aeronav_vecenv_set_noise_state(AeronavVecEnv* env, int32_t env_index, int32_t noise_state);
+
+/* env_count * observation_stride floats, env_count rewards, env_count done flags */
+AERONAV_VECENV_API const float* aeronav_vecenv_observations(const AeronavVecEnv* env);
+AERONAV_VECENV_API const float* aeronav_vecenv_rewards(const AeronavVecEnv* env);
+AERONAV_VECENV_API const uint8_t* aeronav_vecenv_dones(const AeronavVecEnv* env);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AERONAV_VEC_ENV_CAPI_H */
@@ -106,6 +106,20 @@ else
     echo -e "${YELLOW}⚠ RL module not found at $NATIVE_DIR/rl${NC}"
 fi
 
+# Build vectorized training env (physics + RL)
+if [[ -d "$NATIVE_DIR/vecenv" ]]; then
+    build_module "vec_env" "$NATIVE_DIR/vecenv"
+else
+    echo -e "${YELLOW}⚠ VecEnv module not found at $NATIVE_DIR/vecenv${NC}"
+fi
+
+# Build fused audio -> RL pipeline (audio bands + RL)
+if [[ -d "$NATIVE_DIR/pipeline" ]]; then
+    build_module "noise_pipeline" "$NATIVE_DIR/pipeline"
+else
+    echo -e "${YELLOW}⚠ Pipeline module not found at $NATIVE_DIR/pipeline${NC}"
+fi
+
 # Summary
 echo -e "${BLUE}================================${NC}"
 echo -e "${BLUE}  Build Complete${NC}"